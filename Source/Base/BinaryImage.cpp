@@ -0,0 +1,201 @@
+#include "BinaryImage.h"
+
+namespace {
+
+const size_t IMAGE_HEADER_SIZE = 16;
+const size_t IMAGE_ALIGN = 8;
+
+}
+
+ImageWriter::ImageWriter(UINT32 magic, UINT32 version)
+{
+    Allocate(IMAGE_HEADER_SIZE);
+    Put<UINT32>(0, magic);
+    Put<UINT32>(4, version);
+}
+
+UINT32 ImageWriter::Allocate(size_t size)
+{
+    size_t offset = (bytes_.size() + IMAGE_ALIGN - 1) / IMAGE_ALIGN * IMAGE_ALIGN;
+    if (offset + size > 0xFFFFFFFF)
+        throw std::length_error("image over 4GB");
+    bytes_.resize(offset + size, '\0');
+    return static_cast<UINT32>(offset);
+}
+
+void ImageWriter::PutRef(UINT32 field, UINT32 target)
+{
+    ASSERT(field != target);
+    Put<UINT32>(field, target == 0 ? 0 : target - field);
+}
+
+UINT32 ImageWriter::PutString(StringRef s)
+{
+    auto it = strings_.find(s.toString());
+    if (it != strings_.end())
+        return it->second;
+
+    UINT32 offset = Allocate(4 + s.size() + 1);
+    Put<UINT32>(offset, static_cast<UINT32>(s.size()));
+    memcpy(&bytes_[offset + 4], s.begin(), s.size());
+    strings_.emplace(s.toString(), offset);
+    return offset;
+}
+
+UINT32 ImageWriter::Find(const void * object) const
+{
+    auto it = objects_.find(object);
+    return it != objects_.end() ? it->second : 0;
+}
+
+void ImageWriter::Bind(const void * object, UINT32 offset)
+{
+    objects_.emplace(object, offset);
+}
+
+void ImageWriter::Defer(std::function<void()> fill)
+{
+    pending_.push(std::move(fill));
+}
+
+void ImageWriter::Flush()
+{
+    while (!pending_.empty())
+    {
+        std::function<void()> fill = std::move(pending_.front());
+        pending_.pop();
+        fill();
+    }
+}
+
+std::string ImageWriter::Finish(UINT32 root)
+{
+    Flush();
+    Allocate(0);
+    Put<UINT32>(8, static_cast<UINT32>(bytes_.size()));
+    Put<UINT32>(12, root);
+    return std::move(bytes_);
+}
+
+ImageReader::ImageReader(const char * data, size_t size, UINT32 magic, UINT32 version)
+    : data_(data), size_(size), root_(0)
+{
+    if (size < IMAGE_HEADER_SIZE ||
+        Get<UINT32>(0) != magic ||
+        Get<UINT32>(4) != version ||
+        Get<UINT32>(8) != size)
+    {
+        throw std::invalid_argument("not an image of this kind and version");
+    }
+    root_ = Get<UINT32>(12);
+    if (root_ != 0 && root_ < IMAGE_HEADER_SIZE)
+        throw std::invalid_argument("bad image root");
+    Check(root_, 1);
+}
+
+UINT32 ImageReader::GetRef(UINT32 field) const
+{
+    UINT32 relative = Get<UINT32>(field);
+    if (relative == 0)
+        return 0;
+
+    UINT32 target = field + relative;
+    if (target < IMAGE_HEADER_SIZE)
+        throw std::invalid_argument("image reference out of range");
+    Check(target, 1);
+    return target;
+}
+
+StringRef ImageReader::GetString(UINT32 offset) const
+{
+    UINT32 length = Get<UINT32>(offset);
+    Check(offset, 4 + size_t(length) + 1);
+    return StringRef(data_ + offset + 4, length);
+}
+
+void * ImageReader::Find(UINT32 offset) const
+{
+    auto it = objects_.find(offset);
+    return it != objects_.end() ? it->second : nullptr;
+}
+
+void ImageReader::Bind(UINT32 offset, void * object)
+{
+    objects_.emplace(offset, object);
+}
+
+void ImageReader::Defer(std::function<void()> fill)
+{
+    pending_.push(std::move(fill));
+}
+
+void ImageReader::Flush()
+{
+    while (!pending_.empty())
+    {
+        std::function<void()> fill = std::move(pending_.front());
+        pending_.pop();
+        fill();
+    }
+}
+
+void ImageReader::Check(UINT32 offset, size_t size) const
+{
+    if (offset + size > size_)
+        throw std::invalid_argument("image reference out of range");
+}
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+TEST(BinaryImage_RoundTrip)
+{
+    // List a -> b -> a, name strings shared.
+    struct Item { Item * next; StringRef name; UINT64 value; };
+    Item a = { nullptr, "x", 1 };
+    Item b = { &a, "x", 2 };
+    a.next = &b;
+
+    ImageWriter writer(0x54534554, 1);
+    std::function<UINT32(const Item *)> put = [&](const Item * item) -> UINT32
+    {
+        UINT32 offset = writer.Find(item);
+        if (offset == 0)
+        {
+            offset = writer.Allocate(16);
+            writer.Bind(item, offset);
+            writer.Defer([&, item, offset]()
+            {
+                writer.Put<UINT64>(offset, item->value);
+                writer.PutRef(offset + 8, put(item->next));
+                writer.PutRef(offset + 12, writer.PutString(item->name));
+            });
+        }
+        return offset;
+    };
+    UINT32 root = put(&a);
+    std::string image = writer.Finish(root);
+    EXPECT_EQ(image.size() % 8, 0);
+
+    ImageReader reader(image.data(), image.size(), 0x54534554, 1);
+    UINT32 first = reader.Root();
+    UINT32 second = reader.GetRef(first + 8);
+    EXPECT_EQ(reader.Get<UINT64>(first), 1);
+    EXPECT_EQ(reader.Get<UINT64>(second), 2);
+    EXPECT_EQ(reader.GetRef(second + 8), first);
+    EXPECT_EQ(reader.GetRef(first + 12), reader.GetRef(second + 12));
+    EXPECT_EQ(reader.GetString(reader.GetRef(first + 12)).toString(), "x");
+
+    // Position independent.
+    std::string moved = "12345678" + image;
+    ImageReader movedReader(moved.data() + 8, image.size(), 0x54534554, 1);
+    EXPECT_EQ(movedReader.Get<UINT64>(movedReader.GetRef(movedReader.Root() + 8)), 2);
+
+    int errors = 0;
+    try { ImageReader(image.data(), image.size(), 0x54534554, 2); } catch (const std::invalid_argument &) { ++errors; }
+    try { ImageReader(image.data(), image.size() - 8, 0x54534554, 1); } catch (const std::invalid_argument &) { ++errors; }
+    try { reader.Get<UINT64>(static_cast<UINT32>(image.size() - 4)); } catch (const std::invalid_argument &) { ++errors; }
+    EXPECT_EQ(errors, 3);
+}
+
+#endif
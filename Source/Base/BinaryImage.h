@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+#include "Integer.h"
+#include "Legacy.h" // StringRef
+
+// Binary image of pointer-linked data, for caches and for handing data to
+// other processes. Records are 8 byte aligned and refer to each other by
+// 32 bit offsets relative to the referring field, 0 for null, so an image
+// can be memory-mapped and read in place. Loading turns references back
+// into pointers, nothing else is fixed up. A field never refers to itself,
+// records keep a non-reference field first.
+//
+// Header: magic, version, image size, root record offset. Native byte order.
+//
+// Objects are written and loaded on first reference: Find/Bind keep object
+// identity (shared and cyclic references), Defer/Flush fill records from a
+// queue instead of recursing down long lists and deep trees.
+
+class ImageWriter
+{
+public:
+    ImageWriter(UINT32 magic, UINT32 version);
+
+    // Offset of size zero bytes.
+    UINT32      Allocate(size_t size);
+
+    template <typename T>
+    void        Put(UINT32 offset, T value)
+    {
+        ASSERT(offset + sizeof(T) <= bytes_.size());
+        memcpy(&bytes_[offset], &value, sizeof(T));
+    }
+    void        PutRef(UINT32 field, UINT32 target);
+    // Offset of string record (length, chars, '\0'), same string once.
+    UINT32      PutString(StringRef s);
+
+    // Record offset of object, 0 if not allocated yet.
+    UINT32      Find(const void * object) const;
+    void        Bind(const void * object, UINT32 offset);
+    void        Defer(std::function<void()> fill);
+    void        Flush();
+
+    std::string Finish(UINT32 root);
+
+private:
+    std::string                                 bytes_;
+    std::map<const void *, UINT32>              objects_;
+    std::map<std::string, UINT32>               strings_;
+    std::queue<std::function<void()>>           pending_;
+};
+
+// Bounds checked, std::invalid_argument on a bad image.
+class ImageReader
+{
+public:
+    // data must outlive the reader and loaded strings.
+    ImageReader(const char * data, size_t size, UINT32 magic, UINT32 version);
+
+    UINT32      Root() const { return root_; }
+    size_t      Size() const { return size_; }
+
+    template <typename T>
+    T           Get(UINT32 offset) const
+    {
+        Check(offset, sizeof(T));
+        T value;
+        memcpy(&value, data_ + offset, sizeof(T));
+        return value;
+    }
+    UINT32      GetRef(UINT32 field) const;
+    // Points into the image.
+    StringRef   GetString(UINT32 offset) const;
+
+    void *      Find(UINT32 offset) const;
+    void        Bind(UINT32 offset, void * object);
+    void        Defer(std::function<void()> fill);
+    void        Flush();
+
+private:
+    void        Check(UINT32 offset, size_t size) const;
+
+    const char *                        data_;
+    size_t                              size_;
+    UINT32                              root_;
+    std::map<UINT32, void *>            objects_;
+    std::queue<std::function<void()>>   pending_;
+};
@@ -48,6 +48,13 @@ std::string GetFileContent(const char * fileName)
                        std::istreambuf_iterator<char>());
 }
 
+bool FileExists(const char * fileName)
+{
+    DWORD attributes = GetFileAttributesA(fileName);
+    return attributes != INVALID_FILE_ATTRIBUTES &&
+        !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+
 void SetFileContent(const char * fileName, const std::string & content)
 {
     std::ofstream ofs(fileName, std::ifstream::out);
@@ -55,6 +62,19 @@ void SetFileContent(const char * fileName, const std::string & content)
     ofs.close();
 }
 
+std::string GetTempFilePath(const std::string & fileName)
+{
+    char buf[MAX_PATH + 1];
+    DWORD length = GetTempPathA(MAX_PATH + 1, buf);
+    assert(length != 0 && length <= MAX_PATH);
+    return std::string(buf, length) + fileName;
+}
+
+void RemoveFile(const char * fileName)
+{
+    DeleteFileA(fileName);
+}
+
 std::string ChangeFileExtention(const std::string & filename,
                                 std::string from,
                                 std::string to)
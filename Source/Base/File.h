@@ -8,9 +8,16 @@ std::string GetCanonicalFileDirectory(std::string fileName);
 
 std::string GetFileContent(const char * fileName);
 
+bool FileExists(const char * fileName);
+
 void SetFileContent(const char * fileName,
                     const std::string & content);
 
+// Path of fileName in the temporary directory, for files that go away.
+std::string GetTempFilePath(const std::string & fileName);
+
+void RemoveFile(const char * fileName);
+
 std::string ChangeFileExtention(const std::string & filename,
                                 std::string from,
                                 std::string to);
\ No newline at end of file
@@ -8,6 +8,8 @@ typedef uint32_t u32;
 typedef u64 uptr;
 typedef i64 iptr;
 
+using UINT8 = uint8_t;
+using INT16 = int16_t;
 using UINT32 = uint32_t;
 using UINT64 = uint64_t;
 using UINT = UINT32;
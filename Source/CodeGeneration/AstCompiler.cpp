@@ -2,10 +2,14 @@
 
 #include <vector>
 #include <deque>
+#include <cmath>
+#include <climits>
+#include <stdexcept>
 
 #include "AstCompiler.h"
 #include "../Base/Logging.h"
 #include "../Parse/ParseMacros.h"
+#include "../Preprocess/Literal.h"
 
 AstCompileContext * CreateAstCompileContext()
 {
@@ -218,6 +222,35 @@ void EndFunctionContext(AstCompileContext * context)
     context->currentFunctionDefinitionContext = nullptr;
 }
 
+// Body of an earlier compile instead of compiling it: its block scope goes
+// under the new function scope, as the last child like a compiled body's,
+// for the objects it defines, and its constants are located again in order.
+void LinkFunctionBody(AstCompileContext * context,
+                      Language::DefinitionContext * functionDefinitionContext,
+                      Language::FunctionContext * functionContext)
+{
+    Language::DefinitionContext * body = functionContext->functionBody->stmt.context;
+    body->parent = functionDefinitionContext;
+    body->next = nullptr;
+    Language::DefinitionContext ** last = &functionDefinitionContext->firstChild;
+    while (*last)
+        last = &(*last)->next;
+    *last = body;
+
+    for (float value : functionContext->floatConstants)
+        (void)Language::LocateFloat(context->constantContext, value);
+    for (StringRef value : functionContext->stringConstants)
+    {
+        Location stringLocation;
+        Location stringPointerLocation;
+        Language::LocateString(context->constantContext, value, &stringLocation, &stringPointerLocation);
+        delete stringLocation.labelValue;
+        delete stringPointerLocation.labelValue;
+    }
+
+    context->functionContexts.push_back(functionContext);
+}
+
 Language::ObjectStorageType ComputeObjectStorageType(ASTScope scope,
                                                      Token::Type storageToken)
 {
@@ -378,7 +411,7 @@ Language::Type * ConcatType(AstCompileContext * context,
                             Language::Type * declarator)
 {
     // declarator = {nullptr, array x pointer x function}
-    Language::TypeSetProperties(typeSpecifier, typeQualifier);
+    typeSpecifier = Language::TypeSetProperties(context->typeContext, typeSpecifier, typeQualifier);
     if (declarator)
     {
         Language::Type * endType = declarator;
@@ -406,6 +439,7 @@ Language::Type * ConcatType(AstCompileContext * context,
                 break;
             default: ASSERT(false); break;
         }
+        (void)Language::CanonicalType(context->typeContext, declarator);
         return declarator;
     }
     else
@@ -414,6 +448,40 @@ Language::Type * ConcatType(AstCompileContext * context,
     }
 }
 
+// Constant DSL:
+// integer constant type, the first of int, unsigned int (octal/hex or u),
+// long, unsigned long (l) that can hold the value.
+Language::IntType * IntegerConstantType(AstCompileContext * context, const Token & token)
+{
+    UINT64 value = token.ival;
+    bool isDecimal = token.text[0] != '0';
+    bool isUnsigned = (token.suffix & LITERAL_UNSIGNED) != 0;
+    bool isLong = (token.suffix & LITERAL_LONG) != 0;
+
+    if (!isLong && !isUnsigned && value <= INT_MAX)
+        return Language::MakeInt(context->typeContext);
+    if (!isLong && (isUnsigned || !isDecimal) && value <= UINT_MAX)
+        return Language::MakeInt(context->typeContext, 4, false);
+    if (!isUnsigned && value <= LLONG_MAX)
+        return Language::MakeInt(context->typeContext, 8);
+    return Language::MakeInt(context->typeContext, 8, false);
+}
+// enum and case constants are int
+int IntConstantValue(const Token & token)
+{
+    if (token.ival > INT_MAX)
+        throw std::invalid_argument("integer constant out of int range: " + token.text);
+    return static_cast<int>(token.ival);
+}
+// double is float-4, reject what doesn't fit instead of making it inf
+float FloatConstantValue(const Token & token)
+{
+    float value = static_cast<float>(token.fval);
+    if (std::isinf(value))
+        throw std::invalid_argument("floating constant out of float range: " + token.text);
+    return value;
+}
+
 // rules
 // 1. if an ast node generates: at head define local variables, at tail push them on stack.
 //      * type specifier, type qualifier, storage use DSL for more check
@@ -421,11 +489,11 @@ Language::Type * ConcatType(AstCompileContext * context,
 // 3. in function body, both DSL and FunctioContext handles current DefinitionContext.
 
 // TODO: mechanism to check what's generated by a child is as expected, 1 StringRef? 1 Type?
-void CompileAst(AstCompileContext * context, Ast * ast)
+void CompileAst(AstCompileContext * context, Ast ast)
 {
-    Ast * child = ast->leftChild;
+    Ast child = ast.LeftChild();
 
-    if (ast->type == TRANSLATION_UNIT)
+    if (ast.Type() == TRANSLATION_UNIT)
     {
         EnterDefinitionContext(context,
                                NewDefinitionContext(context, Language::GLOBAL_SCOPE));
@@ -434,7 +502,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         while (child)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
         EndScope(context);
@@ -443,7 +511,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         context->globalDefinitionContext = context->definitionContexts.back();
         ExitDefinitionContext(context);
     }
-    else if (ast->type == FUNCTION_DEFINITION)
+    else if (ast.Type() == FUNCTION_DEFINITION)
     {
         BeginTypeSpecifier(context);
         BeginTypeQualifier(context);
@@ -451,7 +519,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         
         // declaration specifiers
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Token::Type         storageToken = GetStorage(context);
         Language::Type *    typeSpecifier = GetTypeSpecifier(context);
@@ -468,7 +536,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         
         // declarator
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
         
         ExitDefinitionContext(context);
 
@@ -488,19 +556,27 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                         ? Language::FunctionStorageType::PRIVATE_FUNCTION
                                         : Language::FunctionStorageType::PUBLIC_FUNCTION);
 
-        EnterDefinitionContext(context, functionDefinitionContext);
-        BeginScope(context, IN_COMPOUND_STATEMENT);
-        BeginFunctionContext(context, functionName, Language::AsFunction(functionType), functionDefinitionContext);
+        auto reused = context->reusedFunctionContexts.find(context->functionContexts.size());
+        if (reused != context->reusedFunctionContexts.end())
+        {
+            LinkFunctionBody(context, functionDefinitionContext, reused->second);
+        }
+        else
+        {
+            EnterDefinitionContext(context, functionDefinitionContext);
+            BeginScope(context, IN_COMPOUND_STATEMENT);
+            BeginFunctionContext(context, functionName, Language::AsFunction(functionType), functionDefinitionContext);
 
-        // compound statement
-        CompileAst(context, child);
-        context->currentFunctionContext->functionBody = PopNode(context);
+            // compound statement
+            CompileAst(context, child);
+            context->currentFunctionContext->functionBody = PopNode(context);
 
-        EndFunctionContext(context);
-        EndScope(context);
-        ExitDefinitionContext(context);
+            EndFunctionContext(context);
+            EndScope(context);
+            ExitDefinitionContext(context);
+        }
     }
-    else if (ast->type == DECLARATION)
+    else if (ast.Type() == DECLARATION)
     {
         BeginTypeSpecifier(context);
         BeginTypeQualifier(context);
@@ -508,20 +584,20 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         // declaration specifier
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         // declarator initializer
         while (child)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
         EndStorage(context);
         EndTypeQualifier(context);
         EndTypeSpecifier(context);
     }
-    else if (ast->type == DECLARATOR_INITIALIZER)
+    else if (ast.Type() == DECLARATOR_INITIALIZER)
     {
         Token::Type         storageToken = GetStorage(context);
         Language::Type *    typeSpecifier = GetTypeSpecifier(context);
@@ -547,8 +623,8 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         }
         else if (type->name == Language::FUNCTION)
         {
-            Language::TypeSetAssignable(type);
-            Language::TypeSetAddressable(type);
+            type = Language::TypeSetAssignable(context->typeContext, type);
+            type = Language::TypeSetAddressable(context->typeContext, type);
             (void)NewFunctionDefinition(CurrentDefinitionContext(context),
                                         id,
                                         type,
@@ -558,8 +634,8 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         }
         else
         {
-            Language::TypeSetAssignable(type);
-            Language::TypeSetAddressable(type);
+            type = Language::TypeSetAssignable(context->typeContext, type);
+            type = Language::TypeSetAddressable(context->typeContext, type);
             (void)Language::NewObjectDefinition(CurrentDefinitionContext(context),
                                                 id,
                                                 type,
@@ -568,38 +644,38 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         // TODO: initializer
     }
-    else if (ast->type == DECLARATOR)
+    else if (ast.Type() == DECLARATOR)
     {
         Language::Type * type = nullptr;
         StringRef id;
 
         // pointer list
         Language::PointerType * pointerType = nullptr;
-        if (child->type == POINTER_LIST)
+        if (child.Type() == POINTER_LIST)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
 
             pointerType = AsPointer(PopType(context));
         }
 
         // id / declarator
         Language::Type * innerType = nullptr;
-        if (child->type == IDENTIFIER)
+        if (child.Type() == IDENTIFIER)
         {
-            ASSERT(!child->token.text.empty());
+            ASSERT(!child.GetToken().text.empty());
 
-            id = child->token.text;
+            id = child.GetToken().text;
         }
         else
         {
-            ASSERT(child->type == DECLARATOR);
+            ASSERT(child.Type() == DECLARATOR);
             CompileAst(context, child);
 
             id = PopId(context);
             innerType = PopType(context);
         }
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         // array:constant expression / function:parameter list
         // constrain: 1+ array or 1 function
@@ -608,13 +684,13 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         int constrain = 0;
         while (child)
         {
-            if (child->type == PRIMARY_EXPR)
+            if (child.Type() == PRIMARY_EXPR)
             {
                 ASSERT(constrain < 2);
                 constrain = 1;
-                ASSERT(child->token.type == Token::CONST_INT);
+                ASSERT(child.GetToken().type == Token::CONST_INT);
 
-                Language::ArrayType * arrayType = Language::MakeArray(context->typeContext, child->token.ival);
+                Language::ArrayType * arrayType = Language::MakeArray(context->typeContext, static_cast<size_t>(child.GetToken().ival));
 
                 if (endType)
                 {
@@ -631,7 +707,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
             {
                 ASSERT(constrain == 0);
                 constrain = 2;
-                ASSERT(child->type == PARAMETER_LIST);
+                ASSERT(child.Type() == PARAMETER_LIST);
 
                 Language::FunctionType * functionType = Language::MakeFunction(context->typeContext);
                 
@@ -651,7 +727,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                 }
                 endType = &functionType->type;
             }
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
         if (beginType)
@@ -672,30 +748,30 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         PushId(context, id);
         PushType(context, type);
     }
-    else if (ast->type == DIRECT_DECLARATOR)
+    else if (ast.Type() == DIRECT_DECLARATOR)
     {
 
     }
-    else if (ast->type == ABSTRACT_DECLARATOR)
+    else if (ast.Type() == ABSTRACT_DECLARATOR)
     {
         Language::Type * type = nullptr;
 
         // pointer list
         Language::PointerType * pointerType = nullptr;
-        if (child->type == POINTER_LIST)
+        if (child.Type() == POINTER_LIST)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
 
             pointerType = AsPointer(PopType(context));
         }
 
         // abstract declarator
         Language::Type * innerType = nullptr;
-        if (child && child->type == ABSTRACT_DECLARATOR)
+        if (child && child.Type() == ABSTRACT_DECLARATOR)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
 
             innerType = PopType(context);
         }
@@ -707,13 +783,13 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         int constrain = 0;
         while (child)
         {
-            if (child->type == PRIMARY_EXPR)
+            if (child.Type() == PRIMARY_EXPR)
             {
                 ASSERT(constrain < 2);
                 constrain = 1;
-                ASSERT(child->token.type == Token::CONST_INT);
+                ASSERT(child.GetToken().type == Token::CONST_INT);
 
-                Language::ArrayType * arrayType = Language::MakeArray(context->typeContext, child->token.ival);
+                Language::ArrayType * arrayType = Language::MakeArray(context->typeContext, static_cast<size_t>(child.GetToken().ival));
 
                 if (endType)
                 {
@@ -730,7 +806,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
             {
                 ASSERT(constrain == 0);
                 constrain = 2;
-                ASSERT(child->type == PARAMETER_LIST);
+                ASSERT(child.Type() == PARAMETER_LIST);
 
                 Language::FunctionType * functionType = Language::MakeFunction(context->typeContext);
                 
@@ -750,7 +826,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                 }
                 endType = &functionType->type;
             }
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
         if (beginType)
@@ -769,15 +845,15 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         ASSERT(type);
         PushType(context, type);
     }
-    else if (ast->type == DIRECT_ABSTRACT_DECLARATOR)
+    else if (ast.Type() == DIRECT_ABSTRACT_DECLARATOR)
     {
 
     }
-    else if (ast->type == PARAMETER_VAR_LIST)
+    else if (ast.Type() == PARAMETER_VAR_LIST)
     {
 
     }
-    else if (ast->type == PARAMETER_LIST)
+    else if (ast.Type() == PARAMETER_LIST)
     {
         BeginScope(context, IN_PARAM_LIST);
 
@@ -793,17 +869,17 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         }
 
         // parameter declaration / parameter var list
-        for (; child; child = child->rightSibling)
+        for (; child; child = child.RightSibling())
         {
-            if (child->type == PARAMETER_DECLARATION)
+            if (child.Type() == PARAMETER_DECLARATION)
             {
                 CompileAst(context, child);
 
                 StringRef           id = PopId(context);
                 Language::Type *    type = PopType(context);
 
-                Language::TypeSetAssignable(type);
-                Language::TypeSetAddressable(type);
+                type = Language::TypeSetAssignable(context->typeContext, type);
+                type = Language::TypeSetAddressable(context->typeContext, type);
 
                 Language::FunctionAddParameter(functionType, id, type);
                 
@@ -814,12 +890,12 @@ void CompileAst(AstCompileContext * context, Ast * ast)
             }
             else
             {
-                ASSERT(child->type == PARAMETER_VAR_LIST);
+                ASSERT(child.Type() == PARAMETER_VAR_LIST);
                 Language::FunctionSetVarList(functionType);
                 break;
             }
         }
-        ASSERT(!child || !child->rightSibling);
+        ASSERT(!child || !child.RightSibling());
 
         if (!isFunctionDefinition)
         {
@@ -828,7 +904,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         EndScope(context);
     }
-    else if (ast->type == PARAMETER_DECLARATION)
+    else if (ast.Type() == PARAMETER_DECLARATION)
     {
         StringRef           id;
         Language::Type *    type;
@@ -839,7 +915,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         // declaration specifier
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Type *    typeSpecifier = GetTypeSpecifier(context);
         int                 typeQualifier = GetTypeQualifier(context);
@@ -849,7 +925,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         EndTypeSpecifier(context);
 
         // declarator
-        ASSERT(child->type == DECLARATOR);
+        ASSERT(child.Type() == DECLARATOR);
         CompileAst(context, child);
 
                             id = PopId(context);
@@ -864,15 +940,15 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         PushId(context, id);
         PushType(context, type);
     }
-    else if (ast->type == IDENTIFIER)
+    else if (ast.Type() == IDENTIFIER)
     {
 
     }
-    else if (ast->type == IDENTIFIER_LIST)
+    else if (ast.Type() == IDENTIFIER_LIST)
     {
 
     }
-    else if (ast->type == TYPE_NAME)
+    else if (ast.Type() == TYPE_NAME)
     {
         Language::Type * type = nullptr;
 
@@ -880,14 +956,14 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         BeginTypeQualifier(context);
 
         // type specifier / type qualifier
-        ASSERT(child && (IsAstTypeSpecifier(child->type) ||
-                         IsAstTypeQualifier(child->type)));
+        ASSERT(child && (IsAstTypeSpecifier(child.Type()) ||
+                         IsAstTypeQualifier(child.Type())));
         do
         {
             CompileAst(context, child);
-            child = child->rightSibling;
-        } while (child && (IsAstTypeSpecifier(child->type) ||
-                           IsAstTypeQualifier(child->type)));
+            child = child.RightSibling();
+        } while (child && (IsAstTypeSpecifier(child.Type()) ||
+                           IsAstTypeQualifier(child.Type())));
 
         Language::Type *    typeSpecifier = GetTypeSpecifier(context);
         int                 typeQualifier = GetTypeQualifier(context);
@@ -899,7 +975,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         Language::Type *    abstractDeclarator = nullptr;
         if (child)
         {
-            ASSERT(child->type == ABSTRACT_DECLARATOR);
+            ASSERT(child.Type() == ABSTRACT_DECLARATOR);
             CompileAst(context, child);
             abstractDeclarator = PopType(context);
         }
@@ -912,7 +988,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         ASSERT(type);
         PushType(context, type);
     }
-    else if (ast->type == POINTER)
+    else if (ast.Type() == POINTER)
     {
         Language::Type * type = &Language::MakePointer(context->typeContext)->type;
 
@@ -922,23 +998,23 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         if (child)
         {
             CompileAst(context, child);
-            ASSERT(!child->rightSibling);
+            ASSERT(!child.RightSibling());
         }
 
         int typeQualifier = GetTypeQualifier(context);
         
         EndTypeQualifier(context);
 
-        Language::TypeSetProperties(type, typeQualifier);
+        type = Language::TypeSetProperties(context->typeContext, type, typeQualifier);
 
         PushType(context, type);
     }
-    else if (ast->type == POINTER_LIST)
+    else if (ast.Type() == POINTER_LIST)
     {
         Language::Type * type;
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
         type = PopType(context);
 
         Language::Type * currType = type;
@@ -946,7 +1022,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         while (child)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
             nextType = PopType(context);
             Language::PointerSetTarget(context->typeContext,
                                        Language::AsPointer(currType),
@@ -956,36 +1032,36 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushType(context, type);
     }
-    else if (ast->type == DECLARATION_SPECIFIERS)
+    else if (ast.Type() == DECLARATION_SPECIFIERS)
     {
         while (child)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
     }
-    else if (ast->type == STORAGE_CLASS_SPECIFIER)
+    else if (ast.Type() == STORAGE_CLASS_SPECIFIER)
     {
-        SetStorage(context, ast->token.type);
+        SetStorage(context, ast.GetToken().type);
     }
-    else if (ast->type == TYPE_QUALIFIER)
+    else if (ast.Type() == TYPE_QUALIFIER)
     {
-        AddTypeQualifier(context, ast->token.type);
+        AddTypeQualifier(context, ast.GetToken().type);
     }
-    else if (ast->type == TYPE_SPECIFIER)
+    else if (ast.Type() == TYPE_SPECIFIER)
     {
-        AddTypeSpecifier(context, ast->token.type);
+        AddTypeSpecifier(context, ast.GetToken().type);
     }
-    else if (ast->type == STRUCT_SPECIFIER ||
-             ast->type == UNION_SPECIFIER)
+    else if (ast.Type() == STRUCT_SPECIFIER ||
+             ast.Type() == UNION_SPECIFIER)
     {
         // identifier
         StringRef tag;
-        if (child->type == IDENTIFIER)
+        if (child.Type() == IDENTIFIER)
         {
-            tag = child->token.text;
+            tag = child.GetToken().text;
 
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
 
@@ -1037,7 +1113,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         //  tag definition
         //      create
 
-        bool                isStructType = (ast->type == STRUCT_SPECIFIER);
+        bool                isStructType = (ast.Type() == STRUCT_SPECIFIER);
         Language::Type *    structOrUnionType = nullptr;
         
         bool needCreateTagDefinition = false;
@@ -1045,7 +1121,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         if (existingTagDefinition != nullptr)
         {
             bool isOldIncomplete = Language::IsIncomplete(existingTagDefinition->taggedType);
-            bool isNewIncomplete = (child == nullptr);
+            bool isNewIncomplete = (!child);
 
             ASSERT(isOldIncomplete || isNewIncomplete);
             ASSERT(
@@ -1056,7 +1132,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         }
         else if (existingParentTagDefinition != nullptr)
         {
-            bool isNewIncomplete = (child == nullptr);
+            bool isNewIncomplete = (!child);
 
             if (isNewIncomplete &&
                 (
@@ -1097,19 +1173,19 @@ void CompileAst(AstCompileContext * context, Ast * ast)
             {
                 // struct declaration
                 {
-                    Ast * subChild = child->leftChild;
+                    Ast subChild = child.LeftChild();
                     BeginTypeSpecifier(context);
                     BeginTypeQualifier(context);
 
                     // type specifier / type qualifier
-                    ASSERT(subChild && (IsAstTypeSpecifier(subChild->type) ||
-                                        IsAstTypeQualifier(subChild->type)));
+                    ASSERT(subChild && (IsAstTypeSpecifier(subChild.Type()) ||
+                                        IsAstTypeQualifier(subChild.Type())));
                     do
                     {
                         CompileAst(context, subChild);
-                        subChild = subChild->rightSibling;
-                    } while (subChild && (IsAstTypeSpecifier(subChild->type) ||
-                                          IsAstTypeQualifier(subChild->type)));
+                        subChild = subChild.RightSibling();
+                    } while (subChild && (IsAstTypeSpecifier(subChild.Type()) ||
+                                          IsAstTypeQualifier(subChild.Type())));
 
                     Language::Type *    typeSpecifier = GetTypeSpecifier(context);
                     int                 typeQualifier = GetTypeQualifier(context);
@@ -1120,9 +1196,9 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                     // struct declarator
                     do
                     {
-                        ASSERT(subChild && subChild->type == STRUCT_DECLARATOR);
+                        ASSERT(subChild && subChild.Type() == STRUCT_DECLARATOR);
                         CompileAst(context, subChild);
-                        subChild = subChild->rightSibling;
+                        subChild = subChild.RightSibling();
 
                         StringRef           mname = PopId(context);
                         Language::Type *    declarator = PopType(context);
@@ -1136,7 +1212,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                             : Language::UnionAddMember(Language::AsUnion(structOrUnionType), mname, mtype);
                     } while (subChild);
                 }
-                child = child->rightSibling;
+                child = child.RightSibling();
             } while (child);
             isStructType
                 ? Language::StructDone(AsStruct(structOrUnionType))
@@ -1147,49 +1223,49 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                          isStructType ? Token::KW_STRUCT : Token::KW_UNION,
                          structOrUnionType);
     }
-    else if (ast->type == UNION_SPECIFIER)
+    else if (ast.Type() == UNION_SPECIFIER)
     {
         // TODO: support union specifier
 
     }
-    else if (ast->type == STRUCT_DECLARATION)
+    else if (ast.Type() == STRUCT_DECLARATION)
     {
         ASSERT(false);
     }
-    else if (ast->type == STRUCT_DECLARATOR)
+    else if (ast.Type() == STRUCT_DECLARATOR)
     {
-        ASSERT(child && child->type == DECLARATOR);
+        ASSERT(child && child.Type() == DECLARATOR);
         CompileAst(context, child);
     }
-    else if (ast->type == ENUM_SPECIFIER)
+    else if (ast.Type() == ENUM_SPECIFIER)
     {
         // identifier
         StringRef tag;
-        if (child->type == IDENTIFIER)
+        if (child.Type() == IDENTIFIER)
         {
-            tag = child->token.text;
+            tag = child.GetToken().text;
 
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
         // enum constant
         Language::EnumType *    enumType = Language::MakeEnum(context->typeContext);
-        bool                    isEnumDefinition = (child != nullptr);
+        bool                    isEnumDefinition = bool(child);
         if (child)
         {
             StringRef enumConstName;
             int nextEnumConstValue = 0;
             for (ASSERT(child);
                  child;
-                 ++nextEnumConstValue, child = child->rightSibling)
+                 ++nextEnumConstValue, child = child.RightSibling())
             {
-                ASSERT(child->type == ENUM_CONSTANT);
+                ASSERT(child.Type() == ENUM_CONSTANT);
 
-                enumConstName = child->token.text;
-                if (child->leftChild)
+                enumConstName = child.GetToken().text;
+                if (child.LeftChild())
                 {
-                    //ASSERT(child->leftChild->type == CONSTANT_EXPR);
-                    nextEnumConstValue = child->leftChild->token.ival;
+                    //ASSERT(child.LeftChild().Type() == CONSTANT_EXPR);
+                    nextEnumConstValue = IntConstantValue(child.LeftChild().GetToken());
                 }
 
                 Language::EnumAddConst(enumType,
@@ -1211,39 +1287,39 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         AddTypeSpecifier(context, Token::KW_ENUM, &enumType->type);
     }
-    else if (ast->type == ENUM_CONSTANT)
+    else if (ast.Type() == ENUM_CONSTANT)
     {
 
     }
-    else if (ast->type == TYPEDEF_NAME)
+    else if (ast.Type() == TYPEDEF_NAME)
     {
 
     }
-    else if (ast->type == INITIALIZER)
+    else if (ast.Type() == INITIALIZER)
     {
 
     }
-    else if (ast->type == INITIALIZER_LIST)
+    else if (ast.Type() == INITIALIZER_LIST)
     {
     }
-    else if (ast->type == STMT)
+    else if (ast.Type() == STMT)
     {
 
     }
-    else if (ast->type == STMT_LIST)
+    else if (ast.Type() == STMT_LIST)
     {
 
     }
-    else if (ast->type == LABELED_STMT)
+    else if (ast.Type() == LABELED_STMT)
     {
 
     }
-    else if (ast->type == CASE_STMT)
+    else if (ast.Type() == CASE_STMT)
     {
-        //ASSERT(child->type == CONSTANT_EXPR);
-        int caseValue = child->token.ival;
+        //ASSERT(child.Type() == CONSTANT_EXPR);
+        int caseValue = IntConstantValue(child.GetToken());
 
-        child = child->rightSibling;
+        child = child.RightSibling();
         CompileAst(context, child);
 
         Language::Node * statement = PopNode(context);
@@ -1254,7 +1330,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, caseStatement);
     }
-    else if (ast->type == DEFAULT_STMT)
+    else if (ast.Type() == DEFAULT_STMT)
     {
         CompileAst(context, child);
 
@@ -1265,7 +1341,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, defaultStatement);
     }
-    else if (ast->type == COMPOUND_STMT)
+    else if (ast.Type() == COMPOUND_STMT)
     {
         Language::DefinitionContext * blockDefinitionContext = NewDefinitionContext(context,
                                                                                     Language::BLOCK_SCOPE);
@@ -1276,17 +1352,17 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                                                blockDefinitionContext);
 
         // declaration*
-        while (child && child->type == DECLARATION)
+        while (child && child.Type() == DECLARATION)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
         }
 
         // statement*
         while (child)
         {
             CompileAst(context, child);
-            child = child->rightSibling;
+            child = child.RightSibling();
 
             Language::CompoundStatement_AddStatement(compoundStatement,
                                                      PopNode(context));
@@ -1298,7 +1374,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, compoundStatement);
     }
-    else if (ast->type == EXPRESSION_STMT)
+    else if (ast.Type() == EXPRESSION_STMT)
     {
         Language::Node * exprStatement = nullptr;
 
@@ -1317,21 +1393,21 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, exprStatement);
     }
-    else if (ast->type == SELECTION_STMT)
+    else if (ast.Type() == SELECTION_STMT)
     {
 
     }
-    else if (ast->type == IF_ELSE_STMT)
+    else if (ast.Type() == IF_ELSE_STMT)
     {
         Language::Node * ifStatement = Language::IfStatement_Begin();
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * expr = PopNode(context);
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * ifBody = PopNode(context);
 
@@ -1351,12 +1427,12 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, ifStatement);
     }
-    else if (ast->type == SWITCH_STMT)
+    else if (ast.Type() == SWITCH_STMT)
     {
         Language::Node * switchStatement = Language::SwitchStatement_Begin(context->currentFunctionContext);
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * expr = PopNode(context);
 
@@ -1370,16 +1446,16 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, switchStatement);
     }
-    else if (ast->type == ITERATION_STMT)
+    else if (ast.Type() == ITERATION_STMT)
     {
 
     }
-    else if (ast->type == WHILE_STMT)
+    else if (ast.Type() == WHILE_STMT)
     {
         Language::Node * whileStatement = Language::WhileStatement_Begin(context->currentFunctionContext);
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * expr = PopNode(context);
 
@@ -1393,12 +1469,12 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, whileStatement);
     }
-    else if (ast->type == DO_WHILE_STMT)
+    else if (ast.Type() == DO_WHILE_STMT)
     {
         Language::Node * doWhileStatement = Language::DoWhileStatement_Begin(context->currentFunctionContext);
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * body = PopNode(context);
 
@@ -1412,12 +1488,12 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, doWhileStatement);
     }
-    else if (ast->type == FOR_STMT)
+    else if (ast.Type() == FOR_STMT)
     {
         Language::Node * forStatement = Language::ForStatement_Begin(context->currentFunctionContext);
 
         Language::Node * preExpr = nullptr;
-        if (child->type != EXPR)
+        if (child.Type() != EXPR)
         {
             CompileAst(context, child);
             preExpr = PopNode(context);
@@ -1426,10 +1502,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         {
             preExpr = Language::EmptyExpression(context->currentFunctionContext);
         }
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * loopExpr = nullptr;
-        if (child->type != EXPR)
+        if (child.Type() != EXPR)
         {
             CompileAst(context, child);
             loopExpr = PopNode(context);
@@ -1438,10 +1514,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         {
             loopExpr = Language::EmptyExpression(context->currentFunctionContext);
         }
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * postExpr = nullptr;
-        if (child->type != EXPR)
+        if (child.Type() != EXPR)
         {
             CompileAst(context, child);
             postExpr = PopNode(context);
@@ -1450,7 +1526,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         {
             postExpr = Language::EmptyExpression(context->currentFunctionContext);
         }
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         CompileAst(context, child);
         
@@ -1464,23 +1540,23 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, forStatement);
     }
-    else if (ast->type == JUMP_STMT)
+    else if (ast.Type() == JUMP_STMT)
     {
 
     }
-    else if (ast->type == CONTINUE_STMT)
+    else if (ast.Type() == CONTINUE_STMT)
     {
         Language::Node * continueStatement = Language::ContinueStatement(context->currentFunctionContext);
 
         PushNode(context, continueStatement);
     }
-    else if (ast->type == BREAK_STMT)
+    else if (ast.Type() == BREAK_STMT)
     {
         Language::Node * breakStatement = Language::BreakStatement(context->currentFunctionContext);
 
         PushNode(context, breakStatement);
     }
-    else if (ast->type == RETURN_STMT)
+    else if (ast.Type() == RETURN_STMT)
     {
         Language::Node * expr = nullptr;
 
@@ -1499,60 +1575,60 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, returnStatement);
     }
-    else if (ast->type == EXPR)
+    else if (ast.Type() == EXPR)
     {
 
     }
-    else if (ast->type == PRIMARY_EXPR)
+    else if (ast.Type() == PRIMARY_EXPR)
     {
         Language::Node * node = nullptr;
 
-        switch (ast->token.type)
+        switch (ast.GetToken().type)
         {
-            case Token::ID:             node = Language::IdExpression(context->currentFunctionContext, ast->token.text); break;
-            case Token::CONST_INT:      node = Language::ConstantExpression(context->currentFunctionContext, ast->token.ival); break;
-            case Token::CONST_CHAR:     node = Language::ConstantExpression(context->currentFunctionContext, (int)ast->token.cval); break;
-            case Token::CONST_FLOAT:    node = Language::ConstantExpression(context->currentFunctionContext, (float)ast->token.fval); break;
-            case Token::STRING:         node = Language::ConstantExpression(context->currentFunctionContext, ast->token.text); break;
+            case Token::ID:             node = Language::IdExpression(context->currentFunctionContext, ast.GetToken().text); break;
+            case Token::CONST_INT:      node = Language::ConstantExpression(context->currentFunctionContext, IntegerConstantType(context, ast.GetToken()), ast.GetToken().ival); break;
+            case Token::CONST_CHAR:     node = Language::ConstantExpression(context->currentFunctionContext, (int)ast.GetToken().cval); break;
+            case Token::CONST_FLOAT:    node = Language::ConstantExpression(context->currentFunctionContext, FloatConstantValue(ast.GetToken())); break;
+            case Token::STRING:         node = Language::ConstantExpression(context->currentFunctionContext, ast.GetToken().text); break;
             default:                    ASSERT(false); break;
         }
 
         PushNode(context, node);
     }
-    else if (ast->type == POSTFIX_EXPR)
+    else if (ast.Type() == POSTFIX_EXPR)
     {
         // unary expr
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * primary = PopNode(context);
 
         Language::Node * postfix = nullptr;
         if (child)
         {
-            if (child->type == IDENTIFIER) // a.id, a->id
+            if (child.Type() == IDENTIFIER) // a.id, a->id
             {
-                if (ast->token.type == Token::OP_DOT)
+                if (ast.GetToken().type == Token::OP_DOT)
                 {
                     postfix = Language::MemberOfExpression(context->currentFunctionContext,
                                                            primary,
-                                                           child->token.text);
+                                                           child.GetToken().text);
                 }
                 else
                 {
                     postfix = Language::IndirectMemberOfExpression(context->currentFunctionContext,
                                                                    primary,
-                                                                   child->token.text);
+                                                                   child.GetToken().text);
                 }
             }
             else // a(), a[]
             {
-                if (child->type == ARGUMENT_EXPR_LIST)
+                if (child.Type() == ARGUMENT_EXPR_LIST)
                 {
                     std::vector<Language::Node *> arguments;
-                    for (Ast * arg = child->leftChild;
+                    for (Ast arg = child.LeftChild();
                          arg;
-                         arg = arg->rightSibling)
+                         arg = arg.RightSibling())
                     {
                         CompileAst(context, arg);
                         arguments.push_back(PopNode(context));
@@ -1576,12 +1652,12 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         }
         else // ++, --
         {
-            if (ast->token.type == Token::OP_INC)
+            if (ast.GetToken().type == Token::OP_INC)
             {
                 postfix = Language::PostIncExpression(context->currentFunctionContext,
                                                       primary);
             }
-            else if (ast->token.type == Token::OP_DEC)
+            else if (ast.GetToken().type == Token::OP_DEC)
             {
                 postfix = Language::PostDecExpression(context->currentFunctionContext,
                                                       primary);
@@ -1591,30 +1667,30 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, postfix);
     }
-    else if (ast->type == ARGUMENT_EXPR_LIST)
+    else if (ast.Type() == ARGUMENT_EXPR_LIST)
     {
         ASSERT(false);
     }
-    else if (ast->type == CONSTANT_EXPR)
+    else if (ast.Type() == CONSTANT_EXPR)
     {
         ASSERT(false);
     }
-    else if (ast->type == UNARY_EXPR)
+    else if (ast.Type() == UNARY_EXPR)
     {
         CompileAst(context, child);
 
         Language::Node * unary = nullptr;
 
-        if (ast->token.type == Token::KW_SIZEOF)
+        if (ast.GetToken().type == Token::KW_SIZEOF)
         {
-            unary = (child->type == TYPE_NAME)
+            unary = (child.Type() == TYPE_NAME)
                     ? Language::SizeOfExpression(context->currentFunctionContext, PopType(context))
                     : Language::SizeOfExpression(context->currentFunctionContext, PopNode(context));
         }
         else
         {
             Language::Node * postfix = PopNode(context);
-            switch (ast->token.type)
+            switch (ast.GetToken().type)
             {
                 case Token::OP_INC:     unary = Language::IncExpression(context->currentFunctionContext, postfix); break;
                 case Token::OP_DEC:     unary = Language::DecExpression(context->currentFunctionContext, postfix); break;
@@ -1630,10 +1706,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         
         PushNode(context, unary);
     }
-    else if (ast->type == CAST_EXPR)
+    else if (ast.Type() == CAST_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Type *    type = PopType(context);
 
@@ -1645,10 +1721,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, cast);
     }
-    else if (ast->type == MUL_EXPR)
+    else if (ast.Type() == MUL_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1657,7 +1733,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         Language::Node * right = PopNode(context);
 
         Language::Node * mul = nullptr;
-        switch (ast->token.type)
+        switch (ast.GetToken().type)
         {
             case Token::OP_MUL: mul = Language::MulExpression(context->currentFunctionContext, left, right); break;
             case Token::OP_DIV: mul = Language::DivExpression(context->currentFunctionContext, left, right); break;
@@ -1667,10 +1743,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, mul);
     }
-    else if (ast->type == ADD_EXPR)
+    else if (ast.Type() == ADD_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1678,15 +1754,15 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         Language::Node * right = PopNode(context);
 
-        Language::Node * add = ast->token.type == Token::OP_ADD
+        Language::Node * add = ast.GetToken().type == Token::OP_ADD
                                ? Language::AddExpression(context->currentFunctionContext, left, right)
                                : Language::SubExpression(context->currentFunctionContext, left, right);
         PushNode(context, add);
     }
-    else if (ast->type == SHIFT_EXPR)
+    else if (ast.Type() == SHIFT_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1695,7 +1771,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         Language::Node * right = PopNode(context);
 
         Language::Node * shift = nullptr;
-        if (ast->token.type == Token::BIT_SHL)
+        if (ast.GetToken().type == Token::BIT_SHL)
         {
             shift = Language::ShiftLeftExpression(context->currentFunctionContext,
                                                   left,
@@ -1710,10 +1786,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, shift);
     }
-    else if (ast->type == REL_EXPR)
+    else if (ast.Type() == REL_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1722,7 +1798,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         Language::Node * right = PopNode(context);
 
         Language::Node * rel = nullptr;
-        switch (ast->token.type)
+        switch (ast.GetToken().type)
         {
             case Token::REL_GT: rel = Language::GtExpression(context->currentFunctionContext, left, right); break;
             case Token::REL_GE: rel = Language::GeExpression(context->currentFunctionContext, left, right); break;
@@ -1733,10 +1809,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, rel);
     }
-    else if (ast->type == EQ_EXPR)
+    else if (ast.Type() == EQ_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1745,7 +1821,7 @@ void CompileAst(AstCompileContext * context, Ast * ast)
         Language::Node * right = PopNode(context);
 
         Language::Node * eq = nullptr;
-        switch (ast->token.type)
+        switch (ast.GetToken().type)
         {
             case Token::REL_EQ: eq = Language::EqExpression(context->currentFunctionContext, left, right); break;
             case Token::REL_NE: eq = Language::NeExpression(context->currentFunctionContext, left, right); break;
@@ -1754,10 +1830,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, eq);
     }
-    else if (ast->type == BIT_AND_EXPR)
+    else if (ast.Type() == BIT_AND_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1770,10 +1846,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                              right);
         PushNode(context, bitAnd);
     }
-    else if (ast->type == BIT_XOR_EXPR)
+    else if (ast.Type() == BIT_XOR_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1786,10 +1862,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                              right);
         PushNode(context, bitXor);
     }
-    else if (ast->type == BIT_OR_EXPR)
+    else if (ast.Type() == BIT_OR_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1802,10 +1878,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                            right);
         PushNode(context, bitOr);
     }
-    else if (ast->type == AND_EXPR)
+    else if (ast.Type() == AND_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1818,10 +1894,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                                right);
         PushNode(context, boolAnd);
     }
-    else if (ast->type == OR_EXPR)
+    else if (ast.Type() == OR_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1834,15 +1910,15 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                              right);
         PushNode(context, boolOr);
     }
-    else if (ast->type == COND_EXPR)
+    else if (ast.Type() == COND_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * a = PopNode(context);
 
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * b = PopNode(context);
         
@@ -1856,10 +1932,10 @@ void CompileAst(AstCompileContext * context, Ast * ast)
                                                               c);
         PushNode(context, cond);
     }
-    else if (ast->type == ASSIGN_EXPR)
+    else if (ast.Type() == ASSIGN_EXPR)
     {
         CompileAst(context, child);
-        child = child->rightSibling;
+        child = child.RightSibling();
 
         Language::Node * left = PopNode(context);
 
@@ -1873,26 +1949,22 @@ void CompileAst(AstCompileContext * context, Ast * ast)
 
         PushNode(context, assign);
     }
-    else if (ast->type == COMMA_EXPR)
+    else if (ast.Type() == COMMA_EXPR)
     {
         std::vector<Language::Node *> exprs;
 
-        Ast * first = ast;
-        while (first->leftChild->type == COMMA_EXPR)
-            first = first->leftChild;
+        // left nested: ((a, b), c)
+        std::vector<Ast> chain = { ast };
+        while (chain.back().LeftChild().Type() == COMMA_EXPR)
+            chain.push_back(chain.back().LeftChild());
 
-        CompileAst(context, first->leftChild);
+        CompileAst(context, chain.back().LeftChild());
         exprs.push_back(PopNode(context));
 
-        while (true)
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
         {
-            CompileAst(context, first->leftChild->rightSibling);
+            CompileAst(context, it->LeftChild().RightSibling());
             exprs.push_back(PopNode(context));
-
-            if (first == ast)
-                break;
-            else
-                first = first->parent;
         }
 
         Language::Node * comma = Language::CommaExpression(exprs);
@@ -1904,3 +1976,77 @@ void CompileAst(AstCompileContext * context, Ast * ast)
     }
 }
 
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+// Constant token with its value, as the lexer evaluates it.
+static Token ConstantToken(Token::Type type, const std::string & text)
+{
+    Token token(type, text);
+    if (type == Token::CONST_INT)
+    {
+        IntegerLiteral literal = ParseIntegerLiteral(text.data(), text.data() + text.length());
+        token.ival = literal.value;
+        token.suffix = literal.suffix;
+    }
+    else
+    {
+        FloatLiteral literal = ParseFloatLiteral(text.data(), text.data() + text.length());
+        token.fval = literal.value;
+        token.suffix = literal.suffix;
+    }
+    return token;
+}
+
+TEST(AstCompiler_ConstantTypes)
+{
+    AstCompileContext * context = CreateAstCompileContext();
+    Language::TypeContext * types = context->typeContext;
+    Language::IntType * intType = Language::MakeInt(types);
+    Language::IntType * unsignedType = Language::MakeInt(types, 4, false);
+    Language::IntType * longType = Language::MakeInt(types, 8);
+    Language::IntType * unsignedLongType = Language::MakeInt(types, 8, false);
+
+    std::vector<std::pair<const char *, Language::IntType *>> ints = {
+        { "0", intType },
+        { "2147483647", intType },
+        { "2147483648", longType },                 // decimal skips unsigned int
+        { "4294967295", longType },
+        { "0x7FFFFFFF", intType },
+        { "0xFFFFFFFF", unsignedType },             // octal/hex tries unsigned int
+        { "037777777777", unsignedType },
+        { "0x100000000", longType },
+        { "9223372036854775807", longType },
+        { "9223372036854775808", unsignedLongType },
+        { "0xFFFFFFFFFFFFFFFF", unsignedLongType },
+        { "1u", unsignedType },
+        { "4294967296u", unsignedLongType },
+        { "1l", longType },
+        { "0xFFFFFFFFl", longType },
+        { "1ul", unsignedLongType },
+    };
+    for (auto & i : ints)
+        EXPECT_EQ(IntegerConstantType(context, ConstantToken(Token::CONST_INT, i.first)), i.second);
+
+    EXPECT_EQ(IntConstantValue(ConstantToken(Token::CONST_INT, "0")), 0);
+    EXPECT_EQ(IntConstantValue(ConstantToken(Token::CONST_INT, "2147483647")), INT_MAX);
+    EXPECT_EQ(IntConstantValue(ConstantToken(Token::CONST_INT, "0x10")), 16);
+    EXPECT_EQ(IntConstantValue(ConstantToken(Token::CONST_INT, "1u")), 1);
+
+    EXPECT_EQ(FloatConstantValue(ConstantToken(Token::CONST_FLOAT, "1.5")), 1.5f);
+    EXPECT_EQ(FloatConstantValue(ConstantToken(Token::CONST_FLOAT, "0.1f")), 0.1f);
+    EXPECT_EQ(FloatConstantValue(ConstantToken(Token::CONST_FLOAT, "3.4e38")), 3.4e38f);
+    EXPECT_EQ(FloatConstantValue(ConstantToken(Token::CONST_FLOAT, "1e-50")), 0.0f);
+
+    // Values that don't fit are errors, not truncated or inf.
+    int errors = 0;
+    try { IntConstantValue(ConstantToken(Token::CONST_INT, "2147483648")); } catch (const std::invalid_argument &) { ++errors; }
+    try { IntConstantValue(ConstantToken(Token::CONST_INT, "0xFFFFFFFF")); } catch (const std::invalid_argument &) { ++errors; }
+    try { IntConstantValue(ConstantToken(Token::CONST_INT, "18446744073709551615")); } catch (const std::invalid_argument &) { ++errors; }
+    try { FloatConstantValue(ConstantToken(Token::CONST_FLOAT, "1e39")); } catch (const std::invalid_argument &) { ++errors; }
+    try { FloatConstantValue(ConstantToken(Token::CONST_FLOAT, "3.5e38")); } catch (const std::invalid_argument &) { ++errors; }
+    EXPECT_EQ(errors, 5);
+}
+
+#endif
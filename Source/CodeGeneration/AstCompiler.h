@@ -44,6 +44,11 @@ struct AstCompileContext
     Language::FunctionContext * currentFunctionContext;
     std::vector<Language::Node *> irNodes;
 
+    // Function bodies built by an earlier compile of the same tokens, by
+    // index among the function definitions. Linked in as they are instead
+    // of compiling the body again.
+    std::map<size_t, Language::FunctionContext *> reusedFunctionContexts;
+
     // Final output
 
     Language::TypeContext *                     typeContext;
@@ -54,4 +59,4 @@ struct AstCompileContext
 
 extern AstCompileContext * CreateAstCompileContext();
 
-extern void CompileAst(AstCompileContext * context, Ast * ast);
\ No newline at end of file
+extern void CompileAst(AstCompileContext * context, Ast ast);
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "IncrementalCompiler.h"
+
+#include <set>
+
+#include "AstCompiler.h"
+#include "Translation.h"
+
+namespace {
+
+UINT64 Mix(UINT64 hash, UINT64 value)
+{
+    return hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+}
+
+// Top level item others may refer to by name: a declaration, or the
+// declarator part of a function definition.
+struct Dependency
+{
+    UINT64                      hash;
+    AstTokenRange               range;
+    std::vector<std::string>    names;
+};
+
+std::vector<std::string> NamesIn(const std::vector<Token> & tokens, size_t begin, size_t end)
+{
+    std::vector<std::string> names;
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (tokens[i].type == Token::ID)
+            names.push_back(tokens[i].text);
+    }
+    return names;
+}
+
+bool SameRange(const std::vector<Token> & a, const AstTokenRange & rangeA,
+               const std::vector<Token> & b, const AstTokenRange & rangeB)
+{
+    return rangeA.tokenEnd - rangeA.tokenBegin == rangeB.tokenEnd - rangeB.tokenBegin &&
+           SameTokens(&a[rangeA.tokenBegin], &b[rangeB.tokenBegin], rangeA.tokenEnd - rangeA.tokenBegin);
+}
+
+}
+
+// Key of each function's IR and assembly: its tokens, the dependencies
+// reachable from its names through shared names (struct members, tags,
+// globals, prototypes), and the string literals up to its end, which
+// number the string labels. Call before the lazy bodies are parsed.
+std::vector<IncrementalCompiler::FunctionKey> IncrementalCompiler::FunctionKeys(const AstTree & ast)
+{
+    const std::vector<Token> & tokens = *ast.tokens;
+
+    std::vector<Dependency> dependencies;
+    std::map<std::string, std::vector<size_t>> dependenciesByName;
+    std::vector<AstTokenRange> definitions;
+    size_t k = 0;
+    for (const AstTokenRange & external : ast.externals)
+    {
+        AstTokenRange range = external;
+        if (Ast(&ast, external.node).Type() == FUNCTION_DEFINITION)
+        {
+            definitions.push_back(external);
+            range.tokenEnd = ast.lazyBodies[k++].tokenBegin;
+        }
+
+        Dependency dependency = { HashTokens(tokens, range.tokenBegin, range.tokenEnd),
+                                  range,
+                                  NamesIn(tokens, range.tokenBegin, range.tokenEnd) };
+        for (const std::string & name : dependency.names)
+            dependenciesByName[name].push_back(dependencies.size());
+        dependencies.push_back(dependency);
+    }
+    ASSERT(k == ast.lazyBodies.size());
+
+    std::vector<FunctionKey> keys;
+    UINT64 strings = 0;
+    size_t stringCount = 0;
+    size_t stringsEnd = 0;
+    for (const AstTokenRange & function : definitions)
+    {
+        for (; stringsEnd < function.tokenEnd; ++stringsEnd)
+        {
+            if (tokens[stringsEnd].type == Token::STRING)
+            {
+                strings = Mix(strings, HashTokens(tokens, stringsEnd, stringsEnd + 1));
+                ++stringCount;
+            }
+        }
+
+        std::set<size_t> reached;
+        std::set<std::string> visited;
+        std::vector<std::string> names = NamesIn(tokens, function.tokenBegin, function.tokenEnd);
+        while (!names.empty())
+        {
+            std::string name = names.back();
+            names.pop_back();
+            if (!visited.insert(name).second)
+                continue;
+
+            auto users = dependenciesByName.find(name);
+            if (users == dependenciesByName.end())
+                continue;
+            for (size_t i : users->second)
+            {
+                if (reached.insert(i).second)
+                    names.insert(names.end(), dependencies[i].names.begin(), dependencies[i].names.end());
+            }
+        }
+
+        FunctionKey key = { Mix(HashTokens(tokens, function.tokenBegin, function.tokenEnd), strings),
+                            function,
+                            {},
+                            stringCount };
+        for (size_t i : reached)
+        {
+            key.hash = Mix(key.hash, dependencies[i].hash);
+            key.dependencies.push_back(dependencies[i].range);
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+std::string IncrementalCompiler::Compile(const std::vector<Token> & tokens)
+{
+    std::shared_ptr<Source> source = std::make_shared<Source>();
+    source->tokens = tokens;
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        if (tokens[i].type == Token::STRING)
+            source->strings.push_back(static_cast<UINT32>(i));
+    }
+
+    TokenIterator ti(source->tokens);
+    AstTree ast = ParseTranslationUnit(ti, true);
+    std::vector<FunctionKey> functionKeys = FunctionKeys(ast);
+    ParseFunctionBodies(ast, 0, &bodyCache);
+    bodyCache.Trim();
+
+    // Hash hits, confirmed by the tokens. Comparisons of strings and
+    // dependency ranges are shared by the functions of one source.
+    std::map<const Source *, size_t> sameStrings;
+    std::map<std::pair<const Token *, const Token *>, bool> sameRanges;
+    auto confirmed = [&](const Function & function, const FunctionKey & key) -> bool
+    {
+        const Source & old = *function.source;
+        if (function.key.strings != key.strings ||
+            function.key.dependencies.size() != key.dependencies.size() ||
+            !SameRange(old.tokens, function.key.function, source->tokens, key.function))
+            return false;
+
+        auto strings = sameStrings.find(&old);
+        if (strings == sameStrings.end())
+        {
+            size_t same = 0;
+            while (same < old.strings.size() && same < source->strings.size() &&
+                   old.tokens[old.strings[same]].text == source->tokens[source->strings[same]].text)
+                ++same;
+            strings = sameStrings.insert({ &old, same }).first;
+        }
+        if (key.strings > strings->second)
+            return false;
+
+        for (size_t i = 0; i < key.dependencies.size(); ++i)
+        {
+            const AstTokenRange & oldRange = function.key.dependencies[i];
+            const AstTokenRange & range = key.dependencies[i];
+            auto same = sameRanges.find({ &old.tokens[oldRange.tokenBegin], &source->tokens[range.tokenBegin] });
+            if (same == sameRanges.end())
+            {
+                same = sameRanges.insert({ { &old.tokens[oldRange.tokenBegin], &source->tokens[range.tokenBegin] },
+                                           SameRange(old.tokens, oldRange, source->tokens, range) }).first;
+            }
+            if (!same->second)
+                return false;
+        }
+        return true;
+    };
+
+    AstCompileContext * context = CreateAstCompileContext();
+    std::vector<Function *> reused(functionKeys.size(), nullptr);
+    for (size_t i = 0; i < functionKeys.size(); ++i)
+    {
+        auto it = functions.find(functionKeys[i].hash);
+        if (it != functions.end() && !it->second.used && confirmed(it->second, functionKeys[i]))
+        {
+            reused[i] = &it->second;
+            reused[i]->used = true;
+            context->reusedFunctionContexts[i] = reused[i]->ir;
+        }
+    }
+
+    CompileAst(context, ast.Root());
+    ASSERT(context->functionContexts.size() == functionKeys.size());
+
+    Language::x64Program program = Language::TranslateGlobals(context->globalDefinitionContext,
+                                                              context->constantContext);
+    reusedFunctions = translatedFunctions = 0;
+    for (size_t i = 0; i < functionKeys.size(); ++i)
+    {
+        if (reused[i])
+        {
+            program.textSegment += reused[i]->text;
+            ++reusedFunctions;
+            continue;
+        }
+
+        std::string text = Language::TranslateFunction(context->functionContexts[i]);
+        program.textSegment += text;
+        ++translatedFunctions;
+
+        // Hash of a function reused in this compile is kept.
+        Function & function = functions[functionKeys[i].hash];
+        if (!function.used)
+            function = { source, functionKeys[i], context->functionContexts[i], std::move(text), true };
+    }
+
+    for (auto it = functions.begin(); it != functions.end(); )
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+        {
+            it = functions.erase(it);
+        }
+    }
+
+    return Language::GetProgram(program);
+}
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+#include "../Base/File.h"
+
+// Tokens of source, through a file as the preprocessor reads files.
+static std::vector<Token> LexSource(const char * fileName, const std::string & source)
+{
+    SetFileContent(fileName, source);
+    return LexProcess(fileName);
+}
+
+// Same steps as the compiler driver.
+static std::string FullCompile(const std::vector<Token> & tokens)
+{
+    TokenIterator ti(tokens);
+    AstTree ast = ParseTranslationUnit(ti);
+
+    AstCompileContext * context = CreateAstCompileContext();
+    CompileAst(context, ast.Root());
+    Language::x64Program program = Language::Translate(context->globalDefinitionContext,
+                                                       context->constantContext,
+                                                       context->functionContexts);
+    return Language::GetProgram(program);
+}
+
+TEST(IncrementalCompiler_Reuse)
+{
+    std::string v1 =
+        "int printf(const char * fmt, ...);\n"
+        "struct P { int x; int y; };\n"
+        "int g;\n"
+        "int h;\n"
+        "int Sum(struct P * p) { return p->x + p->y; }\n"
+        "int UseG(int a) { return a + g; }\n"
+        "int UseH(int a) { return a * h; }\n"
+        "float Half(float f) { return f * 0.5; }\n"
+        "int Count() { static int calls; calls = calls + 1; printf(\"count %d\\n\", calls); return calls; }\n"
+        "int main() { struct P p; p.x = 1; p.y = 2; printf(\"main\\n\"); return Sum(&p) + UseG(3) + UseH(4) + Count(); }\n";
+
+    // Type of global g changed, body of UseH edited.
+    std::string v2 = v1;
+    v2.replace(v2.find("int g;"), 6, "char g;");
+    v2.replace(v2.find("a * h"), 5, "a * h - 1");
+
+    // A string literal added before the functions after UseH.
+    std::string v3 = v2;
+    v3.replace(v3.find("return a * h"), 6, "printf(\"h\\n\"); return");
+
+    std::string file1 = GetTempFilePath("IncrementalCompiler_v1.c");
+    std::string file2 = GetTempFilePath("IncrementalCompiler_v2.c");
+    std::string file3 = GetTempFilePath("IncrementalCompiler_v3.c");
+    std::vector<Token> tokens1 = LexSource(file1.data(), v1);
+    std::vector<Token> tokens2 = LexSource(file2.data(), v2);
+    std::vector<Token> tokens3 = LexSource(file3.data(), v3);
+
+    IncrementalCompiler compiler;
+    EXPECT_EQ(compiler.Compile(tokens1), FullCompile(tokens1));
+    EXPECT_EQ(compiler.reusedFunctions, 0u);
+    EXPECT_EQ(compiler.translatedFunctions, 6u);
+
+    // UseG reaches g, UseH changed; the IR of the others is linked in,
+    // with their string, float and static local.
+    std::string asm2 = compiler.Compile(tokens2);
+    EXPECT_EQ(asm2, FullCompile(tokens2));
+    EXPECT_NE(asm2, FullCompile(tokens1));
+    EXPECT_EQ(compiler.reusedFunctions, 4u);
+    EXPECT_EQ(compiler.translatedFunctions, 2u);
+
+    EXPECT_EQ(compiler.Compile(tokens2), FullCompile(tokens2));
+    EXPECT_EQ(compiler.reusedFunctions, 6u);
+    EXPECT_EQ(compiler.translatedFunctions, 0u);
+
+    // String labels after UseH are numbered anew.
+    EXPECT_EQ(compiler.Compile(tokens3), FullCompile(tokens3));
+    EXPECT_EQ(compiler.reusedFunctions, 2u);
+    EXPECT_EQ(compiler.translatedFunctions, 4u);
+
+    // Back to the first version, none of the bodies kept match.
+    EXPECT_EQ(compiler.Compile(tokens1), FullCompile(tokens1));
+    EXPECT_EQ(compiler.reusedFunctions, 1u);
+    EXPECT_EQ(compiler.translatedFunctions, 5u);
+
+    RemoveFile(file1.data());
+    RemoveFile(file2.data());
+    RemoveFile(file3.data());
+}
+
+#endif
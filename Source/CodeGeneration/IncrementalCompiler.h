@@ -0,0 +1,60 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Parse/AstParser.h"
+#include "../IR/FunctionContext.h"
+
+// Compiles successive versions of one source, for compile servers and
+// editors. Function bodies are reused from the last compiles if their
+// tokens are the same, and the IR and assembly of a function if also the
+// top level declarations it may use are, found by names they share, and
+// the string literals before it. Hash hits are confirmed by comparing the
+// tokens. AST to IR runs for the rest, which lives for one compile unless
+// kept for reuse.
+class IncrementalCompiler
+{
+public:
+    IncrementalCompiler() : reusedFunctions(0), translatedFunctions(0) {}
+
+    // Assembly, same as of a full compile.
+    std::string Compile(const std::vector<Token> & tokens);
+
+    // Of the last Compile().
+    size_t          reusedFunctions;
+    size_t          translatedFunctions;
+    AstBodyCache    bodyCache;
+
+private:
+    // Tokens of a compile, kept while IR built from them is, as names and
+    // strings in the IR point into them.
+    struct Source
+    {
+        std::vector<Token>  tokens;
+        std::vector<UINT32> strings;    // string literal tokens
+    };
+    // What the IR and assembly of a function are built from, ranges in the
+    // tokens of its source.
+    struct FunctionKey
+    {
+        UINT64                      hash;
+        AstTokenRange               function;
+        std::vector<AstTokenRange>  dependencies;
+        size_t                      strings;    // string literals up to the function end
+    };
+    struct Function
+    {
+        std::shared_ptr<const Source>   source;
+        FunctionKey                     key;
+        Language::FunctionContext *     ir;
+        std::string                     text;
+        bool                            used;
+    };
+
+    static std::vector<FunctionKey> FunctionKeys(const AstTree & ast);
+
+    std::map<UINT64, Function> functions;
+};
@@ -2729,9 +2729,8 @@ void TranslateFunctionContext(x64Program * program,
     text += context->functionName + " ENDP\n";
 }
 
-x64Program Translate(DefinitionContext * definitionContext,
-                     ConstantContext * constantContext,
-                     std::vector<FunctionContext *> & functionContexts)
+x64Program TranslateGlobals(DefinitionContext * definitionContext,
+                            ConstantContext * constantContext)
 {
     x64Program program;
 
@@ -2744,12 +2743,26 @@ x64Program Translate(DefinitionContext * definitionContext,
     LocateFloat(constantContext, *(reinterpret_cast<float *>(&flt)));
     TranslateConstantContext(&program, constantContext);
 
+    return program;
+}
+
+std::string TranslateFunction(FunctionContext * functionContext)
+{
+    x64Program program;
+    x64StackLayout * stackLayout = PrepareStack(functionContext);
+    TranslateFunctionContext(&program, functionContext, stackLayout);
+    return program.textSegment;
+}
+
+x64Program Translate(DefinitionContext * definitionContext,
+                     ConstantContext * constantContext,
+                     std::vector<FunctionContext *> & functionContexts)
+{
+    x64Program program = TranslateGlobals(definitionContext, constantContext);
+
     // function -> proc
     for (FunctionContext * functionContext : functionContexts)
-    {
-        x64StackLayout * stackLayout = PrepareStack(functionContext);
-        TranslateFunctionContext(&program, functionContext, stackLayout);
-    }
+        program.textSegment += TranslateFunction(functionContext);
 
     return program;
 }
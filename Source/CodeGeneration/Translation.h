@@ -59,6 +59,12 @@ extern x64Program Translate(DefinitionContext * definitionContext,
                             ConstantContext * constantContext,
                             std::vector<FunctionContext *> & functionContexts);
 
+// Translate() in parts: segments of definitions and constants, then the
+// PROC ... ENDP of each function, to append to textSegment.
+extern x64Program TranslateGlobals(DefinitionContext * definitionContext,
+                                   ConstantContext * constantContext);
+extern std::string TranslateFunction(FunctionContext * functionContext);
+
 extern std::string GetProgram(const x64Program & program);
 
 // Debug
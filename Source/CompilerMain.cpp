@@ -12,29 +12,35 @@
 #include "Base/String.h"
 #include "Base/File.h"
 #include "Parse/AstParser.h"
+#include "Parse/LL1Parser.h"
 #include "CodeGeneration/AstCompiler.h"
 #include "CodeGeneration/Translation.h"
 
 using namespace std;
 
-std::string Compile(std::string fileName)
+// filesRead: if not null, gets the source and include files read.
+std::string Compile(std::string fileName,
+                    const std::vector<std::string> & includeDirs,
+                    std::vector<std::string> * filesRead = nullptr)
 {
     // 1. Token
     std::string sourceAfterPreproc;
-    std::vector<Token> tokens = LexProcess(fileName, &sourceAfterPreproc);
+    std::vector<Token> tokens = LexProcess(fileName, &sourceAfterPreproc, includeDirs, filesRead);
     TokenIterator ti(tokens);
 
     std::cout << "Source:" << std::endl << sourceAfterPreproc << std::endl;
 
     // 2. Ast
-    Ast * ast = ParseTranslationUnit(ti);
+    // Global declarations in order, then function bodies in parallel.
+    AstTree ast = ParseTranslationUnit(ti, true);
+    ParseFunctionBodies(ast);
 
     std::cout << "Ast:" << std::endl;
-    DebugPrintAst(ast);
+    DebugPrintAst(ast.Root());
 
     // 3. IR
     AstCompileContext * context = CreateAstCompileContext();
-    CompileAst(context, ast);
+    CompileAst(context, ast.Root());
 
     std::cout << std::endl << "TypeContext:" << std::endl;
     Language::PrintTypeContext(context->typeContext);
@@ -59,24 +65,70 @@ std::string Compile(std::string fileName)
 
 int main(int argc, char *argv[])
 {
-    if (argc > 1)
+    if (argc == 3 && std::string(argv[1]) == "--gen-scanner")
     {
+        std::cout << "Generate scanner: " << argv[2] << std::endl;
+        GenerateLexScanner(argv[2]);
+    }
+    else if (argc == 3 && std::string(argv[1]) == "--gen-parser")
+    {
+        std::cout << "Generate parser: " << argv[2] << std::endl;
+        GenerateLL1Table(argv[2]);
+    }
+    else if (argc > 1)
+    {
+        // -M:  print dependency rules only, don't compile
+        // -MD: compile, also write <file>.d
+        // -I<dir>, -I <dir>: include search path
+        bool depsOnly = false;
+        bool writeDeps = false;
+        std::vector<std::string> includeDirs;
+        std::vector<std::string> inputs;
         for (int i = 1; i < argc; ++i)
         {
-            std::cout << "Input: " << argv[i] << std::endl;
+            std::string arg = argv[i];
+            if (arg == "-I" && i + 1 < argc)
+                includeDirs.push_back(argv[++i]);
+            else if (arg.compare(0, 2, "-I") == 0)
+                includeDirs.push_back(arg.substr(2));
+            else if (arg == "-M")
+                depsOnly = true;
+            else if (arg == "-MD")
+                writeDeps = true;
+            else
+                inputs.push_back(arg);
+        }
+
+        for (const std::string & input : inputs)
+        {
+            std::string asmFile = ChangeFileExtention(input, ".c", ".asm");
+
+            if (depsOnly)
+            {
+                std::cout << MakeDependencyRule(asmFile, ScanDependencies(input, includeDirs));
+                continue;
+            }
+
+            std::cout << "Input: " << input << std::endl;
+
+            std::vector<std::string> filesRead;
+            std::string destCode = Compile(input, includeDirs, &filesRead);
 
-            std::string destCode = Compile(argv[i]);
+            SetFileContent(asmFile.c_str(), destCode);
 
-            SetFileContent(
-                ChangeFileExtention(argv[i], ".c", ".asm").c_str(),
-                destCode);
+            if (writeDeps)
+            {
+                SetFileContent(
+                    ChangeFileExtention(input, ".c", ".d").c_str(),
+                    MakeDependencyRule(asmFile, filesRead));
+            }
         }
     }
     else
     {
         const std::string fileName = "..\\..\\Test\\Simple.c";
         std::cout << "Input: " << fileName << std::endl;
-        (void)Compile(fileName);
+        (void)Compile(fileName, {});
     }
     return 0;
 }
@@ -1,25 +1,95 @@
 #include "AstParser.h"
 
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <vector>
 
 #include "../Base/common.h"
+#include "../Base/BinaryImage.h"
 
-Ast * NewAst(AstType type)
+// Tree as parsed, linked by pointers, flattened into an AstTree when done.
+struct ParseNode
 {
-    Ast * ast = new Ast;
-    ast->parent = ast->leftChild = ast->rightSibling = nullptr;
+    ParseNode * leftChild;
+    ParseNode * rightSibling;
+    UINT32      token;
+    AstType     type;
+};
+
+// Owns the nodes of one parse, NewAst() allocates from the innermost
+// on the calling thread.
+class ParseNodeArena
+{
+public:
+    ParseNodeArena() : previous(current) { current = this; }
+    ~ParseNodeArena() { current = previous; }
+
+    static ParseNode * New()
+    {
+        ASSERT(current);
+        current->nodes.emplace_back();
+        return &current->nodes.back();
+    }
+
+private:
+    std::deque<ParseNode> nodes; // stable addresses
+    ParseNodeArena * previous;
+
+    static thread_local ParseNodeArena * current;
+};
+thread_local ParseNodeArena * ParseNodeArena::current = nullptr;
+
+ParseNode * NewAst(AstType type)
+{
+    ParseNode * ast = ParseNodeArena::New();
+    ast->leftChild = ast->rightSibling = nullptr;
     ast->type = type;
+    ast->token = AST_NO_TOKEN;
     return ast;
 }
-Ast * NewAst(AstType type, Token token)
+ParseNode * NewAst(AstType type, UINT32 token)
 {
-    Ast * ast = new Ast;
-    ast->parent = ast->leftChild = ast->rightSibling = nullptr;
-    ast->type = type;
+    ParseNode * ast = NewAst(type);
     ast->token = token;
     return ast;
 }
 
+// Pre-order, so a node is followed by its first child.
+void FlattenParseTree(ParseNode * root, AstTree & tree)
+{
+    tree.nodes.clear();
+    tree.nodes.push_back({ 0, 0, AST_NO_TOKEN, 0 });
+    if (!root)
+        return;
+
+    // node, and the node linking to it as left child or right sibling
+    struct Pending
+    {
+        ParseNode * node;
+        AstIndex    from;
+        bool        fromParent;
+    };
+    std::vector<Pending> stack = { { root, 0, false } };
+    while (!stack.empty())
+    {
+        Pending p = stack.back();
+        stack.pop_back();
+
+        AstIndex index = static_cast<AstIndex>(tree.nodes.size());
+        tree.nodes.push_back({ 0, 0, p.node->token, static_cast<UINT8>(p.node->type) });
+        if (p.from)
+            (p.fromParent ? tree.nodes[p.from].leftChild : tree.nodes[p.from].rightSibling) = index;
+
+        if (p.node->rightSibling)
+            stack.push_back({ p.node->rightSibling, index, false });
+        if (p.node->leftChild)
+            stack.push_back({ p.node->leftChild, index, true });
+    }
+}
+
 bool Contains(Token::Type type,
               const Token::Type * types,size_t size)
 {
@@ -30,10 +100,8 @@ bool Contains(Token::Type type,
     return false;
 }
 
-bool First(AstType at, const Token & token)
+bool First(AstType at, Token::Type type)
 {
-    Token::Type type = token.type;
-
     if (at == STORAGE_CLASS_SPECIFIER)
     {
         const Token::Type first[] = {
@@ -74,9 +142,9 @@ bool First(AstType at, const Token & token)
     }
     else if (at == DECLARATION_SPECIFIERS)
     {
-        return First(STORAGE_CLASS_SPECIFIER, token) ||
-               First(TYPE_SPECIFIER, token) ||
-               First(TYPE_QUALIFIER, token);
+        return First(STORAGE_CLASS_SPECIFIER, type) ||
+               First(TYPE_SPECIFIER, type) ||
+               First(TYPE_QUALIFIER, type);
     }
     else if (at == DECLARATOR)
     {
@@ -98,7 +166,7 @@ bool First(AstType at, const Token & token)
     }
     else if (at == DECLARATION)
     {
-        return First(DECLARATION_SPECIFIERS, token);
+        return First(DECLARATION_SPECIFIERS, type);
     }
     else if (at == LABELED_STMT)
     {
@@ -111,12 +179,12 @@ bool First(AstType at, const Token & token)
     }
     else if (at == COMPOUND_STMT)
     {
-        return token.type == Token::BLK_BEGIN;
+        return type == Token::BLK_BEGIN;
     }
     else if (at == EXPRESSION_STMT)
     {
-        return token.type == Token::STMT_END ||
-               First(EXPR, token);
+        return type == Token::STMT_END ||
+               First(EXPR, type);
     }
     else if (at == SELECTION_STMT)
     {
@@ -147,12 +215,12 @@ bool First(AstType at, const Token & token)
     }
     else if (at == STMT)
     {
-        return First(LABELED_STMT,      token) ||
-               First(COMPOUND_STMT,     token) ||
-               First(EXPRESSION_STMT,   token) ||
-               First(SELECTION_STMT,    token) ||
-               First(ITERATION_STMT,    token) ||
-               First(JUMP_STMT,         token);
+        return First(LABELED_STMT,      type) ||
+               First(COMPOUND_STMT,     type) ||
+               First(EXPRESSION_STMT,   type) ||
+               First(SELECTION_STMT,    type) ||
+               First(ITERATION_STMT,    type) ||
+               First(JUMP_STMT,         type);
     }
     else if (at == EXPR)
     {
@@ -180,80 +248,107 @@ bool First(AstType at, const Token & token)
 }
 
 #define NEXT() (ti.next())
+#define NEXT_INDEX() ((void)ti.next(), static_cast<UINT32>(ti.index() - 1))
 #define PEEK() (ti.peek())
-#define PEEK2() (ti.peekN(1))
-#define PEEK_T(n) (ti.peek().type == (n))
+#define PEEK_TYPE() (ti.PeekType())
+#define PEEK2_TYPE() (ti.peekN(1).type)
+#define PEEK_T(n) (ti.PeekType() == (n))
 #define PEEK2_T(n) (ti.peekN(1).type == (n))
 #define SKIP_T(n) (PEEK_T(n) ? (void)ti.next(), true : false)
 #define EXPECT_T(n) (ASSERT(PEEK_T(n)), (void)ti.next())
 
-extern Ast * ParseTranslationUnit(TokenIterator & ti);
-extern Ast * ParseDeclaration(TokenIterator & ti);
-extern Ast * ParseDeclaration(TokenIterator & ti, Ast * declarationSpecifiers, Ast * declarator);
-extern Ast * ParseDeclarationSpecifiers(TokenIterator & ti);
-extern Ast * ParseTypeSpecifier(TokenIterator & ti);
-extern Ast * ParseStructDeclaration(TokenIterator & ti);
-extern Ast * ParseStructDeclarator(TokenIterator & ti);
-extern Ast * ParseDeclaratorInitializer(TokenIterator & ti);
-extern Ast * ParseDeclarator(TokenIterator & ti);
-extern Ast * ParseInitializer(TokenIterator & ti);
-extern Ast * ParseFunctionDefinition(TokenIterator & ti, Ast * declarationSpecifiers, Ast * declarator);
-extern Ast * ParseStatememt(TokenIterator & ti);
-extern Ast * ParseCompoundStatement(TokenIterator & ti);
-extern Ast * ParseExpression(TokenIterator & ti);
-extern Ast * ParseCommaExpr(TokenIterator & ti, Ast * leftCommaExpr = nullptr);
-extern Ast * ParseAssignExpr(TokenIterator & ti);
-extern Ast * ParseCondExpr(TokenIterator & ti);
-extern Ast * ParseOrExpr(TokenIterator & ti, Ast * leftOrExpr = nullptr);
-extern Ast * ParseAndExpr(TokenIterator & ti, Ast * leftAndExpr = nullptr);
-extern Ast * ParseBitOrExpr(TokenIterator & ti, Ast * leftBitOrExpr = nullptr);
-extern Ast * ParseBitXorExpr(TokenIterator & ti, Ast * leftBitXorExpr = nullptr);
-extern Ast * ParseBitAndExpr(TokenIterator & ti, Ast * leftBitAndExpr = nullptr);
-extern Ast * ParseEqExpr(TokenIterator & ti, Ast * leftEqExpr = nullptr);
-extern Ast * ParseRelExpr(TokenIterator & ti, Ast * leftRelExpr = nullptr);
-extern Ast * ParseShiftExpr(TokenIterator & ti, Ast * leftShiftExpr = nullptr);
-extern Ast * ParseAddExpr(TokenIterator & ti, Ast * leftAddExpr = nullptr);
-extern Ast * ParseMulExpr(TokenIterator & ti, Ast * leftMulExpr = nullptr);
-extern Ast * ParseCastExpr(TokenIterator & ti);
-extern Ast * ParseUnaryExpr(TokenIterator & ti);
-extern Ast * ParsePostfixExpr(TokenIterator & ti, Ast * leftPostfixExpr = nullptr);
-extern Ast * ParsePrimaryExpr(TokenIterator & ti);
-extern Ast * ParseArgumentList(TokenIterator & ti);
-extern Ast * ParseConstantExpr(TokenIterator & ti);
-extern Ast * ParseParameterList(TokenIterator & ti);
-
-Ast * ParseTranslationUnit(TokenIterator & ti)
+extern ParseNode * ParseTranslationUnitNode(TokenIterator & ti, std::vector<AstTokenRange> & externals, std::vector<AstTokenRange> * lazyBodies);
+extern ParseNode * ParseDeclaration(TokenIterator & ti);
+extern ParseNode * ParseDeclaration(TokenIterator & ti, ParseNode * declarationSpecifiers, ParseNode * declarator);
+extern ParseNode * ParseDeclarationSpecifiers(TokenIterator & ti);
+extern ParseNode * ParseTypeSpecifier(TokenIterator & ti);
+extern ParseNode * ParseStructDeclaration(TokenIterator & ti);
+extern ParseNode * ParseStructDeclarator(TokenIterator & ti);
+extern ParseNode * ParseDeclaratorInitializer(TokenIterator & ti);
+extern ParseNode * ParseDeclarator(TokenIterator & ti);
+extern ParseNode * ParseInitializer(TokenIterator & ti);
+extern ParseNode * ParseFunctionDefinition(TokenIterator & ti, ParseNode * declarationSpecifiers, ParseNode * declarator);
+extern ParseNode * ParseStatememt(TokenIterator & ti);
+extern ParseNode * ParseCompoundStatement(TokenIterator & ti);
+extern ParseNode * ParseExpression(TokenIterator & ti);
+extern ParseNode * ParseCommaExpr(TokenIterator & ti);
+extern ParseNode * ParseAssignExpr(TokenIterator & ti);
+extern ParseNode * ParseCondExpr(TokenIterator & ti);
+extern ParseNode * ParseBinaryExpr(TokenIterator & ti, int minPrecedence);
+extern ParseNode * ParseCastExpr(TokenIterator & ti);
+extern ParseNode * ParseUnaryExpr(TokenIterator & ti);
+extern ParseNode * ParsePostfixExpr(TokenIterator & ti);
+extern ParseNode * ParsePrimaryExpr(TokenIterator & ti);
+extern ParseNode * ParseArgumentList(TokenIterator & ti);
+extern ParseNode * ParseConstantExpr(TokenIterator & ti);
+extern ParseNode * ParseParameterList(TokenIterator & ti);
+
+// Match braces of "{ ... }", leave a childless COMPOUND_STMT.
+ParseNode * SkipCompoundStatement(TokenIterator & ti, std::vector<AstTokenRange> & lazyBodies)
 {
-    Ast * translationUnit                       = NewAst(TRANSLATION_UNIT);
-    Ast ** pNextChild                           = &translationUnit->leftChild;
+    AstTokenRange body                            = { 0, static_cast<UINT32>(ti.index()), 0 };
+
+    EXPECT_T(Token::BLK_BEGIN);
+    for (int depth = 1; depth > 0; )
+    {
+        Token::Type type                        = NEXT().type;
+        depth                                   += (type == Token::BLK_BEGIN) - (type == Token::BLK_END);
+    }
+
+    body.tokenEnd                               = static_cast<UINT32>(ti.index());
+    lazyBodies.push_back(body);
+
+    return NewAst(COMPOUND_STMT);
+}
+
+// lazyBodies: nullptr to parse function bodies, else where to record them.
+ParseNode * ParseTranslationUnitNode(TokenIterator & ti, std::vector<AstTokenRange> & externals, std::vector<AstTokenRange> * lazyBodies)
+{
+    ParseNode * translationUnit                 = NewAst(TRANSLATION_UNIT);
+    ParseNode ** pNextChild                     = &translationUnit->leftChild;
 
     while (ti.has())
     {
-        ASSERT(First(DECLARATION_SPECIFIERS, PEEK()));
-        Ast * declarationSpecifiers             = ParseDeclarationSpecifiers(ti);
+        AstTokenRange external                  = { 0, static_cast<UINT32>(ti.index()), 0 };
+
+        ASSERT(First(DECLARATION_SPECIFIERS, PEEK_TYPE()));
+        ParseNode * declarationSpecifiers       = ParseDeclarationSpecifiers(ti);
 
-        Ast * declarator                        = First(DECLARATOR, PEEK())
+        ParseNode * declarator                  = First(DECLARATOR, PEEK_TYPE())
                                                   ? ParseDeclarator(ti)
                                                   : nullptr;
 
-        *pNextChild                             = (declarator != nullptr && PEEK_T(Token::BLK_BEGIN))
+        if (declarator != nullptr && PEEK_T(Token::BLK_BEGIN) && lazyBodies)
+        {
+            *pNextChild                         = NewAst(FUNCTION_DEFINITION);
+            (*pNextChild)->leftChild            = declarationSpecifiers;
+            declarationSpecifiers->rightSibling = declarator;
+            declarator->rightSibling            = SkipCompoundStatement(ti, *lazyBodies);
+        }
+        else
+        {
+            *pNextChild                         = (declarator != nullptr && PEEK_T(Token::BLK_BEGIN))
                                                   ? ParseFunctionDefinition(ti, declarationSpecifiers, declarator)
                                                   : ParseDeclaration(ti, declarationSpecifiers, declarator);
+        }
         pNextChild                              = &(*pNextChild)->rightSibling;
+
+        external.tokenEnd                       = static_cast<UINT32>(ti.index());
+        externals.push_back(external);
     }
     //ASSERT(translationUnit->leftChild);
 
     return translationUnit;
 }
 
-Ast * ParseDeclaration(TokenIterator & ti)
+ParseNode * ParseDeclaration(TokenIterator & ti)
 {
-    Ast * declaration                           = NewAst(DECLARATION);
+    ParseNode * declaration                     = NewAst(DECLARATION);
     declaration->leftChild                      = ParseDeclarationSpecifiers(ti);
 
     if (!PEEK_T(Token::STMT_END))
     {
-        Ast ** pNextDeclaratorInitializer       = &declaration->leftChild->rightSibling;
+        ParseNode ** pNextDeclaratorInitializer       = &declaration->leftChild->rightSibling;
         *pNextDeclaratorInitializer             = ParseDeclaratorInitializer(ti);
         pNextDeclaratorInitializer              = &(*pNextDeclaratorInitializer)->rightSibling;
         while (SKIP_T(Token::OP_COMMA))
@@ -268,18 +363,18 @@ Ast * ParseDeclaration(TokenIterator & ti)
     return declaration;
 }
 
-Ast * ParseDeclaration(TokenIterator & ti, Ast * declarationSpecifiers, Ast * declarator)
+ParseNode * ParseDeclaration(TokenIterator & ti, ParseNode * declarationSpecifiers, ParseNode * declarator)
 {
     ASSERT(declarationSpecifiers);
 
-    Ast * declaration                           = NewAst(DECLARATION);
+    ParseNode * declaration                     = NewAst(DECLARATION);
     declaration->leftChild                      = declarationSpecifiers;
 
     if (declarator)
     {
-        Ast ** pNextDeclaratorInitializer = &declaration->leftChild->rightSibling;
+        ParseNode ** pNextDeclaratorInitializer = &declaration->leftChild->rightSibling;
 
-        Ast * declaratorInitializer             = NewAst(DECLARATOR_INITIALIZER);
+        ParseNode * declaratorInitializer       = NewAst(DECLARATOR_INITIALIZER);
         declaratorInitializer->leftChild        = declarator;
         declaratorInitializer->leftChild->rightSibling
                                                 = SKIP_T(Token::ASSIGN)
@@ -303,25 +398,25 @@ bool IsAstTypeQualifier(AstType type)
 {
     return type == TYPE_QUALIFIER;
 }
-Ast * ParseDeclarationSpecifiers(TokenIterator & ti)
+ParseNode * ParseDeclarationSpecifiers(TokenIterator & ti)
 {
-    Ast * declarationSpecifiers                 = NewAst(DECLARATION_SPECIFIERS);
-    Ast ** pNextSpecifer                        = &declarationSpecifiers->leftChild;
+    ParseNode * declarationSpecifiers           = NewAst(DECLARATION_SPECIFIERS);
+    ParseNode ** pNextSpecifer                  = &declarationSpecifiers->leftChild;
     while (true)
     {
-        if (First(STORAGE_CLASS_SPECIFIER, PEEK()))
+        if (First(STORAGE_CLASS_SPECIFIER, PEEK_TYPE()))
         {
-            Ast * storageSpecifier                  = NewAst(STORAGE_CLASS_SPECIFIER, NEXT());
+            ParseNode * storageSpecifier            = NewAst(STORAGE_CLASS_SPECIFIER, NEXT_INDEX());
             *pNextSpecifer                          = storageSpecifier;
             pNextSpecifer                           = &(*pNextSpecifer)->rightSibling;
         }
-        else if (First(TYPE_QUALIFIER, PEEK()))
+        else if (First(TYPE_QUALIFIER, PEEK_TYPE()))
         {
-            Ast * typeQualifier                     = NewAst(TYPE_QUALIFIER, NEXT());
+            ParseNode * typeQualifier               = NewAst(TYPE_QUALIFIER, NEXT_INDEX());
             *pNextSpecifer                          = typeQualifier;
             pNextSpecifer                           = &(*pNextSpecifer)->rightSibling;
         }
-        else if (First(TYPE_SPECIFIER, PEEK()))
+        else if (First(TYPE_SPECIFIER, PEEK_TYPE()))
         {
             *pNextSpecifer                          = ParseTypeSpecifier(ti);
             pNextSpecifer                           = &(*pNextSpecifer)->rightSibling;
@@ -343,20 +438,20 @@ bool IsAstTypeSpecifier(AstType type)
            type == TYPEDEF_NAME ||
            type == TYPE_SPECIFIER;
 }
-Ast * ParseTypeSpecifier(TokenIterator & ti)
+ParseNode * ParseTypeSpecifier(TokenIterator & ti)
 {
-    ASSERT(First(TYPE_SPECIFIER, PEEK()));
+    ASSERT(First(TYPE_SPECIFIER, PEEK_TYPE()));
 
     if (PEEK_T(Token::KW_STRUCT) || PEEK_T(Token::KW_UNION))
     {
-        Ast * structSpecifier               = NewAst(NEXT().type == Token::KW_STRUCT
+        ParseNode * structSpecifier         = NewAst(NEXT().type == Token::KW_STRUCT
                                                         ? STRUCT_SPECIFIER
                                                         : UNION_SPECIFIER);
-        Ast ** pNextChild                   = &structSpecifier->leftChild;
+        ParseNode ** pNextChild             = &structSpecifier->leftChild;
 
         if (PEEK_T(Token::ID))
         {
-            *pNextChild                     = NewAst(IDENTIFIER, NEXT());
+            *pNextChild                     = NewAst(IDENTIFIER, NEXT_INDEX());
             pNextChild                      = &(*pNextChild)->rightSibling;
         }
         else
@@ -378,12 +473,12 @@ Ast * ParseTypeSpecifier(TokenIterator & ti)
     }
     else if (SKIP_T(Token::KW_ENUM))
     {
-        Ast * enumSpecifier                 = NewAst(ENUM_SPECIFIER);
-        Ast ** pNextChild                   = &enumSpecifier->leftChild;
+        ParseNode * enumSpecifier           = NewAst(ENUM_SPECIFIER);
+        ParseNode ** pNextChild             = &enumSpecifier->leftChild;
                 
         if (PEEK_T(Token::ID))
         {
-            *pNextChild                     = NewAst(IDENTIFIER, NEXT());
+            *pNextChild                     = NewAst(IDENTIFIER, NEXT_INDEX());
             pNextChild                      = &(*pNextChild)->rightSibling;
         }
         else
@@ -394,7 +489,7 @@ Ast * ParseTypeSpecifier(TokenIterator & ti)
         if (SKIP_T(Token::BLK_BEGIN))
         {
             ASSERT(PEEK_T(Token::ID));
-            *pNextChild                     = NewAst(ENUM_CONSTANT, NEXT());
+            *pNextChild                     = NewAst(ENUM_CONSTANT, NEXT_INDEX());
             (*pNextChild)->leftChild        = SKIP_T(Token::ASSIGN)
                                               ? ParseConstantExpr(ti)
                                               : nullptr;
@@ -402,7 +497,7 @@ Ast * ParseTypeSpecifier(TokenIterator & ti)
             while (SKIP_T(Token::OP_COMMA))
             {
                 ASSERT(PEEK_T(Token::ID));
-                *pNextChild                 = NewAst(ENUM_CONSTANT, NEXT());
+                *pNextChild                 = NewAst(ENUM_CONSTANT, NEXT_INDEX());
                 (*pNextChild)->leftChild    = SKIP_T(Token::ASSIGN)
                                               ? ParseConstantExpr(ti)
                                               : nullptr;
@@ -416,29 +511,29 @@ Ast * ParseTypeSpecifier(TokenIterator & ti)
     }
     else if (PEEK_T(Token::ID))
     {
-        return NewAst(TYPEDEF_NAME, NEXT());
+        return NewAst(TYPEDEF_NAME, NEXT_INDEX());
     }
     else
     {
-        return NewAst(TYPE_SPECIFIER, NEXT());
+        return NewAst(TYPE_SPECIFIER, NEXT_INDEX());
     }
 }
 
-Ast * ParseStructDeclaration(TokenIterator & ti)
+ParseNode * ParseStructDeclaration(TokenIterator & ti)
 {
-    Ast * structDeclaration                         = NewAst(STRUCT_DECLARATION);
-    Ast ** pNextChild                               = &structDeclaration->leftChild;
+    ParseNode * structDeclaration                   = NewAst(STRUCT_DECLARATION);
+    ParseNode ** pNextChild                         = &structDeclaration->leftChild;
 
     while (true)
     {
-        if (First(TYPE_SPECIFIER, PEEK()))
+        if (First(TYPE_SPECIFIER, PEEK_TYPE()))
         {
             *pNextChild                             = ParseTypeSpecifier(ti);
             pNextChild                              = &(*pNextChild)->rightSibling;
         }
-        else if (First(TYPE_QUALIFIER, PEEK()))
+        else if (First(TYPE_QUALIFIER, PEEK_TYPE()))
         {
-            *pNextChild                             = NewAst(TYPE_QUALIFIER, NEXT());
+            *pNextChild                             = NewAst(TYPE_QUALIFIER, NEXT_INDEX());
             pNextChild                              = &(*pNextChild)->rightSibling;
         }
         else
@@ -460,16 +555,16 @@ Ast * ParseStructDeclaration(TokenIterator & ti)
     return structDeclaration;
 }
 
-Ast * ParseStructDeclarator(TokenIterator & ti)
+ParseNode * ParseStructDeclarator(TokenIterator & ti)
 {
-    Ast * structDeclarator                          = NewAst(STRUCT_DECLARATOR);
+    ParseNode * structDeclarator                    = NewAst(STRUCT_DECLARATOR);
     structDeclarator->leftChild                     = ParseDeclarator(ti);
     return structDeclarator;
 }
 
-Ast * ParseDeclaratorInitializer(TokenIterator & ti)
+ParseNode * ParseDeclaratorInitializer(TokenIterator & ti)
 {
-    Ast * declaratorInitializer                 = NewAst(DECLARATOR_INITIALIZER);
+    ParseNode * declaratorInitializer           = NewAst(DECLARATOR_INITIALIZER);
     declaratorInitializer->leftChild            = ParseDeclarator(ti);
     declaratorInitializer->leftChild->rightSibling
                                                 = SKIP_T(Token::ASSIGN)
@@ -478,19 +573,19 @@ Ast * ParseDeclaratorInitializer(TokenIterator & ti)
     return declaratorInitializer;
 }
 
-Ast * ParseDeclarator(TokenIterator & ti)
+ParseNode * ParseDeclarator(TokenIterator & ti)
 {
-    Ast * declarator                            = NewAst(DECLARATOR);
+    ParseNode * declarator                      = NewAst(DECLARATOR);
 
-    Ast ** pNextDirectDeclarator                = &declarator->leftChild;
+    ParseNode ** pNextDirectDeclarator          = &declarator->leftChild;
 
     if (SKIP_T(Token::OP_MUL))
     {
-        Ast * pointerList                       = NewAst(POINTER_LIST);
+        ParseNode * pointerList                 = NewAst(POINTER_LIST);
 
-        Ast * pointer                           = NewAst(POINTER);
+        ParseNode * pointer                     = NewAst(POINTER);
         pointer->leftChild                      = (PEEK_T(Token::KW_CONST) || PEEK_T(Token::KW_VOLATILE))
-                                                  ? NewAst(TYPE_QUALIFIER, NEXT())
+                                                  ? NewAst(TYPE_QUALIFIER, NEXT_INDEX())
                                                   : nullptr;
 
         pointerList->leftChild                  = pointer;
@@ -499,7 +594,7 @@ Ast * ParseDeclarator(TokenIterator & ti)
         {
             pointer->rightSibling               = NewAst(POINTER);
             pointer->rightSibling->leftChild    = (PEEK_T(Token::KW_CONST) || PEEK_T(Token::KW_VOLATILE))
-                                                  ? NewAst(TYPE_QUALIFIER, NEXT())
+                                                  ? NewAst(TYPE_QUALIFIER, NEXT_INDEX())
                                                   : nullptr;
             pointer                             = pointer->rightSibling;
         }
@@ -516,7 +611,7 @@ Ast * ParseDeclarator(TokenIterator & ti)
     else
     {
         ASSERT(PEEK_T(Token::ID));
-        *pNextDirectDeclarator                  = NewAst(IDENTIFIER, NEXT());
+        *pNextDirectDeclarator                  = NewAst(IDENTIFIER, NEXT_INDEX());
     }
     pNextDirectDeclarator                       = &((*pNextDirectDeclarator)->rightSibling);
 
@@ -547,19 +642,19 @@ Ast * ParseDeclarator(TokenIterator & ti)
     return declarator;
 }
 
-Ast * ParseAbstractDeclarator(TokenIterator & ti)
+ParseNode * ParseAbstractDeclarator(TokenIterator & ti)
 {
-    Ast * declarator                            = NewAst(ABSTRACT_DECLARATOR);
+    ParseNode * declarator                      = NewAst(ABSTRACT_DECLARATOR);
 
-    Ast ** pNextChild                           = &declarator->leftChild;
+    ParseNode ** pNextChild                     = &declarator->leftChild;
 
     if (SKIP_T(Token::OP_MUL))
     {
-        Ast * pointerList                       = NewAst(POINTER_LIST);
+        ParseNode * pointerList                 = NewAst(POINTER_LIST);
 
-        Ast * pointer                           = NewAst(POINTER);
+        ParseNode * pointer                     = NewAst(POINTER);
         pointer->leftChild                      = (PEEK_T(Token::KW_CONST) || PEEK_T(Token::KW_VOLATILE))
-                                                  ? NewAst(TYPE_QUALIFIER, NEXT())
+                                                  ? NewAst(TYPE_QUALIFIER, NEXT_INDEX())
                                                   : nullptr;
 
         pointerList->leftChild                  = pointer;
@@ -568,7 +663,7 @@ Ast * ParseAbstractDeclarator(TokenIterator & ti)
         {
             pointer->rightSibling               = NewAst(POINTER);
             pointer->rightSibling->leftChild    = (PEEK_T(Token::KW_CONST) || PEEK_T(Token::KW_VOLATILE))
-                                                  ? NewAst(TYPE_QUALIFIER, NEXT())
+                                                  ? NewAst(TYPE_QUALIFIER, NEXT_INDEX())
                                                   : nullptr;
             pointer                             = pointer->rightSibling;
         }
@@ -578,7 +673,7 @@ Ast * ParseAbstractDeclarator(TokenIterator & ti)
     }
 
     // abstract_declarator?
-    if (PEEK_T(Token::LPAREN) && First(ABSTRACT_DECLARATOR, PEEK2()))
+    if (PEEK_T(Token::LPAREN) && First(ABSTRACT_DECLARATOR, PEEK2_TYPE()))
     {
         EXPECT_T(Token::LPAREN);
         *pNextChild                             = ParseAbstractDeclarator(ti);
@@ -619,21 +714,21 @@ Ast * ParseAbstractDeclarator(TokenIterator & ti)
     return declarator;
 }
 
-Ast * ParseTypename(TokenIterator & ti)
+ParseNode * ParseTypename(TokenIterator & ti)
 {
-    Ast * typeName                              = NewAst(TYPE_NAME);
-    Ast ** pNextChild                           = &typeName->leftChild;
+    ParseNode * typeName                        = NewAst(TYPE_NAME);
+    ParseNode ** pNextChild                     = &typeName->leftChild;
 
     while (true)
     {
-        if (First(TYPE_SPECIFIER, PEEK()))
+        if (First(TYPE_SPECIFIER, PEEK_TYPE()))
         {
             *pNextChild                         = ParseTypeSpecifier(ti);
             pNextChild                          = &(*pNextChild)->rightSibling;
         }
-        else if (First(TYPE_QUALIFIER, PEEK()))
+        else if (First(TYPE_QUALIFIER, PEEK_TYPE()))
         {
-            *pNextChild                         = NewAst(TYPE_QUALIFIER, NEXT());
+            *pNextChild                         = NewAst(TYPE_QUALIFIER, NEXT_INDEX());
             pNextChild                          = &(*pNextChild)->rightSibling;
         }
         else
@@ -643,7 +738,7 @@ Ast * ParseTypename(TokenIterator & ti)
     }
     ASSERT(typeName->leftChild);
 
-    if (First(ABSTRACT_DECLARATOR, PEEK()))
+    if (First(ABSTRACT_DECLARATOR, PEEK_TYPE()))
     {
         *pNextChild                             = ParseAbstractDeclarator(ti);
         pNextChild                              = &(*pNextChild)->rightSibling;
@@ -652,18 +747,18 @@ Ast * ParseTypename(TokenIterator & ti)
     return typeName;
 }
 
-Ast * ParseInitializer(TokenIterator & ti)
+ParseNode * ParseInitializer(TokenIterator & ti)
 {
     // TODO
     ASSERT(false);
     return nullptr;
 }
 
-Ast * ParseFunctionDefinition(TokenIterator & ti, Ast * declarationSpecifiers, Ast * declarator)
+ParseNode * ParseFunctionDefinition(TokenIterator & ti, ParseNode * declarationSpecifiers, ParseNode * declarator)
 {
     ASSERT(declarationSpecifiers && declarator);
 
-    Ast * functionDefinition                    = NewAst(FUNCTION_DEFINITION);
+    ParseNode * functionDefinition              = NewAst(FUNCTION_DEFINITION);
 
     functionDefinition->leftChild               = declarationSpecifiers;
     functionDefinition->leftChild->rightSibling
@@ -674,22 +769,22 @@ Ast * ParseFunctionDefinition(TokenIterator & ti, Ast * declarationSpecifiers, A
     return functionDefinition;
 }
 
-Ast * ParseStatememt(TokenIterator & ti)
+ParseNode * ParseStatememt(TokenIterator & ti)
 {
-    if (First(COMPOUND_STMT, PEEK()))
+    if (First(COMPOUND_STMT, PEEK_TYPE()))
     {
-        Ast * compoundStatement                 = NewAst(COMPOUND_STMT);
+        ParseNode * compoundStatement           = NewAst(COMPOUND_STMT);
 
         EXPECT_T(Token::BLK_BEGIN);
-        Ast ** pNextChild                       = &compoundStatement->leftChild;
-        while (!PEEK_T(Token::BLK_END) && First(DECLARATION, PEEK()))
+        ParseNode ** pNextChild                 = &compoundStatement->leftChild;
+        while (!PEEK_T(Token::BLK_END) && First(DECLARATION, PEEK_TYPE()))
         {
             *pNextChild                         = ParseDeclaration(ti);
             pNextChild                          = &(*pNextChild)->rightSibling;
         }
         while (!PEEK_T(Token::BLK_END))
         {
-            ASSERT(First(STMT, PEEK()));
+            ASSERT(First(STMT, PEEK_TYPE()));
             *pNextChild                         = ParseStatememt(ti);
             pNextChild                          = &(*pNextChild)->rightSibling;
         }
@@ -709,7 +804,7 @@ Ast * ParseStatememt(TokenIterator & ti)
         }
         else if (SKIP_T(Token::KW_CASE))
         {
-            Ast * caseStatement                 = NewAst(CASE_STMT);
+            ParseNode * caseStatement           = NewAst(CASE_STMT);
             caseStatement->leftChild            = ParseConstantExpr(ti);
             EXPECT_T(Token::OP_COLON);
             caseStatement->leftChild->rightSibling
@@ -718,16 +813,16 @@ Ast * ParseStatememt(TokenIterator & ti)
         }
         else
         {
-            Ast * defaultStatement              = NewAst(DEFAULT_STMT);
+            ParseNode * defaultStatement        = NewAst(DEFAULT_STMT);
             EXPECT_T(Token::KW_DEFAULT);
             EXPECT_T(Token::OP_COLON);
             defaultStatement->leftChild         = ParseStatememt(ti);
             return defaultStatement;
         }
     }
-    else if (First(EXPRESSION_STMT, PEEK()))
+    else if (First(EXPRESSION_STMT, PEEK_TYPE()))
     {
-        Ast * expressionStatement               = NewAst(EXPRESSION_STMT);
+        ParseNode * expressionStatement         = NewAst(EXPRESSION_STMT);
 
         expressionStatement->leftChild          = !PEEK_T(Token::STMT_END)
                                                   ? ParseExpression(ti)
@@ -735,21 +830,21 @@ Ast * ParseStatememt(TokenIterator & ti)
         EXPECT_T(Token::STMT_END);
         return expressionStatement;
     }
-    else if (First(SELECTION_STMT, PEEK()))
+    else if (First(SELECTION_STMT, PEEK_TYPE()))
     {
         if (SKIP_T(Token::KW_IF))
         {
             EXPECT_T(Token::LPAREN);
-            Ast * expression                    = ParseExpression(ti);
+            ParseNode * expression              = ParseExpression(ti);
             EXPECT_T(Token::RPAREN);
 
-            Ast * ifBlock                       = ParseStatememt(ti);
+            ParseNode * ifBlock                 = ParseStatememt(ti);
 
-            Ast * elseBlock                     = SKIP_T(Token::KW_ELSE)
+            ParseNode * elseBlock               = SKIP_T(Token::KW_ELSE)
                                                   ? ParseStatememt(ti)
                                                   : nullptr;
 
-            Ast * ifStatement                   = NewAst(IF_ELSE_STMT);
+            ParseNode * ifStatement             = NewAst(IF_ELSE_STMT);
             ifStatement->leftChild              = expression;
             ifStatement->leftChild->rightSibling= ifBlock;
             ifStatement->leftChild->rightSibling->rightSibling
@@ -760,7 +855,7 @@ Ast * ParseStatememt(TokenIterator & ti)
         {
             EXPECT_T(Token::KW_SWITCH);
 
-            Ast * switchStatement               = NewAst(SWITCH_STMT);
+            ParseNode * switchStatement         = NewAst(SWITCH_STMT);
             EXPECT_T(Token::LPAREN);
             switchStatement->leftChild          = ParseExpression(ti);
             EXPECT_T(Token::RPAREN);
@@ -769,11 +864,11 @@ Ast * ParseStatememt(TokenIterator & ti)
             return switchStatement;
         }
     }
-    else if (First(ITERATION_STMT, PEEK()))
+    else if (First(ITERATION_STMT, PEEK_TYPE()))
     {
         if (SKIP_T(Token::KW_WHILE))
         {
-            Ast * whileStatement                = NewAst(WHILE_STMT);
+            ParseNode * whileStatement          = NewAst(WHILE_STMT);
             EXPECT_T(Token::LPAREN);
             whileStatement->leftChild           = ParseExpression(ti);
             EXPECT_T(Token::RPAREN);
@@ -783,7 +878,7 @@ Ast * ParseStatememt(TokenIterator & ti)
         }
         else if (SKIP_T(Token::KW_DO))
         {
-            Ast * doWhileStatement              = NewAst(DO_WHILE_STMT);
+            ParseNode * doWhileStatement        = NewAst(DO_WHILE_STMT);
             doWhileStatement->leftChild         = ParseStatememt(ti);
             EXPECT_T(Token::KW_WHILE);
             EXPECT_T(Token::LPAREN);
@@ -797,7 +892,7 @@ Ast * ParseStatememt(TokenIterator & ti)
         {
             EXPECT_T(Token::KW_FOR);
 
-            Ast * forStatement                  = NewAst(FOR_STMT);
+            ParseNode * forStatement            = NewAst(FOR_STMT);
             EXPECT_T(Token::LPAREN);
             forStatement->leftChild             = !PEEK_T(Token::STMT_END)
                                                   ? ParseExpression(ti)
@@ -820,7 +915,7 @@ Ast * ParseStatememt(TokenIterator & ti)
     }
     else
     {
-        ASSERT(First(JUMP_STMT, PEEK()));
+        ASSERT(First(JUMP_STMT, PEEK_TYPE()));
 
         if (SKIP_T(Token::KW_GOTO))
         {
@@ -841,7 +936,7 @@ Ast * ParseStatememt(TokenIterator & ti)
         else
         {
             EXPECT_T(Token::KW_RETURN);
-            Ast * returnStatement               = NewAst(RETURN_STMT);
+            ParseNode * returnStatement         = NewAst(RETURN_STMT);
             returnStatement->leftChild          = !PEEK_T(Token::STMT_END)
                                                   ? ParseExpression(ti)
                                                   : nullptr;
@@ -851,39 +946,35 @@ Ast * ParseStatememt(TokenIterator & ti)
     }
 }
 
-Ast * ParseCompoundStatement(TokenIterator & ti)
+ParseNode * ParseCompoundStatement(TokenIterator & ti)
 {
     ASSERT(PEEK_T(Token::BLK_BEGIN));
     return ParseStatememt(ti);
 }
 
-// TODO
-Ast * ParseExpression(TokenIterator & ti)
+ParseNode * ParseExpression(TokenIterator & ti)
 {
     return ParseCommaExpr(ti);
 }
-Ast * ParseCommaExpr(TokenIterator & ti, Ast * leftCommaExpr /* = nullptr */)
+ParseNode * ParseCommaExpr(TokenIterator & ti)
 {
-    Ast * left                                  = leftCommaExpr
-                                                  ? leftCommaExpr
-                                                  : ParseAssignExpr(ti);
-    if (SKIP_T(Token::OP_COMMA))
+    ParseNode * left                            = ParseAssignExpr(ti);
+    while (SKIP_T(Token::OP_COMMA))
     {
-        Ast * commaExpr                         = NewAst(COMMA_EXPR);
+        ParseNode * commaExpr                   = NewAst(COMMA_EXPR);
         commaExpr->leftChild                    = left;
         commaExpr->leftChild->rightSibling      = ParseAssignExpr(ti);
-        return ParseCommaExpr(ti, commaExpr);
+        left                                    = commaExpr;
     }
-    else
-        return left;
+    return left;
 }
-Ast * ParseAssignExpr(TokenIterator & ti)
+ParseNode * ParseAssignExpr(TokenIterator & ti)
 {
-    Ast * condExpr                              = ParseCondExpr(ti);
-    if (IsAssignOp(PEEK().type))
+    ParseNode * condExpr                        = ParseCondExpr(ti);
+    if (IsAssignOp(PEEK_TYPE()))
     {
-        Ast * assignExpr                        = NewAst(ASSIGN_EXPR);
-        assignExpr->token                       = NEXT();
+        ParseNode * assignExpr                  = NewAst(ASSIGN_EXPR);
+        assignExpr->token                       = NEXT_INDEX();
         assignExpr->leftChild                   = condExpr;
         assignExpr->leftChild->rightSibling     = ParseAssignExpr(ti);
         return assignExpr;
@@ -891,12 +982,12 @@ Ast * ParseAssignExpr(TokenIterator & ti)
     else
         return condExpr;
 }
-Ast * ParseCondExpr(TokenIterator & ti)
+ParseNode * ParseCondExpr(TokenIterator & ti)
 {
-    Ast * orExpr                                = ParseOrExpr(ti);
+    ParseNode * orExpr                          = ParseBinaryExpr(ti, 0);
     if (SKIP_T(Token::OP_QMARK))
     {
-        Ast * condExpr                          = NewAst(COND_EXPR);
+        ParseNode * condExpr                    = NewAst(COND_EXPR);
         condExpr->leftChild                     = orExpr;
         condExpr->leftChild->rightSibling       = ParseExpression(ti);
         EXPECT_T(Token::OP_COLON);
@@ -907,166 +998,63 @@ Ast * ParseCondExpr(TokenIterator & ti)
     else
         return orExpr;
 }
-Ast * ParseOrExpr(TokenIterator & ti, Ast * leftOrExpr /* = nullptr */)
-{
-    Ast * left                                  = leftOrExpr
-                                                  ? leftOrExpr
-                                                  : ParseAndExpr(ti);
-    if (SKIP_T(Token::BOOL_OR))
-    {
-        Ast * orExpr                            = NewAst(OR_EXPR);
-        orExpr->leftChild                       = left;
-        orExpr->leftChild->rightSibling         = ParseAndExpr(ti);
-        return ParseOrExpr(ti, orExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseAndExpr(TokenIterator & ti, Ast * leftAndExpr /* = nullptr */)
-{
-    Ast * left                                  = leftAndExpr
-                                                  ? leftAndExpr
-                                                  : ParseBitOrExpr(ti);
-    if (SKIP_T(Token::BOOL_AND))
-    {
-        Ast * andExpr                           = NewAst(AND_EXPR);
-        andExpr->leftChild                      = left;
-        andExpr->leftChild->rightSibling        = ParseBitOrExpr(ti);
-        return ParseAndExpr(ti, andExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseBitOrExpr(TokenIterator & ti, Ast * leftBitOrExpr /* = nullptr */)
+// Binary operators, loosest first. All left associative.
+struct BinaryOperator
 {
-    Ast * left                                  = leftBitOrExpr
-                                                  ? leftBitOrExpr
-                                                  : ParseBitXorExpr(ti);
-    if (SKIP_T(Token::BIT_OR))
-    {
-        Ast * bitOrExpr                         = NewAst(BIT_OR_EXPR);
-        bitOrExpr->leftChild                    = left;
-        bitOrExpr->leftChild->rightSibling      = ParseBitXorExpr(ti);
-        return ParseBitOrExpr(ti, bitOrExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseBitXorExpr(TokenIterator & ti, Ast * leftBitXorExpr /* = nullptr */)
+    AstType type;
+    int     precedence;
+    bool    keepToken;  // operator token tells apart ops of the same AstType
+};
+bool GetBinaryOperator(Token::Type type, BinaryOperator & op)
 {
-    Ast * left                                  = leftBitXorExpr
-                                                  ? leftBitXorExpr
-                                                  : ParseBitAndExpr(ti);
-    if (SKIP_T(Token::BIT_XOR))
-    {
-        Ast * bitXorExpr                        = NewAst(BIT_XOR_EXPR);
-        bitXorExpr->leftChild                   = left;
-        bitXorExpr->leftChild->rightSibling     = ParseBitAndExpr(ti);
-        return ParseBitXorExpr(ti, bitXorExpr);
+    switch (type)
+    {
+        case Token::BOOL_OR:    op = { OR_EXPR,         0, false }; return true;
+        case Token::BOOL_AND:   op = { AND_EXPR,        1, false }; return true;
+        case Token::BIT_OR:     op = { BIT_OR_EXPR,     2, false }; return true;
+        case Token::BIT_XOR:    op = { BIT_XOR_EXPR,    3, false }; return true;
+        case Token::BIT_AND:    op = { BIT_AND_EXPR,    4, false }; return true;
+        case Token::REL_EQ:
+        case Token::REL_NE:     op = { EQ_EXPR,         5, true };  return true;
+        case Token::REL_LT:
+        case Token::REL_LE:
+        case Token::REL_GT:
+        case Token::REL_GE:     op = { REL_EXPR,        6, true };  return true;
+        case Token::BIT_SHL:
+        case Token::BIT_SHR:    op = { SHIFT_EXPR,      7, true };  return true;
+        case Token::OP_ADD:
+        case Token::OP_SUB:     op = { ADD_EXPR,        8, true };  return true;
+        case Token::OP_MUL:
+        case Token::OP_DIV:
+        case Token::OP_MOD:     op = { MUL_EXPR,        9, true };  return true;
+        default:                return false;
     }
-    else
-        return left;
-}
-Ast * ParseBitAndExpr(TokenIterator & ti, Ast * leftBitAndExpr /* = nullptr */)
-{
-    Ast * left                                  = leftBitAndExpr
-                                                  ? leftBitAndExpr
-                                                  : ParseEqExpr(ti);
-    if (SKIP_T(Token::BIT_AND))
-    {
-        Ast * bitAndExpr                        = NewAst(BIT_AND_EXPR);
-        bitAndExpr->leftChild                   = left;
-        bitAndExpr->leftChild->rightSibling     = ParseEqExpr(ti);
-        return ParseBitAndExpr(ti, bitAndExpr);
-    }
-    else
-        return left;
 }
-Ast * ParseEqExpr(TokenIterator & ti, Ast * leftEqExpr/* = nullptr */)
+// Precedence climbing from or-expr down to mul-expr: operators of one level
+// loop here, only a tighter operator recurses, so a cast-expr operand costs
+// one call and a chain of operators no stack.
+ParseNode * ParseBinaryExpr(TokenIterator & ti, int minPrecedence)
 {
-    Ast * left                                  = leftEqExpr
-                                                  ? leftEqExpr
-                                                  : ParseRelExpr(ti);
-    if (IsEqOp(PEEK().type))
-    {
-        Ast * eqExpr                            = NewAst(EQ_EXPR);
-        eqExpr->leftChild                       = left;
-        eqExpr->token                           = NEXT();
-        eqExpr->leftChild->rightSibling         = ParseRelExpr(ti);
-        return ParseEqExpr(ti, eqExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseRelExpr(TokenIterator & ti, Ast * leftRelExpr /* = nullptr */)
-{
-    Ast * left                                  = leftRelExpr
-                                                  ? leftRelExpr
-                                                  : ParseShiftExpr(ti);
-    if (IsRelOp(PEEK().type))
-    {
-        Ast * relExpr                           = NewAst(REL_EXPR);
-        relExpr->leftChild                      = left;
-        relExpr->token                          = NEXT();
-        relExpr->leftChild->rightSibling        = ParseShiftExpr(ti);
-        return ParseRelExpr(ti, relExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseShiftExpr(TokenIterator & ti, Ast * leftShiftExpr /* = nullptr */)
-{
-    Ast * left                                  = leftShiftExpr
-                                                  ? leftShiftExpr
-                                                  : ParseAddExpr(ti);
-    if (IsShiftOp(PEEK().type))
-    {
-        Ast * shiftExpr                         = NewAst(SHIFT_EXPR);
-        shiftExpr->leftChild                    = left;
-        shiftExpr->token                        = NEXT();
-        shiftExpr->leftChild->rightSibling      = ParseAddExpr(ti);
-        return ParseShiftExpr(ti, shiftExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseAddExpr(TokenIterator & ti, Ast * leftAddExpr /* = nullptr */)
-{
-    Ast * left                                  = leftAddExpr
-                                                  ? leftAddExpr
-                                                  : ParseMulExpr(ti);
-    if (IsAddOp(PEEK().type))
-    {
-        Ast * addExpr                           = NewAst(ADD_EXPR);
-        addExpr->leftChild                      = left;
-        addExpr->token                          = NEXT();
-        addExpr->leftChild->rightSibling        = ParseMulExpr(ti);
-        return ParseAddExpr(ti, addExpr);
-    }
-    else
-        return left;
-}
-Ast * ParseMulExpr(TokenIterator & ti, Ast * leftMulExpr /* = nullptr */)
-{
-    Ast * left                                  = leftMulExpr
-                                                  ? leftMulExpr
-                                                  : ParseCastExpr(ti);
-    if (IsMulOp(PEEK().type))
-    {
-        Ast * mulExpr                           = NewAst(MUL_EXPR);
-        mulExpr->leftChild                      = left;
-        mulExpr->token                          = NEXT();
-        mulExpr->leftChild->rightSibling        = ParseCastExpr(ti);
-        return ParseMulExpr(ti, mulExpr);
+    ParseNode * left                            = ParseCastExpr(ti);
+    BinaryOperator op;
+    while (GetBinaryOperator(PEEK_TYPE(), op) && op.precedence >= minPrecedence)
+    {
+        ParseNode * binaryExpr                  = NewAst(op.type);
+        binaryExpr->leftChild                   = left;
+        if (op.keepToken)
+            binaryExpr->token                   = NEXT_INDEX();
+        else
+            NEXT();
+        binaryExpr->leftChild->rightSibling     = ParseBinaryExpr(ti, op.precedence + 1);
+        left                                    = binaryExpr;
     }
-    else
-        return left;
+    return left;
 }
-Ast * ParseCastExpr(TokenIterator & ti)
+ParseNode * ParseCastExpr(TokenIterator & ti)
 {
-    if (PEEK_T(Token::LPAREN) && (First(TYPE_SPECIFIER, PEEK2()) || First(TYPE_QUALIFIER, PEEK2())))
+    if (PEEK_T(Token::LPAREN) && (First(TYPE_SPECIFIER, PEEK2_TYPE()) || First(TYPE_QUALIFIER, PEEK2_TYPE())))
     {
-        Ast * castExpr                          = NewAst(CAST_EXPR);
+        ParseNode * castExpr                    = NewAst(CAST_EXPR);
         EXPECT_T(Token::LPAREN);
         castExpr->leftChild                     = ParseTypename(ti);
         EXPECT_T(Token::RPAREN);
@@ -1078,28 +1066,28 @@ Ast * ParseCastExpr(TokenIterator & ti)
         return ParseUnaryExpr(ti);
     }
 }
-Ast * ParseUnaryExpr(TokenIterator & ti)
+ParseNode * ParseUnaryExpr(TokenIterator & ti)
 {
     if (PEEK_T(Token::OP_INC) || PEEK_T(Token::OP_DEC))
     {
-        Ast * unaryExpr                         = NewAst(UNARY_EXPR);
-        unaryExpr->token                        = NEXT();
+        ParseNode * unaryExpr                   = NewAst(UNARY_EXPR);
+        unaryExpr->token                        = NEXT_INDEX();
         unaryExpr->leftChild                    = ParseUnaryExpr(ti);
         return unaryExpr;
     }
-    else if (IsUnaryOp(PEEK().type))
+    else if (IsUnaryOp(PEEK_TYPE()))
     {
-        Ast * unaryExpr                         = NewAst(UNARY_EXPR);
-        unaryExpr->token                        = NEXT();
+        ParseNode * unaryExpr                   = NewAst(UNARY_EXPR);
+        unaryExpr->token                        = NEXT_INDEX();
         unaryExpr->leftChild                    = ParseCastExpr(ti);
         return unaryExpr;
     }
     else if (PEEK_T(Token::KW_SIZEOF))
     {
-        Ast * unaryExpr                         = NewAst(UNARY_EXPR);
-        unaryExpr->token                        = NEXT();
+        ParseNode * unaryExpr                   = NewAst(UNARY_EXPR);
+        unaryExpr->token                        = NEXT_INDEX();
 
-        if (PEEK_T(Token::LPAREN) && (First(TYPE_SPECIFIER, PEEK2()) || First(TYPE_QUALIFIER, PEEK2())))
+        if (PEEK_T(Token::LPAREN) && (First(TYPE_SPECIFIER, PEEK2_TYPE()) || First(TYPE_QUALIFIER, PEEK2_TYPE())))
         {
             EXPECT_T(Token::LPAREN);
             unaryExpr->leftChild                = ParseTypename(ti);
@@ -1117,51 +1105,53 @@ Ast * ParseUnaryExpr(TokenIterator & ti)
         return ParsePostfixExpr(ti);
     }
 }
-Ast * ParsePostfixExpr(TokenIterator & ti, Ast * leftPostfixExpr /* = nullptr*/)
+ParseNode * ParsePostfixExpr(TokenIterator & ti)
 {
-    Ast * left                                  = leftPostfixExpr
-                                                  ? leftPostfixExpr
-                                                  : ParsePrimaryExpr(ti);
-    if (SKIP_T(Token::LSB))
-    {
-        Ast * postfixExpr                       = NewAst(POSTFIX_EXPR);
-        postfixExpr->leftChild                  = left;
-        postfixExpr->leftChild->rightSibling    = ParseExpression(ti);
-        EXPECT_T(Token::RSB);
-        return ParsePostfixExpr(ti, postfixExpr);
-    }
-    else if (SKIP_T(Token::LPAREN))
-    {
-        Ast * postfixExpr                       = NewAst(POSTFIX_EXPR);
-        postfixExpr->leftChild                  = left;
-        postfixExpr->leftChild->rightSibling    = !PEEK_T(Token::RPAREN)
+    ParseNode * left                            = ParsePrimaryExpr(ti);
+    for (;;)
+    {
+        ParseNode * postfixExpr;
+        if (SKIP_T(Token::LSB))
+        {
+            postfixExpr                         = NewAst(POSTFIX_EXPR);
+            postfixExpr->leftChild              = left;
+            postfixExpr->leftChild->rightSibling
+                                                = ParseExpression(ti);
+            EXPECT_T(Token::RSB);
+        }
+        else if (SKIP_T(Token::LPAREN))
+        {
+            postfixExpr                         = NewAst(POSTFIX_EXPR);
+            postfixExpr->leftChild              = left;
+            postfixExpr->leftChild->rightSibling
+                                                = !PEEK_T(Token::RPAREN)
                                                   ? ParseArgumentList(ti)
                                                   : NewAst(ARGUMENT_EXPR_LIST);
-        EXPECT_T(Token::RPAREN);
-        return ParsePostfixExpr(ti, postfixExpr);
-    }
-    else if (PEEK_T(Token::OP_DOT)|| PEEK_T(Token::OP_POINTTO))
-    {
-        Ast * postfixExpr                       = NewAst(POSTFIX_EXPR);
-        postfixExpr->leftChild                  = left;
-        postfixExpr->token                      = NEXT();
-        ASSERT(PEEK_T(Token::ID));
-        postfixExpr->leftChild->rightSibling    = NewAst(IDENTIFIER, NEXT());
-        return ParsePostfixExpr(ti, postfixExpr);
-    }
-    else if (PEEK_T(Token::OP_INC) || PEEK_T(Token::OP_DEC))
-    {
-        Ast * postfixExpr                       = NewAst(POSTFIX_EXPR);
-        postfixExpr->leftChild                  = left;
-        postfixExpr->token                      = NEXT();
-        return ParsePostfixExpr(ti, postfixExpr);
-    }
-    else
-    {
-        return left;
+            EXPECT_T(Token::RPAREN);
+        }
+        else if (PEEK_T(Token::OP_DOT)|| PEEK_T(Token::OP_POINTTO))
+        {
+            postfixExpr                         = NewAst(POSTFIX_EXPR);
+            postfixExpr->leftChild              = left;
+            postfixExpr->token                  = NEXT_INDEX();
+            ASSERT(PEEK_T(Token::ID));
+            postfixExpr->leftChild->rightSibling
+                                                = NewAst(IDENTIFIER, NEXT_INDEX());
+        }
+        else if (PEEK_T(Token::OP_INC) || PEEK_T(Token::OP_DEC))
+        {
+            postfixExpr                         = NewAst(POSTFIX_EXPR);
+            postfixExpr->leftChild              = left;
+            postfixExpr->token                  = NEXT_INDEX();
+        }
+        else
+        {
+            return left;
+        }
+        left                                    = postfixExpr;
     }
 }
-Ast * ParsePrimaryExpr(TokenIterator & ti)
+ParseNode * ParsePrimaryExpr(TokenIterator & ti)
 {
     if (PEEK_T(Token::ID) ||
         PEEK_T(Token::CONST_INT) ||
@@ -1169,20 +1159,20 @@ Ast * ParsePrimaryExpr(TokenIterator & ti)
         PEEK_T(Token::CONST_FLOAT) ||
         PEEK_T(Token::STRING))
     {
-        return NewAst(PRIMARY_EXPR, NEXT());
+        return NewAst(PRIMARY_EXPR, NEXT_INDEX());
     }
     else
     {
         EXPECT_T(Token::LPAREN);
-        Ast * expr                              = ParseExpression(ti);
+        ParseNode * expr                        = ParseExpression(ti);
         EXPECT_T(Token::RPAREN);
         return expr;
     }
 }
-Ast * ParseArgumentList(TokenIterator & ti)
+ParseNode * ParseArgumentList(TokenIterator & ti)
 {
-    Ast * argumentList                          = NewAst(ARGUMENT_EXPR_LIST);
-    Ast ** pNextArgument                        = &argumentList->leftChild;
+    ParseNode * argumentList                    = NewAst(ARGUMENT_EXPR_LIST);
+    ParseNode ** pNextArgument                  = &argumentList->leftChild;
 
     *pNextArgument                              = ParseAssignExpr(ti);
     pNextArgument                               = &(*pNextArgument)->rightSibling;
@@ -1195,9 +1185,9 @@ Ast * ParseArgumentList(TokenIterator & ti)
     return argumentList;
 }
 
-Ast * ParseConstantExpr(TokenIterator & ti)
+ParseNode * ParseConstantExpr(TokenIterator & ti)
 {
-    Ast * constExpr;
+    ParseNode * constExpr;
 
     ASSERT(PEEK_T(Token::CONST_INT));
     constExpr = ParsePrimaryExpr(ti);
@@ -1206,11 +1196,11 @@ Ast * ParseConstantExpr(TokenIterator & ti)
     return constExpr;
 }
 
-Ast * ParseParameterList(TokenIterator & ti)
+ParseNode * ParseParameterList(TokenIterator & ti)
 {
-    Ast * parameterList                         = NewAst(PARAMETER_LIST);
+    ParseNode * parameterList                   = NewAst(PARAMETER_LIST);
 
-    Ast * pNextParameterDeclaration             = NewAst(PARAMETER_DECLARATION);
+    ParseNode * pNextParameterDeclaration       = NewAst(PARAMETER_DECLARATION);
     pNextParameterDeclaration->leftChild        = ParseDeclarationSpecifiers(ti);
     pNextParameterDeclaration->leftChild->rightSibling
                                                 = ParseDeclarator(ti); // TODO: AbstractDeclarator
@@ -1226,7 +1216,7 @@ Ast * ParseParameterList(TokenIterator & ti)
         }
         else
         {
-            Ast * parameterDeclaration                  = NewAst(PARAMETER_DECLARATION);
+            ParseNode * parameterDeclaration            = NewAst(PARAMETER_DECLARATION);
             parameterDeclaration->leftChild             = ParseDeclarationSpecifiers(ti);
             parameterDeclaration->leftChild->rightSibling
                                                         = ParseDeclarator(ti); // TODO: AbstractDeclarator
@@ -1239,14 +1229,281 @@ Ast * ParseParameterList(TokenIterator & ti)
     return parameterList;
 }
 
-bool IsEqualAst(Ast * a1, Ast * a2)
+AstTree ParseTranslationUnit(TokenIterator & ti, bool lazyBodies)
+{
+    ParseNodeArena arena;
+
+    AstTree tree;
+    tree.tokens = &ti.tokens();
+    FlattenParseTree(ParseTranslationUnitNode(ti, tree.externals, lazyBodies ? &tree.lazyBodies : nullptr), tree);
+
+    // Externals are the children of the root, skipped bodies the last child
+    // of the function definitions, both in order.
+    size_t i = 0, k = 0;
+    for (Ast external = tree.Root().LeftChild(); external; external = external.RightSibling())
+    {
+        tree.externals[i++].node = external.Index();
+        if (lazyBodies && external.Type() == FUNCTION_DEFINITION)
+        {
+            Ast body = external.LeftChild().RightSibling().RightSibling();
+            ASSERT(body.Type() == COMPOUND_STMT && !body.LeftChild());
+            tree.lazyBodies[k++].node = body.Index();
+        }
+    }
+    ASSERT(i == tree.externals.size() && k == tree.lazyBodies.size());
+    return tree;
+}
+
+AstTree ParseExpressionTree(TokenIterator & ti)
+{
+    ParseNodeArena arena;
+
+    AstTree tree;
+    tree.tokens = &ti.tokens();
+    FlattenParseTree(ParseExpression(ti), tree);
+    return tree;
+}
+
+void AstBodyCache::Trim()
+{
+    for (auto it = bodies.begin(); it != bodies.end(); )
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+        {
+            it = bodies.erase(it);
+        }
+    }
+}
+
+void ParseFunctionBodies(AstTree & tree, size_t threadCount, AstBodyCache * cache)
+{
+    // Each body flattened on its own, then spliced in order. Cached ones
+    // only need their tokens moved to where the body is now.
+    std::vector<AstTree> bodies(tree.lazyBodies.size());
+    std::vector<UINT64> hashes(tree.lazyBodies.size());
+    std::vector<size_t> toParse;
+    for (size_t k = 0; k < bodies.size(); ++k)
+    {
+        const AstTokenRange & lazyBody = tree.lazyBodies[k];
+        if (cache)
+        {
+            hashes[k] = HashTokens(*tree.tokens, lazyBody.tokenBegin, lazyBody.tokenEnd);
+            auto cached = cache->bodies.find(hashes[k]);
+            if (cached != cache->bodies.end() &&
+                cached->second.tokens.size() == lazyBody.tokenEnd - lazyBody.tokenBegin &&
+                SameTokens(cached->second.tokens.data(), &(*tree.tokens)[lazyBody.tokenBegin], cached->second.tokens.size()))
+            {
+                cached->second.used = true;
+                bodies[k].nodes = cached->second.nodes;
+                for (AstNode & node : bodies[k].nodes)
+                    node.token = node.token != AST_NO_TOKEN ? node.token + lazyBody.tokenBegin : node.token;
+                ++cache->hits;
+                continue;
+            }
+        }
+        toParse.push_back(k);
+    }
+
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, toParse.size());
+
+    std::atomic<size_t> nextBody(0);
+    auto parseBodies = [&]()
+    {
+        for (size_t i; (i = nextBody++) < toParse.size(); )
+        {
+            const AstTokenRange & lazyBody = tree.lazyBodies[toParse[i]];
+            TokenIterator ti(*tree.tokens, lazyBody.tokenBegin, lazyBody.tokenEnd);
+
+            ParseNodeArena arena;
+            FlattenParseTree(ParseCompoundStatement(ti), bodies[toParse[i]]);
+            ASSERT(!ti.has());
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i)
+        workers.emplace_back(parseBodies);
+    parseBodies();
+    for (std::thread & worker : workers)
+        worker.join();
+
+    if (cache)
+    {
+        for (size_t k : toParse)
+        {
+            AstBodyCache::Body & body = cache->bodies[hashes[k]];
+            body.nodes = bodies[k].nodes;
+            for (AstNode & node : body.nodes)
+                node.token = node.token != AST_NO_TOKEN ? node.token - tree.lazyBodies[k].tokenBegin : node.token;
+            body.tokens.assign(tree.tokens->begin() + tree.lazyBodies[k].tokenBegin,
+                               tree.tokens->begin() + tree.lazyBodies[k].tokenEnd);
+            body.used = true;
+            ++cache->misses;
+        }
+    }
+
+    for (size_t k = 0; k < bodies.size(); ++k)
+    {
+        // Body root is the COMPOUND_STMT already in tree, append the rest.
+        const std::vector<AstNode> & nodes = bodies[k].nodes;
+        AstIndex offset = static_cast<AstIndex>(tree.nodes.size() - 2);
+        for (size_t i = 2; i < nodes.size(); ++i)
+        {
+            AstNode node = nodes[i];
+            node.leftChild = node.leftChild ? node.leftChild + offset : 0;
+            node.rightSibling = node.rightSibling ? node.rightSibling + offset : 0;
+            tree.nodes.push_back(node);
+        }
+        tree.nodes[tree.lazyBodies[k].node].leftChild = nodes[1].leftChild ? nodes[1].leftChild + offset : 0;
+    }
+    tree.lazyBodies.clear();
+}
+
+namespace {
+
+const UINT32 AST_IMAGE_MAGIC = 0x20545341; // "AST "
+const UINT32 AST_IMAGE_VERSION = 1;
+
+// Root:        node count, token count, external count, refs to the 3 arrays
+// Node:        leftChild, rightSibling, token, type
+// Token:       type, flags (hasLeadingSpace 1, atLineStart 2), cval, ref text, suffix, ival, fval
+// External:    node, tokenBegin, tokenEnd
+const size_t AST_IMAGE_ROOT_SIZE = 24;
+const size_t AST_IMAGE_NODE_SIZE = 16;
+const size_t AST_IMAGE_TOKEN_SIZE = 32;
+const size_t AST_IMAGE_EXTERNAL_SIZE = 12;
+
+}
+
+std::string SaveAst(const AstTree & tree)
+{
+    ASSERT(tree.lazyBodies.empty());
+
+    ImageWriter writer(AST_IMAGE_MAGIC, AST_IMAGE_VERSION);
+    const std::vector<Token> & tokens = *tree.tokens;
+
+    UINT32 root = writer.Allocate(AST_IMAGE_ROOT_SIZE);
+    writer.Put<UINT32>(root, static_cast<UINT32>(tree.nodes.size()));
+    writer.Put<UINT32>(root + 4, static_cast<UINT32>(tokens.size()));
+    writer.Put<UINT32>(root + 8, static_cast<UINT32>(tree.externals.size()));
+
+    UINT32 nodes = writer.Allocate(AST_IMAGE_NODE_SIZE * tree.nodes.size());
+    for (const AstNode & node : tree.nodes)
+    {
+        writer.Put<UINT32>(nodes, node.leftChild);
+        writer.Put<UINT32>(nodes + 4, node.rightSibling);
+        writer.Put<UINT32>(nodes + 8, node.token);
+        writer.Put<UINT32>(nodes + 12, node.type);
+        nodes += AST_IMAGE_NODE_SIZE;
+    }
+    writer.PutRef(root + 12, nodes - AST_IMAGE_NODE_SIZE * static_cast<UINT32>(tree.nodes.size()));
+
+    UINT32 firstToken = writer.Allocate(AST_IMAGE_TOKEN_SIZE * tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        const Token & token = tokens[i];
+        UINT32 at = firstToken + static_cast<UINT32>(AST_IMAGE_TOKEN_SIZE * i);
+        writer.Put<UINT32>(at, token.type);
+        writer.Put<UINT8>(at + 4, (token.hasLeadingSpace ? 1 : 0) | (token.atLineStart ? 2 : 0));
+        writer.Put<char>(at + 5, token.cval);
+        writer.PutRef(at + 8, writer.PutString(token.text));
+        writer.Put<int>(at + 12, token.suffix);
+        writer.Put<UINT64>(at + 16, token.ival);
+        writer.Put<double>(at + 24, token.fval);
+    }
+    writer.PutRef(root + 16, tokens.empty() ? 0 : firstToken);
+
+    UINT32 externals = writer.Allocate(AST_IMAGE_EXTERNAL_SIZE * tree.externals.size());
+    for (size_t i = 0; i < tree.externals.size(); ++i)
+    {
+        UINT32 at = externals + static_cast<UINT32>(AST_IMAGE_EXTERNAL_SIZE * i);
+        writer.Put<UINT32>(at, tree.externals[i].node);
+        writer.Put<UINT32>(at + 4, tree.externals[i].tokenBegin);
+        writer.Put<UINT32>(at + 8, tree.externals[i].tokenEnd);
+    }
+    writer.PutRef(root + 20, tree.externals.empty() ? 0 : externals);
+
+    return writer.Finish(root);
+}
+
+AstTree LoadAst(const char * image, size_t size, std::vector<Token> & tokens)
+{
+    ImageReader reader(image, size, AST_IMAGE_MAGIC, AST_IMAGE_VERSION);
+    UINT32 root = reader.Root();
+    UINT32 nodeCount = reader.Get<UINT32>(root);
+    UINT32 tokenCount = reader.Get<UINT32>(root + 4);
+    UINT32 externalCount = reader.Get<UINT32>(root + 8);
+
+    auto checkIndex = [](bool valid)
+    {
+        if (!valid)
+            throw std::invalid_argument("bad index in AST image");
+    };
+
+    AstTree tree;
+    tree.tokens = &tokens;
+
+    tree.nodes.resize(nodeCount);
+    UINT32 nodes = reader.GetRef(root + 12);
+    for (AstNode & node : tree.nodes)
+    {
+        node.leftChild = reader.Get<UINT32>(nodes);
+        node.rightSibling = reader.Get<UINT32>(nodes + 4);
+        node.token = reader.Get<UINT32>(nodes + 8);
+        UINT32 type = reader.Get<UINT32>(nodes + 12);
+        checkIndex(node.leftChild < nodeCount &&
+                   node.rightSibling < nodeCount &&
+                   (node.token < tokenCount || node.token == AST_NO_TOKEN) &&
+                   type <= RETURN_STMT);
+        node.type = static_cast<UINT8>(type);
+        nodes += AST_IMAGE_NODE_SIZE;
+    }
+
+    tokens.clear();
+    tokens.resize(tokenCount);
+    UINT32 firstToken = reader.GetRef(root + 16);
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        Token & token = tokens[i];
+        UINT32 at = firstToken + static_cast<UINT32>(AST_IMAGE_TOKEN_SIZE * i);
+        token.type = static_cast<Token::Type>(reader.Get<UINT32>(at));
+        UINT8 flags = reader.Get<UINT8>(at + 4);
+        token.hasLeadingSpace = (flags & 1) != 0;
+        token.atLineStart = (flags & 2) != 0;
+        token.cval = reader.Get<char>(at + 5);
+        token.text = reader.GetString(reader.GetRef(at + 8)).toString();
+        token.suffix = reader.Get<int>(at + 12);
+        token.ival = reader.Get<UINT64>(at + 16);
+        token.fval = reader.Get<double>(at + 24);
+    }
+
+    tree.externals.resize(externalCount);
+    UINT32 externals = reader.GetRef(root + 20);
+    for (size_t i = 0; i < tree.externals.size(); ++i)
+    {
+        UINT32 at = externals + static_cast<UINT32>(AST_IMAGE_EXTERNAL_SIZE * i);
+        tree.externals[i] = { reader.Get<UINT32>(at), reader.Get<UINT32>(at + 4), reader.Get<UINT32>(at + 8) };
+        checkIndex(tree.externals[i].node < nodeCount && tree.externals[i].tokenEnd <= tokenCount);
+    }
+
+    return tree;
+}
+
+bool IsEqualAst(Ast a1, Ast a2)
 {
     if (a1 && a2)
     {
         return
-            (a1->type == a2->type) &&
-            IsEqualAst(a1->leftChild, a2->leftChild) &&
-            IsEqualAst(a1->rightSibling, a2->rightSibling);
+            (a1.Type() == a2.Type()) &&
+            IsEqualAst(a1.LeftChild(), a2.LeftChild()) &&
+            IsEqualAst(a1.RightSibling(), a2.RightSibling());
     }
     else if (!a1 && !a2)
     {
@@ -1258,7 +1515,7 @@ bool IsEqualAst(Ast * a1, Ast * a2)
     }
 }
 
-void DebugPrintAstImpl(Ast * ast, size_t indent)
+void DebugPrintAstImpl(Ast ast, size_t indent)
 {
     const char * astTypeString[] = {
                                     "translation unit",
@@ -1339,20 +1596,260 @@ void DebugPrintAstImpl(Ast * ast, size_t indent)
     {
         for (size_t i = 0; i < indent; ++i)
             std::cout << ' ';
-        ASSERT((unsigned)ast->type < sizeof(astTypeString) / sizeof(void *));
-        std::cout << astTypeString[(unsigned)ast->type];
-        if (ast->type == IDENTIFIER)
+        ASSERT((unsigned)ast.Type() < sizeof(astTypeString) / sizeof(void *));
+        std::cout << astTypeString[(unsigned)ast.Type()];
+        if (ast.Type() == IDENTIFIER)
         {
-            std::cout << ' '<< ast->token.text;
+            std::cout << ' '<< ast.GetToken().text;
         }
         std::cout << std::endl;
 
-        for (Ast * child = ast->leftChild; child; child = child->rightSibling)
+        for (Ast child = ast.LeftChild(); child; child = child.RightSibling())
             DebugPrintAstImpl(child, indent + 2);
     }
 }
 
-void DebugPrintAst(Ast * ast)
+void DebugPrintAst(Ast ast)
 {
     DebugPrintAstImpl(ast, 0);
 }
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+// "(type child...)" with operator or primary text as type.
+static std::string ExprToString(Ast ast)
+{
+    if (ast.Type() == PRIMARY_EXPR || ast.Type() == IDENTIFIER)
+        return ast.GetToken().text;
+
+    std::string s = "(";
+    switch (ast.Type())
+    {
+        case OR_EXPR:       s += "||"; break;
+        case AND_EXPR:      s += "&&"; break;
+        case BIT_OR_EXPR:   s += "|"; break;
+        case BIT_XOR_EXPR:  s += "^"; break;
+        case BIT_AND_EXPR:  s += "&"; break;
+        case COMMA_EXPR:    s += ","; break;
+        case COND_EXPR:     s += "?"; break;
+        case ASSIGN_EXPR:
+        case EQ_EXPR:
+        case REL_EXPR:
+        case SHIFT_EXPR:
+        case ADD_EXPR:
+        case MUL_EXPR:
+        case UNARY_EXPR:    s += ast.GetToken().text; break;
+        case POSTFIX_EXPR:  s += ast.GetToken().text.empty() ? "postfix" : ast.GetToken().text; break;
+        default:            s += "?"; break;
+    }
+    for (Ast child = ast.LeftChild(); child; child = child.RightSibling())
+        s += " " + ExprToString(child);
+    return s + ")";
+}
+
+// Space separated tokens: keywords, ids, integers and some operators.
+static std::vector<Token> TokensFrom(const std::string & text)
+{
+    static const std::vector<std::pair<std::string, Token::Type>> ops = {
+        { "||", Token::BOOL_OR }, { "&&", Token::BOOL_AND }, { "|", Token::BIT_OR },
+        { "^", Token::BIT_XOR }, { "&", Token::BIT_AND }, { "==", Token::REL_EQ },
+        { "!=", Token::REL_NE }, { "<", Token::REL_LT }, { ">=", Token::REL_GE },
+        { "<<", Token::BIT_SHL }, { "+", Token::OP_ADD }, { "-", Token::OP_SUB },
+        { "*", Token::OP_MUL }, { "%", Token::OP_MOD }, { "=", Token::ASSIGN },
+        { "?", Token::OP_QMARK }, { ":", Token::OP_COLON }, { ",", Token::OP_COMMA },
+        { "(", Token::LPAREN }, { ")", Token::RPAREN }, { "!", Token::BOOL_NOT },
+        { "[", Token::LSB }, { "]", Token::RSB }, { "{", Token::BLK_BEGIN },
+        { "}", Token::BLK_END }, { ";", Token::STMT_END },
+    };
+
+    std::vector<Token> tokens;
+    size_t begin = 0;
+    while (begin < text.size())
+    {
+        size_t end = text.find(' ', begin);
+        end = end == std::string::npos ? text.size() : end;
+        std::string word = text.substr(begin, end - begin);
+        Token::Type type = isdigit(word[0]) ? Token::CONST_INT : ClassifyKeyword(word.data(), word.size());
+        for (auto & op : ops)
+            type = op.first == word ? op.second : type;
+        tokens.emplace_back(type, word);
+        begin = end + 1;
+    }
+    return tokens;
+}
+
+// Expression tokens, then ";".
+static Ast ParseExpressionFrom(const std::string & text)
+{
+    static std::vector<Token> tokens;
+    tokens = TokensFrom(text);
+    tokens.emplace_back(Token::STMT_END, ";");
+
+    static AstTree tree;
+    TokenIterator ti(tokens);
+    tree = ParseExpressionTree(ti);
+    return tree.Root();
+}
+
+TEST(AstParser_Expression)
+{
+    EXPECT_EQ(ExprToString(ParseExpressionFrom("a || b && c | d ^ e & f == g < h << i + j * k")),
+              "(|| a (&& b (| c (^ d (& e (== f (< g (<< h (+ i (* j k))))))))))");
+    EXPECT_EQ(ExprToString(ParseExpressionFrom("a * b + c << d >= e != f & g ^ h | i && j || k")),
+              "(|| (&& (| (^ (& (!= (>= (<< (+ (* a b) c) d) e) f) g) h) i) j) k)");
+    EXPECT_EQ(ExprToString(ParseExpressionFrom("a - b - c % d % e")), "(- (- a b) (% (% c d) e))");
+    EXPECT_EQ(ExprToString(ParseExpressionFrom("a = b = c ? d , e : f || g")),
+              "(= a (= b (? c (, d e) (|| f g))))");
+    EXPECT_EQ(ExprToString(ParseExpressionFrom("! ( a + b ) * c [ d ] , e , f")),
+              "(, (, (* (! (+ a b)) (postfix c d)) e) f)");
+
+    // Long chains loop instead of recursing per operand.
+    std::string chain = "x";
+    for (int i = 0; i < 200000; ++i)
+        chain += (i % 2) ? " + x" : " - x";
+    size_t depth = 0;
+    for (Ast ast = ParseExpressionFrom(chain); ast.Type() == ADD_EXPR; ast = ast.LeftChild())
+        ++depth;
+    EXPECT_EQ(depth, 200000u);
+}
+
+TEST(AstParser_CompactTree)
+{
+    EXPECT_EQ(sizeof(AstNode), 16u);
+
+    // Pre-order: parent, then its subtrees left to right.
+    Ast root = ParseExpressionFrom("a + b * c");
+    EXPECT_EQ(ExprToString(root), "(+ a (* b c))");
+    EXPECT_EQ(root.LeftChild().GetToken().text, "a");
+    EXPECT_EQ(root.LeftChild().RightSibling().Type(), MUL_EXPR);
+    EXPECT_TRUE(!root.RightSibling());
+    EXPECT_TRUE(IsEqualAst(root, ParseExpressionFrom("x - y % z")));
+}
+
+// "(type token child...)", compares tokens unlike IsEqualAst().
+static std::string TreeToString(Ast ast)
+{
+    std::string s = "(" + std::to_string(ast.Type()) + " " + ast.GetToken().text;
+    for (Ast child = ast.LeftChild(); child; child = child.RightSibling())
+        s += " " + TreeToString(child);
+    return s + ")";
+}
+
+TEST(AstParser_LazyBodies)
+{
+    std::vector<Token> tokens = TokensFrom(
+        "int g ; "
+        "int f ( int a ) { int b ; b = a * 2 ; return b + g ; } "
+        "struct S { int x ; } s ; "
+        "void h ( ) { } "
+        "int k ( int n ) { while ( n ) { if ( n < 3 ) { n = n - 1 ; } else n = 0 ; } return f ( n ) ; } "
+        "int main ( ) { return k ( f ( 1 ) , 2 ) ; }");
+
+    TokenIterator eagerTi(tokens);
+    AstTree eager = ParseTranslationUnit(eagerTi);
+    EXPECT_TRUE(eager.lazyBodies.empty());
+
+    for (size_t threadCount : { 1, 3 })
+    {
+        TokenIterator lazyTi(tokens);
+        AstTree lazy = ParseTranslationUnit(lazyTi, true);
+        EXPECT_EQ(lazy.lazyBodies.size(), 4u);
+        EXPECT_EQ(tokens[lazy.lazyBodies[1].tokenBegin].type, Token::BLK_BEGIN);
+        EXPECT_EQ(lazy.lazyBodies[1].tokenEnd, lazy.lazyBodies[1].tokenBegin + 2);
+
+        ParseFunctionBodies(lazy, threadCount);
+        EXPECT_TRUE(lazy.lazyBodies.empty());
+        EXPECT_EQ(lazy.nodes.size(), eager.nodes.size());
+        EXPECT_EQ(TreeToString(lazy.Root()), TreeToString(eager.Root()));
+    }
+}
+
+TEST(AstParser_Image)
+{
+    std::vector<Token> tokens = TokensFrom(
+        "struct S { int x ; } s ; "
+        "int f ( int a ) { while ( a ) { a = a - 1 ; } return a * 2 ; }");
+    tokens[3].ival = 42;
+    tokens[3].hasLeadingSpace = true;
+    TokenIterator ti(tokens);
+    AstTree tree = ParseTranslationUnit(ti);
+
+    std::string image = SaveAst(tree);
+    EXPECT_EQ(SaveAst(tree), image);
+
+    std::vector<Token> loadedTokens;
+    AstTree loaded = LoadAst(image.data(), image.size(), loadedTokens);
+    EXPECT_EQ(TreeToString(loaded.Root()), TreeToString(tree.Root()));
+    EXPECT_EQ(loaded.nodes.size(), tree.nodes.size());
+    EXPECT_EQ(loaded.externals.size(), 2u);
+    EXPECT_EQ(loaded.externals[1].tokenBegin, tree.externals[1].tokenBegin);
+    EXPECT_EQ(loadedTokens.size(), tokens.size());
+    EXPECT_EQ(loadedTokens[3].ival, 42u);
+    EXPECT_TRUE(loadedTokens[3].hasLeadingSpace);
+
+    // Left child of node 1, after header and root.
+    std::string bad = image;
+    bad.replace(16 + AST_IMAGE_ROOT_SIZE + AST_IMAGE_NODE_SIZE, 4, 4, '\xFF');
+    int errors = 0;
+    try { LoadAst(bad.data(), bad.size(), loadedTokens); } catch (const std::invalid_argument &) { ++errors; }
+    try { LoadAst(image.data(), image.size() / 2, loadedTokens); } catch (const std::invalid_argument &) { ++errors; }
+    EXPECT_EQ(errors, 2);
+}
+
+TEST(AstParser_BodyCache)
+{
+    const char * functions[] = {
+        "int f ( int a ) { int b ; b = a * 2 ; return b ; } ",
+        "void h ( ) { } ",
+        "int k ( int n ) { while ( n ) { n = n - 1 ; } return f ( n ) ; } ",
+        "int main ( ) { return k ( f ( 1 ) ) ; }",
+    };
+    std::string source = "int g ; ";
+    for (const char * function : functions)
+        source += function;
+    std::vector<Token> tokens = TokensFrom(source);
+
+    AstBodyCache cache;
+    {
+        TokenIterator ti(tokens);
+        AstTree tree = ParseTranslationUnit(ti, true);
+        EXPECT_EQ(tree.externals.size(), 5u);
+        EXPECT_EQ(tree.externals[1].tokenBegin, 3u);
+        EXPECT_EQ(tokens[tree.externals[1].tokenEnd - 1].type, Token::BLK_END);
+        ParseFunctionBodies(tree, 2, &cache);
+        EXPECT_EQ(cache.misses, 4u);
+        cache.Trim();
+    }
+
+    // Declaration added in front moves all tokens, one body edited.
+    std::string edited = "int g ; struct S { int x ; } s ; ";
+    for (const char * function : functions)
+        edited += function;
+    edited.replace(edited.find("a * 2"), 5, "a * 3 + g");
+    std::vector<Token> editedTokens = TokensFrom(edited);
+
+    TokenIterator eagerTi(editedTokens);
+    AstTree eager = ParseTranslationUnit(eagerTi);
+
+    TokenIterator ti(editedTokens);
+    AstTree tree = ParseTranslationUnit(ti, true);
+    ParseFunctionBodies(tree, 2, &cache);
+    EXPECT_EQ(cache.hits, 3u);
+    EXPECT_EQ(cache.misses, 5u);
+    EXPECT_EQ(TreeToString(tree.Root()), TreeToString(eager.Root()));
+
+    // Only the old body of f is dropped.
+    cache.Trim();
+    TokenIterator originalTi(tokens);
+    AstTree original = ParseTranslationUnit(originalTi, true);
+    ParseFunctionBodies(original, 1, &cache);
+    EXPECT_EQ(cache.hits, 6u);
+    EXPECT_EQ(cache.misses, 6u);
+}
+
+#endif
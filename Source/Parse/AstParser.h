@@ -1,5 +1,10 @@
 #pragma once
 
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Base/Integer.h"
 #include "../Preprocess/Lexer.h"
 
 enum AstType
@@ -79,19 +84,130 @@ enum AstType
     RETURN_STMT,
 };
 
-struct Ast
+// Compact tree: nodes in one array, linked by 32-bit indices, with tokens
+// as indices into the token buffer parsed from, which must outlive the tree.
+
+typedef UINT32 AstIndex;
+
+const UINT32 AST_NO_TOKEN = 0xFFFFFFFF;
+
+struct AstNode
+{
+    AstIndex    leftChild;      // 0: none
+    AstIndex    rightSibling;   // 0: none
+    UINT32      token;          // AST_NO_TOKEN: none
+    UINT8       type;           // AstType
+};
+
+// Node parsed from tokens [tokenBegin, tokenEnd).
+struct AstTokenRange
+{
+    AstIndex    node;
+    UINT32      tokenBegin;
+    UINT32      tokenEnd;
+};
+
+class AstTree;
+
+// Node handle, false if none.
+class Ast
 {
-    Ast *parent;
-    Ast *leftChild;
-    Ast *rightSibling;
+public:
+    Ast() : tree(nullptr), index(0) {}
+    Ast(const AstTree * tree, AstIndex index) : tree(tree), index(index) {}
+
+    explicit operator bool () const { return index != 0; }
+    bool operator == (const Ast & other) const { return tree == other.tree && index == other.index; }
+    bool operator != (const Ast & other) const { return !(*this == other); }
 
-    AstType type;
-    Token token;
+    AstType         Type() const;
+    Ast             LeftChild() const;
+    Ast             RightSibling() const;
+    const Token &   GetToken() const;   // empty token if none
+    AstIndex        Index() const { return index; }
+
+private:
+    const AstTree * tree;
+    AstIndex        index;
 };
 
+class AstTree
+{
+public:
+    AstTree() : tokens(nullptr) {}
+
+    Ast     Root() const { return Ast(this, nodes.size() > 1 ? 1 : 0); }
+
+    // nodes[0] is the none node, nodes in pre-order from 1, except that
+    // bodies parsed by ParseFunctionBodies() are appended after the rest.
+    std::vector<AstNode>        nodes;
+    const std::vector<Token> *  tokens;
+    // Of a translation unit: its declarations and function definitions.
+    std::vector<AstTokenRange>  externals;
+    // Function bodies ParseTranslationUnit() only matched braces of, each
+    // a COMPOUND_STMT without children until parsed. In source order.
+    std::vector<AstTokenRange>  lazyBodies;
+};
+
+// Parsed function bodies by hash of their tokens, to reuse across parses
+// of edited sources. A hash hit is confirmed by comparing the tokens.
+class AstBodyCache
+{
+public:
+    AstBodyCache() : hits(0), misses(0) {}
+
+    // Drop bodies not used since the last call.
+    void    Trim();
+
+    size_t  hits;
+    size_t  misses;
+
+private:
+    friend void ParseFunctionBodies(AstTree & tree, size_t threadCount, AstBodyCache * cache);
+
+    struct Body
+    {
+        std::vector<AstNode>    nodes;  // tokens relative to the "{"
+        std::vector<Token>      tokens;
+        bool                    used;
+    };
+    std::map<UINT64, Body>      bodies;
+};
+
+inline AstType Ast::Type() const
+{
+    return static_cast<AstType>(tree->nodes[index].type);
+}
+inline Ast Ast::LeftChild() const
+{
+    return Ast(tree, tree->nodes[index].leftChild);
+}
+inline Ast Ast::RightSibling() const
+{
+    return Ast(tree, tree->nodes[index].rightSibling);
+}
+inline const Token & Ast::GetToken() const
+{
+    static const Token noToken;
+    UINT32 token = tree->nodes[index].token;
+    return token != AST_NO_TOKEN ? (*tree->tokens)[token] : noToken;
+}
+
 // Build
 
-Ast *   ParseTranslationUnit(TokenIterator & ti);
+// lazyBodies: only match braces of function bodies, see AstTree::lazyBodies.
+AstTree ParseTranslationUnit(TokenIterator & ti, bool lazyBodies = false);
+// Parse lazy bodies on threadCount workers (0: one per core), those with
+// the same tokens as a body in cache are copied from there instead.
+void    ParseFunctionBodies(AstTree & tree, size_t threadCount = 0, AstBodyCache * cache = nullptr);
+// Expression up to the first token that can't continue it.
+AstTree ParseExpressionTree(TokenIterator & ti);
+
+// Binary image of a parsed tree and its tokens, see BinaryImage.h. Nodes
+// are index-linked already, loading copies them as they are.
+std::string SaveAst(const AstTree & tree);
+// tokens: filled with the saved tokens, the tree refers to them.
+AstTree     LoadAst(const char * image, size_t size, std::vector<Token> & tokens);
 
 bool    IsAstTypeSpecifier(AstType type);
 bool    IsAstTypeQualifier(AstType type);
@@ -99,5 +215,5 @@ bool    IsAstTypeQualifier(AstType type);
 // Debug
 
 // TODO: compare token
-bool    IsEqualAst(Ast * a1, Ast * a2);
-void    DebugPrintAst(Ast * ast);
+bool    IsEqualAst(Ast a1, Ast a2);
+void    DebugPrintAst(Ast ast);
@@ -0,0 +1,1072 @@
+#include "LL1Parser.h"
+
+#include <bitset>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../Base/common.h"
+#include "../Base/File.h"
+
+// ==== Grammar ====
+
+// EBNF loops of the hand-written parser written as right recursive tail
+// nonterminals, so a left associative node is built before the tail.
+enum Nonterminal
+{
+    // translation unit and declarations
+    NT_TRANSLATION_UNIT,
+    NT_EXTERNALS,
+    NT_EXTERNAL,
+    NT_EXTERNAL_REST,           // after declaration specifiers
+    NT_EXTERNAL_DECLARATOR,     // after the first declarator: body or declaration
+    NT_DECLARATION,
+    NT_INIT_DECLARATORS,
+    NT_INIT_DECLARATOR_TAIL,
+    NT_DECLARATOR_INITIALIZER,
+    NT_DECLARATION_SPECIFIERS,
+    NT_DECLARATION_SPECIFIER,
+    NT_DECLARATION_SPECIFIER_TAIL,
+    NT_TYPE_SPECIFIER,
+    NT_STRUCT_BODY,             // after struct/union: tag, members or both
+    NT_STRUCT_MEMBERS_OPT,
+    NT_STRUCT_MEMBERS,
+    NT_STRUCT_DECLARATION,
+    NT_STRUCT_DECLARATION_TAIL,
+    NT_STRUCT_DECLARATOR,
+    NT_STRUCT_DECLARATOR_TAIL,
+    NT_ENUM_BODY,               // after enum: tag, enumerators or both
+    NT_ENUMERATORS_OPT,
+    NT_ENUMERATORS,
+    NT_ENUMERATOR,
+    NT_ENUMERATOR_TAIL,
+    NT_ENUMERATOR_VALUE,
+    NT_CONSTANT_EXPR,
+    NT_DECLARATOR,
+    NT_POINTER_LIST_OPT,
+    NT_POINTER_LIST,
+    NT_POINTER,
+    NT_POINTER_QUALIFIER,
+    NT_POINTER_TAIL,
+    NT_DIRECT_DECLARATOR,
+    NT_DECLARATOR_SUFFIX,
+    NT_ARRAY_SIZE,
+    NT_PARAMETERS,
+    NT_PARAMETER,
+    NT_PARAMETER_TAIL,
+    NT_PARAMETER_AFTER_COMMA,
+    // statements
+    NT_COMPOUND_STMT,
+    NT_BLOCK_DECLARATIONS,
+    NT_BLOCK_STMTS,
+    NT_STMT,
+    NT_ELSE_OPT,
+    NT_FOR_EXPR,
+    NT_EXPR_OPT,
+    // expressions
+    NT_EXPR,
+    NT_COMMA_TAIL,
+    NT_ASSIGN,
+    NT_ASSIGN_TAIL,
+    NT_COND,
+    NT_COND_TAIL,
+    NT_OR,
+    NT_OR_TAIL,
+    NT_AND,
+    NT_AND_TAIL,
+    NT_BIT_OR,
+    NT_BIT_OR_TAIL,
+    NT_BIT_XOR,
+    NT_BIT_XOR_TAIL,
+    NT_BIT_AND,
+    NT_BIT_AND_TAIL,
+    NT_EQ,
+    NT_EQ_TAIL,
+    NT_REL,
+    NT_REL_TAIL,
+    NT_SHIFT,
+    NT_SHIFT_TAIL,
+    NT_ADD,
+    NT_ADD_TAIL,
+    NT_MUL,
+    NT_MUL_TAIL,
+    NT_CAST,
+    NT_PAREN_CAST,              // after '(': cast or parenthesized expr
+    NT_UNARY,
+    NT_UNARY_NO_PAREN,
+    NT_SIZEOF_OPERAND,
+    NT_PAREN_SIZEOF,            // after sizeof '(': type name or parenthesized expr
+    NT_POSTFIX_TAIL,
+    NT_ARGUMENTS,
+    NT_ARGUMENTS_TAIL,
+    NT_TYPE_NAME,
+    NT_SPECIFIER_QUALIFIER,
+    NT_SPECIFIER_QUALIFIER_TAIL,
+    NT_ABSTRACT_DECLARATOR_OPT,
+    NT_ABSTRACT_DECLARATOR,
+    NT_ABSTRACT_BODY,
+    NT_ABSTRACT_DIRECT_OPT,
+    NT_ABSTRACT_DIRECT,
+    NT_ABSTRACT_PAREN,          // after '(': nested declarator or parameters
+    NT_ABSTRACT_SUFFIX,
+    NT_COUNT,
+};
+
+const size_t TOKEN_TYPE_COUNT = Token::END + 1;
+typedef std::bitset<TOKEN_TYPE_COUNT> TokenSet;
+
+// LL1Symbol::kind. Actions match nothing, they build nodes.
+enum LL1SymbolKind
+{
+    LL1_TERMINAL,       // value: Token::Type, keepToken: push token
+    LL1_NONTERMINAL,    // value: Nonterminal
+    LL1_MARK,           // remember node stack size
+    LL1_NODE,           // value: AstType, keepToken: pop token into node, childCount: nodes to pop
+    LL1_EXTERNAL,       // an external declaration starts here
+};
+
+LL1Symbol T(Token::Type type)           { return { LL1_TERMINAL, false, 0, type }; }
+LL1Symbol K(Token::Type type)           { return { LL1_TERMINAL, true, 0, type }; }
+LL1Symbol N(Nonterminal nonterminal)    { return { LL1_NONTERMINAL, false, 0, nonterminal }; }
+LL1Symbol Mark()                        { return { LL1_MARK, false, 0, 0 }; }
+LL1Symbol External()                    { return { LL1_EXTERNAL, false, 0, 0 }; }
+LL1Symbol Node(AstType type, int childCount, bool keepToken = false)
+                                        { return { LL1_NODE, keepToken, static_cast<INT16>(childCount), type }; }
+LL1Symbol List(AstType type)            { return Node(type, -1); }
+LL1Symbol Leaf(AstType type)            { return Node(type, 0, true); }
+
+// Productions back to back in symbols, production i is
+// [productionBegin[i], productionBegin[i + 1]).
+struct LL1Grammar
+{
+    std::vector<LL1Symbol>  symbols;
+    std::vector<UINT32>     productionBegin = { 0 };
+    std::vector<int>        left;
+
+    size_t  ProductionCount() const { return left.size(); }
+    void    Add(Nonterminal nonterminal, std::initializer_list<LL1Symbol> right)
+    {
+        symbols.insert(symbols.end(), right);
+        productionBegin.push_back(static_cast<UINT32>(symbols.size()));
+        left.push_back(nonterminal);
+    }
+};
+
+const Token::Type kStorageClassSpecifiers[] = {
+    Token::KW_TYPEDEF, Token::KW_EXTERN, Token::KW_STATIC, Token::KW_AUTO, Token::KW_REGISTER,
+};
+const Token::Type kTypeSpecifiers[] = {
+    Token::KW_VOID, Token::KW_CHAR, Token::KW_SHORT, Token::KW_INT, Token::KW_LONG,
+    Token::KW_FLOAT, Token::KW_DOUBLE, Token::KW_SIGNED, Token::KW_UNSIGNED,
+};
+const Token::Type kTypeQualifiers[] = {
+    Token::KW_CONST, Token::KW_VOLATILE,
+};
+
+// Declarations, external declarations and function definitions. Typedef
+// names and initializers are not supported, as in the hand-written parser.
+void AddDeclarationGrammar(LL1Grammar & g)
+{
+    // translation_unit := external*
+    g.Add(NT_TRANSLATION_UNIT,          { Mark(), N(NT_EXTERNALS), List(TRANSLATION_UNIT) });
+    g.Add(NT_EXTERNALS,                 { N(NT_EXTERNAL), N(NT_EXTERNALS) });
+    g.Add(NT_EXTERNALS,                 {});
+
+    // external := specifiers (';' | declarator (compound_stmt | (',' declarator_initializer)* ';'))
+    // Declaration and function definition share the prefix up to the first
+    // declarator, so left factored it takes one token after it.
+    g.Add(NT_EXTERNAL,                  { External(), Mark(), N(NT_DECLARATION_SPECIFIERS), N(NT_EXTERNAL_REST) });
+    g.Add(NT_EXTERNAL_REST,             { T(Token::STMT_END), List(DECLARATION) });
+    g.Add(NT_EXTERNAL_REST,             { N(NT_DECLARATOR), N(NT_EXTERNAL_DECLARATOR) });
+    g.Add(NT_EXTERNAL_DECLARATOR,       { N(NT_COMPOUND_STMT), List(FUNCTION_DEFINITION) });
+    g.Add(NT_EXTERNAL_DECLARATOR,       { Node(DECLARATOR_INITIALIZER, 1), N(NT_INIT_DECLARATOR_TAIL),
+                                          T(Token::STMT_END), List(DECLARATION) });
+
+    // declaration := specifiers (declarator_initializer (',' declarator_initializer)*)? ';'
+    g.Add(NT_DECLARATION,               { Mark(), N(NT_DECLARATION_SPECIFIERS), N(NT_INIT_DECLARATORS),
+                                          T(Token::STMT_END), List(DECLARATION) });
+    g.Add(NT_INIT_DECLARATORS,          { N(NT_DECLARATOR_INITIALIZER), N(NT_INIT_DECLARATOR_TAIL) });
+    g.Add(NT_INIT_DECLARATORS,          {});
+    g.Add(NT_INIT_DECLARATOR_TAIL,      { T(Token::OP_COMMA), N(NT_DECLARATOR_INITIALIZER), N(NT_INIT_DECLARATOR_TAIL) });
+    g.Add(NT_INIT_DECLARATOR_TAIL,      {});
+    g.Add(NT_DECLARATOR_INITIALIZER,    { N(NT_DECLARATOR), Node(DECLARATOR_INITIALIZER, 1) });
+
+    // specifiers := (storage_class | type_specifier | qualifier)+
+    g.Add(NT_DECLARATION_SPECIFIERS,    { Mark(), N(NT_DECLARATION_SPECIFIER), N(NT_DECLARATION_SPECIFIER_TAIL),
+                                          List(DECLARATION_SPECIFIERS) });
+    for (Token::Type storage : kStorageClassSpecifiers)
+        g.Add(NT_DECLARATION_SPECIFIER, { K(storage), Leaf(STORAGE_CLASS_SPECIFIER) });
+    g.Add(NT_DECLARATION_SPECIFIER,     { N(NT_SPECIFIER_QUALIFIER) });
+    g.Add(NT_DECLARATION_SPECIFIER_TAIL, { N(NT_DECLARATION_SPECIFIER), N(NT_DECLARATION_SPECIFIER_TAIL) });
+    g.Add(NT_DECLARATION_SPECIFIER_TAIL, {});
+
+    // type_specifier := basic | (struct|union) (id | id? '{' struct_declaration+ '}') | enum ...
+    for (Token::Type specifier : kTypeSpecifiers)
+        g.Add(NT_TYPE_SPECIFIER,        { K(specifier), Leaf(TYPE_SPECIFIER) });
+    g.Add(NT_TYPE_SPECIFIER,            { T(Token::KW_STRUCT), Mark(), N(NT_STRUCT_BODY), List(STRUCT_SPECIFIER) });
+    g.Add(NT_TYPE_SPECIFIER,            { T(Token::KW_UNION), Mark(), N(NT_STRUCT_BODY), List(UNION_SPECIFIER) });
+    g.Add(NT_TYPE_SPECIFIER,            { T(Token::KW_ENUM), Mark(), N(NT_ENUM_BODY), List(ENUM_SPECIFIER) });
+
+    g.Add(NT_STRUCT_BODY,               { K(Token::ID), Leaf(IDENTIFIER), N(NT_STRUCT_MEMBERS_OPT) });
+    g.Add(NT_STRUCT_BODY,               { N(NT_STRUCT_MEMBERS) });
+    g.Add(NT_STRUCT_MEMBERS_OPT,        { N(NT_STRUCT_MEMBERS) });
+    g.Add(NT_STRUCT_MEMBERS_OPT,        {});
+    g.Add(NT_STRUCT_MEMBERS,            { T(Token::BLK_BEGIN), N(NT_STRUCT_DECLARATION), N(NT_STRUCT_DECLARATION_TAIL),
+                                          T(Token::BLK_END) });
+    g.Add(NT_STRUCT_DECLARATION,        { Mark(), N(NT_SPECIFIER_QUALIFIER), N(NT_SPECIFIER_QUALIFIER_TAIL),
+                                          N(NT_STRUCT_DECLARATOR), N(NT_STRUCT_DECLARATOR_TAIL),
+                                          T(Token::STMT_END), List(STRUCT_DECLARATION) });
+    g.Add(NT_STRUCT_DECLARATION_TAIL,   { N(NT_STRUCT_DECLARATION), N(NT_STRUCT_DECLARATION_TAIL) });
+    g.Add(NT_STRUCT_DECLARATION_TAIL,   {});
+    g.Add(NT_STRUCT_DECLARATOR,         { N(NT_DECLARATOR), Node(STRUCT_DECLARATOR, 1) });
+    g.Add(NT_STRUCT_DECLARATOR_TAIL,    { T(Token::OP_COMMA), N(NT_STRUCT_DECLARATOR), N(NT_STRUCT_DECLARATOR_TAIL) });
+    g.Add(NT_STRUCT_DECLARATOR_TAIL,    {});
+
+    // enum_body := id | id? '{' id ('=' constant)? (',' id ('=' constant)?)* '}'
+    g.Add(NT_ENUM_BODY,                 { K(Token::ID), Leaf(IDENTIFIER), N(NT_ENUMERATORS_OPT) });
+    g.Add(NT_ENUM_BODY,                 { N(NT_ENUMERATORS) });
+    g.Add(NT_ENUMERATORS_OPT,           { N(NT_ENUMERATORS) });
+    g.Add(NT_ENUMERATORS_OPT,           {});
+    g.Add(NT_ENUMERATORS,               { T(Token::BLK_BEGIN), N(NT_ENUMERATOR), N(NT_ENUMERATOR_TAIL), T(Token::BLK_END) });
+    g.Add(NT_ENUMERATOR,                { K(Token::ID), Mark(), N(NT_ENUMERATOR_VALUE), Node(ENUM_CONSTANT, -1, true) });
+    g.Add(NT_ENUMERATOR_TAIL,           { T(Token::OP_COMMA), N(NT_ENUMERATOR), N(NT_ENUMERATOR_TAIL) });
+    g.Add(NT_ENUMERATOR_TAIL,           {});
+    g.Add(NT_ENUMERATOR_VALUE,          { T(Token::ASSIGN), N(NT_CONSTANT_EXPR) });
+    g.Add(NT_ENUMERATOR_VALUE,          {});
+
+    // Integer constants only, see ParseConstantExpr().
+    g.Add(NT_CONSTANT_EXPR,             { K(Token::CONST_INT), Leaf(PRIMARY_EXPR) });
+
+    // declarator := pointer_list? ('(' declarator ')' | id) ('[' constant? ']' | '(' parameters? ')')*
+    g.Add(NT_DECLARATOR,                { Mark(), N(NT_POINTER_LIST_OPT), N(NT_DIRECT_DECLARATOR),
+                                          N(NT_DECLARATOR_SUFFIX), List(DECLARATOR) });
+    g.Add(NT_POINTER_LIST_OPT,          { N(NT_POINTER_LIST) });
+    g.Add(NT_POINTER_LIST_OPT,          {});
+    g.Add(NT_POINTER_LIST,              { Mark(), N(NT_POINTER), N(NT_POINTER_TAIL), List(POINTER_LIST) });
+    g.Add(NT_POINTER,                   { T(Token::OP_MUL), Mark(), N(NT_POINTER_QUALIFIER), List(POINTER) });
+    for (Token::Type qualifier : kTypeQualifiers)
+        g.Add(NT_POINTER_QUALIFIER,     { K(qualifier), Leaf(TYPE_QUALIFIER) });
+    g.Add(NT_POINTER_QUALIFIER,         {});
+    g.Add(NT_POINTER_TAIL,              { N(NT_POINTER), N(NT_POINTER_TAIL) });
+    g.Add(NT_POINTER_TAIL,              {});
+    g.Add(NT_DIRECT_DECLARATOR,         { T(Token::LPAREN), N(NT_DECLARATOR), T(Token::RPAREN) });
+    g.Add(NT_DIRECT_DECLARATOR,         { K(Token::ID), Leaf(IDENTIFIER) });
+    g.Add(NT_DECLARATOR_SUFFIX,         { T(Token::LSB), N(NT_ARRAY_SIZE), T(Token::RSB), N(NT_DECLARATOR_SUFFIX) });
+    g.Add(NT_DECLARATOR_SUFFIX,         { T(Token::LPAREN), N(NT_PARAMETERS), T(Token::RPAREN), N(NT_DECLARATOR_SUFFIX) });
+    g.Add(NT_DECLARATOR_SUFFIX,         {});
+    g.Add(NT_ARRAY_SIZE,                { N(NT_CONSTANT_EXPR) });
+    g.Add(NT_ARRAY_SIZE,                { Node(CONSTANT_EXPR, 0) });
+
+    // parameters := parameter (',' parameter)* (',' '...')?, parameter := specifiers declarator
+    g.Add(NT_PARAMETERS,                { Mark(), N(NT_PARAMETER), N(NT_PARAMETER_TAIL), List(PARAMETER_LIST) });
+    g.Add(NT_PARAMETERS,                { Node(PARAMETER_LIST, 0) });
+    g.Add(NT_PARAMETER,                 { N(NT_DECLARATION_SPECIFIERS), N(NT_DECLARATOR), Node(PARAMETER_DECLARATION, 2) });
+    g.Add(NT_PARAMETER_TAIL,            { T(Token::OP_COMMA), N(NT_PARAMETER_AFTER_COMMA) });
+    g.Add(NT_PARAMETER_TAIL,            {});
+    g.Add(NT_PARAMETER_AFTER_COMMA,     { T(Token::VAR_PARAM), Node(PARAMETER_VAR_LIST, 0) });
+    g.Add(NT_PARAMETER_AFTER_COMMA,     { N(NT_PARAMETER), N(NT_PARAMETER_TAIL) });
+}
+
+// Statements. Labels and goto are not supported, as in the hand-written
+// parser, so an id always starts an expression.
+void AddStatementGrammar(LL1Grammar & g)
+{
+    // compound_stmt := '{' declaration* stmt* '}'
+    g.Add(NT_COMPOUND_STMT,             { T(Token::BLK_BEGIN), Mark(), N(NT_BLOCK_DECLARATIONS), N(NT_BLOCK_STMTS),
+                                          T(Token::BLK_END), List(COMPOUND_STMT) });
+    g.Add(NT_BLOCK_DECLARATIONS,        { N(NT_DECLARATION), N(NT_BLOCK_DECLARATIONS) });
+    g.Add(NT_BLOCK_DECLARATIONS,        {});
+    g.Add(NT_BLOCK_STMTS,               { N(NT_STMT), N(NT_BLOCK_STMTS) });
+    g.Add(NT_BLOCK_STMTS,               {});
+
+    g.Add(NT_STMT,                      { N(NT_COMPOUND_STMT) });
+    g.Add(NT_STMT,                      { T(Token::KW_CASE), N(NT_CONSTANT_EXPR), T(Token::OP_COLON), N(NT_STMT),
+                                          Node(CASE_STMT, 2) });
+    g.Add(NT_STMT,                      { T(Token::KW_DEFAULT), T(Token::OP_COLON), N(NT_STMT), Node(DEFAULT_STMT, 1) });
+    g.Add(NT_STMT,                      { N(NT_EXPR), T(Token::STMT_END), Node(EXPRESSION_STMT, 1) });
+    g.Add(NT_STMT,                      { T(Token::STMT_END), Node(EXPRESSION_STMT, 0) });
+
+    // Greedy else, bound to the nearest if.
+    g.Add(NT_STMT,                      { T(Token::KW_IF), T(Token::LPAREN), Mark(), N(NT_EXPR), T(Token::RPAREN),
+                                          N(NT_STMT), N(NT_ELSE_OPT), List(IF_ELSE_STMT) });
+    g.Add(NT_ELSE_OPT,                  { T(Token::KW_ELSE), N(NT_STMT) });
+    g.Add(NT_ELSE_OPT,                  {});
+    g.Add(NT_STMT,                      { T(Token::KW_SWITCH), T(Token::LPAREN), N(NT_EXPR), T(Token::RPAREN),
+                                          N(NT_STMT), Node(SWITCH_STMT, 2) });
+
+    g.Add(NT_STMT,                      { T(Token::KW_WHILE), T(Token::LPAREN), N(NT_EXPR), T(Token::RPAREN),
+                                          N(NT_STMT), Node(WHILE_STMT, 2) });
+    g.Add(NT_STMT,                      { T(Token::KW_DO), N(NT_STMT), T(Token::KW_WHILE), T(Token::LPAREN), N(NT_EXPR),
+                                          T(Token::RPAREN), T(Token::STMT_END), Node(DO_WHILE_STMT, 2) });
+    // An omitted for expression is a childless EXPR.
+    g.Add(NT_STMT,                      { T(Token::KW_FOR), T(Token::LPAREN), N(NT_FOR_EXPR), T(Token::STMT_END),
+                                          N(NT_FOR_EXPR), T(Token::STMT_END), N(NT_FOR_EXPR), T(Token::RPAREN),
+                                          N(NT_STMT), Node(FOR_STMT, 4) });
+    g.Add(NT_FOR_EXPR,                  { N(NT_EXPR) });
+    g.Add(NT_FOR_EXPR,                  { Node(EXPR, 0) });
+
+    g.Add(NT_STMT,                      { T(Token::KW_CONTINUE), T(Token::STMT_END), Node(CONTINUE_STMT, 0) });
+    g.Add(NT_STMT,                      { T(Token::KW_BREAK), T(Token::STMT_END), Node(BREAK_STMT, 0) });
+    g.Add(NT_STMT,                      { T(Token::KW_RETURN), Mark(), N(NT_EXPR_OPT), T(Token::STMT_END),
+                                          List(RETURN_STMT) });
+    g.Add(NT_EXPR_OPT,                  { N(NT_EXPR) });
+    g.Add(NT_EXPR_OPT,                  {});
+}
+
+void AddExpressionGrammar(LL1Grammar & g)
+{
+    // expr := assign (',' assign)*
+    g.Add(NT_EXPR,              { N(NT_ASSIGN), N(NT_COMMA_TAIL) });
+    g.Add(NT_COMMA_TAIL,        { T(Token::OP_COMMA), N(NT_ASSIGN), Node(COMMA_EXPR, 2), N(NT_COMMA_TAIL) });
+    g.Add(NT_COMMA_TAIL,        {});
+
+    // assign := cond (assign_op assign)?
+    g.Add(NT_ASSIGN,            { N(NT_COND), N(NT_ASSIGN_TAIL) });
+    for (int type = Token::ASSIGN; type <= Token::XOR_ASSIGN; ++type)
+        g.Add(NT_ASSIGN_TAIL,   { K(static_cast<Token::Type>(type)), N(NT_ASSIGN), Node(ASSIGN_EXPR, 2, true) });
+    g.Add(NT_ASSIGN_TAIL,       {});
+
+    // cond := or ('?' expr ':' cond)?
+    g.Add(NT_COND,              { N(NT_OR), N(NT_COND_TAIL) });
+    g.Add(NT_COND_TAIL,         { T(Token::OP_QMARK), N(NT_EXPR), T(Token::OP_COLON), N(NT_COND), Node(COND_EXPR, 3) });
+    g.Add(NT_COND_TAIL,         {});
+
+    // level := operand (op operand)*, loosest first
+    struct BinaryLevel
+    {
+        Nonterminal                 level;
+        Nonterminal                 operand;
+        AstType                     type;
+        bool                        keepToken;
+        std::vector<Token::Type>    ops;
+    };
+    const BinaryLevel levels[] = {
+        { NT_OR,        NT_AND,     OR_EXPR,        false,  { Token::BOOL_OR } },
+        { NT_AND,       NT_BIT_OR,  AND_EXPR,       false,  { Token::BOOL_AND } },
+        { NT_BIT_OR,    NT_BIT_XOR, BIT_OR_EXPR,    false,  { Token::BIT_OR } },
+        { NT_BIT_XOR,   NT_BIT_AND, BIT_XOR_EXPR,   false,  { Token::BIT_XOR } },
+        { NT_BIT_AND,   NT_EQ,      BIT_AND_EXPR,   false,  { Token::BIT_AND } },
+        { NT_EQ,        NT_REL,     EQ_EXPR,        true,   { Token::REL_EQ, Token::REL_NE } },
+        { NT_REL,       NT_SHIFT,   REL_EXPR,       true,   { Token::REL_LT, Token::REL_LE, Token::REL_GT, Token::REL_GE } },
+        { NT_SHIFT,     NT_ADD,     SHIFT_EXPR,     true,   { Token::BIT_SHL, Token::BIT_SHR } },
+        { NT_ADD,       NT_MUL,     ADD_EXPR,       true,   { Token::OP_ADD, Token::OP_SUB } },
+        { NT_MUL,       NT_CAST,    MUL_EXPR,       true,   { Token::OP_MUL, Token::OP_DIV, Token::OP_MOD } },
+    };
+    for (const BinaryLevel & l : levels)
+    {
+        Nonterminal tail = static_cast<Nonterminal>(l.level + 1);
+        g.Add(l.level, { N(l.operand), N(tail) });
+        for (Token::Type op : l.ops)
+            g.Add(tail, { l.keepToken ? K(op) : T(op), N(l.operand), Node(l.type, 2, l.keepToken), N(tail) });
+        g.Add(tail, {});
+    }
+
+    // cast := '(' type_name ')' cast | unary
+    g.Add(NT_CAST,              { T(Token::LPAREN), N(NT_PAREN_CAST) });
+    g.Add(NT_CAST,              { N(NT_UNARY_NO_PAREN) });
+    g.Add(NT_PAREN_CAST,        { N(NT_TYPE_NAME), T(Token::RPAREN), N(NT_CAST), Node(CAST_EXPR, 2) });
+    g.Add(NT_PAREN_CAST,        { N(NT_EXPR), T(Token::RPAREN), N(NT_POSTFIX_TAIL) });
+
+    // unary := ('++'|'--') unary | unary_op cast | sizeof (unary | '(' type_name ')') | postfix
+    g.Add(NT_UNARY,             { T(Token::LPAREN), N(NT_EXPR), T(Token::RPAREN), N(NT_POSTFIX_TAIL) });
+    g.Add(NT_UNARY,             { N(NT_UNARY_NO_PAREN) });
+    for (Token::Type op : { Token::OP_INC, Token::OP_DEC })
+        g.Add(NT_UNARY_NO_PAREN, { K(op), N(NT_UNARY), Node(UNARY_EXPR, 1, true) });
+    for (Token::Type op : { Token::BIT_AND, Token::OP_MUL, Token::OP_ADD, Token::OP_SUB, Token::BIT_NOT, Token::BOOL_NOT })
+        g.Add(NT_UNARY_NO_PAREN, { K(op), N(NT_CAST), Node(UNARY_EXPR, 1, true) });
+    g.Add(NT_UNARY_NO_PAREN,    { K(Token::KW_SIZEOF), N(NT_SIZEOF_OPERAND), Node(UNARY_EXPR, 1, true) });
+    for (Token::Type primary : { Token::ID, Token::CONST_INT, Token::CONST_CHAR, Token::CONST_FLOAT, Token::STRING })
+        g.Add(NT_UNARY_NO_PAREN, { K(primary), Leaf(PRIMARY_EXPR), N(NT_POSTFIX_TAIL) });
+    g.Add(NT_SIZEOF_OPERAND,    { T(Token::LPAREN), N(NT_PAREN_SIZEOF) });
+    g.Add(NT_SIZEOF_OPERAND,    { N(NT_UNARY_NO_PAREN) });
+    g.Add(NT_PAREN_SIZEOF,      { N(NT_TYPE_NAME), T(Token::RPAREN) });
+    g.Add(NT_PAREN_SIZEOF,      { N(NT_EXPR), T(Token::RPAREN), N(NT_POSTFIX_TAIL) });
+
+    // postfix := primary ('[' expr ']' | '(' arguments ')' | ('.'|'->') id | '++' | '--')*
+    g.Add(NT_POSTFIX_TAIL,      { T(Token::LSB), N(NT_EXPR), T(Token::RSB), Node(POSTFIX_EXPR, 2), N(NT_POSTFIX_TAIL) });
+    g.Add(NT_POSTFIX_TAIL,      { T(Token::LPAREN), Mark(), N(NT_ARGUMENTS), T(Token::RPAREN),
+                                  List(ARGUMENT_EXPR_LIST), Node(POSTFIX_EXPR, 2), N(NT_POSTFIX_TAIL) });
+    for (Token::Type op : { Token::OP_DOT, Token::OP_POINTTO })
+        g.Add(NT_POSTFIX_TAIL,  { K(op), K(Token::ID), Leaf(IDENTIFIER), Node(POSTFIX_EXPR, 2, true), N(NT_POSTFIX_TAIL) });
+    for (Token::Type op : { Token::OP_INC, Token::OP_DEC })
+        g.Add(NT_POSTFIX_TAIL,  { K(op), Node(POSTFIX_EXPR, 1, true), N(NT_POSTFIX_TAIL) });
+    g.Add(NT_POSTFIX_TAIL,      {});
+    g.Add(NT_ARGUMENTS,         { N(NT_ASSIGN), N(NT_ARGUMENTS_TAIL) });
+    g.Add(NT_ARGUMENTS,         {});
+    g.Add(NT_ARGUMENTS_TAIL,    { T(Token::OP_COMMA), N(NT_ASSIGN), N(NT_ARGUMENTS_TAIL) });
+    g.Add(NT_ARGUMENTS_TAIL,    {});
+
+    // type_name := (type_specifier | qualifier)+ abstract_declarator?
+    g.Add(NT_TYPE_NAME,         { Mark(), N(NT_SPECIFIER_QUALIFIER), N(NT_SPECIFIER_QUALIFIER_TAIL),
+                                  N(NT_ABSTRACT_DECLARATOR_OPT), List(TYPE_NAME) });
+    g.Add(NT_SPECIFIER_QUALIFIER, { N(NT_TYPE_SPECIFIER) });
+    for (Token::Type qualifier : kTypeQualifiers)
+        g.Add(NT_SPECIFIER_QUALIFIER, { K(qualifier), Leaf(TYPE_QUALIFIER) });
+    g.Add(NT_SPECIFIER_QUALIFIER_TAIL, { N(NT_SPECIFIER_QUALIFIER), N(NT_SPECIFIER_QUALIFIER_TAIL) });
+    g.Add(NT_SPECIFIER_QUALIFIER_TAIL, {});
+
+    // abstract_declarator := pointer_list abstract_direct? | abstract_direct
+    // abstract_direct := '(' abstract_declarator ')' suffix* | suffix+
+    // The hand-written parser peeks past '(' to tell a nested declarator
+    // from parameters, left factored that is the token after '('.
+    g.Add(NT_ABSTRACT_DECLARATOR_OPT, { N(NT_ABSTRACT_DECLARATOR) });
+    g.Add(NT_ABSTRACT_DECLARATOR_OPT, {});
+    g.Add(NT_ABSTRACT_DECLARATOR, { Mark(), N(NT_ABSTRACT_BODY), List(ABSTRACT_DECLARATOR) });
+    g.Add(NT_ABSTRACT_BODY,     { N(NT_POINTER_LIST), N(NT_ABSTRACT_DIRECT_OPT) });
+    g.Add(NT_ABSTRACT_BODY,     { N(NT_ABSTRACT_DIRECT) });
+    g.Add(NT_ABSTRACT_DIRECT_OPT, { N(NT_ABSTRACT_DIRECT) });
+    g.Add(NT_ABSTRACT_DIRECT_OPT, {});
+    g.Add(NT_ABSTRACT_DIRECT,   { T(Token::LPAREN), N(NT_ABSTRACT_PAREN) });
+    g.Add(NT_ABSTRACT_DIRECT,   { T(Token::LSB), N(NT_ARRAY_SIZE), T(Token::RSB), N(NT_ABSTRACT_SUFFIX) });
+    g.Add(NT_ABSTRACT_PAREN,    { N(NT_ABSTRACT_DECLARATOR), T(Token::RPAREN), N(NT_ABSTRACT_SUFFIX) });
+    g.Add(NT_ABSTRACT_PAREN,    { N(NT_PARAMETERS), T(Token::RPAREN), N(NT_ABSTRACT_SUFFIX) });
+    g.Add(NT_ABSTRACT_SUFFIX,   { T(Token::LSB), N(NT_ARRAY_SIZE), T(Token::RSB), N(NT_ABSTRACT_SUFFIX) });
+    g.Add(NT_ABSTRACT_SUFFIX,   { T(Token::LPAREN), N(NT_PARAMETERS), T(Token::RPAREN), N(NT_ABSTRACT_SUFFIX) });
+    g.Add(NT_ABSTRACT_SUFFIX,   {});
+}
+
+// FNV-1a over the productions and the symbol counts, used to detect a stale
+// generated table.
+UINT64 GrammarFingerprint(const LL1Grammar & g)
+{
+    UINT64 h = 14695981039346656037ull;
+    auto Mix = [&h](i64 value)
+    {
+        for (int i = 0; i < 8; ++i, value >>= 8)
+            h = (h ^ static_cast<UINT8>(value)) * 1099511628211ull;
+    };
+    Mix(NT_COUNT);
+    Mix(TOKEN_TYPE_COUNT);
+    for (size_t i = 0; i < g.ProductionCount(); ++i)
+    {
+        Mix(g.left[i]);
+        Mix(g.productionBegin[i + 1] - g.productionBegin[i]);
+        for (UINT32 k = g.productionBegin[i]; k < g.productionBegin[i + 1]; ++k)
+        {
+            const LL1Symbol & s = g.symbols[k];
+            Mix(s.kind);
+            Mix(s.keepToken);
+            Mix(s.childCount);
+            Mix(s.value);
+        }
+    }
+    return h;
+}
+
+// ==== Table ====
+
+// Predict table built from FIRST/FOLLOW sets of the grammar.
+struct LL1TableBuilder
+{
+    LL1Grammar          grammar;
+    TokenSet            first[NT_COUNT];
+    TokenSet            follow[NT_COUNT];
+    bool                nullable[NT_COUNT];
+    // [nonterminal][token type]: production index, -1 if syntax error.
+    std::vector<INT16>  predict;
+};
+
+// FIRST of symbols [begin, end), true if all of them are nullable.
+bool FirstOf(const LL1TableBuilder & table, const LL1Symbol * begin, const LL1Symbol * end, TokenSet & first)
+{
+    for (const LL1Symbol * s = begin; s != end; ++s)
+    {
+        if (s->kind == LL1_TERMINAL)
+        {
+            first.set(s->value);
+            return false;
+        }
+        else if (s->kind == LL1_NONTERMINAL)
+        {
+            first |= table.first[s->value];
+            if (!table.nullable[s->value])
+                return false;
+        }
+    }
+    return true;
+}
+
+LL1Grammar BuildLL1Grammar()
+{
+    LL1Grammar g;
+    AddDeclarationGrammar(g);
+    AddStatementGrammar(g);
+    AddExpressionGrammar(g);
+    return g;
+}
+
+LL1TableBuilder BuildLL1Table()
+{
+    LL1TableBuilder table;
+    table.grammar = BuildLL1Grammar();
+    const LL1Grammar & g = table.grammar;
+    ASSERT(g.ProductionCount() < 0x7FFF);
+    for (bool & nullable : table.nullable)
+        nullable = false;
+
+    auto Begin = [&g](size_t production) { return g.symbols.data() + g.productionBegin[production]; };
+    auto End = [&g](size_t production) { return g.symbols.data() + g.productionBegin[production + 1]; };
+
+    // FIRST and nullable, to fixed point.
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (size_t i = 0; i < g.ProductionCount(); ++i)
+        {
+            int left = g.left[i];
+            TokenSet first = table.first[left];
+            bool nullable = FirstOf(table, Begin(i), End(i), first);
+            if (first != table.first[left] || (nullable && !table.nullable[left]))
+            {
+                table.first[left] = first;
+                table.nullable[left] = table.nullable[left] || nullable;
+                changed = true;
+            }
+        }
+    }
+
+    // FOLLOW, to fixed point. A translation unit ends at the end of input,
+    // ParseExpressionLL1() stops at anything that can't continue an expr.
+    table.follow[NT_TRANSLATION_UNIT].set(Token::END);
+    table.follow[NT_EXPR].set();
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (size_t i = 0; i < g.ProductionCount(); ++i)
+        {
+            for (const LL1Symbol * s = Begin(i); s != End(i); ++s)
+            {
+                if (s->kind != LL1_NONTERMINAL)
+                    continue;
+                TokenSet follow = table.follow[s->value];
+                if (FirstOf(table, s + 1, End(i), follow))
+                    follow |= table.follow[g.left[i]];
+                if (follow != table.follow[s->value])
+                {
+                    table.follow[s->value] = follow;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Predict by FIRST, conflicts there mean the grammar is not LL(1). A
+    // nullable production takes the rest of FOLLOW, so an optional part is
+    // matched greedily, as the hand-written parser does.
+    table.predict.assign(NT_COUNT * TOKEN_TYPE_COUNT, -1);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < g.ProductionCount(); ++i)
+        {
+            TokenSet first;
+            bool nullable = FirstOf(table, Begin(i), End(i), first);
+            if (pass == 1 && !nullable)
+                continue;
+
+            const TokenSet & predictSet = (pass == 0) ? first : table.follow[g.left[i]];
+            INT16 * row = table.predict.data() + g.left[i] * TOKEN_TYPE_COUNT;
+            for (size_t type = 0; type < TOKEN_TYPE_COUNT; ++type)
+            {
+                if (!predictSet.test(type))
+                    continue;
+                ASSERT(pass == 1 || row[type] == -1);
+                if (row[type] == -1)
+                    row[type] = static_cast<INT16>(i);
+            }
+        }
+    }
+
+    return table;
+}
+
+// What the driver reads, either the generated arrays or a runtime build.
+struct LL1Table
+{
+    const LL1Symbol *   symbols;
+    const UINT32 *      productionBegin;
+    const INT16 *       predict;
+};
+
+// LL1Table.gen.cpp, regenerate with `cc.exe --gen-parser <file>` after editing the grammar.
+extern const UINT64 kLL1GrammarFingerprint;
+extern const LL1Symbol kLL1Symbols[];
+extern const UINT32 kLL1ProductionBegin[];
+extern const INT16 kLL1Predict[];
+
+const LL1Table & GetLL1Table()
+{
+    // Fall back to runtime table construction if generated tables are stale.
+    static const LL1Table table = []() {
+        if (kLL1GrammarFingerprint == GrammarFingerprint(BuildLL1Grammar()))
+            return LL1Table{ kLL1Symbols, kLL1ProductionBegin, kLL1Predict };
+        static const LL1TableBuilder built = BuildLL1Table();
+        return LL1Table{ built.grammar.symbols.data(), built.grammar.productionBegin.data(), built.predict.data() };
+    }();
+    return table;
+}
+
+void GenerateLL1Table(std::string fileName)
+{
+    LL1TableBuilder table = BuildLL1Table();
+    const LL1Grammar & g = table.grammar;
+
+    std::ostringstream os;
+    os << "// Generated by GenerateLL1Table(), do not edit." << std::endl
+       << "// " << g.ProductionCount() << " productions, " << g.symbols.size() << " symbols, "
+       << NT_COUNT << " nonterminals." << std::endl
+       << std::endl
+       << "#include \"LL1Parser.h\"" << std::endl
+       << std::endl
+       << "extern const UINT64 kLL1GrammarFingerprint = 0x" << std::hex << GrammarFingerprint(g) << std::dec << "ull;" << std::endl
+       << std::endl
+       << "// { kind, keepToken, childCount, value }, one production per line." << std::endl
+       << "extern const LL1Symbol kLL1Symbols[] = {" << std::endl;
+    for (size_t i = 0; i < g.ProductionCount(); ++i)
+    {
+        os << "    /* " << i << " */";
+        for (UINT32 k = g.productionBegin[i]; k < g.productionBegin[i + 1]; ++k)
+        {
+            const LL1Symbol & s = g.symbols[k];
+            os << " { " << int(s.kind) << ", " << int(s.keepToken) << ", " << s.childCount << ", " << s.value << " },";
+        }
+        os << std::endl;
+    }
+    os << "};" << std::endl
+       << std::endl
+       << "extern const UINT32 kLL1ProductionBegin[] = {";
+    for (size_t i = 0; i < g.productionBegin.size(); ++i)
+        os << (i % 16 ? " " : "\n    ") << g.productionBegin[i] << ",";
+    os << std::endl << "};" << std::endl
+       << std::endl
+       << "// [nonterminal][token type]: production, -1 if syntax error." << std::endl
+       << "extern const INT16 kLL1Predict[] = {" << std::endl;
+    for (int nt = 0; nt < NT_COUNT; ++nt)
+    {
+        os << "    /* " << nt << " */";
+        for (size_t type = 0; type < TOKEN_TYPE_COUNT; ++type)
+            os << " " << table.predict[nt * TOKEN_TYPE_COUNT + type] << ",";
+        os << std::endl;
+    }
+    os << "};" << std::endl;
+
+    SetFileContent(fileName.data(), os.str());
+}
+
+// ==== Driver ====
+
+// Nodes come out children first, AstTree wants them parent first.
+void ToPreOrder(const std::vector<AstNode> & postOrder, AstIndex root, AstTree & tree)
+{
+    tree.nodes.clear();
+    tree.nodes.reserve(postOrder.size());
+    tree.nodes.push_back({ 0, 0, AST_NO_TOKEN, 0 });
+
+    // node, and the node linking to it as left child or right sibling
+    struct Pending
+    {
+        AstIndex    node;
+        AstIndex    from;
+        bool        fromParent;
+    };
+    std::vector<Pending> stack = { { root, 0, false } };
+    while (!stack.empty())
+    {
+        Pending p = stack.back();
+        stack.pop_back();
+
+        const AstNode & node = postOrder[p.node];
+        AstIndex index = static_cast<AstIndex>(tree.nodes.size());
+        tree.nodes.push_back({ 0, 0, node.token, node.type });
+        if (p.from)
+            (p.fromParent ? tree.nodes[p.from].leftChild : tree.nodes[p.from].rightSibling) = index;
+
+        if (node.rightSibling)
+            stack.push_back({ node.rightSibling, index, false });
+        if (node.leftChild)
+            stack.push_back({ node.leftChild, index, true });
+    }
+}
+
+// Parse start from ti. The symbol stack holds the unmatched rest of each
+// production being expanded, a production is popped before its last symbol
+// runs, so tail nonterminals take no stack.
+AstTree ParseLL1(TokenIterator & ti, Nonterminal start, std::vector<UINT32> * externalBegins)
+{
+    const LL1Table & table = GetLL1Table();
+
+    struct Rest
+    {
+        UINT32  begin;
+        UINT32  end;
+    };
+    std::vector<Rest>       rests;
+    std::vector<AstNode>    nodes = { { 0, 0, AST_NO_TOKEN, 0 } };
+    std::vector<AstIndex>   values;     // built nodes not yet attached
+    std::vector<UINT32>     tokens;     // kept tokens not yet in a node
+    std::vector<size_t>     marks;
+    nodes.reserve(ti.tokens().size() + 1);
+
+    Token::Type lookahead = ti.has() ? ti.PeekType() : Token::END;
+    auto Expand = [&](int nonterminal)
+    {
+        int production = table.predict[nonterminal * TOKEN_TYPE_COUNT + lookahead];
+        ASSERT(production >= 0);
+        Rest rest = { table.productionBegin[production], table.productionBegin[production + 1] };
+        if (rest.begin != rest.end)
+            rests.push_back(rest);
+    };
+
+    Expand(start);
+    while (!rests.empty())
+    {
+        Rest & rest = rests.back();
+        const LL1Symbol & s = table.symbols[rest.begin++];
+        if (rest.begin == rest.end)
+            rests.pop_back();
+
+        switch (s.kind)
+        {
+            case LL1_NONTERMINAL:
+                Expand(s.value);
+                break;
+            case LL1_TERMINAL:
+                ASSERT(lookahead == s.value);
+                if (s.keepToken)
+                    tokens.push_back(static_cast<UINT32>(ti.index()));
+                ti.next();
+                lookahead = ti.has() ? ti.PeekType() : Token::END;
+                break;
+            case LL1_MARK:
+                marks.push_back(values.size());
+                break;
+            case LL1_EXTERNAL:
+                ASSERT(externalBegins);
+                externalBegins->push_back(static_cast<UINT32>(ti.index()));
+                break;
+            case LL1_NODE:
+            {
+                size_t childCount = s.childCount;
+                if (s.childCount < 0)
+                {
+                    childCount = values.size() - marks.back();
+                    marks.pop_back();
+                }
+                ASSERT(values.size() >= childCount);
+
+                AstNode node = { 0, 0, AST_NO_TOKEN, static_cast<UINT8>(s.value) };
+                if (s.keepToken)
+                {
+                    node.token = tokens.back();
+                    tokens.pop_back();
+                }
+                size_t firstChild = values.size() - childCount;
+                if (childCount > 0)
+                    node.leftChild = values[firstChild];
+                for (size_t i = firstChild + 1; i < values.size(); ++i)
+                    nodes[values[i - 1]].rightSibling = values[i];
+                values.resize(firstChild);
+
+                values.push_back(static_cast<AstIndex>(nodes.size()));
+                nodes.push_back(node);
+                break;
+            }
+        }
+    }
+    ASSERT(values.size() == 1 && tokens.empty() && marks.empty());
+
+    AstTree tree;
+    tree.tokens = &ti.tokens();
+    ToPreOrder(nodes, values.back(), tree);
+    return tree;
+}
+
+AstTree ParseTranslationUnitLL1(TokenIterator & ti)
+{
+    std::vector<UINT32> externalBegins;
+    AstTree tree = ParseLL1(ti, NT_TRANSLATION_UNIT, &externalBegins);
+
+    // Externals are the children of the root, in order, each up to where
+    // the next one starts.
+    size_t i = 0;
+    for (Ast external = tree.Root().LeftChild(); external; external = external.RightSibling(), ++i)
+    {
+        UINT32 end = i + 1 < externalBegins.size() ? externalBegins[i + 1] : static_cast<UINT32>(ti.index());
+        tree.externals.push_back({ external.Index(), externalBegins[i], end });
+    }
+    ASSERT(i == externalBegins.size());
+    return tree;
+}
+
+AstTree ParseExpressionLL1(TokenIterator & ti)
+{
+    return ParseLL1(ti, NT_EXPR, nullptr);
+}
+
+void DebugPrintLL1Table()
+{
+    LL1TableBuilder table = BuildLL1Table();
+
+    auto PrintSet = [](const char * name, const TokenSet & set)
+    {
+        std::cout << "  " << name << ":";
+        for (size_t type = 0; type < TOKEN_TYPE_COUNT; ++type)
+        {
+            if (set.test(type))
+                std::cout << ' ' << type;
+        }
+        std::cout << std::endl;
+    };
+
+    for (int nt = 0; nt < NT_COUNT; ++nt)
+    {
+        std::cout << "nonterminal " << nt << (table.nullable[nt] ? " (nullable)" : "") << std::endl;
+        PrintSet("first", table.first[nt]);
+        PrintSet("follow", table.follow[nt]);
+        std::cout << "  predict:";
+        for (size_t type = 0; type < TOKEN_TYPE_COUNT; ++type)
+        {
+            int production = table.predict[nt * TOKEN_TYPE_COUNT + type];
+            if (production >= 0)
+                std::cout << ' ' << type << "->" << production;
+        }
+        std::cout << std::endl;
+    }
+}
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+#include <chrono>
+#include <string>
+
+// Space separated tokens: keywords, ids, integers and operators.
+static std::vector<Token> TokensFrom(const std::string & text)
+{
+    static const std::vector<std::pair<std::string, Token::Type>> ops = {
+        { "||", Token::BOOL_OR }, { "&&", Token::BOOL_AND }, { "|", Token::BIT_OR },
+        { "^", Token::BIT_XOR }, { "&", Token::BIT_AND }, { "==", Token::REL_EQ },
+        { "!=", Token::REL_NE }, { "<", Token::REL_LT }, { "<=", Token::REL_LE },
+        { ">", Token::REL_GT }, { ">=", Token::REL_GE }, { "<<", Token::BIT_SHL },
+        { ">>", Token::BIT_SHR }, { "+", Token::OP_ADD }, { "-", Token::OP_SUB },
+        { "*", Token::OP_MUL }, { "/", Token::OP_DIV }, { "%", Token::OP_MOD },
+        { "=", Token::ASSIGN }, { "+=", Token::ADD_ASSIGN }, { "-=", Token::SUB_ASSIGN },
+        { "?", Token::OP_QMARK }, { ":", Token::OP_COLON }, { ",", Token::OP_COMMA },
+        { "(", Token::LPAREN }, { ")", Token::RPAREN }, { "!", Token::BOOL_NOT },
+        { "~", Token::BIT_NOT }, { "[", Token::LSB }, { "]", Token::RSB },
+        { ".", Token::OP_DOT }, { "->", Token::OP_POINTTO }, { "++", Token::OP_INC },
+        { "--", Token::OP_DEC }, { "{", Token::BLK_BEGIN }, { "}", Token::BLK_END },
+        { "...", Token::VAR_PARAM }, { ";", Token::STMT_END },
+    };
+
+    std::vector<Token> tokens;
+    size_t begin = 0;
+    while (begin < text.size())
+    {
+        size_t end = text.find(' ', begin);
+        end = end == std::string::npos ? text.size() : end;
+        std::string word = text.substr(begin, end - begin);
+        Token::Type type = isdigit(word[0]) ? Token::CONST_INT : ClassifyKeyword(word.data(), word.size());
+        for (auto & op : ops)
+            type = op.first == word ? op.second : type;
+        tokens.emplace_back(type, word);
+        begin = end + 1;
+    }
+    return tokens;
+}
+
+// "(type token child...)"
+static std::string TreeToString(Ast ast)
+{
+    std::string s = "(" + std::to_string(ast.Type()) + " " + ast.GetToken().text;
+    for (Ast child = ast.LeftChild(); child; child = child.RightSibling())
+        s += " " + TreeToString(child);
+    return s + ")";
+}
+
+// Same nodes in the same order, and same externals.
+static void ExpectSameTree(const AstTree & table, const AstTree & hand)
+{
+    EXPECT_EQ(TreeToString(table.Root()), TreeToString(hand.Root()));
+    EXPECT_EQ(table.nodes.size(), hand.nodes.size());
+    for (size_t i = 0; i < table.nodes.size() && i < hand.nodes.size(); ++i)
+    {
+        EXPECT_EQ(table.nodes[i].leftChild, hand.nodes[i].leftChild);
+        EXPECT_EQ(table.nodes[i].rightSibling, hand.nodes[i].rightSibling);
+        EXPECT_EQ(table.nodes[i].token, hand.nodes[i].token);
+        EXPECT_EQ(table.nodes[i].type, hand.nodes[i].type);
+    }
+    EXPECT_EQ(table.externals.size(), hand.externals.size());
+    for (size_t i = 0; i < table.externals.size() && i < hand.externals.size(); ++i)
+    {
+        EXPECT_EQ(table.externals[i].node, hand.externals[i].node);
+        EXPECT_EQ(table.externals[i].tokenBegin, hand.externals[i].tokenBegin);
+        EXPECT_EQ(table.externals[i].tokenEnd, hand.externals[i].tokenEnd);
+    }
+}
+
+static void ExpectSameTranslationUnit(const std::vector<Token> & tokens)
+{
+    TokenIterator handTi(tokens);
+    AstTree hand = ParseTranslationUnit(handTi);
+    TokenIterator tableTi(tokens);
+    AstTree table = ParseTranslationUnitLL1(tableTi);
+
+    ExpectSameTree(table, hand);
+    EXPECT_EQ(tableTi.index(), handTi.index());
+}
+
+TEST(LL1Parser_SameAst)
+{
+    const char * exprs[] = {
+        "a",
+        "a , b , c",
+        "a = b += c ? d , e : f || g",
+        "a || b && c | d ^ e & f == g < h << i + j * k",
+        "a * b + c << d >= e != f & g ^ h | i && j || k",
+        "a - b - c % d / e",
+        "! ( a + b ) * c [ d ] , e",
+        "f ( ) + g ( a , b = 1 , h ( c ) ) ( d )",
+        "s . x -> y ++ -- + ++ -- p",
+        "- ~ * & a",
+        "( int ) a + ( unsigned long * const * ) ( char ) b",
+        "( struct S * ) p -> next",
+        "sizeof a + sizeof ( a ) [ 0 ] + sizeof ( const int * )",
+        "( ( a ) ) ( b ) [ ( c ) ]",
+        "( int ( * ) ( int a , char * p ) ) f + sizeof ( char [ 4 ] [ ] ) + sizeof ( int * ( * ) [ 2 ] )",
+        "( void ( * ) ( ) ) f + ( struct { int x ; } * ) p + ( enum E { A , B = 1 } ) 0",
+    };
+    for (const char * expr : exprs)
+    {
+        std::vector<Token> tokens = TokensFrom(std::string(expr) + " ;");
+
+        TokenIterator handTi(tokens);
+        AstTree hand = ParseExpressionTree(handTi);
+        TokenIterator tableTi(tokens);
+        AstTree table = ParseExpressionLL1(tableTi);
+
+        ExpectSameTree(table, hand);
+        EXPECT_EQ(tableTi.index(), handTi.index());
+    }
+
+    const char * units[] = {
+        "",
+        "int ;",
+        "int a , * const * b , c [ 3 ] [ ] ; static unsigned long const d ;",
+        "extern int ( * f ) ( int a , char * * b , ... ) ; void g ( ) ; int ( * h ( int x ) ) [ 4 ] ;",
+        "struct S ; struct S { int x , * y ; struct S * next ; union { char c ; long l ; } u ; } s ;",
+        "enum E { A , B = 2 , C } ; enum { D } d ; typedef enum E e ;",
+        "int f ( int a ) { int b ; char c ; b = a * 2 ; return b + c ; }",
+        "void g ( ) { } void h ( ) { ; { } return ; }",
+        "int k ( int n ) { if ( n ) if ( n < 3 ) n -= 1 ; else n = 0 ; else { n ++ ; } return k ( n ) ; }",
+        "int l ( int n ) { while ( n > 0 ) { n = n - 1 ; continue ; } do n ++ ; while ( n <= 9 ) ; "
+        "for ( ; ; ) break ; for ( n = 0 ; n < 9 ; ) ; for ( ; n ; n -- ) { } return n >> 1 ; }",
+        "int m ( int n ) { switch ( n ) { case 1 : return 2 ; case 2 : { n = 3 ; } default : break ; } return ; }",
+        "struct S { int x ; } * p ( struct S * s , enum { X } e ) { return s ; } int main ( ) { return 0 ; }",
+    };
+    for (const char * unit : units)
+        ExpectSameTranslationUnit(TokensFrom(unit));
+
+    // Deep nesting uses the explicit stacks, not the call stack.
+    std::string nested = "x";
+    for (int i = 0; i < 100000; ++i)
+        nested = "( " + nested;
+    for (int i = 0; i < 100000; ++i)
+        nested += " )";
+    std::vector<Token> tokens = TokensFrom(nested);
+    TokenIterator ti(tokens);
+    AstTree tree = ParseExpressionLL1(ti);
+    EXPECT_EQ(tree.Root().Type(), PRIMARY_EXPR);
+    EXPECT_FALSE(ti.has());
+}
+
+// Test\fileName in the source tree, whatever the working directory.
+static std::string TestSourcePath(const char * fileName)
+{
+    return GetCanonicalFileDirectory(__FILE__) + "\\..\\..\\Test\\" + fileName;
+}
+
+TEST(LL1Parser_TestSources)
+{
+    const char * fileNames[] = {
+        "fibonacci.c",
+        "io.c",
+        "debug.c",
+        "type.c",
+        "libc.c",
+        "data_structure.c",
+        "greedy_snake.c",
+    };
+    for (const char * fileName : fileNames)
+    {
+        std::string path = TestSourcePath(fileName);
+        EXPECT_TRUE(FileExists(path.data()));
+        if (FileExists(path.data()))
+            ExpectSameTranslationUnit(LexProcess(path));
+    }
+}
+
+TEST(LL1Parser_GeneratedTable)
+{
+    // Stale LL1Table.gen.cpp only costs a runtime build, but should be
+    // regenerated with the grammar.
+    LL1TableBuilder table = BuildLL1Table();
+    const LL1Grammar & g = table.grammar;
+    EXPECT_EQ(kLL1GrammarFingerprint, GrammarFingerprint(g));
+    if (kLL1GrammarFingerprint != GrammarFingerprint(g))
+        return;
+
+    for (size_t i = 0; i < g.productionBegin.size(); ++i)
+        EXPECT_EQ(kLL1ProductionBegin[i], g.productionBegin[i]);
+    for (size_t i = 0; i < g.symbols.size(); ++i)
+    {
+        EXPECT_EQ(kLL1Symbols[i].kind, g.symbols[i].kind);
+        EXPECT_EQ(kLL1Symbols[i].keepToken, g.symbols[i].keepToken);
+        EXPECT_EQ(kLL1Symbols[i].childCount, g.symbols[i].childCount);
+        EXPECT_EQ(kLL1Symbols[i].value, g.symbols[i].value);
+    }
+    for (size_t i = 0; i < table.predict.size(); ++i)
+        EXPECT_EQ(kLL1Predict[i], table.predict[i]);
+}
+
+TEST(LL1Parser_Benchmark)
+{
+    std::string expr = "x";
+    for (int i = 0; i < 20000; ++i)
+        expr += " + f ( a [ i ] , * p -> q ) * ( b - ( int ) c ) << 2 , y = ! z || w";
+    std::string unit;
+    for (int i = 0; i < 5000; ++i)
+        unit += "struct S { int x ; char * y [ 4 ] ; } * f ( struct S * s , int n ) { int i ; "
+                "for ( i = 0 ; i < n ; i ++ ) { if ( s -> x > i ) s -> x -= g ( i , n ) ; else break ; } "
+                "while ( n ) n = n - 1 ; return s ; } ";
+
+    auto Time = [](const std::vector<Token> & tokens, AstTree (*parse)(TokenIterator &), size_t & nodes)
+    {
+        const int kRounds = 10;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            TokenIterator ti(tokens);
+            nodes = parse(ti).nodes.size();
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    };
+    auto HandUnit = [](TokenIterator & ti) { return ParseTranslationUnit(ti); };
+
+    std::vector<Token> exprTokens = TokensFrom(expr + " ;");
+    std::vector<Token> unitTokens = TokensFrom(unit);
+    size_t handNodes = 0, tableNodes = 0;
+
+    auto handExpr = Time(exprTokens, ParseExpressionTree, handNodes);
+    auto tableExpr = Time(exprTokens, ParseExpressionLL1, tableNodes);
+    EXPECT_EQ(tableNodes, handNodes);
+    auto handUnit = Time(unitTokens, HandUnit, handNodes);
+    auto tableUnit = Time(unitTokens, ParseTranslationUnitLL1, tableNodes);
+    EXPECT_EQ(tableNodes, handNodes);
+
+    std::cout << "Parse x 10, hand-written / LL(1) table: expression of " << exprTokens.size() << " tokens "
+              << handExpr << " / " << tableExpr << " ms, translation unit of " << unitTokens.size() << " tokens "
+              << handUnit << " / " << tableUnit << " ms" << std::endl;
+}
+
+#endif
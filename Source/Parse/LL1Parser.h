@@ -0,0 +1,28 @@
+#pragma once
+
+#include "AstParser.h"
+
+// Table-driven LL(1) parser: predict table from FIRST/FOLLOW sets of a BNF
+// grammar of translation units, declarations, statements and expressions,
+// driven by explicit symbol and node stacks, no recursion. Same Ast as
+// AstParser.cpp, unsupported parts (initializers, labels, goto, typedef
+// names) are syntax errors there too.
+AstTree ParseTranslationUnitLL1(TokenIterator & ti);
+// Expression up to the first token that can't continue it.
+AstTree ParseExpressionLL1(TokenIterator & ti);
+
+// Grammar symbol in the generated tables: terminal, nonterminal, or action
+// on the node stack, see LL1Parser.cpp.
+struct LL1Symbol
+{
+    UINT8   kind;
+    UINT8   keepToken;
+    INT16   childCount;     // -1: all since MARK
+    int     value;
+};
+
+// Write the grammar and predict table, read in place by the parser.
+void    GenerateLL1Table(std::string fileName);
+
+// Grammar, FIRST/FOLLOW sets and predict table.
+void    DebugPrintLL1Table();
@@ -0,0 +1,340 @@
+// Generated by GenerateLL1Table(), do not edit.
+// 217 productions, 527 symbols, 92 nonterminals.
+
+#include "LL1Parser.h"
+
+extern const UINT64 kLL1GrammarFingerprint = 0x8f40576aa1d5886dull;
+
+// { kind, keepToken, childCount, value }, one production per line.
+extern const LL1Symbol kLL1Symbols[] = {
+    /* 0 */ { 2, 0, 0, 0 }, { 1, 0, 0, 1 }, { 3, 0, -1, 0 },
+    /* 1 */ { 1, 0, 0, 2 }, { 1, 0, 0, 1 },
+    /* 2 */
+    /* 3 */ { 4, 0, 0, 0 }, { 2, 0, 0, 0 }, { 1, 0, 0, 9 }, { 1, 0, 0, 3 },
+    /* 4 */ { 0, 0, 0, 84 }, { 3, 0, -1, 3 },
+    /* 5 */ { 1, 0, 0, 27 }, { 1, 0, 0, 4 },
+    /* 6 */ { 1, 0, 0, 40 }, { 3, 0, -1, 2 },
+    /* 7 */ { 3, 0, 1, 4 }, { 1, 0, 0, 7 }, { 0, 0, 0, 84 }, { 3, 0, -1, 3 },
+    /* 8 */ { 2, 0, 0, 0 }, { 1, 0, 0, 9 }, { 1, 0, 0, 6 }, { 0, 0, 0, 84 }, { 3, 0, -1, 3 },
+    /* 9 */ { 1, 0, 0, 8 }, { 1, 0, 0, 7 },
+    /* 10 */
+    /* 11 */ { 0, 0, 0, 66 }, { 1, 0, 0, 8 }, { 1, 0, 0, 7 },
+    /* 12 */
+    /* 13 */ { 1, 0, 0, 27 }, { 3, 0, 1, 4 },
+    /* 14 */ { 2, 0, 0, 0 }, { 1, 0, 0, 10 }, { 1, 0, 0, 11 }, { 3, 0, -1, 17 },
+    /* 15 */ { 0, 1, 0, 3 }, { 3, 1, 0, 18 },
+    /* 16 */ { 0, 1, 0, 7 }, { 3, 1, 0, 18 },
+    /* 17 */ { 0, 1, 0, 9 }, { 3, 1, 0, 18 },
+    /* 18 */ { 0, 1, 0, 4 }, { 3, 1, 0, 18 },
+    /* 19 */ { 0, 1, 0, 5 }, { 3, 1, 0, 18 },
+    /* 20 */ { 1, 0, 0, 83 },
+    /* 21 */ { 1, 0, 0, 10 }, { 1, 0, 0, 11 },
+    /* 22 */
+    /* 23 */ { 0, 1, 0, 12 }, { 3, 1, 0, 20 },
+    /* 24 */ { 0, 1, 0, 16 }, { 3, 1, 0, 20 },
+    /* 25 */ { 0, 1, 0, 15 }, { 3, 1, 0, 20 },
+    /* 26 */ { 0, 1, 0, 13 }, { 3, 1, 0, 20 },
+    /* 27 */ { 0, 1, 0, 14 }, { 3, 1, 0, 20 },
+    /* 28 */ { 0, 1, 0, 18 }, { 3, 1, 0, 20 },
+    /* 29 */ { 0, 1, 0, 17 }, { 3, 1, 0, 20 },
+    /* 30 */ { 0, 1, 0, 11 }, { 3, 1, 0, 20 },
+    /* 31 */ { 0, 1, 0, 10 }, { 3, 1, 0, 20 },
+    /* 32 */ { 0, 0, 0, 20 }, { 2, 0, 0, 0 }, { 1, 0, 0, 13 }, { 3, 0, -1, 25 },
+    /* 33 */ { 0, 0, 0, 21 }, { 2, 0, 0, 0 }, { 1, 0, 0, 13 }, { 3, 0, -1, 26 },
+    /* 34 */ { 0, 0, 0, 19 }, { 2, 0, 0, 0 }, { 1, 0, 0, 20 }, { 3, 0, -1, 30 },
+    /* 35 */ { 0, 1, 0, 1 }, { 3, 1, 0, 12 }, { 1, 0, 0, 14 },
+    /* 36 */ { 1, 0, 0, 15 },
+    /* 37 */ { 1, 0, 0, 15 },
+    /* 38 */
+    /* 39 */ { 0, 0, 0, 58 }, { 1, 0, 0, 16 }, { 1, 0, 0, 17 }, { 0, 0, 0, 59 },
+    /* 40 */ { 2, 0, 0, 0 }, { 1, 0, 0, 83 }, { 1, 0, 0, 84 }, { 1, 0, 0, 18 }, { 1, 0, 0, 19 }, { 0, 0, 0, 84 }, { 3, 0, -1, 27 },
+    /* 41 */ { 1, 0, 0, 16 }, { 1, 0, 0, 17 },
+    /* 42 */
+    /* 43 */ { 1, 0, 0, 27 }, { 3, 0, 1, 29 },
+    /* 44 */ { 0, 0, 0, 66 }, { 1, 0, 0, 18 }, { 1, 0, 0, 19 },
+    /* 45 */
+    /* 46 */ { 0, 1, 0, 1 }, { 3, 1, 0, 12 }, { 1, 0, 0, 21 },
+    /* 47 */ { 1, 0, 0, 22 },
+    /* 48 */ { 1, 0, 0, 22 },
+    /* 49 */
+    /* 50 */ { 0, 0, 0, 58 }, { 1, 0, 0, 23 }, { 1, 0, 0, 24 }, { 0, 0, 0, 59 },
+    /* 51 */ { 0, 1, 0, 1 }, { 2, 0, 0, 0 }, { 1, 0, 0, 25 }, { 3, 1, -1, 31 },
+    /* 52 */ { 0, 0, 0, 66 }, { 1, 0, 0, 23 }, { 1, 0, 0, 24 },
+    /* 53 */
+    /* 54 */ { 0, 0, 0, 38 }, { 1, 0, 0, 26 },
+    /* 55 */
+    /* 56 */ { 0, 1, 0, 34 }, { 3, 1, 0, 52 },
+    /* 57 */ { 2, 0, 0, 0 }, { 1, 0, 0, 28 }, { 1, 0, 0, 33 }, { 1, 0, 0, 34 }, { 3, 0, -1, 5 },
+    /* 58 */ { 1, 0, 0, 29 },
+    /* 59 */
+    /* 60 */ { 2, 0, 0, 0 }, { 1, 0, 0, 30 }, { 1, 0, 0, 32 }, { 3, 0, -1, 16 },
+    /* 61 */ { 0, 0, 0, 72 }, { 2, 0, 0, 0 }, { 1, 0, 0, 31 }, { 3, 0, -1, 15 },
+    /* 62 */ { 0, 1, 0, 8 }, { 3, 1, 0, 19 },
+    /* 63 */ { 0, 1, 0, 6 }, { 3, 1, 0, 19 },
+    /* 64 */
+    /* 65 */ { 1, 0, 0, 30 }, { 1, 0, 0, 32 },
+    /* 66 */
+    /* 67 */ { 0, 0, 0, 60 }, { 1, 0, 0, 27 }, { 0, 0, 0, 61 },
+    /* 68 */ { 0, 1, 0, 1 }, { 3, 1, 0, 12 },
+    /* 69 */ { 0, 0, 0, 62 }, { 1, 0, 0, 35 }, { 0, 0, 0, 63 }, { 1, 0, 0, 34 },
+    /* 70 */ { 0, 0, 0, 60 }, { 1, 0, 0, 36 }, { 0, 0, 0, 61 }, { 1, 0, 0, 34 },
+    /* 71 */
+    /* 72 */ { 1, 0, 0, 26 },
+    /* 73 */ { 3, 0, 0, 54 },
+    /* 74 */ { 2, 0, 0, 0 }, { 1, 0, 0, 37 }, { 1, 0, 0, 38 }, { 3, 0, -1, 9 },
+    /* 75 */ { 3, 0, 0, 9 },
+    /* 76 */ { 1, 0, 0, 9 }, { 1, 0, 0, 27 }, { 3, 0, 2, 11 },
+    /* 77 */ { 0, 0, 0, 66 }, { 1, 0, 0, 39 },
+    /* 78 */
+    /* 79 */ { 0, 0, 0, 85 }, { 3, 0, 0, 10 },
+    /* 80 */ { 1, 0, 0, 37 }, { 1, 0, 0, 38 },
+    /* 81 */ { 0, 0, 0, 58 }, { 2, 0, 0, 0 }, { 1, 0, 0, 41 }, { 1, 0, 0, 42 }, { 0, 0, 0, 59 }, { 3, 0, -1, 60 },
+    /* 82 */ { 1, 0, 0, 5 }, { 1, 0, 0, 41 },
+    /* 83 */
+    /* 84 */ { 1, 0, 0, 43 }, { 1, 0, 0, 42 },
+    /* 85 */
+    /* 86 */ { 1, 0, 0, 40 },
+    /* 87 */ { 0, 0, 0, 28 }, { 1, 0, 0, 26 }, { 0, 0, 0, 65 }, { 1, 0, 0, 43 }, { 3, 0, 2, 58 },
+    /* 88 */ { 0, 0, 0, 29 }, { 0, 0, 0, 65 }, { 1, 0, 0, 43 }, { 3, 0, 1, 59 },
+    /* 89 */ { 1, 0, 0, 47 }, { 0, 0, 0, 84 }, { 3, 0, 1, 61 },
+    /* 90 */ { 0, 0, 0, 84 }, { 3, 0, 0, 61 },
+    /* 91 */ { 0, 0, 0, 22 }, { 0, 0, 0, 60 }, { 2, 0, 0, 0 }, { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 1, 0, 0, 43 }, { 1, 0, 0, 44 }, { 3, 0, -1, 63 },
+    /* 92 */ { 0, 0, 0, 23 }, { 1, 0, 0, 43 },
+    /* 93 */
+    /* 94 */ { 0, 0, 0, 27 }, { 0, 0, 0, 60 }, { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 1, 0, 0, 43 }, { 3, 0, 2, 64 },
+    /* 95 */ { 0, 0, 0, 25 }, { 0, 0, 0, 60 }, { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 1, 0, 0, 43 }, { 3, 0, 2, 66 },
+    /* 96 */ { 0, 0, 0, 24 }, { 1, 0, 0, 43 }, { 0, 0, 0, 25 }, { 0, 0, 0, 60 }, { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 0, 0, 0, 84 }, { 3, 0, 2, 67 },
+    /* 97 */ { 0, 0, 0, 26 }, { 0, 0, 0, 60 }, { 1, 0, 0, 45 }, { 0, 0, 0, 84 }, { 1, 0, 0, 45 }, { 0, 0, 0, 84 }, { 1, 0, 0, 45 }, { 0, 0, 0, 61 }, { 1, 0, 0, 43 }, { 3, 0, 4, 68 },
+    /* 98 */ { 1, 0, 0, 47 },
+    /* 99 */ { 3, 0, 0, 35 },
+    /* 100 */ { 0, 0, 0, 31 }, { 0, 0, 0, 84 }, { 3, 0, 0, 70 },
+    /* 101 */ { 0, 0, 0, 30 }, { 0, 0, 0, 84 }, { 3, 0, 0, 71 },
+    /* 102 */ { 0, 0, 0, 32 }, { 2, 0, 0, 0 }, { 1, 0, 0, 46 }, { 0, 0, 0, 84 }, { 3, 0, -1, 72 },
+    /* 103 */ { 1, 0, 0, 47 },
+    /* 104 */
+    /* 105 */ { 1, 0, 0, 49 }, { 1, 0, 0, 48 },
+    /* 106 */ { 0, 0, 0, 66 }, { 1, 0, 0, 49 }, { 3, 0, 2, 36 }, { 1, 0, 0, 48 },
+    /* 107 */
+    /* 108 */ { 1, 0, 0, 51 }, { 1, 0, 0, 50 },
+    /* 109 */ { 0, 1, 0, 38 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 110 */ { 0, 1, 0, 39 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 111 */ { 0, 1, 0, 40 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 112 */ { 0, 1, 0, 41 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 113 */ { 0, 1, 0, 42 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 114 */ { 0, 1, 0, 43 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 115 */ { 0, 1, 0, 44 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 116 */ { 0, 1, 0, 45 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 117 */ { 0, 1, 0, 46 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 118 */ { 0, 1, 0, 47 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 119 */ { 0, 1, 0, 48 }, { 1, 0, 0, 49 }, { 3, 1, 2, 37 },
+    /* 120 */
+    /* 121 */ { 1, 0, 0, 53 }, { 1, 0, 0, 52 },
+    /* 122 */ { 0, 0, 0, 75 }, { 1, 0, 0, 47 }, { 0, 0, 0, 65 }, { 1, 0, 0, 51 }, { 3, 0, 3, 38 },
+    /* 123 */
+    /* 124 */ { 1, 0, 0, 55 }, { 1, 0, 0, 54 },
+    /* 125 */ { 0, 0, 0, 51 }, { 1, 0, 0, 55 }, { 3, 0, 2, 39 }, { 1, 0, 0, 54 },
+    /* 126 */
+    /* 127 */ { 1, 0, 0, 57 }, { 1, 0, 0, 56 },
+    /* 128 */ { 0, 0, 0, 49 }, { 1, 0, 0, 57 }, { 3, 0, 2, 40 }, { 1, 0, 0, 56 },
+    /* 129 */
+    /* 130 */ { 1, 0, 0, 59 }, { 1, 0, 0, 58 },
+    /* 131 */ { 0, 0, 0, 54 }, { 1, 0, 0, 59 }, { 3, 0, 2, 41 }, { 1, 0, 0, 58 },
+    /* 132 */
+    /* 133 */ { 1, 0, 0, 61 }, { 1, 0, 0, 60 },
+    /* 134 */ { 0, 0, 0, 57 }, { 1, 0, 0, 61 }, { 3, 0, 2, 42 }, { 1, 0, 0, 60 },
+    /* 135 */
+    /* 136 */ { 1, 0, 0, 63 }, { 1, 0, 0, 62 },
+    /* 137 */ { 0, 0, 0, 52 }, { 1, 0, 0, 63 }, { 3, 0, 2, 43 }, { 1, 0, 0, 62 },
+    /* 138 */
+    /* 139 */ { 1, 0, 0, 65 }, { 1, 0, 0, 64 },
+    /* 140 */ { 0, 1, 0, 78 }, { 1, 0, 0, 65 }, { 3, 1, 2, 44 }, { 1, 0, 0, 64 },
+    /* 141 */ { 0, 1, 0, 83 }, { 1, 0, 0, 65 }, { 3, 1, 2, 44 }, { 1, 0, 0, 64 },
+    /* 142 */
+    /* 143 */ { 1, 0, 0, 67 }, { 1, 0, 0, 66 },
+    /* 144 */ { 0, 1, 0, 82 }, { 1, 0, 0, 67 }, { 3, 1, 2, 45 }, { 1, 0, 0, 66 },
+    /* 145 */ { 0, 1, 0, 81 }, { 1, 0, 0, 67 }, { 3, 1, 2, 45 }, { 1, 0, 0, 66 },
+    /* 146 */ { 0, 1, 0, 80 }, { 1, 0, 0, 67 }, { 3, 1, 2, 45 }, { 1, 0, 0, 66 },
+    /* 147 */ { 0, 1, 0, 79 }, { 1, 0, 0, 67 }, { 3, 1, 2, 45 }, { 1, 0, 0, 66 },
+    /* 148 */
+    /* 149 */ { 1, 0, 0, 69 }, { 1, 0, 0, 68 },
+    /* 150 */ { 0, 1, 0, 55 }, { 1, 0, 0, 69 }, { 3, 1, 2, 46 }, { 1, 0, 0, 68 },
+    /* 151 */ { 0, 1, 0, 56 }, { 1, 0, 0, 69 }, { 3, 1, 2, 46 }, { 1, 0, 0, 68 },
+    /* 152 */
+    /* 153 */ { 1, 0, 0, 71 }, { 1, 0, 0, 70 },
+    /* 154 */ { 0, 1, 0, 64 }, { 1, 0, 0, 71 }, { 3, 1, 2, 47 }, { 1, 0, 0, 70 },
+    /* 155 */ { 0, 1, 0, 73 }, { 1, 0, 0, 71 }, { 3, 1, 2, 47 }, { 1, 0, 0, 70 },
+    /* 156 */
+    /* 157 */ { 1, 0, 0, 73 }, { 1, 0, 0, 72 },
+    /* 158 */ { 0, 1, 0, 72 }, { 1, 0, 0, 73 }, { 3, 1, 2, 48 }, { 1, 0, 0, 72 },
+    /* 159 */ { 0, 1, 0, 68 }, { 1, 0, 0, 73 }, { 3, 1, 2, 48 }, { 1, 0, 0, 72 },
+    /* 160 */ { 0, 1, 0, 71 }, { 1, 0, 0, 73 }, { 3, 1, 2, 48 }, { 1, 0, 0, 72 },
+    /* 161 */
+    /* 162 */ { 0, 0, 0, 60 }, { 1, 0, 0, 74 },
+    /* 163 */ { 1, 0, 0, 76 },
+    /* 164 */ { 1, 0, 0, 82 }, { 0, 0, 0, 61 }, { 1, 0, 0, 73 }, { 3, 0, 2, 49 },
+    /* 165 */ { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 1, 0, 0, 79 },
+    /* 166 */ { 0, 0, 0, 60 }, { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 1, 0, 0, 79 },
+    /* 167 */ { 1, 0, 0, 76 },
+    /* 168 */ { 0, 1, 0, 70 }, { 1, 0, 0, 75 }, { 3, 1, 1, 50 },
+    /* 169 */ { 0, 1, 0, 67 }, { 1, 0, 0, 75 }, { 3, 1, 1, 50 },
+    /* 170 */ { 0, 1, 0, 52 }, { 1, 0, 0, 73 }, { 3, 1, 1, 50 },
+    /* 171 */ { 0, 1, 0, 72 }, { 1, 0, 0, 73 }, { 3, 1, 1, 50 },
+    /* 172 */ { 0, 1, 0, 64 }, { 1, 0, 0, 73 }, { 3, 1, 1, 50 },
+    /* 173 */ { 0, 1, 0, 73 }, { 1, 0, 0, 73 }, { 3, 1, 1, 50 },
+    /* 174 */ { 0, 1, 0, 53 }, { 1, 0, 0, 73 }, { 3, 1, 1, 50 },
+    /* 175 */ { 0, 1, 0, 50 }, { 1, 0, 0, 73 }, { 3, 1, 1, 50 },
+    /* 176 */ { 0, 1, 0, 2 }, { 1, 0, 0, 77 }, { 3, 1, 1, 50 },
+    /* 177 */ { 0, 1, 0, 1 }, { 3, 1, 0, 52 }, { 1, 0, 0, 79 },
+    /* 178 */ { 0, 1, 0, 34 }, { 3, 1, 0, 52 }, { 1, 0, 0, 79 },
+    /* 179 */ { 0, 1, 0, 35 }, { 3, 1, 0, 52 }, { 1, 0, 0, 79 },
+    /* 180 */ { 0, 1, 0, 36 }, { 3, 1, 0, 52 }, { 1, 0, 0, 79 },
+    /* 181 */ { 0, 1, 0, 37 }, { 3, 1, 0, 52 }, { 1, 0, 0, 79 },
+    /* 182 */ { 0, 0, 0, 60 }, { 1, 0, 0, 78 },
+    /* 183 */ { 1, 0, 0, 76 },
+    /* 184 */ { 1, 0, 0, 82 }, { 0, 0, 0, 61 },
+    /* 185 */ { 1, 0, 0, 47 }, { 0, 0, 0, 61 }, { 1, 0, 0, 79 },
+    /* 186 */ { 0, 0, 0, 62 }, { 1, 0, 0, 47 }, { 0, 0, 0, 63 }, { 3, 0, 2, 51 }, { 1, 0, 0, 79 },
+    /* 187 */ { 0, 0, 0, 60 }, { 2, 0, 0, 0 }, { 1, 0, 0, 80 }, { 0, 0, 0, 61 }, { 3, 0, -1, 53 }, { 3, 0, 2, 51 }, { 1, 0, 0, 79 },
+    /* 188 */ { 0, 1, 0, 69 }, { 0, 1, 0, 1 }, { 3, 1, 0, 12 }, { 3, 1, 2, 51 }, { 1, 0, 0, 79 },
+    /* 189 */ { 0, 1, 0, 74 }, { 0, 1, 0, 1 }, { 3, 1, 0, 12 }, { 3, 1, 2, 51 }, { 1, 0, 0, 79 },
+    /* 190 */ { 0, 1, 0, 70 }, { 3, 1, 1, 51 }, { 1, 0, 0, 79 },
+    /* 191 */ { 0, 1, 0, 67 }, { 3, 1, 1, 51 }, { 1, 0, 0, 79 },
+    /* 192 */
+    /* 193 */ { 1, 0, 0, 49 }, { 1, 0, 0, 81 },
+    /* 194 */
+    /* 195 */ { 0, 0, 0, 66 }, { 1, 0, 0, 49 }, { 1, 0, 0, 81 },
+    /* 196 */
+    /* 197 */ { 2, 0, 0, 0 }, { 1, 0, 0, 83 }, { 1, 0, 0, 84 }, { 1, 0, 0, 85 }, { 3, 0, -1, 14 },
+    /* 198 */ { 1, 0, 0, 12 },
+    /* 199 */ { 0, 1, 0, 8 }, { 3, 1, 0, 19 },
+    /* 200 */ { 0, 1, 0, 6 }, { 3, 1, 0, 19 },
+    /* 201 */ { 1, 0, 0, 83 }, { 1, 0, 0, 84 },
+    /* 202 */
+    /* 203 */ { 1, 0, 0, 86 },
+    /* 204 */
+    /* 205 */ { 2, 0, 0, 0 }, { 1, 0, 0, 87 }, { 3, 0, -1, 7 },
+    /* 206 */ { 1, 0, 0, 29 }, { 1, 0, 0, 88 },
+    /* 207 */ { 1, 0, 0, 89 },
+    /* 208 */ { 1, 0, 0, 89 },
+    /* 209 */
+    /* 210 */ { 0, 0, 0, 60 }, { 1, 0, 0, 90 },
+    /* 211 */ { 0, 0, 0, 62 }, { 1, 0, 0, 35 }, { 0, 0, 0, 63 }, { 1, 0, 0, 91 },
+    /* 212 */ { 1, 0, 0, 86 }, { 0, 0, 0, 61 }, { 1, 0, 0, 91 },
+    /* 213 */ { 1, 0, 0, 36 }, { 0, 0, 0, 61 }, { 1, 0, 0, 91 },
+    /* 214 */ { 0, 0, 0, 62 }, { 1, 0, 0, 35 }, { 0, 0, 0, 63 }, { 1, 0, 0, 91 },
+    /* 215 */ { 0, 0, 0, 60 }, { 1, 0, 0, 36 }, { 0, 0, 0, 61 }, { 1, 0, 0, 91 },
+    /* 216 */
+};
+
+extern const UINT32 kLL1ProductionBegin[] = {
+    0, 3, 5, 5, 9, 11, 13, 15, 19, 24, 26, 26, 29, 29, 31, 35,
+    37, 39, 41, 43, 45, 46, 48, 48, 50, 52, 54, 56, 58, 60, 62, 64,
+    66, 70, 74, 78, 81, 82, 83, 83, 87, 94, 96, 96, 98, 101, 101, 104,
+    105, 106, 106, 110, 114, 117, 117, 119, 119, 121, 126, 127, 127, 131, 135, 137,
+    139, 139, 141, 141, 144, 146, 150, 154, 154, 155, 156, 160, 161, 164, 166, 166,
+    168, 170, 176, 178, 178, 180, 180, 181, 186, 190, 193, 195, 203, 205, 205, 211,
+    217, 225, 235, 236, 237, 240, 243, 248, 249, 249, 251, 255, 255, 257, 260, 263,
+    266, 269, 272, 275, 278, 281, 284, 287, 290, 290, 292, 297, 297, 299, 303, 303,
+    305, 309, 309, 311, 315, 315, 317, 321, 321, 323, 327, 327, 329, 333, 337, 337,
+    339, 343, 347, 351, 355, 355, 357, 361, 365, 365, 367, 371, 375, 375, 377, 381,
+    385, 389, 389, 391, 392, 396, 399, 403, 404, 407, 410, 413, 416, 419, 422, 425,
+    428, 431, 434, 437, 440, 443, 446, 448, 449, 451, 454, 459, 466, 471, 476, 479,
+    482, 482, 484, 484, 487, 487, 492, 493, 495, 497, 499, 499, 500, 500, 503, 505,
+    506, 507, 507, 509, 513, 516, 519, 523, 527, 527,
+};
+
+// [nonterminal][token type]: production, -1 if syntax error.
+extern const INT16 kLL1Predict[] = {
+    /* 0 */ -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0,
+    /* 1 */ -1, -1, -1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2,
+    /* 2 */ -1, -1, -1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 3 */ -1, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 4 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 6, -1, -1, -1, -1, -1, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 5 */ -1, -1, -1, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 6 */ -1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 7 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 8 */ -1, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 9 */ -1, -1, -1, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 10 */ -1, -1, -1, 15, 18, 19, 20, 16, 20, 17, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 11 */ -1, 22, -1, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 22, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 22, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 22, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 12 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 31, 30, 23, 26, 27, 25, 24, 29, 28, 34, 32, 33, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 13 */ -1, 35, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 36, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 14 */ -1, 38, -1, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 37, -1, 38, 38, 38, -1, -1, -1, -1, -1, -1, -1, -1, -1, 38, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 38, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 15 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 39, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 16 */ -1, -1, -1, -1, -1, -1, 40, -1, 40, -1, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 17 */ -1, -1, -1, -1, -1, -1, 41, -1, 41, -1, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 42, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 18 */ -1, 43, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 43, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 43, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 19 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 44, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 45, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 20 */ -1, 46, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 47, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 21 */ -1, 49, -1, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 48, -1, 49, 49, 49, -1, -1, -1, -1, -1, -1, -1, -1, -1, 49, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 49, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 22 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 50, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 23 */ -1, 51, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 24 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 53, -1, -1, -1, -1, -1, -1, 52, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 25 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 54, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 55, -1, -1, -1, -1, -1, -1, 55, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 26 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 56, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 27 */ -1, 57, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 57, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 57, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 28 */ -1, 59, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 59, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 58, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 29 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 60, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 30 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 61, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 31 */ -1, 64, -1, -1, -1, -1, 63, -1, 62, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 64, 64, 64, -1, -1, -1, -1, -1, -1, -1, -1, -1, 64, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 32 */ -1, 66, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 66, 66, 66, -1, -1, -1, -1, -1, -1, -1, -1, -1, 65, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 33 */ -1, 68, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 34 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 71, -1, 70, 71, 69, -1, -1, -1, 71, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 71, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 35 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 72, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 73, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 36 */ -1, -1, -1, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 75, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 37 */ -1, -1, -1, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 38 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 78, -1, -1, -1, -1, 77, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 39 */ -1, -1, -1, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 79, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 40 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 81, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 41 */ -1, 83, 83, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 83, -1, 83, 83, 83, 83, 83, 83, 83, 83, 83, -1, 83, 83, 83, 83, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 83, -1, 83, 83, -1, -1, -1, -1, 83, 83, 83, -1, -1, -1, 83, -1, -1, 83, -1, -1, 83, -1, 83, 83, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 83, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 42 */ -1, 84, 84, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 84, -1, 84, 84, 84, 84, 84, 84, 84, 84, 84, -1, 84, 84, 84, 84, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 84, -1, 84, 84, -1, -1, -1, -1, 84, 85, 84, -1, -1, -1, 84, -1, -1, 84, -1, -1, 84, -1, 84, 84, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 84, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 43 */ -1, 89, 89, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 91, -1, 96, 95, 97, 94, 87, 88, 101, 100, 102, -1, 89, 89, 89, 89, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 89, -1, 89, 89, -1, -1, -1, -1, 86, -1, 89, -1, -1, -1, 89, -1, -1, 89, -1, -1, 89, -1, 89, 89, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 90, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 44 */ -1, 93, 93, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 93, 92, 93, 93, 93, 93, 93, 93, 93, 93, 93, -1, 93, 93, 93, 93, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 93, -1, 93, 93, -1, -1, -1, -1, 93, 93, 93, -1, -1, -1, 93, -1, -1, 93, -1, -1, 93, -1, 93, 93, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 93, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 45 */ -1, 98, 98, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 98, 98, 98, 98, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 98, -1, 98, 98, -1, -1, -1, -1, -1, -1, 98, 99, -1, -1, 98, -1, -1, 98, -1, -1, 98, -1, 98, 98, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 99, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 46 */ -1, 103, 103, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 103, 103, 103, 103, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 103, -1, 103, 103, -1, -1, -1, -1, -1, -1, 103, -1, -1, -1, 103, -1, -1, 103, -1, -1, 103, -1, 103, 103, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 104, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 47 */ -1, 105, 105, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 105, 105, 105, 105, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 105, -1, 105, 105, -1, -1, -1, -1, -1, -1, 105, -1, -1, -1, 105, -1, -1, 105, -1, -1, 105, -1, 105, 105, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 48 */ 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 106, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+    /* 49 */ -1, 108, 108, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 108, 108, 108, 108, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 108, -1, 108, 108, -1, -1, -1, -1, -1, -1, 108, -1, -1, -1, 108, -1, -1, 108, -1, -1, 108, -1, 108, 108, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 50 */ 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120,
+    /* 51 */ -1, 121, 121, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 121, 121, 121, 121, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 121, -1, 121, 121, -1, -1, -1, -1, -1, -1, 121, -1, -1, -1, 121, -1, -1, 121, -1, -1, 121, -1, 121, 121, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 52 */ 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 122, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123,
+    /* 53 */ -1, 124, 124, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 124, 124, 124, 124, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 124, -1, 124, 124, -1, -1, -1, -1, -1, -1, 124, -1, -1, -1, 124, -1, -1, 124, -1, -1, 124, -1, 124, 124, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 54 */ 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 125, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126,
+    /* 55 */ -1, 127, 127, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 127, 127, 127, 127, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 127, -1, 127, 127, -1, -1, -1, -1, -1, -1, 127, -1, -1, -1, 127, -1, -1, 127, -1, -1, 127, -1, 127, 127, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 56 */ 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 128, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129,
+    /* 57 */ -1, 130, 130, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 130, 130, 130, 130, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 130, -1, 130, 130, -1, -1, -1, -1, -1, -1, 130, -1, -1, -1, 130, -1, -1, 130, -1, -1, 130, -1, 130, 130, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 58 */ 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 131, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+    /* 59 */ -1, 133, 133, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 133, 133, 133, 133, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 133, -1, 133, 133, -1, -1, -1, -1, -1, -1, 133, -1, -1, -1, 133, -1, -1, 133, -1, -1, 133, -1, 133, 133, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 60 */ 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 134, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135,
+    /* 61 */ -1, 136, 136, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 136, 136, 136, 136, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 136, -1, 136, 136, -1, -1, -1, -1, -1, -1, 136, -1, -1, -1, 136, -1, -1, 136, -1, -1, 136, -1, 136, 136, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 62 */ 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 137, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138,
+    /* 63 */ -1, 139, 139, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 139, 139, 139, 139, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 139, -1, 139, 139, -1, -1, -1, -1, -1, -1, 139, -1, -1, -1, 139, -1, -1, 139, -1, -1, 139, -1, 139, 139, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 64 */ 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 140, 142, 142, 142, 142, 141, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142,
+    /* 65 */ -1, 143, 143, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 143, 143, 143, 143, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 143, -1, 143, 143, -1, -1, -1, -1, -1, -1, 143, -1, -1, -1, 143, -1, -1, 143, -1, -1, 143, -1, 143, 143, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 66 */ 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 147, 146, 145, 144, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148,
+    /* 67 */ -1, 149, 149, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 149, 149, 149, 149, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 149, -1, 149, 149, -1, -1, -1, -1, -1, -1, 149, -1, -1, -1, 149, -1, -1, 149, -1, -1, 149, -1, 149, 149, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 68 */ 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 150, 151, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152,
+    /* 69 */ -1, 153, 153, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 153, 153, 153, 153, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 153, -1, 153, 153, -1, -1, -1, -1, -1, -1, 153, -1, -1, -1, 153, -1, -1, 153, -1, -1, 153, -1, 153, 153, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 70 */ 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 154, 156, 156, 156, 156, 156, 156, 156, 156, 155, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156,
+    /* 71 */ -1, 157, 157, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 157, 157, 157, 157, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 157, -1, 157, 157, -1, -1, -1, -1, -1, -1, 157, -1, -1, -1, 157, -1, -1, 157, -1, -1, 157, -1, 157, 157, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 72 */ 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 159, 161, 161, 160, 158, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161,
+    /* 73 */ -1, 163, 163, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 163, 163, 163, 163, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 163, -1, 163, 163, -1, -1, -1, -1, -1, -1, 162, -1, -1, -1, 163, -1, -1, 163, -1, -1, 163, -1, 163, 163, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 74 */ -1, 165, 165, -1, -1, -1, 164, -1, 164, -1, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 165, 165, 165, 165, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 165, -1, 165, 165, -1, -1, -1, -1, -1, -1, 165, -1, -1, -1, 165, -1, -1, 165, -1, -1, 165, -1, 165, 165, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 75 */ -1, 167, 167, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 167, 167, 167, 167, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 167, -1, 167, 167, -1, -1, -1, -1, -1, -1, 166, -1, -1, -1, 167, -1, -1, 167, -1, -1, 167, -1, 167, 167, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 76 */ -1, 177, 176, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 178, 179, 180, 181, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 175, -1, 170, 174, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 172, -1, -1, 169, -1, -1, 168, -1, 171, 173, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 77 */ -1, 183, 183, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 183, 183, 183, 183, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 183, -1, 183, 183, -1, -1, -1, -1, -1, -1, 182, -1, -1, -1, 183, -1, -1, 183, -1, -1, 183, -1, 183, 183, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 78 */ -1, 185, 185, -1, -1, -1, 184, -1, 184, -1, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 185, 185, 185, 185, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 185, -1, 185, 185, -1, -1, -1, -1, -1, -1, 185, -1, -1, -1, 185, -1, -1, 185, -1, -1, 185, -1, 185, 185, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 79 */ 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 187, 192, 186, 192, 192, 192, 192, 191, 192, 188, 190, 192, 192, 192, 189, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+    /* 80 */ -1, 193, 193, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 193, 193, 193, 193, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 193, -1, 193, 193, -1, -1, -1, -1, -1, -1, 193, 194, -1, -1, 193, -1, -1, 193, -1, -1, 193, -1, 193, 193, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 81 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 196, -1, -1, -1, -1, 195, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 82 */ -1, -1, -1, -1, -1, -1, 197, -1, 197, -1, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 83 */ -1, -1, -1, -1, -1, -1, 200, -1, 199, -1, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 84 */ -1, 202, -1, -1, -1, -1, 201, -1, 201, -1, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 202, 202, 202, -1, -1, -1, -1, -1, -1, -1, -1, -1, 202, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 85 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 203, 204, 203, -1, -1, -1, -1, -1, -1, -1, -1, -1, 203, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 86 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 205, -1, 205, -1, -1, -1, -1, -1, -1, -1, -1, -1, 205, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 87 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 207, -1, 207, -1, -1, -1, -1, -1, -1, -1, -1, -1, 206, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 88 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 208, 209, 208, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 89 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 210, -1, 211, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 90 */ -1, -1, -1, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 212, 213, 212, -1, -1, -1, -1, -1, -1, -1, -1, -1, 212, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 91 */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 215, 216, 214, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
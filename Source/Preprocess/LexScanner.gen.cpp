@@ -0,0 +1,1468 @@
+// Generated by GenerateScannerSource(), do not edit.
+// 68 patterns, 128 dfa states.
+
+#include "RegexMatcher.h"
+
+extern const UINT64 kLexScannerFingerprint = 0x970ff65e7eeab6ceull;
+
+static const DfaAccel kAccel2 = { 0, { 0, 0, 0 }, 3, { 9, 13, 32, 0 }, { 9, 13, 32, 0 } };
+static const DfaAccel kAccel5 = { 2, { 34, 92, 0 }, 0, { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+static const DfaAccel kAccel19 = { 0, { 0, 0, 0 }, 1, { 48, 0, 0, 0 }, { 57, 0, 0, 0 } };
+static const DfaAccel kAccel26 = { 0, { 0, 0, 0 }, 4, { 48, 65, 95, 97 }, { 57, 90, 95, 122 } };
+static const DfaAccel kAccel48 = { 2, { 39, 92, 0 }, 0, { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+static const DfaAccel kAccel57 = { 0, { 0, 0, 0 }, 1, { 48, 0, 0, 0 }, { 57, 0, 0, 0 } };
+static const DfaAccel kAccel60 = { 0, { 0, 0, 0 }, 4, { 76, 85, 108, 117 }, { 76, 85, 108, 117 } };
+static const DfaAccel kAccel62 = { 3, { 32, 62, 92 }, 0, { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+static const DfaAccel kAccel87 = { 0, { 0, 0, 0 }, 1, { 48, 0, 0, 0 }, { 57, 0, 0, 0 } };
+static const DfaAccel kAccel88 = { 0, { 0, 0, 0 }, 3, { 48, 65, 97, 0 }, { 57, 70, 102, 0 } };
+
+MatchResult LexScan(const char * begin, const char * end)
+{
+    size_t matchedLength = 0;
+    size_t matchedBranch = 0;
+    const char * pos = begin;
+
+    goto s0;
+s0:
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+        case 8: case 11: case 12: case 14: case 15: case 16: case 17: case 18:
+        case 19: case 20: case 21: case 22: case 23: case 24: case 25: case 26:
+        case 27: case 28: case 29: case 30: case 31: case 36: case 64: case 92:
+        case 96: case 127:
+            goto done;
+        case 9: case 13: case 32:
+            goto s2;
+        case 10:
+            goto s3;
+        case 33:
+            goto s4;
+        case 34:
+            goto s5;
+        case 35:
+            goto s6;
+        case 37:
+            goto s7;
+        case 38:
+            goto s8;
+        case 39:
+            goto s9;
+        case 40:
+            goto s10;
+        case 41:
+            goto s11;
+        case 42:
+            goto s12;
+        case 43:
+            goto s13;
+        case 44:
+            goto s14;
+        case 45:
+            goto s15;
+        case 46:
+            goto s16;
+        case 47:
+            goto s17;
+        case 48:
+            goto s18;
+        case 49: case 50: case 51: case 52: case 53: case 54: case 55: case 56:
+        case 57:
+            goto s19;
+        case 58:
+            goto s20;
+        case 59:
+            goto s21;
+        case 60:
+            goto s22;
+        case 61:
+            goto s23;
+        case 62:
+            goto s24;
+        case 63:
+            goto s25;
+        case 91:
+            goto s27;
+        case 93:
+            goto s28;
+        case 94:
+            goto s29;
+        case 123:
+            goto s30;
+        case 124:
+            goto s31;
+        case 125:
+            goto s32;
+        case 126:
+            goto s33;
+        default:
+            goto s26;
+    }
+s2:
+    pos = SkipRun(kAccel2, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 67;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 9: case 13: case 32:
+            goto s2;
+        default:
+            goto done;
+    }
+s3:
+    matchedLength = pos - begin;
+    matchedBranch = 68;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s4:
+    matchedLength = pos - begin;
+    matchedBranch = 66;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s34;
+        default:
+            goto done;
+    }
+s5:
+    pos = SkipRun(kAccel5, pos, end);
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 34:
+            goto s35;
+        case 92:
+            goto s36;
+        default:
+            goto s5;
+    }
+s6:
+    matchedLength = pos - begin;
+    matchedBranch = 64;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 9: case 32:
+            goto s37;
+        case 35:
+            goto s38;
+        case 100:
+            goto s39;
+        case 101:
+            goto s40;
+        case 105:
+            goto s41;
+        case 108:
+            goto s42;
+        case 112:
+            goto s43;
+        case 117:
+            goto s44;
+        default:
+            goto done;
+    }
+s7:
+    matchedLength = pos - begin;
+    matchedBranch = 62;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s45;
+        default:
+            goto done;
+    }
+s8:
+    matchedLength = pos - begin;
+    matchedBranch = 60;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 38:
+            goto s46;
+        case 61:
+            goto s47;
+        default:
+            goto done;
+    }
+s9:
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 39:
+            goto done;
+        case 92:
+            goto s49;
+        default:
+            goto s48;
+    }
+s10:
+    matchedLength = pos - begin;
+    matchedBranch = 57;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s11:
+    matchedLength = pos - begin;
+    matchedBranch = 56;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s12:
+    matchedLength = pos - begin;
+    matchedBranch = 55;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s50;
+        default:
+            goto done;
+    }
+s13:
+    matchedLength = pos - begin;
+    matchedBranch = 53;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 43:
+            goto s51;
+        case 61:
+            goto s52;
+        default:
+            goto done;
+    }
+s14:
+    matchedLength = pos - begin;
+    matchedBranch = 50;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s15:
+    matchedLength = pos - begin;
+    matchedBranch = 49;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 45:
+            goto s53;
+        case 61:
+            goto s54;
+        case 62:
+            goto s55;
+        default:
+            goto done;
+    }
+s16:
+    matchedLength = pos - begin;
+    matchedBranch = 45;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 46:
+            goto s56;
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s57;
+        default:
+            goto done;
+    }
+s17:
+    matchedLength = pos - begin;
+    matchedBranch = 43;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s58;
+        default:
+            goto done;
+    }
+s18:
+    matchedLength = pos - begin;
+    matchedBranch = 15;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 46:
+            goto s57;
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s19;
+        case 69: case 101:
+            goto s59;
+        case 76: case 85: case 108: case 117:
+            goto s60;
+        case 88: case 120:
+            goto s61;
+        default:
+            goto done;
+    }
+s19:
+    pos = SkipRun(kAccel19, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 15;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 46:
+            goto s57;
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s19;
+        case 69: case 101:
+            goto s59;
+        case 76: case 85: case 108: case 117:
+            goto s60;
+        default:
+            goto done;
+    }
+s20:
+    matchedLength = pos - begin;
+    matchedBranch = 41;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s21:
+    matchedLength = pos - begin;
+    matchedBranch = 40;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s22:
+    matchedLength = pos - begin;
+    matchedBranch = 39;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32: case 62:
+            goto done;
+        case 60:
+            goto s63;
+        case 61:
+            goto s64;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s23:
+    matchedLength = pos - begin;
+    matchedBranch = 35;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s66;
+        default:
+            goto done;
+    }
+s24:
+    matchedLength = pos - begin;
+    matchedBranch = 33;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s67;
+        case 62:
+            goto s68;
+        default:
+            goto done;
+    }
+s25:
+    matchedLength = pos - begin;
+    matchedBranch = 29;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s26:
+    pos = SkipRun(kAccel26, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 1;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57: case 65: case 66: case 67: case 68: case 69: case 70:
+        case 71: case 72: case 73: case 74: case 75: case 76: case 77: case 78:
+        case 79: case 80: case 81: case 82: case 83: case 84: case 85: case 86:
+        case 87: case 88: case 89: case 90: case 95: case 97: case 98: case 99:
+        case 100: case 101: case 102: case 103: case 104: case 105: case 106: case 107:
+        case 108: case 109: case 110: case 111: case 112: case 113: case 114: case 115:
+        case 116: case 117: case 118: case 119: case 120: case 121: case 122:
+            goto s26;
+        default:
+            goto done;
+    }
+s27:
+    matchedLength = pos - begin;
+    matchedBranch = 28;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s28:
+    matchedLength = pos - begin;
+    matchedBranch = 27;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s29:
+    matchedLength = pos - begin;
+    matchedBranch = 26;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s69;
+        default:
+            goto done;
+    }
+s30:
+    matchedLength = pos - begin;
+    matchedBranch = 24;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s31:
+    matchedLength = pos - begin;
+    matchedBranch = 23;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s70;
+        case 124:
+            goto s71;
+        default:
+            goto done;
+    }
+s32:
+    matchedLength = pos - begin;
+    matchedBranch = 20;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s33:
+    matchedLength = pos - begin;
+    matchedBranch = 19;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s34:
+    matchedLength = pos - begin;
+    matchedBranch = 65;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s35:
+    matchedLength = pos - begin;
+    matchedBranch = 17;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s36:
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 34:
+            goto s72;
+        case 92:
+            goto s36;
+        default:
+            goto s5;
+    }
+s37:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 9: case 32:
+            goto s37;
+        case 100:
+            goto s39;
+        case 101:
+            goto s40;
+        case 105:
+            goto s41;
+        case 108:
+            goto s42;
+        case 112:
+            goto s43;
+        case 117:
+            goto s44;
+        default:
+            goto done;
+    }
+s38:
+    matchedLength = pos - begin;
+    matchedBranch = 63;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s39:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s73;
+        default:
+            goto done;
+    }
+s40:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 108:
+            goto s74;
+        case 110:
+            goto s75;
+        case 114:
+            goto s76;
+        default:
+            goto done;
+    }
+s41:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s77;
+        case 110:
+            goto s78;
+        default:
+            goto done;
+    }
+s42:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 105:
+            goto s79;
+        default:
+            goto done;
+    }
+s43:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 114:
+            goto s80;
+        default:
+            goto done;
+    }
+s44:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 110:
+            goto s81;
+        default:
+            goto done;
+    }
+s45:
+    matchedLength = pos - begin;
+    matchedBranch = 61;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s46:
+    matchedLength = pos - begin;
+    matchedBranch = 59;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s47:
+    matchedLength = pos - begin;
+    matchedBranch = 58;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s48:
+    pos = SkipRun(kAccel48, pos, end);
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 39:
+            goto s82;
+        case 92:
+            goto s49;
+        default:
+            goto s48;
+    }
+s49:
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 39:
+            goto s83;
+        case 92:
+            goto s49;
+        default:
+            goto s48;
+    }
+s50:
+    matchedLength = pos - begin;
+    matchedBranch = 54;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s51:
+    matchedLength = pos - begin;
+    matchedBranch = 52;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s52:
+    matchedLength = pos - begin;
+    matchedBranch = 51;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s53:
+    matchedLength = pos - begin;
+    matchedBranch = 48;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s54:
+    matchedLength = pos - begin;
+    matchedBranch = 47;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s55:
+    matchedLength = pos - begin;
+    matchedBranch = 46;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s56:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 46:
+            goto s84;
+        default:
+            goto done;
+    }
+s57:
+    pos = SkipRun(kAccel57, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 14;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s57;
+        case 69: case 101:
+            goto s59;
+        case 70: case 76: case 102: case 108:
+            goto s85;
+        default:
+            goto done;
+    }
+s58:
+    matchedLength = pos - begin;
+    matchedBranch = 42;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s59:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 43: case 45:
+            goto s86;
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s87;
+        default:
+            goto done;
+    }
+s60:
+    pos = SkipRun(kAccel60, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 15;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 76: case 85: case 108: case 117:
+            goto s60;
+        default:
+            goto done;
+    }
+s61:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57: case 65: case 66: case 67: case 68: case 69: case 70:
+        case 97: case 98: case 99: case 100: case 101: case 102:
+            goto s88;
+        default:
+            goto done;
+    }
+s62:
+    pos = SkipRun(kAccel62, pos, end);
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32:
+            goto done;
+        case 62:
+            goto s89;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s63:
+    matchedLength = pos - begin;
+    matchedBranch = 38;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32:
+            goto done;
+        case 61:
+            goto s90;
+        case 62:
+            goto s89;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s64:
+    matchedLength = pos - begin;
+    matchedBranch = 36;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32:
+            goto done;
+        case 62:
+            goto s89;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s65:
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32:
+            goto done;
+        case 62:
+            goto s91;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s66:
+    matchedLength = pos - begin;
+    matchedBranch = 34;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s67:
+    matchedLength = pos - begin;
+    matchedBranch = 32;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s68:
+    matchedLength = pos - begin;
+    matchedBranch = 31;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 61:
+            goto s92;
+        default:
+            goto done;
+    }
+s69:
+    matchedLength = pos - begin;
+    matchedBranch = 25;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s70:
+    matchedLength = pos - begin;
+    matchedBranch = 22;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s71:
+    matchedLength = pos - begin;
+    matchedBranch = 21;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s72:
+    matchedLength = pos - begin;
+    matchedBranch = 17;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 34:
+            goto s35;
+        case 92:
+            goto s36;
+        default:
+            goto s5;
+    }
+s73:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s93;
+        default:
+            goto done;
+    }
+s74:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 105:
+            goto s94;
+        case 115:
+            goto s95;
+        default:
+            goto done;
+    }
+s75:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 100:
+            goto s96;
+        default:
+            goto done;
+    }
+s76:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 114:
+            goto s97;
+        default:
+            goto done;
+    }
+s77:
+    matchedLength = pos - begin;
+    matchedBranch = 8;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 100:
+            goto s98;
+        case 110:
+            goto s99;
+        default:
+            goto done;
+    }
+s78:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 99:
+            goto s100;
+        default:
+            goto done;
+    }
+s79:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 110:
+            goto s101;
+        default:
+            goto done;
+    }
+s80:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 97:
+            goto s102;
+        default:
+            goto done;
+    }
+s81:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 100:
+            goto s103;
+        default:
+            goto done;
+    }
+s82:
+    matchedLength = pos - begin;
+    matchedBranch = 16;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s83:
+    matchedLength = pos - begin;
+    matchedBranch = 16;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 39:
+            goto s82;
+        case 92:
+            goto s49;
+        default:
+            goto s48;
+    }
+s84:
+    matchedLength = pos - begin;
+    matchedBranch = 44;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s85:
+    matchedLength = pos - begin;
+    matchedBranch = 14;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s86:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s87;
+        default:
+            goto done;
+    }
+s87:
+    pos = SkipRun(kAccel87, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 14;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57:
+            goto s87;
+        case 70: case 76: case 102: case 108:
+            goto s85;
+        default:
+            goto done;
+    }
+s88:
+    pos = SkipRun(kAccel88, pos, end);
+    matchedLength = pos - begin;
+    matchedBranch = 15;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55:
+        case 56: case 57: case 65: case 66: case 67: case 68: case 69: case 70:
+        case 97: case 98: case 99: case 100: case 101: case 102:
+            goto s88;
+        case 76: case 85: case 108: case 117:
+            goto s60;
+        default:
+            goto done;
+    }
+s89:
+    matchedLength = pos - begin;
+    matchedBranch = 18;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s90:
+    matchedLength = pos - begin;
+    matchedBranch = 37;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32:
+            goto done;
+        case 62:
+            goto s89;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s91:
+    matchedLength = pos - begin;
+    matchedBranch = 18;
+    if (pos == end) goto done;
+    if (*pos < 0) goto done;
+    switch (*pos++)
+    {
+        case 32:
+            goto done;
+        case 62:
+            goto s89;
+        case 92:
+            goto s65;
+        default:
+            goto s62;
+    }
+s92:
+    matchedLength = pos - begin;
+    matchedBranch = 30;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s93:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 105:
+            goto s104;
+        default:
+            goto done;
+    }
+s94:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s105;
+        default:
+            goto done;
+    }
+s95:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s106;
+        default:
+            goto done;
+    }
+s96:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 105:
+            goto s107;
+        default:
+            goto done;
+    }
+s97:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 111:
+            goto s108;
+        default:
+            goto done;
+    }
+s98:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s109;
+        default:
+            goto done;
+    }
+s99:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 100:
+            goto s110;
+        default:
+            goto done;
+    }
+s100:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 108:
+            goto s111;
+        default:
+            goto done;
+    }
+s101:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s112;
+        default:
+            goto done;
+    }
+s102:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 103:
+            goto s113;
+        default:
+            goto done;
+    }
+s103:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s114;
+        default:
+            goto done;
+    }
+s104:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 110:
+            goto s115;
+        default:
+            goto done;
+    }
+s105:
+    matchedLength = pos - begin;
+    matchedBranch = 12;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s106:
+    matchedLength = pos - begin;
+    matchedBranch = 11;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s107:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s116;
+        default:
+            goto done;
+    }
+s108:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 114:
+            goto s117;
+        default:
+            goto done;
+    }
+s109:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s118;
+        default:
+            goto done;
+    }
+s110:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s119;
+        default:
+            goto done;
+    }
+s111:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 117:
+            goto s120;
+        default:
+            goto done;
+    }
+s112:
+    matchedLength = pos - begin;
+    matchedBranch = 4;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s113:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 109:
+            goto s121;
+        default:
+            goto done;
+    }
+s114:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s122;
+        default:
+            goto done;
+    }
+s115:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s123;
+        default:
+            goto done;
+    }
+s116:
+    matchedLength = pos - begin;
+    matchedBranch = 10;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s117:
+    matchedLength = pos - begin;
+    matchedBranch = 9;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s118:
+    matchedLength = pos - begin;
+    matchedBranch = 7;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s119:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 102:
+            goto s124;
+        default:
+            goto done;
+    }
+s120:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 100:
+            goto s125;
+        default:
+            goto done;
+    }
+s121:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 97:
+            goto s126;
+        default:
+            goto done;
+    }
+s122:
+    matchedLength = pos - begin;
+    matchedBranch = 2;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s123:
+    matchedLength = pos - begin;
+    matchedBranch = 13;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s124:
+    matchedLength = pos - begin;
+    matchedBranch = 6;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s125:
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        case 101:
+            goto s127;
+        default:
+            goto done;
+    }
+s126:
+    matchedLength = pos - begin;
+    matchedBranch = 3;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+s127:
+    matchedLength = pos - begin;
+    matchedBranch = 5;
+    if (pos == end) goto done;
+    switch (*pos++)
+    {
+        default:
+            goto done;
+    }
+done:
+    return { 0, matchedLength, matchedBranch };
+}
+
+// Keyword perfect hash, see ClassifyKeyword().
+
+extern const UINT64 kLexKeywordFingerprint = 0x4b5d74788a61f7b6ull;
+extern const int kLexKeywordBuckets = 8;
+extern const UINT32 kLexKeywordDisp[] = { 2073, 42, 78, 18, 5, 105, 66, 2 };
+extern const int kLexKeywordSlot[] = { 28, 29, 8, 6, 23, 26, 31, 2, 19, 14, 1, 22, 3, 0, 16, 5, 25, 21, 27, 15, 4, 11, 13, 20, 17, 24, 7, 30, 10, 18, 9, 12 };
@@ -6,64 +6,72 @@
 #include <map>
 #include <set>
 #include <variant>
+#include <tuple>
 #include <algorithm>
 #include <memory>
 #include <iostream>
+#include <cstring>
+#include <sstream>
 
 #include "Lexer.h"
+#include "Literal.h"
 #include "../Base/File.h"
 
 
 // ==== C Lex Definition ====
 
+// Keywords are not part of the DFA: the ID pattern matches them and
+// ClassifyKeyword() re-types the token through a perfect hash.
+static std::vector<std::pair<std::string, Token::Type>> LexKeywords = {
+    { "while", Token::KW_WHILE },
+    { "volatile", Token::KW_VOLATILE },
+    { "void", Token::KW_VOID },
+    { "unsigned", Token::KW_UNSIGNED },
+    { "union", Token::KW_UNION },
+    { "typedef", Token::KW_TYPEDEF },
+    { "switch", Token::KW_SWITCH },
+    { "struct", Token::KW_STRUCT },
+    { "static", Token::KW_STATIC },
+    { "sizeof", Token::KW_SIZEOF },
+    { "signed", Token::KW_SIGNED },
+    { "short", Token::KW_SHORT },
+    { "return", Token::KW_RETURN },
+    { "register", Token::KW_REGISTER },
+    { "long", Token::KW_LONG },
+    { "int", Token::KW_INT },
+    { "if", Token::KW_IF },
+    { "goto", Token::KW_GOTO },
+    { "for", Token::KW_FOR },
+    { "float", Token::KW_FLOAT },
+    { "extern", Token::KW_EXTERN },
+    { "enum", Token::KW_ENUM },
+    { "else", Token::KW_ELSE },
+    { "double", Token::KW_DOUBLE },
+    { "do", Token::KW_DO },
+    { "default", Token::KW_DEFAULT },
+    { "continue", Token::KW_CONTINUE },
+    { "const", Token::KW_CONST },
+    { "char", Token::KW_CHAR },
+    { "case", Token::KW_CASE },
+    { "break", Token::KW_BREAK },
+    { "auto", Token::KW_AUTO },
+};
 static std::vector<std::string> LexPatterns = {
-    "while",
-    "volatile",
-    "void",
-    "unsigned",
-    "union",
-    "typedef",
-    "switch",
-    "struct",
-    "static",
-    "sizeof",
-    "signed",
-    "short",
-    "return",
-    "register",
-    "long",
-    "int",
-    "if",
-    "goto",
-    "for",
-    "float",
-    "extern",
-    "enum",
-    "else",
-    "double",
-    "do",
-    "default",
-    "continue",
-    "const",
-    "char",
-    "case",
-    "break",
-    "auto",
     "[_a-zA-Z][_a-zA-Z0-9]*",
-    "#undef",
-    "#pragma",
-    "#line",
-    "#include",
-    "#ifndef",
-    "#ifdef",
-    "#if",
-    "#error",
-    "#endif",
-    "#else",
-    "#elif",
-    "#define",
-    "[0-9]+\\.[0-9]*|\\.[0-9]+", // float
-    "[0-9]+", // int
+    "#[ \t]*undef",
+    "#[ \t]*pragma",
+    "#[ \t]*line",
+    "#[ \t]*include",
+    "#[ \t]*ifndef",
+    "#[ \t]*ifdef",
+    "#[ \t]*if",
+    "#[ \t]*error",
+    "#[ \t]*endif",
+    "#[ \t]*else",
+    "#[ \t]*elif",
+    "#[ \t]*define",
+    "([0-9]+\\.[0-9]*|\\.[0-9]+)([eE](\\+|-)?[0-9]+)?[fFlL]?|[0-9]+[eE](\\+|-)?[0-9]+[fFlL]?", // float
+    "(0[xX][0-9a-fA-F]+|[0-9]+)[uUlL]*", // int
     "'([^']|\\\\')+'", // char
     "\"([^\"]|\\\\\")*\"", // string or pp-local-path
     "<([^> ]|\\\\>)+>", // pp-env-path
@@ -72,38 +80,6 @@ static std::vector<std::string> LexPatterns = {
     /* NEW LINE  */ "\n",
 };
 static std::vector<Token::Type> LexTypes = {
-    Token::KW_WHILE,
-    Token::KW_VOLATILE,
-    Token::KW_VOID,
-    Token::KW_UNSIGNED,
-    Token::KW_UNION,
-    Token::KW_TYPEDEF,
-    Token::KW_SWITCH,
-    Token::KW_STRUCT,
-    Token::KW_STATIC,
-    Token::KW_SIZEOF,
-    Token::KW_SIGNED,
-    Token::KW_SHORT,
-    Token::KW_RETURN,
-    Token::KW_REGISTER,
-    Token::KW_LONG,
-    Token::KW_INT,
-    Token::KW_IF,
-    Token::KW_GOTO,
-    Token::KW_FOR,
-    Token::KW_FLOAT,
-    Token::KW_EXTERN,
-    Token::KW_ENUM,
-    Token::KW_ELSE,
-    Token::KW_DOUBLE,
-    Token::KW_DO,
-    Token::KW_DEFAULT,
-    Token::KW_CONTINUE,
-    Token::KW_CONST,
-    Token::KW_CHAR,
-    Token::KW_CASE,
-    Token::KW_BREAK,
-    Token::KW_AUTO,
     Token::ID,
     Token::PPD_UNDEF,
     Token::PPD_PRAGMA,
@@ -128,6 +104,168 @@ static std::vector<Token::Type> LexTypes = {
     Token::END,
 };
 
+// ==== Generated Scanner ====
+
+// LexScanner.gen.cpp, regenerate with `cc.exe --gen-scanner <file>` after editing LexPatterns/LexKeywords.
+extern const UINT64 kLexScannerFingerprint;
+MatchResult LexScan(const char * begin, const char * end);
+
+extern const UINT64 kLexKeywordFingerprint;
+extern const int kLexKeywordBuckets;
+extern const UINT32 kLexKeywordDisp[];
+extern const int kLexKeywordSlot[];
+
+MatchEngine CompileLexPatterns()
+{
+    // Fall back to runtime DFA construction if generated scanner is stale.
+    if (kLexScannerFingerprint == PatternsFingerprint(LexPatterns))
+        return FromScanner(LexScan);
+    else
+        return Compile(LexPatterns);
+}
+
+// ==== Keyword Perfect Hash ====
+
+// Minimal perfect hash (hash and displace) keyed by (length, first char,
+// last char), which is unique among C keywords:
+//
+//      bucket = Mix(key, 0) % buckets
+//      slot   = Mix(key, disp[bucket]) % keywords
+//
+// slot[] maps back to LexKeywords, one string compare confirms the match.
+struct KeywordHash
+{
+    std::vector<UINT32> disp;
+    std::vector<int> slot;
+};
+
+static inline UINT32 KeywordKey(const char * text, size_t length)
+{
+    return static_cast<UINT32>(length) |
+        (static_cast<UINT32>(static_cast<unsigned char>(text[0])) << 8) |
+        (static_cast<UINT32>(static_cast<unsigned char>(text[length - 1])) << 16);
+}
+static inline UINT32 KeywordMix(UINT32 key, UINT32 seed)
+{
+    UINT32 h = key ^ (seed * 0x9E3779B1u);
+    h = (h ^ (h >> 16)) * 0x85EBCA6Bu;
+    h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+    return h ^ (h >> 16);
+}
+
+KeywordHash BuildKeywordHash()
+{
+    const int n = static_cast<int>(LexKeywords.size());
+    const int buckets = (n + 3) / 4;
+
+    std::vector<std::vector<int>> bucketKeys(buckets);
+    for (int i = 0; i < n; ++i)
+    {
+        const std::string & kw = LexKeywords[i].first;
+        bucketKeys[KeywordMix(KeywordKey(kw.data(), kw.size()), 0) % buckets].push_back(i);
+    }
+
+    // Place large buckets first, they are hardest to fit.
+    std::vector<int> order(buckets);
+    for (int b = 0; b < buckets; ++b)
+        order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return bucketKeys[a].size() > bucketKeys[b].size();
+    });
+
+    KeywordHash kh;
+    kh.disp.assign(buckets, 0);
+    kh.slot.assign(n, -1);
+    for (int b : order)
+    {
+        UINT32 d = 1;
+        for (; d < 0x100000u; ++d)
+        {
+            std::vector<int> slots;
+            for (int i : bucketKeys[b])
+            {
+                const std::string & kw = LexKeywords[i].first;
+                int s = static_cast<int>(KeywordMix(KeywordKey(kw.data(), kw.size()), d) % n);
+                if (kh.slot[s] != -1 || std::find(slots.begin(), slots.end(), s) != slots.end())
+                    break;
+                slots.push_back(s);
+            }
+            if (slots.size() == bucketKeys[b].size())
+            {
+                for (size_t k = 0; k < slots.size(); ++k)
+                    kh.slot[slots[k]] = bucketKeys[b][k];
+                break;
+            }
+        }
+        if (d == 0x100000u)
+            throw std::invalid_argument("Lex error: can't build keyword hash.");
+        kh.disp[b] = d;
+    }
+    return kh;
+}
+
+static std::vector<std::string> KeywordTexts()
+{
+    std::vector<std::string> texts;
+    for (auto & kw : LexKeywords)
+        texts.push_back(kw.first);
+    return texts;
+}
+
+static const KeywordHash & GetKeywordHash()
+{
+    // Fall back to runtime construction if generated tables are stale.
+    static KeywordHash kh = []() {
+        if (kLexKeywordFingerprint != PatternsFingerprint(KeywordTexts()))
+            return BuildKeywordHash();
+        KeywordHash gen;
+        gen.disp.assign(kLexKeywordDisp, kLexKeywordDisp + kLexKeywordBuckets);
+        gen.slot.assign(kLexKeywordSlot, kLexKeywordSlot + LexKeywords.size());
+        return gen;
+    }();
+    return kh;
+}
+
+// Returns KW_* if text is a keyword, else ID.
+Token::Type ClassifyKeyword(const char * text, size_t length)
+{
+    if (length < 2 || length > 8)
+        return Token::ID;
+
+    const KeywordHash & kh = GetKeywordHash();
+    UINT32 key = KeywordKey(text, length);
+    UINT32 d = kh.disp[KeywordMix(key, 0) % kh.disp.size()];
+    const auto & kw = LexKeywords[kh.slot[KeywordMix(key, d) % kh.slot.size()]];
+
+    if (kw.first.size() == length && memcmp(kw.first.data(), text, length) == 0)
+        return kw.second;
+    else
+        return Token::ID;
+}
+
+void GenerateLexScanner(std::string fileName)
+{
+    KeywordHash kh = BuildKeywordHash();
+
+    std::ostringstream os;
+    os << GenerateScannerSource(LexPatterns, "LexScan", "kLexScannerFingerprint")
+       << std::endl
+       << "// Keyword perfect hash, see ClassifyKeyword()." << std::endl
+       << std::endl
+       << "extern const UINT64 kLexKeywordFingerprint = 0x" << std::hex << PatternsFingerprint(KeywordTexts()) << std::dec << "ull;" << std::endl
+       << "extern const int kLexKeywordBuckets = " << kh.disp.size() << ";" << std::endl
+       << "extern const UINT32 kLexKeywordDisp[] = {";
+    for (size_t i = 0; i < kh.disp.size(); ++i)
+        os << (i ? ", " : " ") << kh.disp[i];
+    os << " };" << std::endl
+       << "extern const int kLexKeywordSlot[] = {";
+    for (size_t i = 0; i < kh.slot.size(); ++i)
+        os << (i ? ", " : " ") << kh.slot[i];
+    os << " };" << std::endl;
+
+    SetFileContent(fileName.data(), os.str());
+}
+
 // ==== Error Handling ====
 
 #define LEX_ERROR(message) do { throw std::invalid_argument(std::string("Lex error: ") + message); } while (false)
@@ -142,6 +280,9 @@ static std::vector<Token::Type> LexTypes = {
 // ==== Comments ====
 
 // Remove /* ... */, keep new line.
+//
+// Runs between '/' (outside) or '*' (inside a comment) are skipped with
+// memchr rather than char by char.
 std::string RemoveComments(std::string input)
 {
     std::string output;
@@ -153,43 +294,50 @@ std::string RemoveComments(std::string input)
     const char * inEnd = input.data() + input.length();
     while (in < inEnd)
     {
-        // toggle in comment state
-        if (in + 1 < inEnd)
+        if (!inComment)
         {
-            if (!inComment && *in == '/' && *(in + 1) == '*')
+            const char * slash = static_cast<const char *>(memchr(in, '/', inEnd - in));
+            if (!slash)
+                slash = inEnd;
+            output.append(in, slash);
+            in = slash;
+            if (in == inEnd)
+                break;
+
+            // toggle in comment state
+            if (in + 1 < inEnd && *(in + 1) == '*')
             {
                 inComment = true;
                 in += 2;
-                continue;
             }
-            else if (inComment && *in == '*' && *(in + 1) == '/')
-            {
-                inComment = false;
-                in += 2;
-                continue;
-            }
-            else if (!inComment && *in == '/' && *(in + 1) == '/')
+            else
             {
-                ASSERT("C++ comment not allowed" && false);
+                ASSERT("C++ comment not allowed" && !(in + 1 < inEnd && *(in + 1) == '/'));
+                output += *in++;
             }
         }
-
-        if (inComment)
+        else
         {
+            const char * star = static_cast<const char *>(memchr(in, '*', inEnd - in));
+            if (!star)
+                star = inEnd;
             // keep new line in comment
-            if (*in == '\n')
+            output.append(std::count(in, star, '\n'), '\n');
+            in = star;
+            if (in == inEnd)
+                break;
+
+            // toggle in comment state
+            if (in + 1 < inEnd && *(in + 1) == '/')
             {
-                output += *in++;
+                inComment = false;
+                in += 2;
             }
             else
             {
                 ++in;
             }
         }
-        else
-        {
-            output += *in++;
-        }
     }
 
     ASSERT(!inComment);
@@ -197,12 +345,101 @@ std::string RemoveComments(std::string input)
     return output;
 }
 
+// ==== Conditional Group ====
+
+// Directive name of the line starting at 'line', empty if it doesn't start
+// with '#'. 'next' is set to the start of the next line.
+std::string LineDirective(const char * line, const char * end, const char ** next)
+{
+    std::string directive;
+    const char * p = line;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    if (p < end && *p == '#')
+    {
+        ++p;
+        while (p < end && (*p == ' ' || *p == '\t'))
+            ++p;
+        const char * word = p;
+        while (p < end && isalpha(static_cast<unsigned char>(*p)))
+            ++p;
+        directive.assign(word, p);
+    }
+
+    const char * newLine = static_cast<const char *>(memchr(p, '\n', end - p));
+    *next = newLine ? newLine + 1 : end;
+    return directive;
+}
+
+// Find the end of a conditional group starting at line start 'pos', i.e.
+// the start of the line holding its #elif/#else/#endif. Only lines starting
+// with '#' are looked at, to track #if/#ifdef/#ifndef nesting; nothing is
+// tokenized.
+size_t SkipConditionalGroup(const std::string & text, size_t pos)
+{
+    const char * begin = text.data();
+    const char * end = text.data() + text.length();
+    const char * line = begin + pos;
+
+    int depth = 0;
+    while (line < end)
+    {
+        const char * next;
+        std::string directive = LineDirective(line, end, &next);
+
+        if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+            ++depth;
+        else if (directive == "endif" && depth > 0)
+            --depth;
+        else if ((directive == "endif" || directive == "elif" || directive == "else") && depth == 0)
+            return line - begin;
+
+        line = next;
+    }
+    return text.length();
+}
+
+// [begin, end) of the text ParseAllTokens() tokenizes, found at character
+// level: a group follows each #if/#ifdef/#ifndef/#elif/#else line and is
+// skipped as one PP_GROUP token.
+std::vector<std::pair<size_t, size_t>> UngroupedRegions(const std::string & text)
+{
+    std::vector<std::pair<size_t, size_t>> regions;
+
+    const char * begin = text.data();
+    const char * end = text.data() + text.length();
+    size_t regionBegin = 0;
+    const char * line = begin;
+    while (line < end)
+    {
+        const char * next;
+        std::string directive = LineDirective(line, end, &next);
+        line = next;
+
+        if (directive == "if" || directive == "ifdef" || directive == "ifndef" ||
+            directive == "elif" || directive == "else")
+        {
+            size_t groupBegin = line - begin;
+            regions.emplace_back(regionBegin, groupBegin);
+            regionBegin = SkipConditionalGroup(text, groupBegin);
+            line = begin + regionBegin;
+        }
+    }
+    if (regionBegin < text.length())
+        regions.emplace_back(regionBegin, text.length());
+
+    return regions;
+}
+
 // ==== Parse & Eval Token ====
 
 Token ToToken(MatchResult mr, std::string & text)
 {
+    Token::Type type = LexTypes.at(mr.which - 1);
+    if (type == Token::ID)
+        type = ClassifyKeyword(text.data() + mr.offset, mr.length);
     return {
-        LexTypes.at(mr.which - 1), // type
+        type, // type
         std::string(text.data() + mr.offset, mr.length) // text
     };
 }
@@ -216,104 +453,138 @@ Token ParseOneToken(MatchEngine & me, std::string & text)
 }
 std::vector<Token> ParseAllTokens(MatchEngine & me, std::string & text)
 {
-    // Text --dfa--> Raw Tokens (keyword, id, flt/int/char/str-const, op, punc, pp-directive, pp-path, pp-lparen, space, nl)
-    std::vector<MatchResult> mrs = MatchAll(me, StringView(text.data(), text.length()));
-
+    // Text --dfa--> Raw Tokens (keyword, id, flt/int/char/str-const, op, punc, pp-directive, pp-path, pp-lparen)
+    //  space, nl are folded into hasLeadingSpace/atLineStart of the next token.
+    //  conditional groups after #if/#ifdef/#ifndef/#elif/#else lines become one PP_GROUP token.
     std::vector<Token> tokens;
-    for (auto mr : mrs)
+
+    // Large files are pre-lexed in parallel outside skipped groups, used
+    // wherever a match starts at pos, else fall back to MatchPrefix. The
+    // last match of a region may be cut short by its end, drop it.
+    const size_t kParallelLexBytes = 1024 * 1024;
+    std::vector<MatchResult> prelexed;
+    if (text.length() >= kParallelLexBytes)
     {
+        for (const std::pair<size_t, size_t> & region : UngroupedRegions(text))
+        {
+            std::vector<MatchResult> matches = MatchAllParallel(me, StringView(text.data() + region.first,
+                                                                               region.second - region.first));
+            if (!matches.empty())
+                matches.pop_back();
+            for (MatchResult & mr : matches)
+            {
+                mr.offset += region.first;
+                prelexed.push_back(mr);
+            }
+        }
+    }
+    size_t prelexedIndex = 0;
+
+    bool space = false;
+    bool lineStart = true;
+    bool groupFollows = false;
+    size_t pos = 0;
+    while (pos < text.length())
+    {
+        while (prelexedIndex < prelexed.size() && prelexed[prelexedIndex].offset < pos)
+            ++prelexedIndex;
+
+        MatchResult mr;
+        if (prelexedIndex < prelexed.size() && prelexed[prelexedIndex].offset == pos)
+        {
+            mr = prelexed[prelexedIndex];
+        }
+        else
+        {
+            mr = MatchPrefix(me, StringView(text.data() + pos, text.length() - pos));
+            if (mr.length == 0)
+                LEX_ERROR(std::string("Unexpected char: ") + text[pos]);
+            mr.offset = pos;
+        }
+        pos += mr.length;
+
+        Token::Type type = LexTypes.at(mr.which - 1);
+        if (type == Token::SPACE)
+        {
+            space = true;
+            continue;
+        }
+        else if (type == Token::NEW_LINE)
+        {
+            space = lineStart = true;
+            if (groupFollows)
+            {
+                size_t groupEnd = SkipConditionalGroup(text, pos);
+                Token group(Token::PP_GROUP, text.substr(pos, groupEnd - pos));
+                group.hasLeadingSpace = group.atLineStart = true;
+                tokens.push_back(group);
+                pos = groupEnd;
+                groupFollows = false;
+            }
+            continue;
+        }
+
         Token t = ToToken(mr, text);
+        t.hasLeadingSpace = space;
+        t.atLineStart = lineStart;
+        space = lineStart = false;
 
         if (t.type == Token::STRING) // Fix PP_LOCAL_PATH
         {
-            if (tokens.size() >= 2 &&
-                tokens[tokens.size() - 1].type == Token::SPACE &&
-                tokens[tokens.size() - 2].type == Token::PPD_INCLUDE)
+            if (!t.atLineStart &&
+                tokens.size() >= 1 &&
+                tokens[tokens.size() - 1].type == Token::PPD_INCLUDE)
                 t.type = Token::PP_LOCAL_PATH;
         }
         else if (t.type == Token::LPAREN) // Fix PP_LPAREN
         {
-            if (tokens.size() >= 3 &&
+            if (!t.hasLeadingSpace &&
+                tokens.size() >= 2 &&
                 tokens[tokens.size() - 1].type == Token::ID &&
-                tokens[tokens.size() - 2].type == Token::SPACE &&
-                tokens[tokens.size() - 3].type == Token::PPD_DEFINE)
+                !tokens[tokens.size() - 1].atLineStart &&
+                tokens[tokens.size() - 2].type == Token::PPD_DEFINE)
                 t.type = Token::PP_LPAREN;
         }
+        else if (t.atLineStart &&
+                 (t.type == Token::PPD_IF ||
+                  t.type == Token::PPD_IFDEF ||
+                  t.type == Token::PPD_IFNDEF ||
+                  t.type == Token::PPD_ELIF ||
+                  t.type == Token::PPD_ELSE))
+        {
+            groupFollows = true;
+        }
 
         tokens.push_back(t);
     }
+    if (groupFollows)
+        tokens.emplace_back(Token::PP_GROUP, "");
 
     return tokens;
 }
 
-int StringToInt(const char * begin, const char * end)
-{
-    bool neg = *begin == '-' ? (++begin, true) : false;
-
-    int value = 0;
-    while (begin != end)
-    {
-        value = value * 10 - (*begin - '0');
-        ++begin;
-    }
-
-    return neg ? value : -value;
-}
-char StringToChar(const char * begin, const char * end)
-{
-    if (begin[0] == '\\')
-    {
-        assert(begin[1] == 'n');
-        return '\n';
-    }
-    else
-    {
-        assert(begin + 1 == end);
-        return *begin;
-    }
-}
-float StringToFloat(const char * begin, const char * end)
-{
-    int digits = 0;
-    double factor = *begin == '-' ? (++begin, -1.0) : 1.0;
-    bool afterDot = false;
-
-    while (begin != end)
-    {
-        char c = *begin++;
-
-        if (isdigit(c))
-        {
-            digits = digits * 10 + (c - '0');
-            if (afterDot)
-                factor *= 10.0;
-        }
-        else if (c == '.')
-        {
-            ASSERT(afterDot == false);
-            afterDot = true;
-        }
-        else
-        {
-            break;
-        }
-    }
-
-    return static_cast<float>(digits / factor);
-}
 void EvalToken(Token & token)
 {
     switch (token.type)
     {
         case Token::CONST_INT:
-            token.ival = StringToInt(token.text.data(), token.text.data() + token.text.length());
+        {
+            IntegerLiteral literal = ParseIntegerLiteral(token.text.data(), token.text.data() + token.text.length());
+            token.ival = literal.value;
+            token.suffix = literal.suffix;
             break;
+        }
         case Token::CONST_CHAR:
-            token.cval = StringToChar(token.text.data() + 1, token.text.data() + token.text.length() - 1);
+            token.cval = ParseCharLiteral(token.text.data() + 1, token.text.data() + token.text.length() - 1);
+            token.suffix = 0;
             break;
         case Token::CONST_FLOAT:
-            token.fval = StringToFloat(token.text.data(), token.text.data() + token.text.length());
+        {
+            FloatLiteral literal = ParseFloatLiteral(token.text.data(), token.text.data() + token.text.length());
+            token.fval = literal.value;
+            token.suffix = literal.suffix;
             break;
+        }
         default:
             break;
     }
@@ -342,18 +613,95 @@ public:
 class FileTokenReader : public TokenReader<std::string>
 {
 public:
-    FileTokenReader(MatchEngine a0)
+    // a1: if not null, gets each file read, once, in the order first read.
+    FileTokenReader(MatchEngine a0, std::vector<std::string> * a1 = nullptr)
         : matchEngine(a0)
+        , filesRead(a1)
     {}
 
     std::vector<Token>              Read(std::string fileName) override
     {
+        if (filesRead && seen.insert(fileName).second)
+            filesRead->push_back(fileName);
         return ParseAllTokens(matchEngine,
                               RemoveComments(GetFileContent(fileName.data())));
     }
 
 private:
     MatchEngine matchEngine;
+    std::vector<std::string> * filesRead;
+    std::set<std::string> seen;
+};
+
+// ==== Include Search ====
+
+// Lookup cache: (directory, name) -> file exists, misses included, so no
+// path is stat'd twice. The default instance lives for the whole process,
+// LexProcess() drops its misses as files may have been added since.
+struct IncludeStatCache
+{
+    void DropMisses()
+    {
+        for (auto it = exists.begin(); it != exists.end(); )
+            it = it->second ? std::next(it) : exists.erase(it);
+    }
+
+    std::map<std::pair<std::string, std::string>, bool> exists;
+};
+IncludeStatCache & GetIncludeStatCache()
+{
+    static IncludeStatCache cache;
+    return cache;
+}
+
+class IncludeSearch
+{
+public:
+    IncludeSearch(std::string a0,
+                  std::vector<std::string> a1,
+                  IncludeStatCache & a2 = GetIncludeStatCache())
+        : baseDir(a0)
+        , includeDirs(a1)
+        , statCache(a2)
+    {}
+    virtual ~IncludeSearch() = default;
+
+    // "name": base dir, then -I dirs. <name>: -I dirs only.
+    std::string                     Find(const std::string & name, bool isSystem)
+    {
+        if (!isSystem && Exists(baseDir, name))
+            return Join(baseDir, name);
+        for (const std::string & dir : includeDirs)
+        {
+            if (Exists(dir, name))
+                return Join(dir, name);
+        }
+        LEX_ERROR("Can't find include file: " + name);
+    }
+
+protected:
+    virtual bool                    Stat(const std::string & path)
+    {
+        return FileExists(path.data());
+    }
+
+private:
+    static std::string              Join(const std::string & dir, const std::string & name)
+    {
+        return dir + "\\" + name;
+    }
+    bool                            Exists(const std::string & dir, const std::string & name)
+    {
+        auto key = std::make_pair(dir, name);
+        auto it = statCache.exists.find(key);
+        if (it == statCache.exists.end())
+            it = statCache.exists.emplace(key, Stat(Join(dir, name))).first;
+        return it->second;
+    }
+
+    std::string baseDir;
+    std::vector<std::string> includeDirs;
+    IncludeStatCache & statCache;
 };
 
 // ==== Helper: Token Replacer ====
@@ -493,16 +841,16 @@ TokenRange SubrangeUntilIncludeType(TokenRange range, Token::Type type)
     }
     return EmptyRange();
 }
-TokenRange SubrangeBeforeTypes(TokenRange range, std::vector<Token::Type> types)
+// [range.begin, first-token-at-line-start), i.e. the rest of the line
+TokenRange SubrangeUntilLineEnd(TokenRange range)
 {
+    assert(!range.Empty());
     TokenListConstIterator end = range.begin;
-    while (end != range.end)
+    do
     {
-        if (std::find(types.begin(), types.end(), end->token.type) != types.end())
-            return FromRange(range.begin, end);
         ++end;
-    }
-    return EmptyRange();
+    } while (end != range.end && !end->token.atLineStart);
+    return FromRange(range.begin, end);
 }
 TokenBuffer FromVector(TokenVector & tokens)
 {
@@ -646,7 +994,7 @@ public:
                 ? PPType::DEF_MACRO_FUN
                 : PPType::DEF_MACRO_OBJ;
 
-            return SubrangeUntilIncludeType(range, Token::NEW_LINE);
+            return SubrangeUntilLineEnd(range);
         }
         else
         {
@@ -661,7 +1009,6 @@ public:
         if (macroType == PPType::DEF_MACRO_OBJ)
         {
             ++begin; // skip #define
-            --end; // ignore new-line
 
             LEX_EXPECT_TOKEN(begin->token, Token::ID);
             std::string id = begin->token.text;
@@ -675,7 +1022,6 @@ public:
         else
         {
             ++begin; // skip #define
-            --end; // ignore new-line
 
             LEX_EXPECT_TOKEN(begin->token, Token::ID);
             std::string id = begin->token.text;
@@ -900,6 +1246,7 @@ public:
             {
                 if (curr->index() == 0 && std::get<0>(*curr).token.type == Token::OP_STRINGIZING)
                 {
+                    bool hasLeadingSpace = std::get<0>(*curr).token.hasLeadingSpace;
                     ++curr; // skip #
                     assert(curr != rt.end());
                     assert(curr->index() == 1);
@@ -908,15 +1255,20 @@ public:
 
                     std::string * leakyText = new std::string("\"");
 
-                    std::for_each(argReplaceTokens.at(argIndex).begin(),
-                                  argReplaceTokens.at(argIndex).end(),
-                                  [leakyText](AnnotatedToken & token) { leakyText->append(token.token.text.data(), token.token.text.size()); leakyText->push_back(' '); });
-                    leakyText->pop_back();
+                    // whitespace between argument tokens becomes one space
+                    TokenVector & argTokens = argReplaceTokens.at(argIndex);
+                    for (size_t i = 0; i < argTokens.size(); ++i)
+                    {
+                        if (i > 0 && argTokens[i].token.hasLeadingSpace)
+                            leakyText->push_back(' ');
+                        leakyText->append(argTokens[i].token.text.data(), argTokens[i].token.text.size());
+                    }
                     leakyText->append("\"");
 
                     Token t;
                     t.text = *leakyText;
                     t.type = Token::STRING;
+                    t.hasLeadingSpace = hasLeadingSpace;
                     rt2.emplace_back(Annotate(t, annotation));
                 }
                 else
@@ -957,6 +1309,7 @@ public:
                     // merge, re-pase, insert
                     std::string * leakyMergedText = new std::string(std::get<0>(rt[l]).token.text + std::get<0>(rt[r]).token.text);
                     Token mergedToken = ParseOneToken(matchEngine, *leakyMergedText);
+                    mergedToken.hasLeadingSpace = std::get<0>(rt[l]).token.hasLeadingSpace;
                     rt[r] = Annotate(mergedToken, {});
                     // remove 3, insert 1 -> add 2
                     ++l, ++m, ++r;
@@ -989,8 +1342,10 @@ class ConditionalIncludeTokenReplacer : public TokenReplacer
 {
     // Handle #if...#elif...#endif, #ifdef...#endif, #ifndef...#endif
 public:
-    ConditionalIncludeTokenReplacer(PPContext & a0)
+    ConditionalIncludeTokenReplacer(PPContext & a0,
+                                    MatchEngine a1)
         : macroContext(a0)
+        , matchEngine(a1)
     {}
 
     TokenRange                      Accept(TokenRange range) override
@@ -1002,8 +1357,10 @@ public:
             case Token::PPD_IFDEF:
             case Token::PPD_IFNDEF:
                 acceptedRange = SubrangeUntilIncludeType(range, Token::PPD_ENDIF);
-                ++acceptedRange.end;
-                LEX_EXPECT_TOKEN(acceptedRange.Last().token, Token::NEW_LINE);
+                if (acceptedRange.Empty())
+                    LEX_ERROR("Missing #endif.");
+                if (acceptedRange.End() != range.End() && !acceptedRange.End()->token.atLineStart)
+                    LEX_UNEXPECTED_TOKEN(acceptedRange.End()->token);
                 break;
             default:
                 acceptedRange = EmptyRange();
@@ -1013,31 +1370,26 @@ public:
     }
     void                            Replace(TokenRange range, TokenOut & out) override
     {
+        // Each directive line is followed by a PP_GROUP, only the selected
+        // group gets lexed. Nested conditionals are inside the group text,
+        // so the first #endif closes this one.
         TokenRange expr;
-        TokenRange body;
-        TokenRange rest;
-
-        body = EmptyRange();
-        rest = range;
+        TokenRange rest = range;
 
         while (!rest.Empty() && rest.First().token.type != Token::PPD_ENDIF)
         {
-            expr = SubrangeUntilIncludeType(rest, Token::NEW_LINE);
-            body = SubrangeBeforeTypes(
-                FromRange(expr.End(), rest.End()),
-                { Token::PPD_ELIF,Token::PPD_ELSE, Token::PPD_ENDIF, }
-            );
-            rest = FromRange(body.End(), rest.End());
+            expr = SubrangeUntilLineEnd(rest);
+            TokenListConstIterator group = expr.End();
+            LEX_EXPECT_TOKEN(group->token, Token::PP_GROUP);
+            rest = FromRange(std::next(group), rest.End());
 
             if (EvalPPExpr(expr))
+            {
+                std::string text = group->token.text;
+                for (Token & token : ParseAllTokens(matchEngine, text))
+                    out.Insert(Annotate(token, {}));
                 break;
-            else
-                body = EmptyRange();
-        }
-
-        for (auto it = body.Begin(); it != body.End(); ++it)
-        {
-            out.Insert(*it);
+            }
         }
     }
 
@@ -1088,20 +1440,22 @@ private:
                 break;
         }
 
-        LEX_EXPECT_TOKEN(it->token, Token::NEW_LINE);
+        if (it != range.End())
+            LEX_UNEXPECTED_TOKEN(it->token);
 
         return isTrue;
     }
 
     PPContext & macroContext;
+    MatchEngine matchEngine;
 };
 class FileIncludeTokenReplacer : public TokenReplacer
 {
     // Handle #include...
 public:
-    FileIncludeTokenReplacer(TokenReader<std::string> * a0, std::string a1)
+    FileIncludeTokenReplacer(TokenReader<std::string> * a0, IncludeSearch * a1)
         : trFile(a0)
-        , baseDir(a1)
+        , includeSearch(a1)
     {}
 
     TokenRange                      Accept(TokenRange range) override
@@ -1110,10 +1464,11 @@ public:
         if (end->token.type == Token::PPD_INCLUDE)
         {
             ++end;
-            LEX_EXPECT_TOKEN(end->token, Token::PP_LOCAL_PATH); // PP_ENV_PATH
-            ++end;
-            LEX_EXPECT_TOKEN(end->token, Token::NEW_LINE);
+            if (end->token.type != Token::PP_ENV_PATH)
+                LEX_EXPECT_TOKEN(end->token, Token::PP_LOCAL_PATH);
             ++end;
+            if (end != range.End() && !end->token.atLineStart)
+                LEX_UNEXPECTED_TOKEN(end->token);
             return FromRange(range.Begin(), end);
         }
         else
@@ -1126,7 +1481,8 @@ public:
         auto it = range.Begin();
         ++it;
         std::string fileName = it->token.text.substr(1, it->token.text.size() - 2);
-        for (Token & token : trFile->Read(baseDir + "\\" + fileName))
+        std::string path = includeSearch->Find(fileName, it->token.type == Token::PP_ENV_PATH);
+        for (Token & token : trFile->Read(path))
         {
             out.Insert(Annotate(token, {}));
         }
@@ -1134,7 +1490,7 @@ public:
 
 private:
     TokenReader<std::string> * trFile;
-    std::string baseDir;
+    IncludeSearch * includeSearch;
 };
 class ChainedTokenReplacer : public TokenReplacer
 {
@@ -1169,79 +1525,6 @@ private:
     size_t acceptedTokenReplacerIndex;
 };
 
-// ==== Token Filter ====
-
-// Token -> bool
-
-class TokenFilter
-{
-public:
-    virtual bool                    Filter(const Token &) = 0;
-};
-class TypeTokenFilter : public TokenFilter
-{
-public:
-    TypeTokenFilter(Token::Type type)
-        : filteredType(type)
-    {}
-
-    bool                            Filter(const Token & token)
-    {
-        return token.type == filteredType;
-    }
-
-private:
-    Token::Type filteredType;
-};
-
-class FilteredTokenReader : public TokenReader<std::string>
-{
-public:
-    FilteredTokenReader(TokenReader<std::string> * a0,
-                      TokenFilter * a1)
-        : tokenReader(a0)
-        , tokenFilter(a1)
-    {}
-
-    std::vector<Token>              Read(std::string source) override
-    {
-        std::vector<Token> tokens1 = tokenReader->Read(source);
-        std::vector<Token> tokens2;
-
-        std::copy_if(tokens1.begin(),
-                     tokens1.end(),
-
-                     std::back_inserter(tokens2),
-
-                     [this](Token & token) ->bool
-                     {
-                         return !tokenFilter->Filter(token);
-                     });
-
-        return tokens2;
-    }
-
-private:
-    TokenReader<std::string> * tokenReader;
-    TokenFilter * tokenFilter;
-};
-struct FilteredTokenOut : public TokenOut
-{
-    TokenFilter * filter;
-    TokenOut & out;
-
-    FilteredTokenOut(TokenOut & a0, TokenFilter * a1)
-        : out(a0)
-        , filter(a1)
-    {}
-
-    void Insert(AnnotatedToken token) override
-    {
-        if (!filter->Filter(token))
-            out.Insert(token);
-    }
-};
-
 // ==== Print ====
 
 struct PrintTokenOut : public TokenOut
@@ -1261,6 +1544,8 @@ struct PrintTokenOut : public TokenOut
     {
         if (printDest)
         {
+            if (token.token.atLineStart && !printDest->empty())
+                printDest->push_back('\n');
             *printDest += token.token.text;
             printDest->push_back(' ');
         }
@@ -1275,17 +1560,6 @@ std::vector<Token> ReadAllTokens(T input, TokenReader<T> & reader)
 {
     return reader.Read(input);
 }
-std::vector<Token> FilterAllTokens(const std::vector<Token> & input, TokenFilter & filter)
-{
-    std::vector<Token> output;
-
-    std::copy_if(input.begin(),
-                 input.end(),
-                 std::back_inserter(output),
-                 [&filter] (const Token & token) -> bool { return !filter.Filter(token); });
-    
-    return output;
-}
 std::vector<Token> ReplaceAllTokens(const std::vector<Token> & input, TokenReplacer & replacer)
 {
     std::vector<Token> output;
@@ -1313,28 +1587,201 @@ std::vector<Token> ReplaceAllTokens(const std::vector<Token> & input, TokenRepla
     return output;
 }
 
+// ==== Dependency Scan ====
+
+// Directive-only preprocessor: follows #include, #define/#undef and
+// conditionals line by line, everything else is skipped without lexing.
+class DependencyScanner
+{
+public:
+    DependencyScanner(IncludeSearch & a0)
+        : includeSearch(a0)
+    {}
+    virtual ~DependencyScanner() = default;
+
+    void                            Scan(std::string fileName)
+    {
+        if (std::find(includeStack.begin(), includeStack.end(), fileName) != includeStack.end())
+            LEX_ERROR("Recursive include: " + fileName);
+        if (std::find(files.begin(), files.end(), fileName) == files.end())
+            files.push_back(fileName);
+
+        includeStack.push_back(fileName);
+        ScanText(ReadFile(fileName));
+        includeStack.pop_back();
+    }
+    const std::vector<std::string> & Files() const
+    {
+        return files;
+    }
+
+protected:
+    virtual std::string             ReadFile(std::string fileName)
+    {
+        return RemoveComments(GetFileContent(fileName.data()));
+    }
+
+private:
+    static void                     SkipBlank(const char *& p, const char * end)
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+    }
+    static std::string              ReadId(const char *& p, const char * end)
+    {
+        SkipBlank(p, end);
+        const char * begin = p;
+        while (p < end && (isalnum(static_cast<unsigned char>(*p)) || *p == '_'))
+            ++p;
+        return std::string(begin, p);
+    }
+
+    // Same forms as ConditionalIncludeTokenReplacer::EvalPPExpr().
+    bool                            EvalCondition(const std::string & directive, const char * p, const char * end)
+    {
+        bool neg = false;
+        if (directive == "if" || directive == "elif")
+        {
+            SkipBlank(p, end);
+            if (p < end && *p == '!')
+                neg = true, ++p;
+            if (ReadId(p, end) != "defined")
+                LEX_ERROR("Expect 'defined'.");
+        }
+        else if (directive == "ifndef")
+        {
+            neg = true;
+        }
+
+        std::string id = ReadId(p, end);
+        if (id.empty())
+            LEX_ERROR("Expect macro name after #" + directive + ".");
+        bool isTrue = macros.find(id) != macros.end();
+        return neg ? !isTrue : isTrue;
+    }
+
+    void                            ScanText(const std::string & text)
+    {
+        const char * begin = text.data();
+        const char * end = text.data() + text.length();
+
+        // one entry per open conditional: has a group been taken
+        std::vector<bool> taken;
+
+        size_t pos = 0;
+        while (pos < text.length())
+        {
+            const char * p = begin + pos;
+            const char * lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+            lineEnd = lineEnd ? lineEnd : end;
+            size_t next = lineEnd < end ? lineEnd - begin + 1 : text.length();
+
+            SkipBlank(p, lineEnd);
+            if (p == lineEnd || *p != '#')
+            {
+                pos = next;
+                continue;
+            }
+            ++p;
+            std::string directive = ReadId(p, lineEnd);
+
+            if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+            {
+                bool isTrue = EvalCondition(directive, p, lineEnd);
+                taken.push_back(isTrue);
+                pos = isTrue ? next : SkipConditionalGroup(text, next);
+            }
+            else if (directive == "elif" || directive == "else")
+            {
+                if (taken.empty())
+                    LEX_ERROR("Unexpected #" + directive + ".");
+                bool isTrue = !taken.back() && (directive == "else" || EvalCondition(directive, p, lineEnd));
+                taken.back() = taken.back() || isTrue;
+                pos = isTrue ? next : SkipConditionalGroup(text, next);
+            }
+            else if (directive == "endif")
+            {
+                if (taken.empty())
+                    LEX_ERROR("Unexpected #endif.");
+                taken.pop_back();
+                pos = next;
+            }
+            else
+            {
+                if (directive == "define")
+                    macros.insert(ReadId(p, lineEnd));
+                else if (directive == "undef")
+                    macros.erase(ReadId(p, lineEnd));
+                else if (directive == "include")
+                {
+                    SkipBlank(p, lineEnd);
+                    bool isSystem = p < lineEnd && *p == '<';
+                    const char * close = p < lineEnd && (*p == '"' || *p == '<')
+                        ? static_cast<const char *>(memchr(p + 1, isSystem ? '>' : '"', lineEnd - p - 1))
+                        : nullptr;
+                    if (!close)
+                        LEX_ERROR("Expect \"file\" or <file> after #include.");
+                    Scan(includeSearch.Find(std::string(p + 1, close), isSystem));
+                }
+                pos = next;
+            }
+        }
+        if (!taken.empty())
+            LEX_ERROR("Missing #endif.");
+    }
+
+    IncludeSearch & includeSearch;
+    std::set<std::string> macros;
+    std::vector<std::string> files;
+    std::vector<std::string> includeStack;
+};
+
+// "target: dep dep ...", with spaces escaped for Make.
+std::string MakeDependencyRule(const std::string & target, const std::vector<std::string> & deps)
+{
+    auto escape = [](const std::string & path) -> std::string {
+        std::string escaped;
+        for (char c : path)
+        {
+            if (c == ' ' || c == '#')
+                escaped.push_back('\\');
+            else if (c == '$')
+                escaped.push_back('$');
+            escaped.push_back(c);
+        }
+        return escaped;
+    };
+
+    std::string rule = escape(target) + ":";
+    for (const std::string & dep : deps)
+        rule += " \\\n  " + escape(dep);
+    rule += "\n";
+    return rule;
+}
+
 // ==== API ====
 
-std::vector<Token> LexProcess(std::string sourceFile, std::string * sourceAfterPreproc)
+std::vector<Token> LexProcess(std::string sourceFile,
+                              std::string * sourceAfterPreproc,
+                              const std::vector<std::string> & includeDirs,
+                              std::vector<std::string> * filesRead)
 {
-    TokenVector output;
+    GetIncludeStatCache().DropMisses();
 
-    MatchEngine                         me = Compile(LexPatterns);
+    TokenVector output;
 
-    TokenFilter *                       tfSpace = new TypeTokenFilter({ Token::SPACE });
-    TokenFilter *                       tfNewLine = new TypeTokenFilter({ Token::NEW_LINE });
+    MatchEngine                         me = CompileLexPatterns();
 
-    TokenReader<std::string> *          trFile = new FilteredTokenReader(new FileTokenReader(me), tfSpace);
+    TokenReader<std::string> *          trFile = new FileTokenReader(me, filesRead);
 
     TokenOut                            e0 = Inserter(output);
-    FilteredTokenOut                    e1(e0, tfNewLine);
-    PrintTokenOut                       emitter(e1, sourceAfterPreproc);
+    PrintTokenOut                       emitter(e0, sourceAfterPreproc);
 
     EmitTokenReplacer *                 repEmit = new EmitTokenReplacer(emitter);
     MacroContextTokenReplacer *         repMacroContext = new MacroContextTokenReplacer;
     MacroSubTokenReplacer *             repMacroSub = new MacroSubTokenReplacer(repMacroContext->GetMacroContext(), me);
-    ConditionalIncludeTokenReplacer *   repCondIncl = new ConditionalIncludeTokenReplacer(repMacroContext->GetMacroContext());
-    FileIncludeTokenReplacer *          repFileIncl = new FileIncludeTokenReplacer(trFile, GetCanonicalFileDirectory(sourceFile));
+    ConditionalIncludeTokenReplacer *   repCondIncl = new ConditionalIncludeTokenReplacer(repMacroContext->GetMacroContext(), me);
+    FileIncludeTokenReplacer *          repFileIncl = new FileIncludeTokenReplacer(trFile, new IncludeSearch(GetCanonicalFileDirectory(sourceFile), includeDirs));
 
     ChainedTokenReplacer                repPreproc({ repMacroContext, repMacroSub, repCondIncl, repFileIncl, repEmit });
 
@@ -1356,30 +1803,86 @@ std::vector<Token> LexProcess(std::string sourceFile, std::string * sourceAfterP
     return EvalTokens(DeAnnotateAll(output));
 }
 
-TokenIterator::TokenIterator(std::vector<Token> & tokens)
+std::vector<std::string> ScanDependencies(std::string sourceFile,
+                                          const std::vector<std::string> & includeDirs)
+{
+    GetIncludeStatCache().DropMisses();
+    IncludeSearch search(GetCanonicalFileDirectory(sourceFile), includeDirs);
+    DependencyScanner scanner(search);
+    scanner.Scan(sourceFile);
+    return scanner.Files();
+}
+
+void InvalidateIncludeCache()
+{
+    GetIncludeStatCache().exists.clear();
+}
+
+UINT64 HashTokens(const std::vector<Token> & tokens, size_t begin, size_t end) {
+    const UINT64 kPrime = 0x100000001b3ull;
+    UINT64 hash = 0xcbf29ce484222325ull;
+    for (size_t i = begin; i < end; ++i) {
+        hash = (hash ^ static_cast<UINT64>(tokens[i].type)) * kPrime;
+        for (char c : tokens[i].text)
+            hash = (hash ^ static_cast<unsigned char>(c)) * kPrime;
+        hash = (hash ^ 0xFF) * kPrime;  // text end
+    }
+    return hash;
+}
+
+bool SameTokens(const Token * a, const Token * b, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i].type != b[i].type || a[i].text != b[i].text)
+            return false;
+    }
+    return true;
+}
+
+TokenIterator::TokenIterator(const std::vector<Token> & tokens)
+    : tokens_(tokens)
+    , i_(0)
+    , end_(tokens.size()) {
+}
+
+TokenIterator::TokenIterator(const std::vector<Token> & tokens, size_t begin, size_t end)
     : tokens_(tokens)
-    , i_(0) {
+    , i_(begin)
+    , end_(end) {
+    ASSERT(begin <= end && end <= tokens.size());
 }
 
 bool TokenIterator::has() const {
-    return i_ < tokens_.size();
+    return i_ < end_;
 }
 
-Token TokenIterator::next() {
-    ASSERT(i_ < tokens_.size());
+const Token & TokenIterator::next() {
+    ASSERT(i_ < end_);
     return tokens_[i_++];
 }
 
-Token TokenIterator::peek() const {
-    ASSERT(i_ < tokens_.size());
+const Token & TokenIterator::peek() const {
+    ASSERT(i_ < end_);
     return tokens_[i_];
 }
 
-Token TokenIterator::peekN(int n) const {
-    ASSERT(i_ + n < tokens_.size());
+Token::Type TokenIterator::PeekType() const {
+    ASSERT(i_ < end_);
+    return tokens_[i_].type;
+}
+
+const Token & TokenIterator::peekN(int n) const {
+    ASSERT(i_ + n < end_);
     return tokens_[i_ + n];
 }
 
+size_t TokenIterator::index() const {
+    return i_;
+}
+
+const std::vector<Token> & TokenIterator::tokens() const {
+    return tokens_;
+}
+
 #ifdef UNIT_TEST
 #include "../UnitTest/UnitTest.h"
 
@@ -1388,7 +1891,7 @@ class LexerTest : public Tester
 protected:
     void BeforeAllTestCases() override
     {
-        lexMatcher = Compile(LexPatterns);
+        lexMatcher = CompileLexPatterns();
     }
     MatchEngine & GetMatcher()
     {
@@ -1513,11 +2016,10 @@ TEST_F(LexerTest, ParseToken)
     { Token::OP_STRINGIZING, "#" },
     { Token::REL_NE, "!=" },
     { Token::BOOL_NOT, "!" },
-    { Token::NEW_LINE, "\n" },
     };
     try
     {
-        std::vector<Token> tokens = FilterAllTokens(ParseAllTokens(GetMatcher(), input), TypeTokenFilter(Token::SPACE));
+        std::vector<Token> tokens = ParseAllTokens(GetMatcher(), input);
         EXPECT_EQ(tokens.size(), output.size());
         for (size_t i = 0; i < output.size(); ++i)
         {
@@ -1536,31 +2038,134 @@ TEST_F(LexerTest, ParseToken)
     }
 }
 
+// generated scanner == runtime dfa
+TEST_F(LexerTest, GeneratedScanner)
+{
+    EXPECT_EQ(kLexScannerFingerprint, PatternsFingerprint(LexPatterns));
+
+    MatchEngine scanner = FromScanner(LexScan);
+    MatchEngine dfa = Compile(LexPatterns);
+    std::string corpus =
+        "int main(void) { return a->b[3] >>= 1.5e-3f + .5 - 0x1Fu * 10UL % 077; }\n"
+        "#  define  F(x, ...) x ## __VA_ARGS__ #x\n"
+        "#\tinclude <sys/types.h>\n"
+        "#include \"dir/file.h\"\r\n"
+        "char c = '\\'', d = 'ab'; char * s = \"a\\\"b\\n\";\n"
+        "x+++y---z&&=w||!v != ~u ^= t |= s ? r : q <<= 2 <= 3 < 4 ... . ;\n"
+        "1. 1e5 12E+3L 0XABCDEFlu 5ll\n"
+        "<not a path> \"unterminated\n 'x \t\t \xC3\xA9 @ ` $ \\\n";
+
+    for (size_t offset = 0; offset < corpus.size(); ++offset)
+    {
+        StringView text(corpus.data() + offset, corpus.size() - offset);
+        MatchResult a = MatchPrefix(scanner, text);
+        MatchResult b = MatchPrefix(dfa, text);
+        EXPECT_EQ(a.offset, b.offset);
+        EXPECT_EQ(a.length, b.length);
+        EXPECT_EQ(a.which, b.which);
+    }
+}
+
+// id text -> keyword type
+TEST_F(LexerTest, ClassifyKeyword)
+{
+    for (auto & kw : LexKeywords)
+        EXPECT_EQ(ClassifyKeyword(kw.first.data(), kw.first.size()), kw.second);
+
+    // Same length/first/last char as a keyword, or off by one char.
+    std::vector<std::string> ids = {
+        "wxxle", "voxxxxle", "cast", "Int", "_if", "i", "autos", "sizeo",
+        "dx", "doubles", "register_", "continuex", "x", "elsee", "goto_",
+    };
+    for (auto & id : ids)
+        EXPECT_EQ(ClassifyKeyword(id.data(), id.size()), Token::ID);
+
+    // Generated tables agree with runtime construction.
+    KeywordHash kh = BuildKeywordHash();
+    EXPECT_TRUE(kh.slot == GetKeywordHash().slot);
+    EXPECT_TRUE(kh.disp == GetKeywordHash().disp);
+}
+
+// string -> Token[] (hasLeadingSpace, atLineStart)
+TEST_F(LexerTest, TokenFlags)
+{
+    std::string input =
+        "#define F(x) x\n"
+        "#define G (x)\n"
+        "  a+ b\n"
+        "\n"
+        "c";
+    std::vector<std::tuple<Token::Type, bool, bool>> output = {
+        { Token::PPD_DEFINE, false, true },
+        { Token::ID, true, false },
+        { Token::PP_LPAREN, false, false },
+        { Token::ID, false, false },
+        { Token::RPAREN, false, false },
+        { Token::ID, true, false },
+        { Token::PPD_DEFINE, true, true },
+        { Token::ID, true, false },
+        { Token::LPAREN, true, false },
+        { Token::ID, false, false },
+        { Token::RPAREN, false, false },
+        { Token::ID, true, true },
+        { Token::OP_ADD, false, false },
+        { Token::ID, true, false },
+        { Token::ID, true, true },
+    };
+    try
+    {
+        std::vector<Token> tokens = ParseAllTokens(GetMatcher(), input);
+        EXPECT_EQ(tokens.size(), output.size());
+        for (size_t i = 0; i < output.size() && i < tokens.size(); ++i)
+        {
+            EXPECT_EQ(tokens[i].type, std::get<0>(output[i]));
+            EXPECT_EQ(tokens[i].hasLeadingSpace, std::get<1>(output[i]));
+            EXPECT_EQ(tokens[i].atLineStart, std::get<2>(output[i]));
+        }
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        EXPECT_NOT_REACH;
+    }
+}
+
 // Token[] -> Token[]
 TEST_F(LexerTest, EvalToken)
 {
     std::string input =
-        "0 -1 1 2147483647 -2147483648 "
-        "0.0 1.0 2.0 -1.0 -2.0 "
-        "'c' '\\n' "
+        "0 1 2147483647 4294967295u 18446744073709551615UL 0x7fffffff 0XFFl 017 "
+        "0.0 1.0 .5 3. 2.5e-3 1e10 1.5f 1.0L 0.1 "
+        "'c' '\\n' '\\0' '\\x41' '\\101' '\\'' "
         ;
-    std::vector<std::pair<Token::Type, std::variant<int, float, char>>> output = {
-        { Token::CONST_INT, 0 },
-    { Token::CONST_INT, -1 },
-    { Token::CONST_INT, 1 },
-    { Token::CONST_INT, 2147483647 },
-    { Token::CONST_INT, -2147483647 - 1 },
-    { Token::CONST_FLOAT, 0.0f },
-    { Token::CONST_FLOAT, 1.0f },
-    { Token::CONST_FLOAT, 2.0f },
-    { Token::CONST_FLOAT, -1.0f },
-    { Token::CONST_FLOAT, -2.0f },
+    std::vector<std::pair<Token::Type, std::variant<UINT64, double, char>>> output = {
+    { Token::CONST_INT, 0ull },
+    { Token::CONST_INT, 1ull },
+    { Token::CONST_INT, 2147483647ull },
+    { Token::CONST_INT, 4294967295ull },
+    { Token::CONST_INT, 18446744073709551615ull },
+    { Token::CONST_INT, 0x7fffffffull },
+    { Token::CONST_INT, 0xFFull },
+    { Token::CONST_INT, 15ull },
+    { Token::CONST_FLOAT, 0.0 },
+    { Token::CONST_FLOAT, 1.0 },
+    { Token::CONST_FLOAT, 0.5 },
+    { Token::CONST_FLOAT, 3.0 },
+    { Token::CONST_FLOAT, 2.5e-3 },
+    { Token::CONST_FLOAT, 1e10 },
+    { Token::CONST_FLOAT, 1.5 },
+    { Token::CONST_FLOAT, 1.0 },
+    { Token::CONST_FLOAT, 0.1 },
     { Token::CONST_CHAR, 'c' },
     { Token::CONST_CHAR, '\n' },
+    { Token::CONST_CHAR, '\0' },
+    { Token::CONST_CHAR, 'A' },
+    { Token::CONST_CHAR, 'A' },
+    { Token::CONST_CHAR, '\'' },
     };
     try
     {
-        std::vector<Token> tokens = FilterAllTokens(ParseAllTokens(GetMatcher(), input), TypeTokenFilter(Token::SPACE));
+        std::vector<Token> tokens = ParseAllTokens(GetMatcher(), input);
         EvalTokens(tokens);
 
         EXPECT_EQ(tokens.size(), output.size());
@@ -1571,9 +2176,9 @@ TEST_F(LexerTest, EvalToken)
             {
                 switch (tokens[i].type)
                 {
-                    case Token::CONST_INT:      EXPECT_EQ(tokens[i].ival, std::get<int>(output[i].second)); break;
+                    case Token::CONST_INT:      EXPECT_EQ(tokens[i].ival, std::get<UINT64>(output[i].second)); break;
                     case Token::CONST_CHAR:     EXPECT_EQ(tokens[i].cval, std::get<char>(output[i].second)); break;
-                    case Token::CONST_FLOAT:    EXPECT_EQ(tokens[i].fval, std::get<float>(output[i].second)); break;
+                    case Token::CONST_FLOAT:    EXPECT_EQ(tokens[i].fval, std::get<double>(output[i].second)); break;
                     default: break;
                 }
             }
@@ -1586,6 +2191,242 @@ TEST_F(LexerTest, EvalToken)
     }
 }
 
+// Token[] -> Token[]
+TEST_F(LexerTest, ConditionalInclude)
+{
+    try
+    {
+        // Inactive groups are never lexed, '@' and '`' would fail to.
+        std::string input =
+            "#define A 1\n"
+            "#ifdef A\n"
+            "#ifndef A\n"
+            "  @ x\n"
+            "#else\n"
+            "  y\n"
+            "#endif\n"
+            "#elif defined B\n"
+            "  ` z\n"
+            "#else\n"
+            "  # if `\n"
+            "  #endif\n"
+            "#endif\n"
+            "w\n";
+
+        std::vector<Token> rawTokens = ParseAllTokens(GetMatcher(), input);
+        EXPECT_EQ(std::count_if(rawTokens.begin(), rawTokens.end(),
+                                [](const Token & t) { return t.type == Token::PP_GROUP; }), 3);
+
+        MacroContextTokenReplacer           repMacroContext;
+        ConditionalIncludeTokenReplacer     repCondIncl(repMacroContext.GetMacroContext(), GetMatcher());
+        ChainedTokenReplacer                rep({ &repMacroContext, &repCondIncl });
+        std::vector<Token>                  tokens = ReplaceAllTokens(rawTokens, rep);
+
+        EXPECT_EQ(tokens.size(), 2);
+        if (tokens.size() == 2)
+        {
+            EXPECT_EQ(tokens[0].text, "y");
+            EXPECT_EQ(tokens[1].text, "w");
+        }
+
+        std::string group = "a\n#if X\n#else\n#endif\n  #  else\nb\n";
+        EXPECT_EQ(SkipConditionalGroup(group, 0), 21);
+        EXPECT_EQ(SkipConditionalGroup(group, group.length() - 2), group.length());
+
+        std::vector<std::pair<size_t, size_t>> regions = UngroupedRegions(input);
+        std::vector<std::pair<size_t, size_t>> expectRegions = { { 0, 21 }, { 54, 70 }, { 76, 82 }, { 100, 109 } };
+        EXPECT_TRUE(regions == expectRegions);
+
+        // Past the parallel pre-lex size, same tokens as lexing the pieces.
+        std::string line = "int x = a->b[3] + 1.5e-3f; /* c */ s = \"str\";\n";
+        std::string body;
+        while (body.length() < 1024 * 1024)
+            body += line;
+        std::string large = body + input + body;
+        std::vector<Token> largeTokens = ParseAllTokens(GetMatcher(), large);
+        std::vector<Token> bodyTokens = ParseAllTokens(GetMatcher(), body);
+        EXPECT_EQ(largeTokens.size(), 2 * bodyTokens.size() + rawTokens.size());
+        for (size_t i = 0; i < bodyTokens.size() && i < largeTokens.size(); ++i)
+        {
+            EXPECT_EQ(largeTokens[i].type, bodyTokens[i].type);
+            EXPECT_EQ(largeTokens[i].text, bodyTokens[i].text);
+        }
+        for (size_t i = 0; i < rawTokens.size() && bodyTokens.size() + i < largeTokens.size(); ++i)
+            EXPECT_EQ(largeTokens[bodyTokens.size() + i].text, rawTokens[i].text);
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        EXPECT_NOT_REACH;
+    }
+}
+
+// file -> included files
+class MemoryIncludeSearch : public IncludeSearch
+{
+public:
+    MemoryIncludeSearch(std::vector<std::string> a0,
+                        std::set<std::string> a1,
+                        IncludeStatCache & a2)
+        : IncludeSearch("dir", a0, a2)
+        , files(a1)
+        , statCount(0)
+    {}
+
+    std::set<std::string> files;
+    int statCount;
+
+protected:
+    bool                            Stat(const std::string & path) override
+    {
+        ++statCount;
+        return files.find(path) != files.end();
+    }
+};
+class MemoryDependencyScanner : public DependencyScanner
+{
+public:
+    MemoryDependencyScanner(IncludeSearch & a0,
+                            std::map<std::string, std::string> a1)
+        : DependencyScanner(a0)
+        , fileContents(a1)
+    {}
+
+protected:
+    std::string                     ReadFile(std::string fileName) override
+    {
+        return fileContents.at(fileName);
+    }
+
+private:
+    std::map<std::string, std::string> fileContents;
+};
+TEST_F(LexerTest, DependencyScan)
+{
+    try
+    {
+        IncludeStatCache cache;
+        MemoryIncludeSearch search({}, { "dir\\a.h", "dir\\b.h", "dir\\e h.h" }, cache);
+        MemoryDependencyScanner scanner(search, {
+            { "dir\\main.c",
+              "#include \"a.h\"\n"
+              "#include \"a.h\"\n"
+              "#ifdef USE_B\n"
+              "#include \"b.h\"\n"
+              "#elif !defined NO_C\n"
+              "  #  include \"c.h\"\n"
+              "#else\n"
+              "#include \"d.h\"\n"
+              "#endif\n"
+              "int main() { return 0; }\n" },
+            { "dir\\a.h",
+              "#ifndef A_H\n"
+              "#define A_H\n"
+              "#if defined A_H\n"
+              "#define USE_B\n"
+              "#endif\n"
+              "#endif\n" },
+            { "dir\\b.h", "#undef USE_B\n#include \"e h.h\"\n" },
+            { "dir\\e h.h", "" },
+        });
+        scanner.Scan("dir\\main.c");
+
+        std::vector<std::string> expect = { "dir\\main.c", "dir\\a.h", "dir\\b.h", "dir\\e h.h" };
+        EXPECT_TRUE(scanner.Files() == expect);
+        EXPECT_EQ(MakeDependencyRule("main.asm", { "main.c", "e h.h" }),
+                  "main.asm: \\\n  main.c \\\n  e\\ h.h\n");
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        EXPECT_NOT_REACH;
+    }
+}
+
+// files the preprocessor reads, for -MD
+TEST_F(LexerTest, FilesRead)
+{
+    try
+    {
+        std::string main = GetTempFilePath("LexerTest_main.c");
+        std::string a = GetTempFilePath("LexerTest_a.h");
+        std::string b = GetTempFilePath("LexerTest_b.h");
+        SetFileContent(main.data(),
+                       "#include \"LexerTest_a.h\"\n"
+                       "#include \"LexerTest_a.h\"\n"
+                       "#ifdef USE_B\n"
+                       "#include \"LexerTest_b.h\"\n"
+                       "#else\n"
+                       "#include \"LexerTest_c.h\"\n"
+                       "#endif\n"
+                       "int main() { return b; }\n");
+        SetFileContent(a.data(), "#ifndef A_H\n#define A_H\n#define USE_B\n#endif\n");
+        SetFileContent(b.data(), "int b;\n");
+
+        std::vector<std::string> filesRead;
+        std::vector<Token> tokens = LexProcess(main, nullptr, {}, &filesRead);
+        EXPECT_EQ(tokens.size(), 12u);
+
+        std::string dir = GetCanonicalFileDirectory(main);
+        std::vector<std::string> expect = { main, dir + "\\LexerTest_a.h", dir + "\\LexerTest_b.h" };
+        EXPECT_TRUE(filesRead == expect);
+        EXPECT_TRUE(ScanDependencies(main) == expect);
+
+        RemoveFile(main.data());
+        RemoveFile(a.data());
+        RemoveFile(b.data());
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        EXPECT_NOT_REACH;
+    }
+}
+
+// include name -> path
+TEST_F(LexerTest, IncludeSearch)
+{
+    try
+    {
+        IncludeStatCache cache;
+        MemoryIncludeSearch search({ "inc1", "inc2" },
+                                   { "dir\\local.h", "inc1\\sys.h", "inc2\\sys.h", "inc2\\deep.h", "inc2\\local.h" },
+                                   cache);
+
+        EXPECT_EQ(search.Find("local.h", false), "dir\\local.h");
+        EXPECT_EQ(search.Find("local.h", true), "inc2\\local.h");
+        EXPECT_EQ(search.Find("sys.h", true), "inc1\\sys.h");
+        EXPECT_EQ(search.Find("deep.h", false), "inc2\\deep.h");
+        EXPECT_EQ(search.statCount, 7);
+
+        // hits and misses are cached
+        EXPECT_EQ(search.Find("deep.h", false), "inc2\\deep.h");
+        EXPECT_EQ(search.Find("local.h", true), "inc2\\local.h");
+        EXPECT_EQ(search.statCount, 7);
+
+        bool thrown = false;
+        try { search.Find("none.h", false); } catch (const std::invalid_argument &) { thrown = true; }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(search.statCount, 10);
+
+        // a file added later is found once the misses are dropped
+        search.files.insert("inc1\\none.h");
+        thrown = false;
+        try { search.Find("none.h", false); } catch (const std::invalid_argument &) { thrown = true; }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(search.statCount, 10);
+        cache.DropMisses();
+        EXPECT_EQ(search.Find("none.h", false), "inc1\\none.h");
+        EXPECT_EQ(search.Find("local.h", false), "dir\\local.h");
+        EXPECT_EQ(search.statCount, 12);
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        EXPECT_NOT_REACH;
+    }
+}
+
 // Token[] -> Token[]
 TEST_F(LexerTest, MacroSubstitution)
 {
@@ -1602,6 +2443,7 @@ TEST_F(LexerTest, MacroSubstitution)
             "ADD(2, 3)                   \n"
             "ADD(I, I)                   \n"
             "STR(apple)                  \n"
+            "STR(a  +b)                  \n"
             "CONCAT(ye, ah)              \n"
             "FOO(a)                      \n"
             "BAR(a)                      \n"
@@ -1611,20 +2453,18 @@ TEST_F(LexerTest, MacroSubstitution)
             "(2 + 3)                     \n"
             "(5 + 5)                     \n"
             "\"apple\"                   \n"
+            "\"a +b\"                    \n"
             "yeah                        \n"
             "FOO(a) FOO(a)               \n"
             "BAR(a) BAR(a)               \n"
             ;
 
-        std::vector<Token>          expectTokens = FilterAllTokens(ParseAllTokens(GetMatcher(), output),
-                                                                   TypeTokenFilter(Token::SPACE));
+        std::vector<Token>          expectTokens = ParseAllTokens(GetMatcher(), output);
 
         MacroContextTokenReplacer   repMacroContext ;
         MacroSubTokenReplacer       repMacroSub(repMacroContext.GetMacroContext(), GetMatcher());
         ChainedTokenReplacer        rep({ &repMacroContext, &repMacroSub });
-        std::vector<Token>          actualTokens = ReplaceAllTokens(FilterAllTokens(ParseAllTokens(GetMatcher(), input),
-                                                                                    TypeTokenFilter(Token::SPACE)),
-                                                                    rep);
+        std::vector<Token>          actualTokens = ReplaceAllTokens(ParseAllTokens(GetMatcher(), input), rep);
         
         EXPECT_EQ(actualTokens.size(), expectTokens.size());
         for (size_t i = 0; i < expectTokens.size(); ++i)
@@ -1644,4 +2484,32 @@ TEST_F(LexerTest, MacroSubstitution)
     }
 }
 
+TEST(Lexer_TokenIterator)
+{
+    Token literal(Token::CONST_INT, "0x10UL");
+    EvalToken(literal);
+
+    Token moved(std::move(literal));
+    EXPECT_EQ(moved.text, "0x10UL");
+    EXPECT_EQ(moved.ival, 16u);
+    EXPECT_EQ(moved.suffix, LITERAL_UNSIGNED | LITERAL_LONG);
+
+    Token assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.ival, 16u);
+    assigned = assigned;
+    EXPECT_EQ(assigned.text, "0x10UL");
+
+    // peek/next borrow from the vector, no copies.
+    std::vector<Token> tokens = { Token(Token::ID, "a"), assigned, Token(Token::STMT_END, ";") };
+    TokenIterator ti(tokens);
+    EXPECT_EQ(ti.PeekType(), Token::ID);
+    EXPECT_EQ(&ti.peek(), &tokens[0]);
+    EXPECT_EQ(&ti.peekN(2), &tokens[2]);
+    EXPECT_EQ(&ti.next(), &tokens[0]);
+    EXPECT_EQ(ti.next().ival, 16u);
+    EXPECT_EQ(ti.PeekType(), Token::STMT_END);
+    EXPECT_EQ(ti.index(), 2u);
+}
+
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 
 #include "../Base/String.h"
 #include "RegexMatcher.h"
@@ -136,10 +137,14 @@ struct Token
 
         PP_LPAREN,
 
+        // PP Conditional Group (raw text, lexed only if selected)
+
+        PP_GROUP,
+
         // Special
 
-        SPACE,
-        NEW_LINE,
+        SPACE,      // scanner only, folded into hasLeadingSpace
+        NEW_LINE,   // scanner only, folded into atLineStart
         END,
     };
 
@@ -147,25 +152,35 @@ struct Token
     std::string text;
     struct
     {
-        int ival;
-        float fval;
+        UINT64 ival;
+        double fval;
         char cval;
+        int suffix;     // LiteralSuffix flags
     };
+    // Set by the scanner in place of SPACE/NEW_LINE tokens.
+    bool hasLeadingSpace;   // whitespace (or new line) right before token
+    bool atLineStart;       // first token on its line
 
-    Token() : type(UNKNOWN), text() {}
-    Token(Type type_, std::string text_) : type(type_), text(text_) {}
-    Token(const Token & t) : type(t.type), text(t.text), ival(t.ival), fval(t.fval), cval(t.cval) {}
+    Token() : type(UNKNOWN), text(), hasLeadingSpace(false), atLineStart(false) {}
+    Token(Type type_, std::string text_) : type(type_), text(text_), hasLeadingSpace(false), atLineStart(false) {}
+    Token(const Token & t) : type(t.type), text(t.text), ival(t.ival), fval(t.fval), cval(t.cval), suffix(t.suffix), hasLeadingSpace(t.hasLeadingSpace), atLineStart(t.atLineStart) {}
     Token & operator = (const Token & t)
     {
-        this->~Token();
-        new (this) Token(t);
+        if (this != &t)
+        {
+            this->~Token();
+            new (this) Token(t);
+        }
         return *this;
     }
-    Token(Token && t) : type(t.type), text(t.text) {}
+    Token(Token && t) : type(t.type), text(std::move(t.text)), ival(t.ival), fval(t.fval), cval(t.cval), suffix(t.suffix), hasLeadingSpace(t.hasLeadingSpace), atLineStart(t.atLineStart) {}
     Token & operator = (Token && t)
     {
-        this->~Token();
-        new (this) Token(t);
+        if (this != &t)
+        {
+            this->~Token();
+            new (this) Token(std::move(t));
+        }
         return *this;
     }
     ~Token() {}
@@ -204,17 +219,47 @@ inline bool IsUnaryOp(Token::Type t)
         t == Token::BOOL_NOT;
 }
 
-std::vector<Token> LexProcess(std::string fileName, std::string * sourceAfterPreproc = nullptr);
+// includeDirs: -I search path, for "file" after the source directory, for <file> only.
+// filesRead: source file followed by every file it includes, as ScanDependencies().
+std::vector<Token> LexProcess(std::string fileName,
+                              std::string * sourceAfterPreproc = nullptr,
+                              const std::vector<std::string> & includeDirs = {},
+                              std::vector<std::string> * filesRead = nullptr);
+// Source file followed by every file it includes, without lexing/compiling.
+std::vector<std::string> ScanDependencies(std::string fileName,
+                                          const std::vector<std::string> & includeDirs = {});
+// Forget the include files found or missed by earlier lexes, for servers
+// that see files deleted or moved. Misses are forgotten by each lex anyway.
+void InvalidateIncludeCache();
+// Make rule listing deps as prerequisites of target.
+std::string MakeDependencyRule(const std::string & target, const std::vector<std::string> & deps);
+// Write direct-coded scanner for the C lex patterns to file.
+void GenerateLexScanner(std::string fileName);
+// Keyword type (KW_*) of an identifier spelling, or ID.
+Token::Type ClassifyKeyword(const char * text, size_t length);
+
+// FNV-1a of types and texts of tokens [begin, end).
+UINT64 HashTokens(const std::vector<Token> & tokens, size_t begin, size_t end);
+// Same types and texts, what HashTokens() hashes, of count tokens.
+bool SameTokens(const Token * a, const Token * b, size_t count);
 
 class TokenIterator {
 public:
-    TokenIterator(std::vector<Token> & tokens);
+    TokenIterator(const std::vector<Token> & tokens);
+    // Only tokens [begin, end), indices stay those of tokens.
+    TokenIterator(const std::vector<Token> & tokens, size_t begin, size_t end);
     bool has() const;
-    Token next();
-    Token peek() const;
-    Token peekN(int n) const;
+    // Borrowed from tokens(), valid while it is.
+    const Token & next();
+    const Token & peek() const;
+    const Token & peekN(int n) const;
+    Token::Type PeekType() const;
+    // Index of the next token in tokens().
+    size_t index() const;
+    const std::vector<Token> & tokens() const;
 
 private:
-    std::vector<Token> & tokens_;
+    const std::vector<Token> & tokens_;
     size_t i_;
+    size_t end_;
 };
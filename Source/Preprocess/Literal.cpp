@@ -0,0 +1,726 @@
+#include "Literal.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#define LITERAL_ERROR(message) do { throw std::invalid_argument(std::string("Literal error: ") + message); } while (false)
+
+// ==== SWAR Digits ====
+
+// 8 chars per UINT64, first char in the lowest byte (little endian).
+
+static inline UINT64 Load8(const char * p)
+{
+    UINT64 v;
+    memcpy(&v, p, 8);
+    return v;
+}
+static inline UINT64 Broadcast(unsigned char c)
+{
+    return 0x0101010101010101ull * c;
+}
+// 0x80 in every byte within [lo, hi], bytes must be < 0x80.
+static inline UINT64 InRange8(UINT64 v, unsigned char lo, unsigned char hi)
+{
+    return (v + Broadcast(0x80 - lo)) & ~(v + Broadcast(0x7F - hi)) & Broadcast(0x80);
+}
+static inline bool IsDecimal8(UINT64 v)
+{
+    return (v & Broadcast(0x80)) == 0 &&
+        InRange8(v, '0', '9') == Broadcast(0x80);
+}
+static inline bool IsOctal8(UINT64 v)
+{
+    return (v & Broadcast(0x80)) == 0 &&
+        InRange8(v, '0', '7') == Broadcast(0x80);
+}
+static inline bool IsHex8(UINT64 v)
+{
+    return (v & Broadcast(0x80)) == 0 &&
+        (InRange8(v, '0', '9') | InRange8(v | Broadcast(0x20), 'a', 'f')) == Broadcast(0x80);
+}
+
+// Pairs of adjacent lanes merge into one lane twice as wide, the earlier
+// (lower) lane being more significant.
+static inline UINT32 Decimal8(UINT64 v)
+{
+    v -= Broadcast('0');
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+         (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+    return static_cast<UINT32>(v);
+}
+static inline UINT32 Octal8(UINT64 v)
+{
+    v -= Broadcast('0');
+    v = ((v & 0x0007000700070007ull) << 3) | ((v >> 8) & 0x0007000700070007ull);
+    v = ((v & 0x0000003F0000003Full) << 6) | ((v >> 16) & 0x0000003F0000003Full);
+    v = ((v & 0xFFFull) << 12) | ((v >> 32) & 0xFFFull);
+    return static_cast<UINT32>(v);
+}
+static inline UINT32 Hex8(UINT64 v)
+{
+    v = (v & Broadcast(0x0F)) + ((v >> 6) & Broadcast(0x01)) * 9;
+    v = ((v & 0x000F000F000F000Full) << 4) | ((v >> 8) & 0x000F000F000F000Full);
+    v = ((v & 0x000000FF000000FFull) << 8) | ((v >> 16) & 0x000000FF000000FFull);
+    v = ((v & 0xFFFFull) << 16) | ((v >> 32) & 0xFFFFull);
+    return static_cast<UINT32>(v);
+}
+
+static inline int HexDigit(char c)
+{
+    if ('0' <= c && c <= '9') return c - '0';
+    if ('a' <= c && c <= 'f') return c - 'a' + 10;
+    if ('A' <= c && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static UINT64 ParseDecimal(const char * p, const char * end)
+{
+    UINT64 value = 0;
+    for (; end - p >= 8 && IsDecimal8(Load8(p)); p += 8)
+    {
+        UINT32 chunk = Decimal8(Load8(p));
+        if (value > (UINT64_MAX - chunk) / 100000000u)
+            LITERAL_ERROR("integer constant too large.");
+        value = value * 100000000u + chunk;
+    }
+    for (; p < end; ++p)
+    {
+        if (*p < '0' || *p > '9')
+            LITERAL_ERROR(std::string("invalid digit '") + *p + "' in decimal constant.");
+        UINT64 digit = *p - '0';
+        if (value > (UINT64_MAX - digit) / 10)
+            LITERAL_ERROR("integer constant too large.");
+        value = value * 10 + digit;
+    }
+    return value;
+}
+static UINT64 ParseOctal(const char * p, const char * end)
+{
+    UINT64 value = 0;
+    for (; end - p >= 8 && IsOctal8(Load8(p)); p += 8)
+    {
+        if (value >> 40)
+            LITERAL_ERROR("integer constant too large.");
+        value = (value << 24) | Octal8(Load8(p));
+    }
+    for (; p < end; ++p)
+    {
+        if (*p < '0' || *p > '7')
+            LITERAL_ERROR(std::string("invalid digit '") + *p + "' in octal constant.");
+        if (value >> 61)
+            LITERAL_ERROR("integer constant too large.");
+        value = (value << 3) | (*p - '0');
+    }
+    return value;
+}
+static UINT64 ParseHex(const char * p, const char * end)
+{
+    if (p == end)
+        LITERAL_ERROR("missing digits in hex constant.");
+
+    UINT64 value = 0;
+    for (; end - p >= 8 && IsHex8(Load8(p)); p += 8)
+    {
+        if (value >> 32)
+            LITERAL_ERROR("integer constant too large.");
+        value = (value << 32) | Hex8(Load8(p));
+    }
+    for (; p < end; ++p)
+    {
+        int digit = HexDigit(*p);
+        if (digit < 0)
+            LITERAL_ERROR(std::string("invalid digit '") + *p + "' in hex constant.");
+        if (value >> 60)
+            LITERAL_ERROR("integer constant too large.");
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+// ==== Integer ====
+
+IntegerLiteral ParseIntegerLiteral(const char * begin, const char * end)
+{
+    IntegerLiteral literal = { 0, 0 };
+
+    // U, L, UL, LU in any case
+    const char * digitsEnd = end;
+    while (digitsEnd > begin && (digitsEnd[-1] == 'u' || digitsEnd[-1] == 'U' ||
+                                 digitsEnd[-1] == 'l' || digitsEnd[-1] == 'L'))
+    {
+        --digitsEnd;
+        int flag = (*digitsEnd == 'u' || *digitsEnd == 'U') ? LITERAL_UNSIGNED : LITERAL_LONG;
+        if (literal.suffix & flag)
+            LITERAL_ERROR("invalid suffix '" + std::string(digitsEnd, end) + "' on integer constant.");
+        literal.suffix |= flag;
+    }
+
+    if (begin == digitsEnd)
+        LITERAL_ERROR("missing digits in integer constant.");
+    else if (digitsEnd - begin >= 2 && begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X'))
+        literal.value = ParseHex(begin + 2, digitsEnd);
+    else if (begin[0] == '0')
+        literal.value = ParseOctal(begin + 1, digitsEnd);
+    else
+        literal.value = ParseDecimal(begin, digitsEnd);
+
+    return literal;
+}
+
+// ==== Float: Eisel-Lemire ====
+
+// Decimal w * 10^q to binary, see Lemire, "Number Parsing at a Gigabyte per
+// Second" and Mushtak & Lemire, "Fast Number Parsing Without Fallback".
+// Exact for w of up to 19 digits, longer inputs go to strtod().
+
+struct BinaryFormat
+{
+    int mantissaBits;
+    int minimumExponent;
+    int infinitePower;
+    int minRoundToEven;
+    int maxRoundToEven;
+    int smallestPowerOfTen;
+    int largestPowerOfTen;
+};
+static const BinaryFormat kBinary64 = { 52, -1023, 0x7FF, -4, 23, -342, 308 };
+static const BinaryFormat kBinary32 = { 23, -127, 0xFF, -17, 10, -64, 38 };
+
+static const int kSmallestPowerOfFive = -342;
+static const int kLargestPowerOfFive = 308;
+
+// Big unsigned integer, 32-bit words, least significant first.
+typedef std::vector<UINT32> BigInt;
+
+static size_t BitLength(const BigInt & a)
+{
+    for (size_t i = a.size(); i > 0; --i)
+    {
+        if (a[i - 1])
+        {
+            size_t bits = (i - 1) * 32;
+            for (UINT32 w = a[i - 1]; w; w >>= 1)
+                ++bits;
+            return bits;
+        }
+    }
+    return 0;
+}
+static UINT64 BitsAt(const BigInt & a, size_t bit) // 64 bits from bit
+{
+    UINT64 v = 0;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        size_t b = bit + i;
+        if (b / 32 < a.size() && ((a[b / 32] >> (b % 32)) & 1))
+            v |= 1ull << i;
+    }
+    return v;
+}
+static void MulSmall(BigInt & a, UINT32 m)
+{
+    UINT64 carry = 0;
+    for (UINT32 & w : a)
+    {
+        carry += static_cast<UINT64>(w) * m;
+        w = static_cast<UINT32>(carry);
+        carry >>= 32;
+    }
+    if (carry)
+        a.push_back(static_cast<UINT32>(carry));
+}
+static void DivSmall(BigInt & a, UINT32 d)
+{
+    UINT64 rem = 0;
+    for (size_t i = a.size(); i > 0; --i)
+    {
+        UINT64 cur = (rem << 32) | a[i - 1];
+        a[i - 1] = static_cast<UINT32>(cur / d);
+        rem = cur % d;
+    }
+}
+static BigInt ShiftRight(const BigInt & a, size_t bits)
+{
+    BigInt r((BitLength(a) + 31) / 32 + 1, 0);
+    for (size_t i = 0; i < r.size(); ++i)
+        r[i] = static_cast<UINT32>(BitsAt(a, bits + i * 32));
+    return r;
+}
+static void AddOne(BigInt & a)
+{
+    for (UINT32 & w : a)
+    {
+        if (++w != 0)
+            return;
+    }
+    a.push_back(1);
+}
+
+// 128-bit truncated 5^q for q in [-342, 308], high word first: for q < 0
+// floor(2^b / 5^-q) + 1 at b = bitlen + 127 (q >= -27) or 2 * bitlen + 128.
+static const std::vector<UINT64> & PowersOfFive()
+{
+    static std::vector<UINT64> table = []() {
+        std::vector<UINT64> t(2 * (kLargestPowerOfFive - kSmallestPowerOfFive + 1));
+        auto store = [&t](int q, const BigInt & c) {
+            size_t length = BitLength(c);
+            size_t shift = length > 128 ? length - 128 : 0;
+            UINT64 high = BitsAt(c, shift + 64);
+            UINT64 low = BitsAt(c, shift);
+            if (length < 128) // normalize
+            {
+                size_t up = 128 - length;
+                high = up >= 64 ? low << (up - 64) : (high << up) | (low >> (64 - up));
+                low = up >= 64 ? 0 : low << up;
+            }
+            t[2 * (q - kSmallestPowerOfFive)] = high;
+            t[2 * (q - kSmallestPowerOfFive) + 1] = low;
+        };
+
+        // q >= 0: 5^q
+        BigInt power5 = { 1 };
+        for (int q = 0; q <= kLargestPowerOfFive; ++q)
+        {
+            store(q, power5);
+            MulSmall(power5, 5);
+        }
+
+        // q < 0: floor(2^P / 5^n) by repeated division, floor(floor(x / a) / b) == floor(x / ab)
+        power5 = { 1 };
+        std::vector<size_t> bitLengths(-kSmallestPowerOfFive + 1);
+        for (int n = 1; n <= -kSmallestPowerOfFive; ++n)
+        {
+            MulSmall(power5, 5);
+            bitLengths[n] = BitLength(power5);
+        }
+        const size_t P = 2 * bitLengths[-kSmallestPowerOfFive] + 128;
+        BigInt quotient(P / 32 + 1, 0);
+        quotient[P / 32] = 1u << (P % 32);
+        for (int n = 1; n <= -kSmallestPowerOfFive; ++n)
+        {
+            DivSmall(quotient, 5);
+            size_t z = bitLengths[n];
+            size_t b = n <= 27 ? z + 127 : 2 * z + 128;
+            BigInt c = ShiftRight(quotient, P - b);
+            AddOne(c);
+            store(-n, c);
+        }
+        return t;
+    }();
+    return table;
+}
+
+struct UINT128
+{
+    UINT64 high;
+    UINT64 low;
+};
+static inline UINT128 FullMultiply(UINT64 a, UINT64 b)
+{
+    UINT128 r;
+#if defined(_M_X64)
+    r.low = _umul128(a, b, &r.high);
+#elif defined(__SIZEOF_INT128__)
+    unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+    r.high = static_cast<UINT64>(p >> 64);
+    r.low = static_cast<UINT64>(p);
+#else
+    UINT64 aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+    UINT64 bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+    UINT64 ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    UINT64 mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    r.low = (mid << 32) | (ll & 0xFFFFFFFFu);
+    r.high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    return r;
+}
+static inline int LeadingZeros(UINT64 x) // x != 0
+{
+    int n = 0;
+    if (!(x >> 32)) n += 32, x <<= 32;
+    if (!(x >> 48)) n += 16, x <<= 16;
+    if (!(x >> 56)) n += 8, x <<= 8;
+    if (!(x >> 60)) n += 4, x <<= 4;
+    if (!(x >> 62)) n += 2, x <<= 2;
+    if (!(x >> 63)) n += 1;
+    return n;
+}
+
+// w * 10^q -> (biased exponent, mantissa) of the format.
+static void ComputeFloat(const BinaryFormat & format, i64 q, UINT64 w, UINT64 & mantissa, int & power2)
+{
+    mantissa = 0;
+    power2 = 0;
+    if (w == 0 || q < format.smallestPowerOfTen)
+        return;
+    if (q > format.largestPowerOfTen)
+    {
+        power2 = format.infinitePower;
+        return;
+    }
+
+    int lz = LeadingZeros(w);
+    w <<= lz;
+
+    // product of w and 5^q, second half of the table only when needed
+    const std::vector<UINT64> & powers = PowersOfFive();
+    size_t index = 2 * static_cast<size_t>(q - kSmallestPowerOfFive);
+    const UINT64 precisionMask = 0xFFFFFFFFFFFFFFFFull >> (format.mantissaBits + 3);
+    UINT128 product = FullMultiply(w, powers[index]);
+    if ((product.high & precisionMask) == precisionMask)
+    {
+        UINT128 second = FullMultiply(w, powers[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low)
+            ++product.high;
+    }
+
+    int upperBit = static_cast<int>(product.high >> 63);
+    int shift = upperBit + 64 - format.mantissaBits - 3;
+    mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63 == ((217706 * q) >> 16) + 63
+    power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63 + upperBit - lz - format.minimumExponent);
+
+    if (power2 <= 0) // subnormal
+    {
+        if (-power2 + 1 >= 64)
+        {
+            mantissa = 0;
+            power2 = 0;
+            return;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = mantissa < (1ull << format.mantissaBits) ? 0 : 1;
+        return;
+    }
+
+    // exactly halfway, round to even
+    if (product.low <= 1 &&
+        q >= format.minRoundToEven && q <= format.maxRoundToEven &&
+        (mantissa & 3) == 1 &&
+        (mantissa << shift) == product.high)
+    {
+        mantissa &= ~1ull;
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= (2ull << format.mantissaBits))
+    {
+        mantissa = 1ull << format.mantissaBits;
+        ++power2;
+    }
+    mantissa &= ~(1ull << format.mantissaBits);
+    if (power2 >= format.infinitePower)
+    {
+        power2 = format.infinitePower;
+        mantissa = 0;
+    }
+}
+
+static double ToDouble(i64 q, UINT64 w)
+{
+    // Clinger: both exact in double, one correctly rounded operation
+    static const double kPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    if (-22 <= q && q <= 22 && w <= (1ull << 53))
+    {
+        double d = static_cast<double>(w);
+        return q >= 0 ? d * kPowersOfTen[q] : d / kPowersOfTen[-q];
+    }
+
+    UINT64 mantissa;
+    int power2;
+    ComputeFloat(kBinary64, q, w, mantissa, power2);
+    UINT64 bits = mantissa | (static_cast<UINT64>(power2) << kBinary64.mantissaBits);
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+static float ToFloat(i64 q, UINT64 w)
+{
+    static const float kPowersOfTen[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+    };
+    if (-10 <= q && q <= 10 && w <= (1ull << 24))
+    {
+        float f = static_cast<float>(w);
+        return q >= 0 ? f * kPowersOfTen[q] : f / kPowersOfTen[-q];
+    }
+
+    UINT64 mantissa;
+    int power2;
+    ComputeFloat(kBinary32, q, w, mantissa, power2);
+    UINT32 bits = static_cast<UINT32>(mantissa | (static_cast<UINT64>(power2) << kBinary32.mantissaBits));
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// ==== Float ====
+
+FloatLiteral ParseFloatLiteral(const char * begin, const char * end)
+{
+    FloatLiteral literal = { 0.0, 0 };
+
+    if (end > begin && (end[-1] == 'f' || end[-1] == 'F'))
+        literal.suffix = LITERAL_FLOAT, --end;
+    else if (end > begin && (end[-1] == 'l' || end[-1] == 'L'))
+        literal.suffix = LITERAL_LONG, --end;
+
+    // significand: up to 19 digits in w, the rest scale q
+    UINT64 w = 0;
+    i64 q = 0;
+    int digits = 0;
+    bool truncated = false;
+    bool anyDigit = false;
+    auto digit = [&](char c, bool afterDot) {
+        anyDigit = true;
+        if (digits == 0 && c == '0')
+        {
+            q -= afterDot ? 1 : 0;
+        }
+        else if (digits < 19)
+        {
+            w = w * 10 + (c - '0');
+            ++digits;
+            q -= afterDot ? 1 : 0;
+        }
+        else
+        {
+            q += afterDot ? 0 : 1;
+            truncated = truncated || c != '0';
+        }
+    };
+
+    const char * p = begin;
+    for (; p < end && '0' <= *p && *p <= '9'; ++p)
+        digit(*p, false);
+    if (p < end && *p == '.')
+    {
+        ++p;
+        // 8 at a time while they all fit in w
+        while (digits > 0 && digits + 8 <= 19 && end - p >= 8 && IsDecimal8(Load8(p)))
+        {
+            w = w * 100000000u + Decimal8(Load8(p));
+            digits += 8;
+            q -= 8;
+            p += 8;
+        }
+        for (; p < end && '0' <= *p && *p <= '9'; ++p)
+            digit(*p, true);
+    }
+    if (!anyDigit)
+        LITERAL_ERROR("missing digits in floating constant.");
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negative = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+'))
+            ++p;
+        if (p == end)
+            LITERAL_ERROR("missing exponent digits in floating constant.");
+        i64 exponent = 0;
+        for (; p < end && '0' <= *p && *p <= '9'; ++p)
+        {
+            if (exponent < 100000)
+                exponent = exponent * 10 + (*p - '0');
+        }
+        q += negative ? -exponent : exponent;
+    }
+    if (p != end)
+        LITERAL_ERROR("invalid floating constant '" + std::string(begin, end) + "'.");
+
+    if (truncated)
+    {
+        std::string text(begin, end);
+        literal.value = (literal.suffix & LITERAL_FLOAT)
+            ? strtof(text.data(), nullptr)
+            : strtod(text.data(), nullptr);
+    }
+    else
+    {
+        literal.value = (literal.suffix & LITERAL_FLOAT)
+            ? ToFloat(q, w)
+            : ToDouble(q, w);
+    }
+    return literal;
+}
+
+// ==== Char ====
+
+char ParseCharLiteral(const char * begin, const char * end)
+{
+    if (begin == end)
+        LITERAL_ERROR("empty character constant.");
+
+    const char * p = begin;
+    int value;
+    if (*p != '\\')
+    {
+        value = static_cast<unsigned char>(*p++);
+    }
+    else if (++p == end)
+    {
+        LITERAL_ERROR("incomplete escape sequence.");
+    }
+    else
+    {
+        char c = *p++;
+        switch (c)
+        {
+            case 'n': value = '\n'; break;
+            case 't': value = '\t'; break;
+            case 'r': value = '\r'; break;
+            case 'v': value = '\v'; break;
+            case 'b': value = '\b'; break;
+            case 'f': value = '\f'; break;
+            case 'a': value = '\a'; break;
+            case '\\': case '\'': case '"': case '?':
+                value = c;
+                break;
+            case 'x':
+                value = 0;
+                if (p == end || HexDigit(*p) < 0)
+                    LITERAL_ERROR("missing digits in \\x escape.");
+                for (; p < end && HexDigit(*p) >= 0; ++p)
+                    value = (value << 4) | HexDigit(*p);
+                if (value > 0xFF)
+                    LITERAL_ERROR("\\x escape out of range.");
+                break;
+            default:
+                if (c < '0' || c > '7')
+                    LITERAL_ERROR(std::string("unknown escape sequence '\\") + c + "'.");
+                value = c - '0';
+                for (int i = 1; i < 3 && p < end && '0' <= *p && *p <= '7'; ++i, ++p)
+                    value = (value << 3) | (*p - '0');
+                if (value > 0xFF)
+                    LITERAL_ERROR("octal escape out of range.");
+                break;
+        }
+    }
+    if (p != end)
+        LITERAL_ERROR("multi-character constant.");
+
+    return static_cast<char>(value);
+}
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+TEST(Literal_Integer)
+{
+    struct { const char * text; UINT64 value; int suffix; } cases[] = {
+        { "0", 0, 0 },
+        { "7", 7, 0 },
+        { "123456789", 123456789, 0 },
+        { "1234567812345678", 1234567812345678ull, 0 },
+        { "18446744073709551615", 18446744073709551615ull, 0 },
+        { "42u", 42, LITERAL_UNSIGNED },
+        { "42L", 42, LITERAL_LONG },
+        { "42uL", 42, LITERAL_UNSIGNED | LITERAL_LONG },
+        { "42LU", 42, LITERAL_UNSIGNED | LITERAL_LONG },
+        { "017", 15, 0 },
+        { "0123456701234567", 0123456701234567ull, 0 },
+        { "01777777777777777777777", 01777777777777777777777ull, 0 },
+        { "0x0", 0, 0 },
+        { "0xff", 255, 0 },
+        { "0XdeadBEEF", 0xDEADBEEFull, 0 },
+        { "0x0123456789abcdef", 0x0123456789ABCDEFull, 0 },
+        { "0xFFFFFFFFFFFFFFFFul", 0xFFFFFFFFFFFFFFFFull, LITERAL_UNSIGNED | LITERAL_LONG },
+    };
+    for (auto & c : cases)
+    {
+        IntegerLiteral literal = ParseIntegerLiteral(c.text, c.text + strlen(c.text));
+        EXPECT_EQ(literal.value, c.value);
+        EXPECT_EQ(literal.suffix, c.suffix);
+    }
+
+    const char * bad[] = {
+        "18446744073709551616", "0x10000000000000000", "02000000000000000000000",
+        "08", "0123456789", "0x", "1uu", "1lul",
+    };
+    for (const char * text : bad)
+    {
+        bool thrown = false;
+        try { ParseIntegerLiteral(text, text + strlen(text)); }
+        catch (const std::invalid_argument &) { thrown = true; }
+        EXPECT_TRUE(thrown);
+    }
+}
+
+TEST(Literal_Float)
+{
+    // generated table matches the published one at a few points
+    const std::vector<UINT64> & powers = PowersOfFive();
+    EXPECT_EQ(powers[0], 0xeef453d6923bd65aull);
+    EXPECT_EQ(powers[1], 0x113faa2906a13b3full);
+    EXPECT_EQ(powers[2 * 342], 0x8000000000000000ull);
+    EXPECT_EQ(powers[2 * 343], 0xa000000000000000ull);
+
+    const char * texts[] = {
+        "0.0", "1.0", "0.1", ".5", "3.", "3.14159", "2.5e-3", "1e10", "1E+10",
+        "1.7976931348623157e308", "1.8e308", "4.9406564584124654e-324", "2.4703282292062328e-324",
+        "2.4703282292062327e-324", "1e-400", "9007199254740993.0", "0.30000000000000004",
+        "123456789012345678901234567890.5", "1.00000000000000011102230246251565404236316680908203125",
+        "7.038531e-26", "0.000000000000000000000000000000000000001", "2.2250738585072011e-308",
+        "1.4e-45", "3.4028235e38", "3.4028236e38",
+    };
+    for (const char * text : texts)
+    {
+        double d = ParseFloatLiteral(text, text + strlen(text)).value;
+        EXPECT_EQ(d, strtod(text, nullptr));
+
+        std::string f = std::string(text) + "f";
+        FloatLiteral literal = ParseFloatLiteral(f.data(), f.data() + f.length());
+        EXPECT_EQ(literal.suffix, LITERAL_FLOAT);
+        EXPECT_EQ(static_cast<float>(literal.value), strtof(text, nullptr));
+    }
+
+    // random digits and exponents against strtod
+    UINT32 seed = 2020;
+    auto random = [&seed](UINT32 n) { seed = seed * 1103515245u + 12345u; return (seed >> 8) % n; };
+    int mismatch = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string text;
+        size_t digitCount = 1 + random(19);
+        for (size_t k = 0; k < digitCount; ++k)
+            text.push_back(static_cast<char>('0' + random(10)));
+        text.insert(random(static_cast<UINT32>(digitCount + 1)), ".");
+        text += "e" + std::to_string(static_cast<int>(random(700)) - 350);
+
+        if (ParseFloatLiteral(text.data(), text.data() + text.length()).value != strtod(text.data(), nullptr))
+            ++mismatch;
+        std::string f = text + "f";
+        if (static_cast<float>(ParseFloatLiteral(f.data(), f.data() + f.length()).value) != strtof(text.data(), nullptr))
+            ++mismatch;
+    }
+    EXPECT_EQ(mismatch, 0);
+}
+
+TEST(Literal_Char)
+{
+    struct { const char * text; char value; } cases[] = {
+        { "a", 'a' }, { "\\n", '\n' }, { "\\t", '\t' }, { "\\\\", '\\' }, { "\\'", '\'' },
+        { "\\0", '\0' }, { "\\101", 'A' }, { "\\x41", 'A' }, { "\\xff", '\xff' }, { "\\377", '\377' },
+    };
+    for (auto & c : cases)
+        EXPECT_EQ(ParseCharLiteral(c.text, c.text + strlen(c.text)), c.value);
+}
+
+#endif
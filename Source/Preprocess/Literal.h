@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../Base/Integer.h"
+
+// Literal suffix flags, U/L for integer, F/L for float constants.
+enum LiteralSuffix
+{
+    LITERAL_UNSIGNED    = 1,
+    LITERAL_LONG        = 2,
+    LITERAL_FLOAT       = 4,
+};
+
+struct IntegerLiteral
+{
+    UINT64 value;
+    int suffix;
+};
+struct FloatLiteral
+{
+    double value;       // float suffix: value rounded to float
+    int suffix;
+};
+
+// Throw std::invalid_argument on malformed literal or overflow.
+
+// Decimal, 0x hex or 0 octal digits, then U/L suffix.
+IntegerLiteral  ParseIntegerLiteral(const char * begin, const char * end);
+// C89 floating constant, then F/L suffix. Correctly rounded.
+FloatLiteral    ParseFloatLiteral(const char * begin, const char * end);
+// Text between the quotes of a char constant, with escapes.
+char            ParseCharLiteral(const char * begin, const char * end);
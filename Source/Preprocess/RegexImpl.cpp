@@ -5,6 +5,11 @@
 #include <set>
 #include <deque>
 #include <map>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace v2 {
 namespace re {
@@ -30,6 +35,46 @@ using CharIndex = int;
 #define CHAR_EOS (256 + 2)
 #define CHAR_LAST CHAR_EOS
 #define CHAR_COUNT (CHAR_LAST + 1)
+// Not a jump table column, node consumes its CharBitmap.
+#define CHAR_CLASS (256 + 3)
+
+CharBitmap::CharBitmap()
+{
+    bits[0] = bits[1] = bits[2] = bits[3] = 0;
+}
+
+void CharBitmap::Set(int ch)
+{
+    ASSERT(0 <= ch && ch < 256);
+    bits[ch / 64] |= 1ull << (ch % 64);
+}
+
+void CharBitmap::SetRange(int first, int last)
+{
+    for (int ch = first; ch <= last; ++ch)
+        Set(ch);
+}
+
+void CharBitmap::Negate()
+{
+    bits[0] = ~bits[0];
+    bits[1] = ~bits[1];
+    bits[2] = ~bits[2];
+    bits[3] = ~bits[3];
+}
+
+bool CharBitmap::Test(int ch) const
+{
+    return 0 <= ch && ch < 256 && ((bits[ch / 64] >> (ch % 64)) & 1);
+}
+
+int CharBitmap::Count() const
+{
+    int count = 0;
+    for (int ch = 0; ch < 256; ++ch)
+        count += Test(ch) ? 1 : 0;
+    return count;
+}
 
 // Regex
 
@@ -65,6 +110,20 @@ public:
     ACCEPT_VISIT_DECL
         CharIndex index;
 };
+class CharClass : public RegexStruct::Element
+{
+public:
+    ACCEPT_VISIT_DECL
+        CharBitmap chars;
+};
+// max < 0: no upper bound.
+class RepeatOperator : public RegexStruct::Element
+{
+public:
+    ACCEPT_VISIT_DECL
+        int min;
+        int max;
+};
 
 class RegexStruct::Visitor
 {
@@ -75,20 +134,199 @@ public:
     virtual void Visit(AlterOperator &) {}
     virtual void Visit(KleeneStarOperator &) {}
     virtual void Visit(ASCIICharacter &) {}
+    virtual void Visit(CharClass &) {}
+    virtual void Visit(RepeatOperator &) {}
 };
 
 ACCEPT_VISIT_IMPL(ConcatOperator)
 ACCEPT_VISIT_IMPL(AlterOperator)
 ACCEPT_VISIT_IMPL(KleeneStarOperator)
 ACCEPT_VISIT_IMPL(ASCIICharacter)
+ACCEPT_VISIT_IMPL(CharClass)
+ACCEPT_VISIT_IMPL(RepeatOperator)
 
 RegexStructFactory::PostfixBuilder RegexStructFactory::CreateBuilder()
 {
     return {};
 }
 
-// group -> or -> and -> star -> group/char
-// RegexStruct RegexStructFactory::CreateFromString(StringView svRegex);
+#define REGEX_EXPECT_TRUE(cond) \
+    do { \
+        if (!(cond)) \
+            throw std::invalid_argument("bad regex: expect " #cond); \
+    } while (false)
+
+// alter -> concat -> repeat -> atom (group/class/char)
+RegexStruct RegexStructFactory::CreateFromString(StringView svRegex)
+{
+    const char * c = svRegex.Begin();
+    const char * end = svRegex.End();
+
+    RegexStruct rs(ParseAlter(c, end));
+    REGEX_EXPECT_TRUE(c == end);
+    return rs;
+}
+
+// concat ('|' concat)*
+RegexStruct::Node * RegexStructFactory::ParseAlter(const char * & c, const char * end)
+{
+    RegexStruct::Node * pNode = ParseConcat(c, end);
+    while (c != end && *c == '|')
+    {
+        ++c;
+        pNode = NewAlterNode(pNode, ParseConcat(c, end));
+    }
+    return pNode;
+}
+
+// repeat+
+RegexStruct::Node * RegexStructFactory::ParseConcat(const char * & c, const char * end)
+{
+    RegexStruct::Node * pNode = ParseRepeat(c, end);
+    while (c != end && *c != '|' && *c != ')')
+    {
+        pNode = NewConcatNode(pNode, ParseRepeat(c, end));
+    }
+    return pNode;
+}
+
+// atom ('*' | '+' | '?' | '{' m (',' n?)? '}')*
+RegexStruct::Node * RegexStructFactory::ParseRepeat(const char * & c, const char * end)
+{
+    auto ParseInt = [&c, end] () -> int
+    {
+        REGEX_EXPECT_TRUE(c != end && '0' <= *c && *c <= '9');
+        int i = 0;
+        while (c != end && '0' <= *c && *c <= '9')
+            i = i * 10 + (*c++ - '0');
+        return i;
+    };
+
+    RegexStruct::Node * pNode = ParseAtom(c, end);
+    while (c != end)
+    {
+        if (*c == '*')
+        {
+            ++c;
+            pNode = NewKleeneStarNode(pNode);
+        }
+        else if (*c == '+')
+        {
+            ++c;
+            pNode = NewRepeatNode(pNode, 1, -1);
+        }
+        else if (*c == '?')
+        {
+            ++c;
+            pNode = NewRepeatNode(pNode, 0, 1);
+        }
+        else if (*c == '{')
+        {
+            ++c;
+            int min = ParseInt();
+            int max = min;
+            if (c != end && *c == ',')
+            {
+                ++c;
+                max = (c != end && *c == '}') ? -1 : ParseInt();
+            }
+            REGEX_EXPECT_TRUE(c != end && *c == '}');
+            REGEX_EXPECT_TRUE(max < 0 || (min <= max && max > 0));
+            ++c;
+            pNode = NewRepeatNode(pNode, min, max);
+        }
+        else
+            break;
+    }
+    return pNode;
+}
+
+// '(' alter ')' | class | '.' | '\\' char | char
+RegexStruct::Node * RegexStructFactory::ParseAtom(const char * & c, const char * end)
+{
+    REGEX_EXPECT_TRUE(c != end);
+    switch (*c)
+    {
+        case '(':
+        {
+            ++c;
+            RegexStruct::Node * pNode = ParseAlter(c, end);
+            REGEX_EXPECT_TRUE(c != end && *c == ')');
+            ++c;
+            return pNode;
+        }
+        case '[':
+            return ParseClass(c, end);
+        case '.':
+        {
+            ++c;
+            CharBitmap chars;
+            chars.SetRange(0, 255);
+            return NewClassNode(chars);
+        }
+        case '\\':
+            ++c;
+            REGEX_EXPECT_TRUE(c != end);
+            return NewAsciiNode(static_cast<unsigned char>(*c++));
+        default:
+            REGEX_EXPECT_TRUE(*c != '|' && *c != ')' && *c != '*' && *c != '+' && *c != '?' && *c != '{');
+            return NewAsciiNode(static_cast<unsigned char>(*c++));
+    }
+}
+
+// '[' '^'? (char | char '-' char | '\\' char)+ ']'
+RegexStruct::Node * RegexStructFactory::ParseClass(const char * & c, const char * end)
+{
+    CharBitmap chars;
+    bool negate = false;
+
+    ++c;
+    if (c != end && *c == '^')
+    {
+        negate = true;
+        ++c;
+    }
+
+    REGEX_EXPECT_TRUE(c != end && *c != ']');
+    do
+    {
+        if (*c == '\\')
+        {
+            ++c;
+            REGEX_EXPECT_TRUE(c != end);
+            chars.Set(static_cast<unsigned char>(*c++));
+        }
+        else if (c + 2 < end && c[1] == '-' && c[2] != ']')
+        {
+            int first = static_cast<unsigned char>(c[0]);
+            int last = static_cast<unsigned char>(c[2]);
+            REGEX_EXPECT_TRUE(first <= last);
+            chars.SetRange(first, last);
+            c += 3;
+        }
+        else
+        {
+            chars.Set(static_cast<unsigned char>(*c++));
+        }
+    } while (c != end && *c != ']');
+
+    REGEX_EXPECT_TRUE(c != end && *c == ']');
+    ++c;
+
+    if (negate)
+        chars.Negate();
+
+    // Single char: keep it an ASCIICharacter.
+    if (chars.Count() == 1)
+    {
+        for (int ch = 0; ch < 256; ++ch)
+        {
+            if (chars.Test(ch))
+                return NewAsciiNode(ch);
+        }
+    }
+    return NewClassNode(chars);
+}
 
 RegexStruct::Node * RegexStructFactory::NewAsciiNode(int ch)
 {
@@ -103,6 +341,19 @@ RegexStruct::Node * RegexStructFactory::NewAsciiNode(int ch)
     return pNode;
 }
 
+RegexStruct::Node * RegexStructFactory::NewClassNode(const CharBitmap & chars)
+{
+    CharClass * pElement = REGEX_ALLOC(CharClass);
+    pElement->chars = chars;
+
+    RegexStruct::Node * pNode = REGEX_ALLOC(RegexStruct::Node);
+    pNode->pLeft = nullptr;
+    pNode->pRight = nullptr;
+    pNode->pElement = pElement;
+
+    return pNode;
+}
+
 RegexStruct::Node * RegexStructFactory::NewConcatNode(RegexStruct::Node * pLeft, RegexStruct::Node * pRight)
 {
     RegexStruct::Node * pNode = REGEX_ALLOC(RegexStruct::Node);
@@ -133,6 +384,22 @@ RegexStruct::Node * RegexStructFactory::NewKleeneStarNode(RegexStruct::Node * pI
     return pNode;
 }
 
+RegexStruct::Node * RegexStructFactory::NewRepeatNode(RegexStruct::Node * pInner, int min, int max)
+{
+    ASSERT(min >= 0 && (max < 0 || (min <= max && max > 0)));
+
+    RepeatOperator * pElement = REGEX_ALLOC(RepeatOperator);
+    pElement->min = min;
+    pElement->max = max;
+
+    RegexStruct::Node * pNode = REGEX_ALLOC(RegexStruct::Node);
+    pNode->pLeft = pInner;
+    pNode->pRight = nullptr;
+    pNode->pElement = pElement;
+
+    return pNode;
+}
+
 void RegexStruct::FreeRegexStruct(Node * pNode)
 {
     if (pNode)
@@ -179,6 +446,12 @@ RegexStructFactory::PostfixBuilder & RegexStructFactory::PostfixBuilder::Ascii(i
     return *this;
 }
 
+RegexStructFactory::PostfixBuilder & RegexStructFactory::PostfixBuilder::Class(const CharBitmap & chars)
+{
+    stack.Add(NewClassNode(chars));
+    return *this;
+}
+
 RegexStructFactory::PostfixBuilder & RegexStructFactory::PostfixBuilder::Concat()
 {
     RegexStruct::Node * pNode1 = stack[stack.Count() - 2];
@@ -208,6 +481,15 @@ RegexStructFactory::PostfixBuilder & RegexStructFactory::PostfixBuilder::KleeneS
     return *this;
 }
 
+RegexStructFactory::PostfixBuilder & RegexStructFactory::PostfixBuilder::Repeat(int min, int max)
+{
+    RegexStruct::Node * pNode = stack[stack.Count() - 1];
+    RegexStruct::Node * pNodeRepeat = NewRepeatNode(pNode, min, max);
+    stack.RemoveAt(stack.Count() - 1, 1);
+    stack.Add(pNodeRepeat);
+    return *this;
+}
+
 RegexStruct RegexStructFactory::PostfixBuilder::Build()
 {
     ASSERT(stack.Count() == 1);
@@ -222,6 +504,8 @@ struct NfaNode
     CharIndex ch2;
     NfaNode * out1;
     NfaNode * out2;
+    // ch1 == CHAR_CLASS only.
+    CharBitmap * pClass;
 };
 
 struct Nfa
@@ -240,7 +524,13 @@ public:
     }
 
     NfaContext()
+        : NfaContext(ownAllocator)
+    {
+    }
+    // Nfa nodes outlive the context, allocator owner frees them.
+    explicit NfaContext(Allocator & allocator)
         : pOldContext(pCurrentContext)
+        , allocator(allocator)
     {
         pCurrentContext = this;
     }
@@ -253,7 +543,8 @@ public:
 
 private:
     NfaContext * pOldContext;
-    Allocator allocator;
+    Allocator ownAllocator;
+    Allocator & allocator;
 
     static NfaContext * pCurrentContext;
 };
@@ -324,11 +615,86 @@ protected:
         arrNfa.Add(nfa);
     }
     virtual void Visit(KleeneStarOperator &) override
+    {
+        arrNfa.Last() = Star(arrNfa.Last());
+    }
+    virtual void Visit(ASCIICharacter & ch) override
+    {
+        NfaNode * in = NewNode();
+        NfaNode * out = NewNode();
+
+        in->ch1 = ch.index;
+        in->out1 = out;
+
+        Nfa nfa = { in, out };
+
+        arrNfa.Add(nfa);
+    }
+    virtual void Visit(CharClass & cc) override
     {
         NfaNode * in = NewNode();
         NfaNode * out = NewNode();
 
+        in->ch1 = CHAR_CLASS;
+        in->pClass = NFA_GC_NEW(CharBitmap);
+        *in->pClass = cc.chars;
+        in->out1 = out;
+
+        Nfa nfa = { in, out };
+
+        arrNfa.Add(nfa);
+    }
+    // in -> inner{min} -> (opt -> inner){max - min} -> out
+    //                      opt ---------------------------^
+    // or, without upper bound
+    // in -> inner{min} -> inner* -> out
+    virtual void Visit(RepeatOperator & rep) override
+    {
         Nfa inner = arrNfa.Last();
+        ASSERT(!inner.out->out1 && !inner.out->out2);
+
+        int copyCount = rep.max < 0 ? rep.min + 1 : rep.max;
+        ASSERT(copyCount > 0);
+
+        // Copy before linking, inner.out has no out edge yet.
+        std::vector<Nfa> copies = { inner };
+        for (int i = 1; i < copyCount; ++i)
+            copies.push_back(Clone(inner));
+
+        NfaNode * in = NewNode();
+        NfaNode * out = NewNode();
+
+        NfaNode * last = in;
+        for (int i = 0; i < rep.min; ++i)
+        {
+            last->out1 = copies[i].in;
+            last = copies[i].out;
+        }
+        if (rep.max < 0)
+        {
+            Nfa star = Star(copies[rep.min]);
+            last->out1 = star.in;
+            last = star.out;
+        }
+        else
+        {
+            for (int i = rep.min; i < rep.max; ++i)
+            {
+                NfaNode * opt = NewNode();
+                opt->out1 = copies[i].in;
+                opt->out2 = out;
+                last->out1 = opt;
+                last = copies[i].out;
+            }
+        }
+        last->out1 = out;
+
+        arrNfa.Last() = { in, out };
+    }
+    Nfa Star(Nfa inner)
+    {
+        NfaNode * in = NewNode();
+        NfaNode * out = NewNode();
 
         in->out1 = inner.in;
         in->out2 = out;
@@ -337,25 +703,50 @@ protected:
         inner.out->out1 = inner.in;
         inner.out->out2 = in;
 
-        arrNfa.Last() = { in, out };
+        return { in, out };
     }
-    virtual void Visit(ASCIICharacter & ch) override
+    // Every node of nfa is reachable from nfa.in.
+    Nfa Clone(Nfa nfa)
     {
-        NfaNode * in = NewNode();
-        NfaNode * out = NewNode();
+        std::map<NfaNode *, NfaNode *> copyOf = { { nullptr, nullptr } };
 
-        in->ch1 = ch.index;
-        in->out1 = out;
+        Queue<NfaNode *> q;
+        q.Enqueue(nfa.in);
+        while (!q.Empty())
+        {
+            NfaNode * pNode = q.Dequeue();
+            if (copyOf.count(pNode))
+                continue;
+
+            NfaNode * pCopy = NewNode();
+            pCopy->ch1 = pNode->ch1;
+            pCopy->ch2 = pNode->ch2;
+            if (pNode->pClass)
+            {
+                pCopy->pClass = NFA_GC_NEW(CharBitmap);
+                *pCopy->pClass = *pNode->pClass;
+            }
+            copyOf[pNode] = pCopy;
 
-        Nfa nfa = { in, out };
+            q.Enqueue(pNode->out1);
+            q.Enqueue(pNode->out2);
+        }
+        for (auto p : copyOf)
+        {
+            if (!p.first)
+                continue;
+            p.second->out1 = copyOf[p.first->out1];
+            p.second->out2 = copyOf[p.first->out2];
+        }
 
-        arrNfa.Add(nfa);
+        return { copyOf[nfa.in], copyOf[nfa.out] };
     }
     NfaNode * NewNode()
     {
         NfaNode * n = NFA_GC_NEW(NfaNode);
         n->ch1 = n->ch2 = CHAR_EPSILON;
         n->out1 = n->out2 = nullptr;
+        n->pClass = nullptr;
         return n;
     }
 
@@ -424,6 +815,11 @@ NfaNodeSet Start(Nfa nfa)
 
     return ns;
 }
+bool Consume(CharIndex nodeCh, const CharBitmap * pClass, CharIndex ch)
+{
+    return nodeCh == ch ||
+           (nodeCh == CHAR_CLASS && pClass->Test(ch));
+}
 NfaNodeSet Jump(NfaNodeSet ns, CharIndex ch)
 {
     Set<NfaNode *> output;
@@ -434,7 +830,7 @@ NfaNodeSet Jump(NfaNodeSet ns, CharIndex ch)
          ns.nodes.GetNextElem(pos, pNode);
          )
     {
-        if (pNode->ch1 == ch && pNode->out1)
+        if (Consume(pNode->ch1, pNode->pClass, ch) && pNode->out1)
             q.Enqueue(pNode->out1);
         if (pNode->ch2 == ch && pNode->out2)
             q.Enqueue(pNode->out2);
@@ -469,22 +865,23 @@ NfaNodeSet Jump(NfaNodeSet ns, CharIndex ch)
 
     return ns2;
 }
+// Contains the end-of-input node.
 bool IsAccept(NfaNodeSet ns)
 {
-    if (ns.nodes.Count() != 1)
-        return false;
-
-    NfaNode * pNode = ns.nodes.GetFirst();
-    return pNode->ch1 == CHAR_EOS && pNode->out1 != pNode;
+    NfaNode * pNode;
+    for (auto pos = ns.nodes.GetStartPos();
+         ns.nodes.GetNextElem(pos, pNode);
+         )
+    {
+        if (pNode->ch1 == CHAR_EOS && pNode->out1 != pNode)
+            return true;
+    }
+    return false;
 }
-
-} } namespace containers {
-// For Set<NfaNodeSet>, Map<NfaNodeSet, *>
-template <>
-UINT HashKey(v2::re::NfaNodeSet ns)
+UINT HashNodeSet(const NfaNodeSet & ns)
 {
     UINT64 h = 0;
-    v2::re::NfaNode * n;
+    NfaNode * n;
     for (auto pos = ns.nodes.GetStartPos();
          ns.nodes.GetNextElem(pos, n);
          )
@@ -494,6 +891,42 @@ UINT HashKey(v2::re::NfaNodeSet ns)
     }
     return static_cast<UINT>(h);
 }
+// Every node is reachable from nfa.in.
+void FreeNfa(Nfa nfa, Allocator & allocator)
+{
+    Set<NfaNode *> dup;
+    Queue<NfaNode *> q;
+
+    q.Enqueue(nfa.in);
+    while (!q.Empty())
+    {
+        NfaNode * pNode = q.Dequeue();
+        if (!pNode || dup.Contains(pNode))
+            continue;
+        dup.Insert(pNode);
+
+        q.Enqueue(pNode->out1);
+        q.Enqueue(pNode->out2);
+    }
+
+    NfaNode * pNode;
+    for (auto pos = dup.GetStartPos();
+         dup.GetNextElem(pos, pNode);
+         )
+    {
+        if (pNode->pClass)
+            allocator.Free(pNode->pClass);
+        allocator.Free(pNode);
+    }
+}
+
+} } namespace containers {
+// For Set<NfaNodeSet>, Map<NfaNodeSet, *>
+template <>
+UINT HashKey(v2::re::NfaNodeSet ns)
+{
+    return v2::re::HashNodeSet(ns);
+}
 } namespace v2 { namespace re {
 
 // Dfa structure
@@ -649,6 +1082,14 @@ public:
     {
         return propTable[state];
     }
+    int StateCount() const
+    {
+        return jumpTable.nRow;
+    }
+    int CharCount() const
+    {
+        return jumpTable.nCol;
+    }
 
     DfaJumpTable & GetJumpTable()
     {
@@ -668,6 +1109,7 @@ class DfaConverter
 {
 public:
     static Dfa Convert(Nfa nfa);
+    static Dfa Minimize(const Dfa & dfa);
 };
 
 Dfa DfaConverter::Convert(Nfa nfa)
@@ -683,6 +1125,9 @@ Dfa DfaConverter::Convert(Nfa nfa)
     while (!qNodeSet.Empty())
     {
         NfaNodeSet ns = qNodeSet.Dequeue();
+        // Enqueued more than once, e.g. by every char of a class.
+        if (mNfa2Dfa.Contains(ns))
+            continue;
 
         ++maxDfaState;
         mNfa2Dfa.Insert(ns, maxDfaState);
@@ -765,6 +1210,7 @@ Dfa DfaConverter::Convert(Nfa nfa)
             {
                 if (p.first->ch1 == CHAR_EPSILON) std::cout << "--->" << mNfaId[p.first->out1];
                 else if (p.first->ch1 == CHAR_EOS) std::cout << "-$->" << mNfaId[p.first->out1];
+                else if (p.first->ch1 == CHAR_CLASS) std::cout << "-[" << p.first->pClass->Count() << "]->" << mNfaId[p.first->out1];
                 else std::cout << "-" << (char)p.first->ch1 << "->" << mNfaId[p.first->out1];
                 std::cout << "\t";
             }
@@ -813,48 +1259,364 @@ Dfa DfaConverter::Convert(Nfa nfa)
         std::cout << "-----------------------------" << std::endl;
     }
 
-    return dfa;
+    return Minimize(dfa);
 }
 
-// Dfa match
-
-class InputReader
+// Hopcroft partition refinement.
+//
+// Initial partition is {dead}, {accept}, {others}. Dead state stays 0 and
+// start state stays 1, as Dfa::Start() expects.
+//
+// Blocks are ranges [blockBegin, blockEnd) of elems, split by moving marked
+// states to the front of their block.
+Dfa DfaConverter::Minimize(const Dfa & dfa)
 {
-public:
-    InputReader(const char * str, const char * end = nullptr)
-        : pNext(str)
-        , pEnd(end)
-    {
-        ASSERT(pNext);
-    }
-    bool More()
-    {
-        return (!pEnd && *pNext) || (pEnd && pNext < pEnd);
-    }
-    int Peek()
+    const int n = dfa.StateCount();
+    const int col = dfa.CharCount();
+
+    // (Char, State) to (States jumping in), as ranges of jumpInStates.
+    std::vector<int> jumpInBegin(col * (n + 1), 0);
+    std::vector<int> jumpInStates(col * n, 0);
+    for (int ch = 0; ch < col; ++ch)
     {
-        if (More())
-            return *pNext;
-        else
+        int * begin = &jumpInBegin[ch * (n + 1)];
+        for (int state = 0; state < n; ++state)
+            ++begin[dfa.Jump(state, ch) + 1];
+        for (int state = 0; state < n; ++state)
+            begin[state + 1] += begin[state];
+        std::vector<int> fill(n, 0);
+        for (int state = 0; state < n; ++state)
         {
-            return CHAR_EOS;
+            int to = dfa.Jump(state, ch);
+            jumpInStates[ch * n + begin[to] + fill[to]++] = state;
         }
     }
-    int Get()
+
+    std::vector<int> elems(n, 0);
+    std::vector<int> loc(n, 0);
+    std::vector<int> blockOf(n, 0);
+    std::vector<int> blockBegin;
+    std::vector<int> blockEnd;
+    std::vector<int> markCount;
     {
-        if (More())
-            return *pNext++;
+        int count = 0;
+        for (int key = 0; key < 3; ++key)
+        {
+            int begin = count;
+            for (int state = 0; state < n; ++state)
+            {
+                if (key == ((state == 0) ? 0 : (dfa.Accept(state) ? 1 : 2)))
+                {
+                    loc[state] = count;
+                    elems[count++] = state;
+                    blockOf[state] = (int)blockBegin.size();
+                }
+            }
+            if (count > begin)
+            {
+                blockBegin.push_back(begin);
+                blockEnd.push_back(count);
+                markCount.push_back(0);
+            }
+        }
+    }
+
+    std::vector<int> work;
+    std::vector<bool> inWork(blockBegin.size(), true);
+    for (int b = 0; b < (int)blockBegin.size(); ++b)
+        work.push_back(b);
+
+    std::vector<int> splitter;
+    std::vector<int> touched;
+    while (!work.empty())
+    {
+        int a = work.back();
+        work.pop_back();
+        inWork[a] = false;
+
+        splitter.clear();
+        for (int i = blockBegin[a]; i < blockEnd[a]; ++i)
+            splitter.push_back(elems[i]);
+
+        for (int ch = 0; ch < col; ++ch)
+        {
+            for (int to : splitter)
+            {
+                int * begin = &jumpInBegin[ch * (n + 1)];
+                for (int i = begin[to]; i < begin[to + 1]; ++i)
+                {
+                    // Mark: move to front of its block.
+                    int from = jumpInStates[ch * n + i];
+                    int b = blockOf[from];
+                    if (markCount[b] == 0)
+                        touched.push_back(b);
+                    int j = blockBegin[b] + markCount[b]++;
+                    int other = elems[j];
+                    elems[j] = from, elems[loc[from]] = other;
+                    loc[other] = loc[from], loc[from] = j;
+                }
+            }
+
+            for (int b : touched)
+            {
+                int marks = markCount[b];
+                markCount[b] = 0;
+                if (marks == blockEnd[b] - blockBegin[b])
+                    continue;
+
+                // Split b into (marked, rest).
+                int nb = (int)blockBegin.size();
+                blockBegin.push_back(blockBegin[b]);
+                blockEnd.push_back(blockBegin[b] + marks);
+                markCount.push_back(0);
+                inWork.push_back(false);
+                blockBegin[b] += marks;
+                for (int i = blockBegin[nb]; i < blockEnd[nb]; ++i)
+                    blockOf[elems[i]] = nb;
+
+                if (inWork[b] || marks <= blockEnd[b] - blockBegin[b])
+                    work.push_back(nb), inWork[nb] = true;
+                else
+                    work.push_back(b), inWork[b] = true;
+            }
+            touched.clear();
+        }
+    }
+
+    // Renumber, dead block first, start block second.
+    const int blockCount = (int)blockBegin.size();
+    std::vector<int> newState(blockCount, -1);
+    int nextState = 0;
+    newState[blockOf[0]] = nextState++;
+    newState[blockOf[1]] = nextState++;
+    for (int state = 0; state < n; ++state)
+    {
+        if (newState[blockOf[state]] < 0)
+            newState[blockOf[state]] = nextState++;
+    }
+
+    Dfa minDfa(blockCount, col);
+
+    DfaJumpTable & jumpTable = minDfa.GetJumpTable();
+    DfaPropTable & propTable = minDfa.GetPropTable();
+    for (int b = 0; b < blockCount; ++b)
+    {
+        int rep = elems[blockBegin[b]];
+        int state = newState[b];
+        propTable[state] = dfa.Accept(rep);
+        for (int ch = 0; ch < col; ++ch)
+            jumpTable[state][ch] = newState[blockOf[dfa.Jump(rep, ch)]];
+    }
+
+    return minDfa;
+}
+
+// Lazy dfa structure
+//
+// Dfa states are built from nfa node sets while matching, and kept in a
+// cache of at most cacheBytes. A full cache is flushed. If it fills again
+// within kMinCharsPerState chars per cached state, the cache is thrashing
+// and the caller should match by nfa simulation instead.
+
+class LazyDfa
+{
+public:
+    static const size_t kMinCharsPerState = 10;
+
+    LazyDfa(Nfa nfa, size_t cacheBytes)
+        : nfa(nfa)
+        , startSet(re::Start(nfa))
+        , cacheBytes(cacheBytes)
+        , usedBytes(0)
+        , startState(-1)
+        , charsSinceFlush(0)
+        , flushCount(0)
+        , thrashing(false)
+    {
+        Flush();
+    }
+
+    int Start()
+    {
+        if (startState < 0)
+            startState = AddState(startSet);
+        return startState;
+    }
+    int Jump(int state, int ch)
+    {
+        ++charsSinceFlush;
+        if (ch < CHAR_FIRST || ch > CHAR_LAST)
+            return 0;
+
+        int nextState = jumps[state * CHAR_COUNT + ch];
+        if (nextState >= 0)
+            return nextState;
+
+        int oldFlushCount = flushCount;
+        nextState = AddState(re::Jump(states[state].ns, ch));
+        // Flushed, state is gone.
+        if (flushCount == oldFlushCount)
+            jumps[state * CHAR_COUNT + ch] = nextState;
+        return nextState;
+    }
+    bool Accept(int state) const
+    {
+        return states[state].accept;
+    }
+
+    bool Thrashing() const
+    {
+        return thrashing;
+    }
+    int FlushCount() const
+    {
+        return flushCount;
+    }
+    int StateCount() const
+    {
+        return static_cast<int>(states.size());
+    }
+    Nfa GetNfa() const
+    {
+        return nfa;
+    }
+
+private:
+    struct State
+    {
+        NfaNodeSet ns;
+        bool accept;
+    };
+    struct NodeSetHash
+    {
+        size_t operator () (const NfaNodeSet & ns) const
+        {
+            return HashNodeSet(ns);
+        }
+    };
+
+    // Jump row, node set in State and in stateOf.
+    static size_t StateBytes(const NfaNodeSet & ns)
+    {
+        return CHAR_COUNT * sizeof(int) +
+               sizeof(State) +
+               2 * ns.nodes.Count() * 2 * sizeof(void *);
+    }
+
+    int AddState(const NfaNodeSet & ns)
+    {
+        if (ns.IsEmpty())
+            return 0;
+
+        auto kv = stateOf.find(ns);
+        if (kv != stateOf.end())
+            return kv->second;
+
+        size_t bytes = StateBytes(ns);
+        if (usedBytes + bytes > cacheBytes && states.size() > 1)
+        {
+            if (charsSinceFlush < kMinCharsPerState * states.size())
+                thrashing = true;
+            Flush();
+            ++flushCount;
+        }
+
+        int state = static_cast<int>(states.size());
+        states.push_back({ ns, IsAccept(ns) });
+        jumps.resize(jumps.size() + CHAR_COUNT, -1);
+        stateOf.emplace(ns, state);
+        usedBytes += bytes;
+        return state;
+    }
+
+    // Keep only the dead state 0.
+    void Flush()
+    {
+        states.clear();
+        jumps.clear();
+        stateOf.clear();
+
+        states.push_back({ NfaNodeSet(), false });
+        jumps.resize(CHAR_COUNT, 0);
+        usedBytes = StateBytes(NfaNodeSet());
+        startState = -1;
+        charsSinceFlush = 0;
+    }
+
+    Nfa nfa;
+    NfaNodeSet startSet;
+
+    size_t cacheBytes;
+    size_t usedBytes;
+    std::vector<State> states;
+    // (State, Char) to (State), -1 if not built yet
+    std::vector<int> jumps;
+    std::unordered_map<NfaNodeSet, int, NodeSetHash> stateOf;
+    int startState;
+
+    size_t charsSinceFlush;
+    int flushCount;
+    bool thrashing;
+};
+
+// Dfa match
+
+class InputReader
+{
+public:
+    InputReader(const char * str, const char * end = nullptr)
+        : pNext(str)
+        , pEnd(end)
+    {
+        ASSERT(pNext);
+    }
+    bool More()
+    {
+        return (!pEnd && *pNext) || (pEnd && pNext < pEnd);
+    }
+    int Peek()
+    {
+        if (More())
+            return *pNext;
+        else
+        {
+            return CHAR_EOS;
+        }
+    }
+    int Get()
+    {
+        if (More())
+            return *pNext++;
         else
         {
             return CHAR_EOS;
         }
     }
+    // Skip chars not in first, firstChar >= 0 if it's the only one.
+    size_t SkipUntil(const CharBitmap & first, int firstChar)
+    {
+        ASSERT(pEnd);
+        const char * pBegin = pNext;
+        if (firstChar >= 0)
+        {
+            const void * found = memchr(pNext, firstChar, pEnd - pNext);
+            pNext = found ? static_cast<const char *>(found) : pEnd;
+        }
+        else
+        {
+            while (pNext < pEnd && !first.Test(static_cast<unsigned char>(*pNext)))
+                ++pNext;
+        }
+        return pNext - pBegin;
+    }
 private:
     const char * pNext;
     const char * pEnd;
 };
 
-MatchResult DfaMatch(const Dfa & dfa,
+// Dfa or LazyDfa.
+template <typename TDfa>
+MatchResult DfaMatch(TDfa & dfa,
                      InputReader & input)
 {
     int maxScanLen = 0;
@@ -885,6 +1647,46 @@ MatchResult DfaMatch(const Dfa & dfa,
     return MatchResult(content, maxScanLen, maxAcptLen);
 }
 
+MatchResult NfaMatch(Nfa nfa,
+                     InputReader & input)
+{
+    int maxScanLen = 0;
+    int maxAcptLen = -1;
+    String content;
+
+    NfaNodeSet ns = Start(nfa);
+    for (;;)
+    {
+        if (IsAccept(ns))
+            maxAcptLen = maxScanLen;
+
+        if (!input.More())
+            break;
+
+        ns = Jump(ns, input.Peek());
+        if (ns.IsEmpty())
+            break;
+
+        content.Add(input.Get());
+        ++maxScanLen;
+    }
+    if (maxAcptLen >= 0)
+        content.ShrinkTo(maxAcptLen);
+    else
+        content.Clear();
+
+    return MatchResult(content, maxScanLen, maxAcptLen);
+}
+
+MatchResult LazyDfaMatch(LazyDfa & dfa,
+                         InputReader & input)
+{
+    if (dfa.Thrashing())
+        return NfaMatch(dfa.GetNfa(), input);
+    else
+        return DfaMatch(dfa, input);
+}
+
 // Client interface
 
 MatchResult::MatchResult(String content,
@@ -919,7 +1721,41 @@ int MatchResult::MaxAcceptLen() const
 class Regex::Impl
 {
 public:
+    ~Impl()
+    {
+        if (lazyDfa)
+            FreeNfa(lazyDfa->GetNfa(), nfaAllocator);
+    }
+
+    // Chars leaving the start state, a match can only start at one.
+    template <typename F>
+    void FindPrefilter(F isLiveJump, bool startAccepts)
+    {
+        for (int ch = 0; ch < 256; ++ch)
+        {
+            if (isLiveJump(ch))
+                first.Set(ch);
+        }
+        int count = first.Count();
+        // Empty match at any position, or most chars start one.
+        prefilter = !startAccepts && count <= 128;
+        firstChar = -1;
+        for (int ch = 0; count == 1 && ch < 256; ++ch)
+        {
+            if (first.Test(ch))
+                firstChar = ch;
+        }
+    }
+
+    // Lazy mode only.
+    Allocator nfaAllocator;
+    std::unique_ptr<LazyDfa> lazyDfa;
+
     Dfa dfa;
+
+    CharBitmap first;
+    bool prefilter;
+    int firstChar;
 };
 
 Regex::Regex(RegexStruct rs)
@@ -928,22 +1764,47 @@ Regex::Regex(RegexStruct rs)
 
     Nfa nfa = NfaConverter::Convert(rs);
     Dfa dfa = DfaConverter::Convert(nfa);
+    FreeNfa(nfa, nfaCtx.GetAllocator());
 
     Regex::Impl * impl = new Regex::Impl();
     impl->dfa = std::move(dfa);
 
+    const Dfa & d = impl->dfa;
+    impl->FindPrefilter([&d](int ch) { return d.Jump(d.Start(), ch) != 0; },
+                        d.Accept(d.Start()));
+
+    pImpl.reset(impl);
+}
+
+Regex::Regex(RegexStruct rs, size_t cacheBytes)
+{
+    Regex::Impl * impl = new Regex::Impl();
+
+    NfaContext nfaCtx(impl->nfaAllocator);
+
+    Nfa nfa = NfaConverter::Convert(rs);
+    impl->lazyDfa.reset(new LazyDfa(nfa, cacheBytes));
+
+    NfaNodeSet start = Start(nfa);
+    impl->FindPrefilter([&start](int ch) { return !Jump(start, ch).IsEmpty(); },
+                        IsAccept(start));
+
     pImpl.reset(impl);
 }
 
 class MatchResultIterator::Impl
 {
 public:
-    Impl(const Dfa & dfa, InputReader inputReader)
-        : dfa(dfa)
+    Impl(const Regex::Impl & regex, InputReader inputReader)
+        : dfa(regex.dfa)
+        , pLazyDfa(regex.lazyDfa.get())
+        , regex(regex)
         , inputReader(inputReader)
     {}
 
     const Dfa & dfa;
+    LazyDfa * pLazyDfa;
+    const Regex::Impl & regex;
     InputReader inputReader;
 };
 
@@ -986,7 +1847,10 @@ bool MatchResultIterator::More()
 
 MatchResult MatchResultIterator::Next()
 {
-    return DfaMatch(pImpl->dfa, pImpl->inputReader);
+    if (pImpl->pLazyDfa)
+        return LazyDfaMatch(*pImpl->pLazyDfa, pImpl->inputReader);
+    else
+        return DfaMatch(pImpl->dfa, pImpl->inputReader);
 }
 
 int MatchResultIterator::IgnoreCharacter()
@@ -997,12 +1861,20 @@ int MatchResultIterator::IgnoreCharacter()
         return CHAR_EOS;
 }
 
+size_t MatchResultIterator::SkipToCandidate()
+{
+    const Regex::Impl & regex = pImpl->regex;
+    if (!regex.prefilter)
+        return 0;
+    return pImpl->inputReader.SkipUntil(regex.first, regex.firstChar);
+}
+
 MatchResultIterator IterateMatches(const Regex & regex,
                                    StringView input)
 {
     MatchResultIterator::Impl * impl =
         new MatchResultIterator::Impl(
-            PImplAccessor::Get(regex)->dfa,
+            *PImplAccessor::Get(regex),
             InputReader(input.Begin(), input.End())
         );
 
@@ -1011,6 +1883,226 @@ MatchResultIterator IterateMatches(const Regex & regex,
     return mri;
 }
 
+// Stream positions are offsets from the first byte fed. Bytes before the
+// current chunk come from carry, which starts at the oldest byte still needed
+// (the start of the unfinished match).
+class StreamMatcher::Impl
+{
+public:
+    Impl(const Dfa & dfa, LazyDfa * pLazyDfa)
+        : dfa(dfa)
+        , pLazyDfa(pLazyDfa)
+        , carryBase(0)
+        , chunk(nullptr)
+        , chunkBase(0)
+        , chunkLen(0)
+        , finished(false)
+        , matchBegin(0)
+        , scanning(false)
+        , decided(false)
+        , scanPos(0)
+        , acceptEnd(kNoAccept)
+        , state(0)
+        , useNfa(false)
+        , flushCount(0)
+    {}
+
+    static const size_t kNoAccept = static_cast<size_t>(-1);
+
+    size_t DataEnd() const
+    {
+        return chunkBase + chunkLen;
+    }
+    int CharAt(size_t pos) const
+    {
+        return pos < chunkBase
+            ? static_cast<unsigned char>(carry[pos - carryBase])
+            : static_cast<unsigned char>(chunk[pos - chunkBase]);
+    }
+
+    void Feed(const char * data, size_t length)
+    {
+        ASSERT(!finished && chunkLen == 0);
+        chunk = data;
+        chunkLen = length;
+    }
+    // Out of data: keep [matchBegin, DataEnd()) in carry, drop the chunk.
+    void Retire()
+    {
+        std::string kept;
+        if (matchBegin < chunkBase)
+            kept.assign(carry, matchBegin - carryBase, std::string::npos);
+        size_t chunkKeep = Max(matchBegin, chunkBase) - chunkBase;
+        kept.append(chunk + chunkKeep, chunkLen - chunkKeep);
+        carry.swap(kept);
+        carryBase = matchBegin;
+
+        chunkBase = DataEnd();
+        chunk = nullptr;
+        chunkLen = 0;
+    }
+
+    void BeginScan()
+    {
+        useNfa = pLazyDfa && pLazyDfa->Thrashing();
+        if (useNfa)
+            ns = Start(pLazyDfa->GetNfa());
+        else
+            state = pLazyDfa ? pLazyDfa->Start() : dfa.Start();
+
+        scanning = true;
+        scanPos = matchBegin;
+        acceptEnd = Accepting() ? matchBegin : kNoAccept;
+    }
+    bool Accepting()
+    {
+        if (useNfa)
+            return IsAccept(ns);
+        else
+            return pLazyDfa ? pLazyDfa->Accept(state) : dfa.Accept(state);
+    }
+    bool Jump(int ch)
+    {
+        if (useNfa)
+        {
+            ns = re::Jump(ns, ch);
+            return !ns.IsEmpty();
+        }
+        state = pLazyDfa ? pLazyDfa->Jump(state, ch) : dfa.Jump(state, ch);
+        return state != 0;
+    }
+
+    // Scan until the match is decided, or data runs out.
+    bool Decide()
+    {
+        if (decided)
+            return true;
+        if (matchBegin == DataEnd())
+        {
+            Retire();
+            return false;
+        }
+
+        // Another user of the lazy dfa flushed it, saved state is gone.
+        if (scanning && !useNfa && pLazyDfa && pLazyDfa->FlushCount() != flushCount)
+            scanning = false;
+        if (!scanning)
+            BeginScan();
+
+        for (; scanPos < DataEnd(); ++scanPos)
+        {
+            if (!Jump(CharAt(scanPos)))
+                break;
+            if (Accepting())
+                acceptEnd = scanPos + 1;
+        }
+        if (scanPos == DataEnd() && !finished)
+        {
+            if (pLazyDfa)
+                flushCount = pLazyDfa->FlushCount();
+            Retire();
+            return false;
+        }
+
+        scanning = false;
+        decided = true;
+        return true;
+    }
+
+    const Dfa & dfa;
+    LazyDfa * pLazyDfa;
+
+    std::string carry;
+    size_t carryBase;
+    const char * chunk;
+    size_t chunkBase;
+    size_t chunkLen;
+    bool finished;
+
+    // Current match
+    size_t matchBegin;
+    bool scanning;
+    bool decided;
+    size_t scanPos;
+    size_t acceptEnd;
+
+    // Dfa state, or nfa state if the lazy dfa thrashes.
+    int state;
+    NfaNodeSet ns;
+    bool useNfa;
+    int flushCount;
+
+    // Match across the chunk edge.
+    std::string joined;
+};
+
+StreamMatcher::StreamMatcher(const Regex & regex)
+    : pImpl(new StreamMatcher::Impl(PImplAccessor::Get(regex)->dfa,
+                                    PImplAccessor::Get(regex)->lazyDfa.get()))
+{
+}
+
+StreamMatcher::~StreamMatcher()
+{
+}
+
+void StreamMatcher::Feed(StringView chunk)
+{
+    pImpl->Feed(chunk.Begin(), chunk.Length());
+}
+
+void StreamMatcher::Finish()
+{
+    pImpl->finished = true;
+}
+
+bool StreamMatcher::More()
+{
+    return pImpl->Decide();
+}
+
+StreamMatchResult StreamMatcher::Next()
+{
+    Impl & impl = *pImpl;
+
+    StreamMatchResult result = { impl.matchBegin, 0, nullptr, false };
+    if (!impl.Decide() || impl.acceptEnd == Impl::kNoAccept)
+        return result;
+
+    result.valid = true;
+    result.length = impl.acceptEnd - impl.matchBegin;
+    if (impl.matchBegin >= impl.chunkBase)
+    {
+        result.content = impl.chunk + (impl.matchBegin - impl.chunkBase);
+    }
+    else if (impl.acceptEnd <= impl.chunkBase)
+    {
+        result.content = impl.carry.data() + (impl.matchBegin - impl.carryBase);
+    }
+    else
+    {
+        impl.joined.assign(impl.carry, impl.matchBegin - impl.carryBase, std::string::npos);
+        impl.joined.append(impl.chunk, impl.acceptEnd - impl.chunkBase);
+        result.content = impl.joined.data();
+    }
+
+    impl.matchBegin = impl.acceptEnd;
+    impl.decided = false;
+    return result;
+}
+
+int StreamMatcher::IgnoreCharacter()
+{
+    Impl & impl = *pImpl;
+
+    impl.scanning = false;
+    impl.decided = false;
+    if (impl.matchBegin == impl.DataEnd())
+        return CHAR_EOS;
+    else
+        return impl.CharAt(impl.matchBegin++);
+}
+
 }
 }
 
@@ -1063,6 +2155,37 @@ protected:
     {
         arrStr.Add(String((char)ch.index, 1));
     }
+    virtual void Visit(CharClass & cc) override
+    {
+        String s;
+        s.Add('[');
+        for (int ch = 0; ch < 256; ++ch)
+        {
+            if (!cc.chars.Test(ch))
+                continue;
+            int last = ch;
+            while (last + 1 < 256 && cc.chars.Test(last + 1))
+                ++last;
+            s.Add((char)ch);
+            if (last > ch)
+                s.Add('-').Add((char)last);
+            ch = last;
+        }
+        s.Add(']');
+        arrStr.Add(s);
+    }
+    virtual void Visit(RepeatOperator & rep) override
+    {
+        ASSERT(arrStr.Count() >= 1);
+        std::string bound = "{" + std::to_string(rep.min) + "," +
+            (rep.max < 0 ? "" : std::to_string(rep.max)) + "}";
+        String s;
+        s.Add('(').Append(arrStr[arrStr.Count() - 1]).Add(')');
+        for (char ch : bound)
+            s.Add(ch);
+        arrStr.RemoveAt(arrStr.Count() - 1, 1);
+        arrStr.Add(s);
+    }
 
 private:
     containers::Array<String> arrStr;
@@ -1088,6 +2211,35 @@ TEST(Regex2_Builder)
         String("(((ab)(c)*)|d)"));
 }
 
+TEST(Regex2_FromString)
+{
+    auto Format = [] (const char * regex) -> String
+    {
+        RegexStruct rs = RegexStructFactory::CreateFromString(regex);
+        return REToStringConverter::Convert(rs);
+    };
+    EXPECT_EQ(Format("abc*|d"), String("(((ab)(c)*)|d)"));
+    EXPECT_EQ(Format("[_a-zA-Z][_a-z0-9]*"), String("([A-Z_a-z]([0-9_a-z])*)"));
+    EXPECT_EQ(Format("x{3,8}(y|\\+)+z?[a]{2,}"), String("((((x){3,8}((y|+)){1,})(z){0,1})(a){2,})"));
+
+    auto Fails = [] (const char * regex) -> bool
+    {
+        try
+        {
+            RegexStructFactory::CreateFromString(regex);
+        }
+        catch (const std::invalid_argument &)
+        {
+            return true;
+        }
+        return false;
+    };
+    EXPECT_TRUE(Fails("(ab"));
+    EXPECT_TRUE(Fails("a{3,2}"));
+    EXPECT_TRUE(Fails("[]"));
+    EXPECT_TRUE(Fails("a|*"));
+}
+
 TEST(Regex2_Nfa)
 {
     // re::Start, re::Jump
@@ -1139,6 +2291,240 @@ TEST(Regex2_Dfa)
     EXPECT_EQ(mr.MaxAcceptLen(), 2);
 }
 
+TEST(Regex2_Minimize)
+{
+    NfaContext nfaCtx;
+
+    // ab|cb
+    RegexStruct rs =
+        RegexStructFactory::CreateBuilder()
+        .Ascii('a')
+        .Ascii('b')
+        .Concat()
+        .Ascii('c')
+        .Ascii('b')
+        .Concat()
+        .Alter()
+        .Build();
+
+    Nfa nfa = NfaConverter::Convert(rs);
+    Dfa dfa = DfaConverter::Convert(nfa);
+
+    // dead, start, b, end, end-more
+    EXPECT_EQ(dfa.StateCount(), 5);
+
+    InputReader ir("cb");
+    MatchResult mr = DfaMatch(dfa, ir);
+    EXPECT_EQ(mr.MaxAcceptLen(), 2);
+}
+
+static int CountNfaNodes(Nfa nfa)
+{
+    Set<NfaNode *> dup;
+    Queue<NfaNode *> q;
+    q.Enqueue(nfa.in);
+    while (!q.Empty())
+    {
+        NfaNode * pNode = q.Dequeue();
+        if (!pNode || dup.Contains(pNode))
+            continue;
+        dup.Insert(pNode);
+        q.Enqueue(pNode->out1);
+        q.Enqueue(pNode->out2);
+    }
+    return dup.Count();
+}
+
+static int MatchLength(const char * regex, const char * input)
+{
+    Regex re(RegexStructFactory::CreateFromString(regex));
+    MatchResultIterator mri = IterateMatches(re, input);
+    return mri.Next().MaxAcceptLen();
+}
+
+TEST(Regex2_CharClassRepeat)
+{
+    {
+        NfaContext nfaCtx;
+
+        // 2 class nodes, not 53 + 63 char nodes and their alternations.
+        RegexStruct rs = RegexStructFactory::CreateFromString("[_a-zA-Z][_a-zA-Z0-9]*");
+        Nfa nfa = NfaConverter::Convert(rs);
+        EXPECT_EQ(CountNfaNodes(nfa), 8);
+        FreeNfa(nfa, nfaCtx.GetAllocator());
+    }
+
+    EXPECT_EQ(MatchLength("[_a-zA-Z][_a-zA-Z0-9]*", "_if0 x"), 4);
+    EXPECT_EQ(MatchLength("[_a-zA-Z][_a-zA-Z0-9]*", "0x"), -1);
+    EXPECT_EQ(MatchLength("[^\"]*\"", "abc\"d"), 4);
+    EXPECT_EQ(MatchLength("x{3,5}", "xx"), -1);
+    EXPECT_EQ(MatchLength("x{3,5}", "xxxx"), 4);
+    EXPECT_EQ(MatchLength("x{3,5}", "xxxxxxx"), 5);
+    EXPECT_EQ(MatchLength("x{2}y", "xxy"), 3);
+    EXPECT_EQ(MatchLength("(ab){2,}", "abababa"), 6);
+    EXPECT_EQ(MatchLength("[0-9]+(\\.[0-9]*)?", "12.5e"), 4);
+    EXPECT_EQ(MatchLength(".", "\n"), 1);
+}
+
+static RegexStruct BuildLazyTestRegex()
+{
+    // (ab|cd)*e
+    return RegexStructFactory::CreateBuilder()
+        .Ascii('a').Ascii('b').Concat()
+        .Ascii('c').Ascii('d').Concat()
+        .Alter()
+        .KleeneStar()
+        .Ascii('e')
+        .Concat()
+        .Build();
+}
+
+static std::string MatchesToString(const Regex & regex, StringView input)
+{
+    std::string s;
+    MatchResultIterator mri = IterateMatches(regex, input);
+    while (mri.More())
+    {
+        MatchResult mr = mri.Next();
+        if (mr.IsValid())
+            s.append(mr.Content().Begin(), mr.Content().End()).push_back(',');
+        else
+            s.push_back('-'), mri.IgnoreCharacter();
+    }
+    return s;
+}
+
+TEST(Regex2_LazyDfa)
+{
+    const char * input = "ababe cde abcdcdexe ee abab";
+
+    Regex full(BuildLazyTestRegex());
+    Regex lazy(BuildLazyTestRegex(), 1 << 20);
+    Regex tiny(BuildLazyTestRegex(), 0);
+
+    std::string expect = MatchesToString(full, input);
+    EXPECT_EQ(MatchesToString(lazy, input), expect);
+    EXPECT_EQ(MatchesToString(tiny, input), expect);
+
+    LazyDfa & lazyDfa = *PImplAccessor::Get(lazy)->lazyDfa;
+    EXPECT_FALSE(lazyDfa.Thrashing());
+    EXPECT_EQ(lazyDfa.FlushCount(), 0);
+
+    LazyDfa & tinyDfa = *PImplAccessor::Get(tiny)->lazyDfa;
+    EXPECT_TRUE(tinyDfa.Thrashing());
+}
+
+static std::string StreamMatchesToString(const Regex & regex, StringView input, size_t chunkSize)
+{
+    std::string s;
+    size_t offset = 0;
+    StreamMatcher sm(regex);
+    auto drain = [&]() {
+        while (sm.More())
+        {
+            StreamMatchResult mr = sm.Next();
+            EXPECT_EQ(mr.offset, offset);
+            if (mr.valid)
+                s.append(mr.content, mr.length).push_back(','), offset += mr.length;
+            else
+                s.push_back('-'), sm.IgnoreCharacter(), ++offset;
+        }
+    };
+    for (size_t i = 0; i < input.Length(); i += chunkSize)
+    {
+        // Chunk buffer dies after use, matches must not point into old chunks.
+        std::string chunk(input.Begin() + i, Min(chunkSize, input.Length() - i));
+        sm.Feed(chunk);
+        drain();
+        chunk.assign(chunk.length(), '#');
+    }
+    sm.Finish();
+    drain();
+    return s;
+}
+
+TEST(Regex2_StreamMatcher)
+{
+    const char * input = "ababe cde abcdcdexe ee ababcdcdcdcdcdcde abab";
+
+    Regex full(BuildLazyTestRegex());
+    Regex lazy(BuildLazyTestRegex(), 1 << 20);
+    Regex tiny(BuildLazyTestRegex(), 0);
+
+    // Unlike MatchResultIterator, a failed scan gives back its chars.
+    std::string expect = "ababe,-cde,-abcdcde,-e,-e,e,-ababcdcdcdcdcdcde,-----";
+    for (size_t chunkSize : { 1, 2, 3, 5, 7, 64 })
+    {
+        EXPECT_EQ(StreamMatchesToString(full, input, chunkSize), expect);
+        EXPECT_EQ(StreamMatchesToString(lazy, input, chunkSize), expect);
+        EXPECT_EQ(StreamMatchesToString(tiny, input, chunkSize), expect);
+    }
+
+    // Backtrack into earlier chunks after "(ab)+" fails to end with 'c'.
+    Regex ab(RegexStructFactory::CreateFromString("(ab)+c|a|b"));
+    EXPECT_EQ(StreamMatchesToString(ab, "ababababx", 3), "a,b,a,b,a,b,a,b,-");
+    EXPECT_EQ(StreamMatchesToString(ab, "ababababcx", 3), "ababababc,-");
+
+    // Only an unfinished match is carried over.
+    StreamMatcher sm(full);
+    sm.Feed("ab ababab");
+    while (sm.More())
+        sm.Next().valid || sm.IgnoreCharacter();
+    sm.Feed("abab");
+    EXPECT_FALSE(sm.More());
+    EXPECT_EQ(PImplAccessor::Get(sm)->carry, "ababababab");
+    sm.Feed("e");
+    EXPECT_FALSE(sm.More());
+    sm.Finish();
+    EXPECT_TRUE(sm.More());
+    StreamMatchResult mr = sm.Next();
+    EXPECT_TRUE(mr.valid);
+    EXPECT_EQ(mr.offset, 3u);
+    EXPECT_EQ(std::string(mr.content, mr.length), "abababababe");
+}
+
+static std::string SearchToString(const Regex & regex, StringView input, bool prefilter)
+{
+    std::string s;
+    MatchResultIterator mri = IterateMatches(regex, input);
+    while ((!prefilter || (mri.SkipToCandidate(), true)) && mri.More())
+    {
+        MatchResult mr = mri.Next();
+        if (mr.IsValid())
+            s.append(mr.Content().Begin(), mr.Content().End()).push_back(',');
+        else
+            mri.IgnoreCharacter();
+    }
+    return s;
+}
+
+TEST(Regex2_Prefilter)
+{
+    std::string input;
+    for (int i = 0; i < 100; ++i)
+        input += "int x = 1;\n#include <a.h>\n# define X\nworld wide web\n";
+
+    for (const char * pattern : { "#[a-z]+", "w[a-z]*|x", "[a-z]*;" })
+    {
+        Regex full(RegexStructFactory::CreateFromString(pattern));
+        Regex lazy(RegexStructFactory::CreateFromString(pattern), 1 << 20);
+        std::string expect = SearchToString(full, input, false);
+        EXPECT_EQ(SearchToString(full, input, true), expect);
+        EXPECT_EQ(SearchToString(lazy, input, true), expect);
+    }
+
+    // Only '#' starts a match, memchr() finds it.
+    Regex directive(RegexStructFactory::CreateFromString("#[a-z]+"));
+    EXPECT_EQ(PImplAccessor::Get(directive)->firstChar, '#');
+    MatchResultIterator mri = IterateMatches(directive, "int x;\n#if");
+    EXPECT_EQ(mri.SkipToCandidate(), 7u);
+    EXPECT_EQ(mri.Next().MaxAcceptLen(), 3);
+
+    // Empty match anywhere, no filter.
+    Regex empty(RegexStructFactory::CreateFromString("a*"));
+    EXPECT_FALSE(PImplAccessor::Get(empty)->prefilter);
+}
+
 TEST(Regex2_API)
 {
     // Build Regex
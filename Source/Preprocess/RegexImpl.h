@@ -12,6 +12,25 @@ namespace v2 {
 
 namespace re {
 
+// Char set
+
+// 256-bit bitmap, one bit per char.
+class CharBitmap
+{
+public:
+    CharBitmap();
+
+    void Set(int ch);
+    void SetRange(int first, int last);
+    void Negate();
+
+    bool Test(int ch) const;
+    int  Count() const;
+
+private:
+    UINT64 bits[4];
+};
+
 // Regex structure
 
 class RegexStruct
@@ -50,9 +69,12 @@ public:
     {
     public:
         PostfixBuilder & Ascii(int ch);
+        PostfixBuilder & Class(const CharBitmap & chars);
         PostfixBuilder & Concat();
         PostfixBuilder & Alter();
         PostfixBuilder & KleeneStar();
+        // max < 0: no upper bound.
+        PostfixBuilder & Repeat(int min, int max);
         RegexStruct Build();
     private:
         containers::Array<RegexStruct::Node *> stack;
@@ -60,13 +82,23 @@ public:
     static PostfixBuilder CreateBuilder();
     
     // Build from string
+    //
+    // a|b ab a* a+ a? a{m} a{m,} a{m,n} (a) [a-z_] [^a] . \a
     static RegexStruct CreateFromString(StringView svRegex);
 
 private:
     static RegexStruct::Node * NewAsciiNode(int ch);
+    static RegexStruct::Node * NewClassNode(const CharBitmap & chars);
     static RegexStruct::Node * NewConcatNode(RegexStruct::Node * pLeft, RegexStruct::Node * pRight);
     static RegexStruct::Node * NewAlterNode(RegexStruct::Node * pLeft, RegexStruct::Node * pRight);
     static RegexStruct::Node * NewKleeneStarNode(RegexStruct::Node * pNode);
+    static RegexStruct::Node * NewRepeatNode(RegexStruct::Node * pNode, int min, int max);
+
+    static RegexStruct::Node * ParseAlter(const char * & c, const char * end);
+    static RegexStruct::Node * ParseConcat(const char * & c, const char * end);
+    static RegexStruct::Node * ParseRepeat(const char * & c, const char * end);
+    static RegexStruct::Node * ParseAtom(const char * & c, const char * end);
+    static RegexStruct::Node * ParseClass(const char * & c, const char * end);
 };
 
 // Regex handle
@@ -77,7 +109,11 @@ public:
     class Impl;
 
 public:
+    // Build the full dfa up front.
     Regex(RegexStruct rs);
+    // Build dfa states while matching, cache at most cacheBytes of them.
+    // Falls back to nfa simulation if the cache thrashes.
+    Regex(RegexStruct rs, size_t cacheBytes);
 
 private:
     std::unique_ptr<Impl> pImpl;
@@ -112,6 +148,10 @@ public:
     // Error handling.
     int IgnoreCharacter();
 
+    // Search: skip chars no match starts with, memchr() for a single one.
+    // Returns the count skipped.
+    size_t SkipToCandidate();
+
     class Impl;
 private:
     std::unique_ptr<Impl> pImpl;
@@ -121,6 +161,55 @@ private:
 
 MatchResultIterator IterateMatches(const Regex & regex, StringView input);
 
+// Streaming match
+
+// A match as stream offsets. Content points into the chunk passed to Feed()
+// if the match lies in it, else into a buffer owned by the matcher; valid
+// until the next Feed() or Next().
+struct StreamMatchResult
+{
+    size_t offset;
+    size_t length;
+    const char * content;
+    bool valid;
+};
+
+// Input fed in chunks of any size; dfa state is kept across chunk edges,
+// and only the bytes of an unfinished match are kept between chunks.
+//
+//   StreamMatcher sm(regex);
+//   while (read chunk)
+//   {
+//       sm.Feed(chunk);
+//       while (sm.More()) ... sm.Next() / sm.IgnoreCharacter() ...
+//   }
+//   sm.Finish();
+//   while (sm.More()) ...
+class StreamMatcher
+{
+public:
+    StreamMatcher(const Regex & regex);
+    ~StreamMatcher();
+
+    // Chunk must stay valid until the next Feed() or Finish().
+    void Feed(StringView chunk);
+    // End of input.
+    void Finish();
+
+    // A match is decided, false if more input is needed (or at end).
+    bool More();
+    StreamMatchResult Next();
+
+    // Error handling.
+    int IgnoreCharacter();
+
+    class Impl;
+private:
+    std::unique_ptr<Impl> pImpl;
+
+    friend class PImplAccessor;
+};
+
 }
 
 }
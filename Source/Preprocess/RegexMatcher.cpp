@@ -1,15 +1,25 @@
 #include "RegexMatcher.h"
 
 #include <cassert>
-#include <bitset>
 #include <unordered_map>
+#include <map>
 #include <array>
 #include <deque>
 #include <memory>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <numeric>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define DFA_ACCEL_SSE2
+#endif
 
 class CharSet
 {
@@ -66,7 +76,88 @@ struct NfaState
     NfaState * alt;
 };
 
-typedef std::bitset<4096> NfaStateSet;
+// Dense bitset over NfaState::id, sized to the number of nfa states.
+class NfaStateSet
+{
+public:
+    NfaStateSet() {}
+    explicit NfaStateSet(size_t n) : words((n + 63) / 64, 0) {}
+
+    size_t size() const
+    {
+        return words.size() * 64;
+    }
+    bool test(size_t i) const
+    {
+        return (words[i / 64] >> (i % 64)) & 1;
+    }
+    bool operator [] (size_t i) const
+    {
+        return test(i);
+    }
+    void set(size_t i)
+    {
+        words[i / 64] |= 1ull << (i % 64);
+    }
+    bool none() const
+    {
+        for (UINT64 w : words)
+        {
+            if (w)
+                return false;
+        }
+        return true;
+    }
+    NfaStateSet & operator |= (const NfaStateSet & other)
+    {
+        assert(words.size() == other.words.size());
+        for (size_t i = 0; i < words.size(); ++i)
+            words[i] |= other.words[i];
+        return *this;
+    }
+    bool operator == (const NfaStateSet & other) const
+    {
+        return words == other.words;
+    }
+
+    // Call f(id) for each id in (this & mask), skipping empty words.
+    template <typename F>
+    void ForEach(const NfaStateSet & mask, F f) const
+    {
+        assert(words.size() == mask.words.size());
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            UINT64 w = words[i] & mask.words[i];
+            for (size_t id = i * 64; w; ++id, w >>= 1)
+            {
+                if (w & 1)
+                    f(id);
+            }
+        }
+    }
+
+    size_t Hash() const
+    {
+        UINT64 h = 14695981039346656037ull;
+        for (UINT64 w : words)
+            h = (h ^ w) * 1099511628211ull;
+        return static_cast<size_t>(h);
+    }
+
+private:
+    std::vector<UINT64> words;
+};
+
+namespace std {
+template <>
+struct hash<NfaStateSet>
+{
+    size_t operator () (const NfaStateSet & nss) const
+    {
+        return nss.Hash();
+    }
+};
+}
 
 struct Nfa
 {
@@ -120,12 +211,25 @@ struct DfaMatchResult
 
 typedef std::array<size_t, CharSet::N> DfaTableRow;
 
+// Chars a match can start with, and the literal all matches start with.
+struct DfaPrefilter
+{
+    bool enabled;                       // false: try every position
+    std::array<bool, CharSet::N> first;
+    DfaAccel skip;                      // stays on chars not in first[]
+    std::string prefix;
+};
+
 struct Dfa
 {
     // (Table-State, Char) to (Table-State)
     std::vector<DfaTableRow> table;
     // (Table-State) to (Match-Status)
     std::vector<DfaAction> action;
+    // (Table-State) to (Self-loop to skip), filled by FindAccelStates()
+    std::vector<DfaAccel> accel;
+    // Where a match can start, filled by FindPrefilter()
+    DfaPrefilter prefilter;
 };
 
 // Dfa build
@@ -140,8 +244,15 @@ struct DfaCompileContext
 {
     const std::vector<Nfa> & nfas;
     const NfaStateFactory & nfaStates;
-    std::unordered_map<const NfaState *, NfaStateSet> c1;
-    std::unordered_map<NfaStateSet, NfaStateSet> c2;
+    // (Nfa-State) to (Epsilon closure), for jump targets and nfa entries
+    std::vector<NfaStateSet> closure;
+    // (Char) to (Nfa-States consuming the char)
+    std::vector<NfaStateSet> consume;
+    // (Char) to (Byte class), chars of a class are consumed by the same
+    // nfa states so they jump alike
+    std::array<size_t, CharSet::N> byteClass;
+    // (Byte class) to (First char of the class)
+    std::vector<char> classChar;
 };
 
 class NfaStateSetToDfaState
@@ -233,7 +344,6 @@ void PrintNfaStateSet(NfaStateSet c)
     }
     std::cout << " }" << std::endl;;
 }
-NfaStateSet EpsilonClosure(NfaState * ns, DfaCompileContext & context);
 void PrintDfaCompileContext(DfaCompileContext & context)
 {
     for (const auto & n : context.nfaStates.States())
@@ -247,7 +357,10 @@ void PrintDfaCompileContext(DfaCompileContext & context)
     {
         std::cout
             << n->id << (n->done ? "(done)" : "") << ": ";
-        PrintNfaStateSet(EpsilonClosure(n.get(), context));
+        if (context.closure[n->id].size() > 0)
+            PrintNfaStateSet(context.closure[n->id]);
+        else
+            std::cout << "-" << std::endl;
     }
 }
 void PrintDfa(Dfa & dfa)
@@ -582,22 +695,13 @@ Nfa FromRegex(std::string regex)
 
 // ==== Subset Construction ====
 
-NfaStateSet Init(DfaCompileContext & context)
-{
-    NfaStateSet nss;
-    for (const Nfa & g : context.nfas)
-        nss.set(g.in->id);
-    return nss;
-}
 // All reachable Node and self that are non-empty or done
 NfaStateSet EpsilonClosure(NfaState * ns, DfaCompileContext & context)
 {
-    auto kv = context.c1.find(ns);
-    if (kv != context.c1.end())
-        return kv->second;
+    const size_t n = context.nfaStates.States().size();
 
-    NfaStateSet nss;
-    NfaStateSet mask;
+    NfaStateSet nss(n);
+    NfaStateSet mask(n);
     std::deque<NfaState *> q = { ns };
     while (!q.empty())
     {
@@ -624,46 +728,57 @@ NfaStateSet EpsilonClosure(NfaState * ns, DfaCompileContext & context)
         }
     }
 
-    return context.c1.emplace_hint(kv, ns, nss)->second;
+    return nss;
 }
-NfaStateSet EpsilonClosure(const NfaStateSet & nss, DfaCompileContext & context)
+// Fill closure, consume and byte classes once, before subset construction.
+void Prepare(DfaCompileContext & context)
 {
-    NfaStateSet nss2;
+    const size_t n = context.nfaStates.States().size();
 
-    auto kv = context.c2.find(nss);
-    if (kv != context.c2.end())
-    {
-        nss2 = kv->second;
-    }
-    else
+    context.closure.assign(n, NfaStateSet());
+    for (const Nfa & g : context.nfas)
+        context.closure[g.in->id] = EpsilonClosure(g.in, context);
+
+    context.consume.assign(CharSet::N, NfaStateSet(n));
+    for (const auto & ns : context.nfaStates.States())
     {
-        for (size_t i = 0; i < nss.size(); ++i)
+        if (ns->c)
         {
-            if (nss[i])
-            {
-                nss2 |= EpsilonClosure(context.nfaStates[i], context);
-            }
+            context.consume[CharSet::CharIdx(*ns->c)].set(ns->id);
+            if (ns->next && context.closure[ns->next->id].size() == 0)
+                context.closure[ns->next->id] = EpsilonClosure(ns->next, context);
         }
-        context.c2.emplace_hint(kv, nss, nss2);
     }
 
-    return nss2;
+    std::unordered_map<NfaStateSet, size_t> classOf;
+    context.classChar.clear();
+    for (char ch : CharSet::Chars())
+    {
+        size_t i = CharSet::CharIdx(ch);
+        auto result = classOf.try_emplace(context.consume[i], context.classChar.size());
+        if (result.second)
+            context.classChar.push_back(ch);
+        context.byteClass[i] = result.first->second;
+    }
 }
+NfaStateSet Init(DfaCompileContext & context)
+{
+    NfaStateSet nss(context.nfaStates.States().size());
+    for (const Nfa & g : context.nfas)
+        nss |= context.closure[g.in->id];
+    return nss;
+}
+// Jump then epsilon closure.
 NfaStateSet Jump(const NfaStateSet & nss, char ch, DfaCompileContext & context)
 {
-    NfaStateSet nss2;
-    for (size_t i = 0; i < nss.size(); ++i)
+    NfaStateSet nss2(context.nfaStates.States().size());
+    nss.ForEach(context.consume[CharSet::CharIdx(ch)], [&] (size_t i)
     {
-        if (nss[i])
-        {
-            NfaState * n = context.nfaStates[i];
-            assert(n->done || n->c);
-            if (n->done)
-                /*c2.set(n->id)*/;
-            else if (*n->c == ch && n->next)
-                nss2.set(n->next->id);
-        }
-    }
+        NfaState * n = context.nfaStates[i];
+        assert(*n->c == ch);
+        if (n->next)
+            nss2 |= context.closure[n->next->id];
+    });
     return nss2;
 }
 // Die? Cont? Which rule (prefer given first)?
@@ -699,6 +814,309 @@ DfaAction GetAction(const NfaStateSet & nss, DfaCompileContext & context)
     return { false, cont, goodBranch };
 }
 
+// ==== Minimization ====
+
+// Hopcroft partition refinement.
+//
+// Initial partition keys on (bad, goodBranch), so the dead state and each
+// accepting pattern stay apart. Start state is renumbered to 0.
+Dfa Minimize(const Dfa & dfa)
+{
+    const size_t n = dfa.table.size();
+
+    // (Char, Table-State) to (Table-States jumping in)
+    std::vector<std::vector<std::vector<DfaState>>> jumpIn(CharSet::N, std::vector<std::vector<DfaState>>(n));
+    for (DfaState ds = 0; ds < n; ++ds)
+    {
+        for (size_t i : CharSet::CharIdxs())
+            jumpIn[i][dfa.table[ds][i]].push_back(ds);
+    }
+
+    std::vector<std::vector<DfaState>> blocks;
+    std::vector<size_t> blockOf(n);
+    {
+        std::map<std::pair<bool, size_t>, size_t> initial;
+        for (DfaState ds = 0; ds < n; ++ds)
+        {
+            auto key = std::make_pair(dfa.action[ds].bad, dfa.action[ds].goodBranch);
+            auto kv = initial.emplace(key, blocks.size());
+            if (kv.second)
+                blocks.emplace_back();
+            blockOf[ds] = kv.first->second;
+            blocks[blockOf[ds]].push_back(ds);
+        }
+    }
+
+    std::vector<size_t> work;
+    std::vector<bool> inWork(blocks.size(), true);
+    for (size_t b = 0; b < blocks.size(); ++b)
+        work.push_back(b);
+
+    std::vector<bool> marked(n, false);
+    std::map<size_t, std::vector<DfaState>> touched;
+    while (!work.empty())
+    {
+        size_t a = work.back();
+        work.pop_back();
+        inWork[a] = false;
+
+        const std::vector<DfaState> splitter = blocks[a];
+        for (size_t i : CharSet::CharIdxs())
+        {
+            touched.clear();
+            for (DfaState to : splitter)
+            {
+                for (DfaState from : jumpIn[i][to])
+                    touched[blockOf[from]].push_back(from);
+            }
+            for (auto & b_x : touched)
+            {
+                size_t b = b_x.first;
+                std::vector<DfaState> & x = b_x.second;
+                if (x.size() == blocks[b].size())
+                    continue;
+
+                // Split b into (b - x, x).
+                size_t nb = blocks.size();
+                for (DfaState ds : x)
+                    marked[ds] = true, blockOf[ds] = nb;
+                blocks[b].erase(std::remove_if(blocks[b].begin(),
+                                               blocks[b].end(),
+                                               [&marked](DfaState ds) { return marked[ds]; }),
+                                blocks[b].end());
+                for (DfaState ds : x)
+                    marked[ds] = false;
+                blocks.emplace_back(std::move(x));
+                inWork.push_back(false);
+
+                if (inWork[b] || blocks[nb].size() <= blocks[b].size())
+                    work.push_back(nb), inWork[nb] = true;
+                else
+                    work.push_back(b), inWork[b] = true;
+            }
+        }
+    }
+
+    // Renumber, start block first.
+    std::vector<DfaState> newState(blocks.size(), n);
+    DfaState nextDS = 0;
+    newState[blockOf[0]] = nextDS++;
+    for (DfaState ds = 0; ds < n; ++ds)
+    {
+        if (newState[blockOf[ds]] == n)
+            newState[blockOf[ds]] = nextDS++;
+    }
+
+    Dfa minDfa;
+    minDfa.table.resize(blocks.size());
+    minDfa.action.resize(blocks.size());
+    for (size_t b = 0; b < blocks.size(); ++b)
+    {
+        DfaState rep = blocks[b].front();
+        DfaState ds = newState[b];
+        for (size_t i : CharSet::CharIdxs())
+            minDfa.table[ds][i] = newState[blockOf[dfa.table[rep][i]]];
+        minDfa.action[ds] = dfa.action[rep];
+        for (DfaState member : blocks[b])
+            minDfa.action[ds].cont |= dfa.action[member].cont;
+    }
+
+    return minDfa;
+}
+
+// ==== Acceleration ====
+
+bool IsAccel(const DfaAccel & accel)
+{
+    return accel.exitCount > 0 || accel.rangeCount > 0;
+}
+bool Stays(const DfaAccel & accel, char ch)
+{
+    if (ch < 0)
+        return false;
+    if (accel.exitCount > 0)
+    {
+        for (int i = 0; i < accel.exitCount; ++i)
+        {
+            if (ch == accel.exits[i])
+                return false;
+        }
+        return true;
+    }
+    for (int i = 0; i < accel.rangeCount; ++i)
+    {
+        if (accel.lo[i] <= ch && ch <= accel.hi[i])
+            return true;
+    }
+    return false;
+}
+const char * SkipRun(const DfaAccel & accel, const char * pos, const char * end)
+{
+#ifdef DFA_ACCEL_SSE2
+    while (end - pos >= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        // Sign bit: non-ASCII.
+        int exitMask = _mm_movemask_epi8(v);
+        if (accel.exitCount > 0)
+        {
+            for (int i = 0; i < accel.exitCount; ++i)
+                exitMask |= _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(accel.exits[i])));
+        }
+        else
+        {
+            __m128i stay = _mm_setzero_si128();
+            for (int i = 0; i < accel.rangeCount; ++i)
+            {
+                __m128i in = _mm_cmpgt_epi8(v, _mm_set1_epi8(accel.lo[i] - 1));
+                if (accel.hi[i] < 127)
+                    in = _mm_and_si128(in, _mm_cmplt_epi8(v, _mm_set1_epi8(accel.hi[i] + 1)));
+                stay = _mm_or_si128(stay, in);
+            }
+            exitMask |= ~_mm_movemask_epi8(stay) & 0xffff;
+        }
+        if (exitMask)
+            break;
+        pos += 16;
+    }
+#endif
+    while (pos != end && Stays(accel, *pos))
+        ++pos;
+    return pos;
+}
+// Stay chars as at most 3 exits or at most 4 ranges, else not accelerable.
+DfaAccel AccelFromStays(const std::array<bool, CharSet::N> & stays)
+{
+    DfaAccel accel;
+    accel.exitCount = accel.rangeCount = 0;
+
+    std::vector<char> exits;
+    std::vector<std::pair<char, char>> ranges;
+    for (char ch : CharSet::Chars())
+    {
+        if (!stays[CharSet::CharIdx(ch)])
+            exits.push_back(ch);
+        else if (!ranges.empty() && ranges.back().second + 1 == ch)
+            ranges.back().second = ch;
+        else
+            ranges.emplace_back(ch, ch);
+    }
+
+    if (exits.size() <= 3)
+    {
+        accel.exitCount = static_cast<int>(exits.size());
+        std::copy(exits.begin(), exits.end(), accel.exits);
+    }
+    else if (ranges.size() <= 4)
+    {
+        accel.rangeCount = static_cast<int>(ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i)
+            accel.lo[i] = ranges[i].first, accel.hi[i] = ranges[i].second;
+    }
+    return accel;
+}
+// A state is accelerable if it jumps to itself on at least kMinStayChars
+// chars, and the others are at most 3 chars or the stay chars form at most
+// 4 ranges.
+void FindAccelStates(Dfa & dfa)
+{
+    const size_t kMinStayChars = 3;
+
+    dfa.accel.assign(dfa.table.size(), DfaAccel());
+    for (DfaState ds = 0; ds < dfa.table.size(); ++ds)
+    {
+        DfaAccel & accel = dfa.accel[ds];
+        accel.exitCount = accel.rangeCount = 0;
+        if (dfa.action[ds].bad)
+            continue;
+
+        std::array<bool, CharSet::N> stays;
+        size_t stayCount = 0;
+        for (size_t i : CharSet::CharIdxs())
+        {
+            stays[i] = dfa.table[ds][i] == ds;
+            stayCount += stays[i] ? 1 : 0;
+        }
+        if (stayCount >= kMinStayChars)
+            accel = AccelFromStays(stays);
+    }
+}
+
+// ==== Prefilter ====
+
+// first[]: chars leaving the start state for a live state. prefix: chars
+// on the path from the start state while each state has a single live
+// char and accepts nothing.
+void FindPrefilter(Dfa & dfa)
+{
+    DfaPrefilter & prefilter = dfa.prefilter;
+    prefilter.enabled = false;
+    prefilter.first.fill(false);
+    prefilter.skip.exitCount = prefilter.skip.rangeCount = 0;
+    prefilter.prefix.clear();
+
+    if (dfa.table.empty() || dfa.action[0].goodBranch)
+        return;
+
+    std::array<bool, CharSet::N> stays;
+    size_t firstCount = 0;
+    for (size_t i : CharSet::CharIdxs())
+    {
+        prefilter.first[i] = !dfa.action[dfa.table[0][i]].bad;
+        stays[i] = !prefilter.first[i];
+        firstCount += prefilter.first[i] ? 1 : 0;
+    }
+    // Matching most chars, a filter costs more than it skips.
+    prefilter.enabled = firstCount <= CharSet::N / 2;
+    prefilter.skip = AccelFromStays(stays);
+
+    DfaState ds = 0;
+    for (;;)
+    {
+        size_t liveCount = 0;
+        char liveChar = 0;
+        for (char ch : CharSet::Chars())
+        {
+            if (!dfa.action[dfa.table[ds][CharSet::CharIdx(ch)]].bad)
+                ++liveCount, liveChar = ch;
+        }
+        if (liveCount != 1 || prefilter.prefix.size() >= 16)
+            break;
+
+        prefilter.prefix.push_back(liveChar);
+        ds = dfa.table[ds][CharSet::CharIdx(liveChar)];
+        if (dfa.action[ds].goodBranch)
+            break;
+    }
+}
+
+// First candidate in [pos, end): a char in first[] followed by the prefix.
+const char * FindCandidate(const DfaPrefilter & prefilter, const char * pos, const char * end)
+{
+    const size_t n = prefilter.prefix.size();
+    while (pos < end)
+    {
+        if (IsAccel(prefilter.skip))
+        {
+            pos = SkipRun(prefilter.skip, pos, end);
+        }
+        else
+        {
+            while (pos < end && (*pos < 0 || !prefilter.first[CharSet::CharIdx(*pos)]))
+                ++pos;
+        }
+        if (pos == end)
+            break;
+
+        // Non-ASCII chars stop SkipRun() but start no match.
+        if (*pos >= 0 &&
+            (n <= 1 || (static_cast<size_t>(end - pos) >= n && memcmp(pos, prefilter.prefix.data(), n) == 0)))
+            return pos;
+        ++pos;
+    }
+    return end;
+}
+
 #define DFA_EXPECT_TRUE(cond) \
     do { \
         if (!(cond)) \
@@ -714,30 +1132,27 @@ Dfa Compile(DfaCompileInput & input)
     NfaStateSet nss;
     DfaState ds;
 
+    Prepare(context);
     //PrintDfaCompileContext(context);
 
-    nss =
-        EpsilonClosure(
-            Init(context),
-            context
-        );
+    std::vector<DfaState> classTarget(context.classChar.size());
+
+    nss = Init(context);
     ds = nfa2dfa.Add(nss);
     for (; ds < nfa2dfa.Guard(); ++ds)
     {
         nss = nfa2dfa.Get(ds);
+        for (size_t k = 0; k < context.classChar.size(); ++k)
+        {
+            classTarget[k] =
+                nfa2dfa.Add(Jump(nss, context.classChar[k], context));
+        }
         dfaTable.emplace_back();
-        for (char ch : CharSet::Chars())
+        for (size_t i : CharSet::CharIdxs())
         {
-            NfaStateSet nss2 =
-                EpsilonClosure(
-                    Jump(nss, ch, context),
-                    context
-                );
-            dfaTable[ds][CharSet::CharIdx(ch)] =
-                nfa2dfa.Add(nss2);
+            dfaTable[ds][i] = classTarget[context.byteClass[i]];
         }
     }
-    assert(ds < nss.size());
 
     Dfa dfa;
 
@@ -748,7 +1163,10 @@ Dfa Compile(DfaCompileInput & input)
         dfa.action[nss_ds.second] = GetAction(nss_ds.first, context);
     }
 
-    return dfa;
+    Dfa minDfa = Minimize(dfa);
+    FindAccelStates(minDfa);
+    FindPrefilter(minDfa);
+    return minDfa;
 }
 
 DfaMatchResult Match(Dfa & dfa, const char * begin, const char * end)
@@ -764,6 +1182,8 @@ DfaMatchResult Match(Dfa & dfa, const char * begin, const char * end)
          ++pos)
     {
         char ch = *pos;
+        if (!CharSet::Contains(ch))
+            break;
         size_t ds2 = dfa.table[ds][CharSet::CharIdx(ch)];
 
         ds = ds2;
@@ -771,6 +1191,10 @@ DfaMatchResult Match(Dfa & dfa, const char * begin, const char * end)
         if (dfa.action[ds].bad)
             break;
 
+        // Self-loop: stop on the last char of the run.
+        if (!dfa.accel.empty() && IsAccel(dfa.accel[ds]))
+            pos = SkipRun(dfa.accel[ds], pos + 1, end) - 1;
+
         if (dfa.action[ds].goodBranch)
         {
             matchedBranch = dfa.action[ds].goodBranch;
@@ -781,6 +1205,160 @@ DfaMatchResult Match(Dfa & dfa, const char * begin, const char * end)
     // Offset filled by client.
     return { 0, matchedLength, matchedBranch };
 }
+DfaMatchResult Match(MatchEngine m, const char * begin, const char * end)
+{
+    if (m.scan)
+    {
+        MatchResult r = m.scan(begin, end);
+        return { r.offset, r.length, r.which };
+    }
+
+    assert(m.dfa);
+    return Match(*m.dfa, begin, end);
+}
+
+// ==== Generate Scanner ====
+
+// FNV-1a over all patterns, used to detect a stale generated scanner.
+UINT64 PatternsFingerprint(const std::vector<std::string> & patterns)
+{
+    UINT64 h = 14695981039346656037ull;
+    for (const std::string & p : patterns)
+    {
+        for (char ch : p)
+            h = (h ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+        h = (h ^ 0xffu) * 1099511628211ull;
+    }
+    return h;
+}
+// One label per live state, one switch per label:
+//
+//  sN:
+//      pos = SkipRun(kAccelN, pos, end);              (self-looping state only)
+//      matchedLength = ...; matchedBranch = ...;   (accepting state only)
+//      if (pos == end) goto done;
+//      switch (*pos++) { case ...: goto sM; default: goto sK; }
+//
+// The most frequent target becomes the default case, non-ASCII chars always
+// go to done.
+void GenerateScannerFunction(std::ostream & os, const Dfa & dfa, const std::string & scanName)
+{
+    for (DfaState ds = 0; ds < dfa.table.size(); ++ds)
+    {
+        const DfaAccel & accel = dfa.accel[ds];
+        if (!IsAccel(accel))
+            continue;
+
+        os << "static const DfaAccel kAccel" << ds << " = { " << accel.exitCount << ", { ";
+        for (int i = 0; i < 3; ++i)
+            os << (i ? ", " : "") << (i < accel.exitCount ? (int)accel.exits[i] : 0);
+        os << " }, " << accel.rangeCount << ", { ";
+        for (int i = 0; i < 4; ++i)
+            os << (i ? ", " : "") << (i < accel.rangeCount ? (int)accel.lo[i] : 0);
+        os << " }, { ";
+        for (int i = 0; i < 4; ++i)
+            os << (i ? ", " : "") << (i < accel.rangeCount ? (int)accel.hi[i] : 0);
+        os << " } };" << std::endl;
+    }
+    os << std::endl;
+
+    os << "MatchResult " << scanName << "(const char * begin, const char * end)" << std::endl
+       << "{" << std::endl
+       << "    size_t matchedLength = 0;" << std::endl
+       << "    size_t matchedBranch = 0;" << std::endl
+       << "    const char * pos = begin;" << std::endl
+       << std::endl
+       << "    goto s0;" << std::endl;
+
+    auto Label = [&dfa] (DfaState ds) -> std::string
+    {
+        return dfa.action[ds].bad ? "done" : "s" + std::to_string(ds);
+    };
+
+    for (DfaState ds = 0; ds < dfa.table.size(); ++ds)
+    {
+        const DfaAction & action = dfa.action[ds];
+        if (action.bad)
+            continue;
+
+        // Group chars by target state, keep first-seen order.
+        std::vector<DfaState> targets;
+        std::vector<size_t> counts;
+        for (size_t i : CharSet::CharIdxs())
+        {
+            DfaState ds2 = dfa.table[ds][i];
+            auto it = std::find(targets.begin(), targets.end(), ds2);
+            if (it == targets.end())
+                targets.push_back(ds2), counts.push_back(1);
+            else
+                ++counts[it - targets.begin()];
+        }
+        DfaState dsDefault = targets[std::max_element(counts.begin(), counts.end()) - counts.begin()];
+
+        os << "s" << ds << ":" << std::endl;
+        if (IsAccel(dfa.accel[ds]))
+            os << "    pos = SkipRun(kAccel" << ds << ", pos, end);" << std::endl;
+        if (action.goodBranch > 0)
+            os << "    matchedLength = pos - begin;" << std::endl
+               << "    matchedBranch = " << action.goodBranch << ";" << std::endl;
+        os << "    if (pos == end) goto done;" << std::endl;
+        if (!dfa.action[dsDefault].bad)
+            os << "    if (*pos < 0) goto done;" << std::endl;
+        os << "    switch (*pos++)" << std::endl
+           << "    {" << std::endl;
+
+        for (DfaState ds2 : targets)
+        {
+            if (ds2 == dsDefault)
+                continue;
+
+            size_t n = 0;
+            for (size_t i : CharSet::CharIdxs())
+            {
+                if (dfa.table[ds][i] != ds2)
+                    continue;
+                os << (n % 8 == 0 ? "        " : " ") << "case " << i << ":";
+                if (++n % 8 == 0)
+                    os << std::endl;
+            }
+            if (n % 8 != 0)
+                os << std::endl;
+            os << "            goto " << Label(ds2) << ";" << std::endl;
+        }
+        os << "        default:" << std::endl
+           << "            goto " << Label(dsDefault) << ";" << std::endl
+           << "    }" << std::endl;
+    }
+
+    os << "done:" << std::endl
+       << "    return { 0, matchedLength, matchedBranch };" << std::endl
+       << "}" << std::endl;
+}
+std::string GenerateScannerSource(std::vector<std::string> & patterns,
+                                  const std::string & scanName,
+                                  const std::string & fingerprintName)
+{
+    DfaCompileInput input;
+    NfaStateFactoryScope scope(&input.nfaStateFactory);
+
+    input.nfaList.reserve(patterns.size());
+    for (auto & p : patterns)
+        input.nfaList.emplace_back(FromRegex(p));
+
+    Dfa dfa = ::Compile(input);
+
+    std::ostringstream os;
+    os << "// Generated by GenerateScannerSource(), do not edit." << std::endl
+       << "// " << patterns.size() << " patterns, " << dfa.table.size() << " dfa states." << std::endl
+       << std::endl
+       << "#include \"RegexMatcher.h\"" << std::endl
+       << std::endl
+       << "extern const UINT64 " << fingerprintName << " = 0x" << std::hex << PatternsFingerprint(patterns) << std::dec << "ull;" << std::endl
+       << std::endl;
+    GenerateScannerFunction(os, dfa, scanName);
+
+    return os.str();
+}
 
 // ==== API ====
 
@@ -835,12 +1413,16 @@ bool LoadFromFile(std::string fileName, Dfa * dfa)
         ifs >> action.bad >> action.cont >> action.goodBranch;
     }
 
+    FindAccelStates(*dfa);
+    FindPrefilter(*dfa);
+
     return true;
 }
 
 MatchEngine Compile(std::vector<std::string> & patterns)
 {
     MatchEngine m;
+    m.scan = nullptr;
 
     DfaCompileInput input;
     NfaStateFactoryScope scope(&input.nfaStateFactory);
@@ -852,9 +1434,11 @@ MatchEngine Compile(std::vector<std::string> & patterns)
     // No cache
     // this->dfa = new Dfa(std::move(::Compile(input)));
 
-    // With cache
+    // With cache, keyed by the patterns so an edited set never loads a stale dfa
     m.dfa = NewDfa();
-    const std::string cacheFile = "lex_cache.bin";
+    std::ostringstream cacheName;
+    cacheName << "lex_cache_" << std::hex << PatternsFingerprint(patterns) << ".bin";
+    const std::string cacheFile = cacheName.str();
     if (LoadFromFile(cacheFile, m.dfa))
     {
         std::cout << "Load lex cache from file: " << cacheFile << std::endl;
@@ -869,19 +1453,23 @@ MatchEngine Compile(std::vector<std::string> & patterns)
     return m;
 }
 
-MatchResult MatchPrefix(MatchEngine m, StringView text)
+MatchEngine FromScanner(ScanFunction scan)
 {
-    assert(m.dfa);
+    MatchEngine m;
+    m.dfa = nullptr;
+    m.scan = scan;
+    return m;
+}
 
-    DfaMatchResult r = ::Match(*m.dfa, text.Begin(), text.End());
+MatchResult MatchPrefix(MatchEngine m, StringView text)
+{
+    DfaMatchResult r = ::Match(m, text.Begin(), text.End());
 
     return { r.offset, r.length, r.which };
 }
 
 std::vector<MatchResult> MatchAll(MatchEngine m, StringView text)
 {
-    assert(m.dfa);
-
     std::vector<MatchResult> mrs;
 
     const char * begin = text.Begin();
@@ -889,7 +1477,7 @@ std::vector<MatchResult> MatchAll(MatchEngine m, StringView text)
     const char * pos = begin;
     while (pos < end)
     {
-        DfaMatchResult r = ::Match(*m.dfa, pos, end);
+        DfaMatchResult r = ::Match(m, pos, end);
         r.offset = pos - begin;
 
         if (r.length == 0)
@@ -906,6 +1494,161 @@ std::vector<MatchResult> MatchAll(MatchEngine m, StringView text)
     return mrs;
 }
 
+std::vector<MatchResult> SearchAll(MatchEngine m, StringView text)
+{
+    std::vector<MatchResult> mrs;
+
+    const DfaPrefilter * prefilter =
+        (m.dfa && m.dfa->prefilter.enabled) ? &m.dfa->prefilter : nullptr;
+
+    const char * begin = text.Begin();
+    const char * end = text.End();
+    const char * pos = begin;
+    while (pos < end)
+    {
+        if (prefilter)
+        {
+            pos = FindCandidate(*prefilter, pos, end);
+            if (pos == end)
+                break;
+        }
+        else if (!CharSet::Contains(*pos))
+        {
+            ++pos;
+            continue;
+        }
+
+        DfaMatchResult r = ::Match(m, pos, end);
+        if (r.length == 0)
+        {
+            ++pos;
+            continue;
+        }
+
+        mrs.push_back({ static_cast<size_t>(pos - begin), r.length, r.which });
+        pos += r.length;
+    }
+
+    return mrs;
+}
+
+// Chunk-parallel MatchAll:
+//
+//  1. split text just after a '\n' near every 1/n, and speculate each
+//     chunk starts at a token boundary (the dfa start state)
+//  2. lex chunks in parallel, each up to the first token reaching the next
+//     chunk, or the first unmatched char
+//  3. stitch in order: re-lex from where the previous chunk really ended
+//     until reaching a token start the chunk speculated, since lexing from
+//     the same offset always gives the same tokens
+//
+// Unlike MatchAll() stops before the first unmatched char instead of
+// throwing, callers check the last match end.
+struct MatchChunk
+{
+    std::vector<MatchResult> mrs;
+    size_t stop; // end of last match, or the unmatched char
+};
+static void MatchChunkAt(MatchEngine m, StringView text, size_t begin, size_t end, MatchChunk & chunk)
+{
+    size_t pos = begin;
+    while (pos < end)
+    {
+        DfaMatchResult r = Match(m, text.Begin() + pos, text.End());
+        if (r.length == 0)
+            break;
+        chunk.mrs.push_back({ pos, r.length, r.which });
+        pos += r.length;
+    }
+    chunk.stop = pos;
+}
+std::vector<MatchResult> MatchAllChunked(MatchEngine m, StringView text, size_t chunkCount)
+{
+    const char * begin = text.Begin();
+    const size_t length = text.End() - text.Begin();
+
+    std::vector<size_t> bounds = { 0 };
+    for (size_t k = 1; k < chunkCount; ++k)
+    {
+        size_t split = std::max(bounds.back(), length * k / chunkCount);
+        const char * newLine = static_cast<const char *>(memchr(begin + split, '\n', length - split));
+        if (!newLine || static_cast<size_t>(newLine + 1 - begin) >= length)
+            break;
+        if (static_cast<size_t>(newLine + 1 - begin) > bounds.back())
+            bounds.push_back(newLine + 1 - begin);
+    }
+    bounds.push_back(length);
+
+    std::vector<MatchChunk> chunks(bounds.size() - 1);
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < chunks.size(); ++k)
+        workers.emplace_back(MatchChunkAt, m, text, bounds[k], bounds[k + 1], std::ref(chunks[k]));
+    MatchChunkAt(m, text, bounds[0], bounds[1], chunks[0]);
+    for (std::thread & worker : workers)
+        worker.join();
+
+    size_t total = 0;
+    for (const MatchChunk & chunk : chunks)
+        total += chunk.mrs.size();
+
+    std::vector<MatchResult> mrs = std::move(chunks[0].mrs);
+    mrs.reserve(total);
+    size_t pos = chunks[0].stop;
+    for (size_t k = 1; k < chunks.size() && pos < length; ++k)
+    {
+        const MatchChunk & chunk = chunks[k];
+
+        // fix-up until synchronized with speculation
+        size_t i = 0;
+        bool synced = false;
+        while (!synced && pos < chunk.stop)
+        {
+            while (i < chunk.mrs.size() && chunk.mrs[i].offset < pos)
+                ++i;
+            if (i < chunk.mrs.size() && chunk.mrs[i].offset == pos)
+            {
+                synced = true;
+                break;
+            }
+
+            DfaMatchResult r = Match(m, begin + pos, text.End());
+            if (r.length == 0)
+                return mrs;
+            mrs.push_back({ pos, r.length, r.which });
+            pos += r.length;
+        }
+
+        if (synced)
+        {
+            mrs.insert(mrs.end(), chunk.mrs.begin() + i, chunk.mrs.end());
+            pos = chunk.stop;
+        }
+    }
+    // previous chunk overran the rest, or stopped at an unmatched char
+    while (pos < length)
+    {
+        DfaMatchResult r = Match(m, begin + pos, text.End());
+        if (r.length == 0)
+            break;
+        mrs.push_back({ pos, r.length, r.which });
+        pos += r.length;
+    }
+
+    return mrs;
+}
+std::vector<MatchResult> MatchAllParallel(MatchEngine m, StringView text, size_t threadCount)
+{
+    // Small chunks don't pay for a thread.
+    const size_t kMinChunkBytes = 256 * 1024;
+
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t length = text.End() - text.Begin();
+    size_t chunkCount = std::max<size_t>(1, std::min(threadCount, length / kMinChunkBytes));
+
+    return MatchAllChunked(m, text, chunkCount);
+}
+
 std::vector<MatchResult> MatchAll(std::vector<std::string> patterns, StringView text)
 {
     DfaCompileInput input;
@@ -982,6 +1725,232 @@ TEST(RegexMatcher_Escape)
     }
 }
 
+TEST(RegexMatcher_Minimize)
+{
+    DfaCompileInput input;
+    NfaStateFactoryScope scope(&input.nfaStateFactory);
+    input.nfaList.emplace_back(FromRegex("ab|cb"));
+    input.nfaList.emplace_back(FromRegex("b"));
+
+    // {a c b'} -a-> {b1} -b-> {done1}
+    //          -c-> {b2} -b-> {done1}  (b1 == b2)
+    //          -b-> {done2}
+    // plus the bad state.
+    Dfa dfa = ::Compile(input);
+    EXPECT_EQ(dfa.table.size(), 5);
+
+    std::string text = "cbab";
+    DfaMatchResult r = ::Match(dfa, text.data(), text.data() + text.size());
+    EXPECT_EQ(r.length, 2);
+    EXPECT_EQ(r.which, 1);
+    r = ::Match(dfa, text.data() + 1, text.data() + text.size());
+    EXPECT_EQ(r.length, 1);
+    EXPECT_EQ(r.which, 2);
+}
+
+TEST(RegexMatcher_Benchmark)
+{
+    // 1024 keyword-like patterns, then the usual catch-alls.
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 1024; ++i)
+    {
+        std::string n = std::to_string(i);
+        patterns.push_back(i % 4 == 0 ? "#" + n + "[a-z]*" : "kw_" + n);
+    }
+    patterns.push_back("[_a-zA-Z][_a-zA-Z0-9]*");
+    patterns.push_back("[0-9]+");
+    patterns.push_back("[ \t\r\n]+");
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    DfaCompileInput input;
+    NfaStateFactoryScope scope(&input.nfaStateFactory);
+    for (const std::string & p : patterns)
+        input.nfaList.emplace_back(FromRegex(p));
+    Dfa dfa = ::Compile(input);
+
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << "Compile " << patterns.size() << " patterns ("
+              << input.nfaStateFactory.States().size() << " nfa states): "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << " ms" << std::endl;
+
+    std::string text = "kw_123 kw_12x #8abc";
+    DfaMatchResult r = ::Match(dfa, text.data(), text.data() + text.size());
+    EXPECT_EQ(r.length, 6);
+    EXPECT_EQ(r.which, 124);
+    r = ::Match(dfa, text.data() + 7, text.data() + text.size());
+    EXPECT_EQ(r.length, 6);
+    EXPECT_EQ(r.which, 1025);
+    r = ::Match(dfa, text.data() + 14, text.data() + text.size());
+    EXPECT_EQ(r.length, 5);
+    EXPECT_EQ(r.which, 9);
+}
+
+TEST(RegexMatcher_Accel)
+{
+    DfaCompileInput input;
+    NfaStateFactoryScope scope(&input.nfaStateFactory);
+    input.nfaList.emplace_back(FromRegex("[_a-zA-Z][_a-zA-Z0-9]*"));
+    input.nfaList.emplace_back(FromRegex("\"([^\"]|\\\\\")*\""));
+    input.nfaList.emplace_back(FromRegex("[ \t\r]+"));
+    input.nfaList.emplace_back(FromRegex("[0-9]+"));
+    input.nfaList.emplace_back(FromRegex("[^a]"));
+    Dfa dfa = ::Compile(input);
+
+    // identifier, string, space, int
+    size_t accelCount = 0;
+    for (const DfaAccel & accel : dfa.accel)
+        accelCount += IsAccel(accel) ? 1 : 0;
+    EXPECT_EQ(accelCount, 4);
+
+    std::string text;
+    for (int i = 0; i < 37; ++i)
+        text += "id_" + std::to_string(i * 7919);
+    text += " \t \t\r  \"a string \\\" with escapes and a long run of text\"";
+    text += "0123456789012345678901234567890123456789";
+    text += std::string(40, ' ');
+
+    Dfa plain;
+    plain.table = dfa.table;
+    plain.action = dfa.action;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const char * begin = text.data() + i;
+        const char * end = text.data() + text.size();
+        DfaMatchResult r1 = ::Match(dfa, begin, end);
+        DfaMatchResult r2 = ::Match(plain, begin, end);
+        EXPECT_EQ(r1.length, r2.length);
+        EXPECT_EQ(r1.which, r2.which);
+    }
+}
+
+TEST(RegexMatcher_MatchAllParallel)
+{
+    DfaCompileInput input;
+    NfaStateFactoryScope scope(&input.nfaStateFactory);
+    input.nfaList.emplace_back(FromRegex("[_a-zA-Z][_a-zA-Z0-9]*"));
+    input.nfaList.emplace_back(FromRegex("\"[^\"]*\""));  // may span lines
+    input.nfaList.emplace_back(FromRegex("[ \t]+"));
+    input.nfaList.emplace_back(FromRegex("\n"));
+    input.nfaList.emplace_back(FromRegex("[0-9]+"));
+    Dfa dfa = ::Compile(input);
+    MatchEngine me = { &dfa, nullptr };
+
+    std::string text;
+    UINT32 seed = 12345;
+    auto random = [&seed](UINT32 n) { seed = seed * 1103515245u + 12345u; return (seed >> 16) % n; };
+    const char * pieces[] = { "id", "_x1", " ", "\t ", "\n", "42", "\"str\"", "\"multi\nline\n\"", "\n\n" };
+    while (text.size() < 20000)
+        text += pieces[random(9)];
+
+    auto same = [](const std::vector<MatchResult> & a, const std::vector<MatchResult> & b) -> bool {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].offset != b[i].offset || a[i].length != b[i].length || a[i].which != b[i].which)
+                return false;
+        }
+        return true;
+    };
+
+    std::vector<MatchResult> expect = MatchAll(me, StringView(text.data(), text.length()));
+    for (size_t chunkCount = 1; chunkCount <= 64; chunkCount *= 2)
+        EXPECT_TRUE(same(MatchAllChunked(me, StringView(text.data(), text.length()), chunkCount), expect));
+
+    // Stops before the unmatched char, wherever chunks split.
+    size_t bad = 0;
+    for (size_t i = expect.size() / 3; bad == 0; ++i)
+        bad = expect[i].which == 4 ? expect[i].offset : 0; // new line, not in a string
+    text[bad] = '@';
+    expect = MatchAllChunked(me, StringView(text.data(), text.length()), 1);
+    EXPECT_TRUE(!expect.empty() && expect.back().offset + expect.back().length == bad);
+    for (size_t chunkCount = 2; chunkCount <= 64; chunkCount *= 2)
+        EXPECT_TRUE(same(MatchAllChunked(me, StringView(text.data(), text.length()), chunkCount), expect));
+    EXPECT_TRUE(same(MatchAllParallel(me, StringView(text.data(), text.length()), 4), expect));
+}
+
+TEST(RegexMatcher_SearchAll)
+{
+    auto compile = [](std::vector<const char *> patterns) -> Dfa {
+        DfaCompileInput input;
+        NfaStateFactoryScope scope(&input.nfaStateFactory);
+        for (const char * p : patterns)
+            input.nfaList.emplace_back(FromRegex(p));
+        return ::Compile(input);
+    };
+    // Try the dfa at every position.
+    auto naive = [](Dfa & dfa, const std::string & text) -> std::vector<MatchResult> {
+        std::vector<MatchResult> mrs;
+        for (size_t pos = 0; pos < text.size();)
+        {
+            DfaMatchResult r = ::Match(dfa, text.data() + pos, text.data() + text.size());
+            if (r.length == 0)
+            {
+                ++pos;
+                continue;
+            }
+            mrs.push_back({ pos, r.length, r.which });
+            pos += r.length;
+        }
+        return mrs;
+    };
+    auto same = [](const std::vector<MatchResult> & a, const std::vector<MatchResult> & b) -> bool {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].offset != b[i].offset || a[i].length != b[i].length || a[i].which != b[i].which)
+                return false;
+        }
+        return true;
+    };
+
+    Dfa directive = compile({ "#[ \t]*include", "#[ \t]*define" });
+    EXPECT_TRUE(directive.prefilter.enabled);
+    EXPECT_EQ(directive.prefilter.prefix, "#");
+    EXPECT_EQ(directive.prefilter.skip.exitCount, 1);
+
+    Dfa words = compile({ "hello[0-9]+", "help", "world" });
+    EXPECT_EQ(words.prefilter.prefix, "");
+    EXPECT_EQ(words.prefilter.skip.exitCount, 2);
+    Dfa hello = compile({ "hello[0-9]+" });
+    EXPECT_EQ(hello.prefilter.prefix, "hello");
+
+    Dfa any = compile({ "[^#]+" });
+    EXPECT_FALSE(any.prefilter.enabled);
+
+    std::string text;
+    UINT32 seed = 4242;
+    auto random = [&seed](UINT32 n) { seed = seed * 1103515245u + 12345u; return (seed >> 16) % n; };
+    const char * pieces[] = {
+        "int x = 0;\n", "# include <a.h>\n", "#define X\n", "#if X\n", "hello42 ", "help ", "hell ",
+        "world\n", "\xC3\xA9t\xC3\xA9 ", "/* # */ ", "\thellohello7", "# \tdefine",
+    };
+    while (text.size() < 50000)
+        text += pieces[random(12)];
+
+    for (Dfa * dfa : { &directive, &words, &hello, &any })
+    {
+        MatchEngine me = { dfa, nullptr };
+        EXPECT_TRUE(same(SearchAll(me, StringView(text.data(), text.length())), naive(*dfa, text)));
+    }
+
+    // Sparse matches: the prefilter skips whole blocks, up to a match at
+    // the very end.
+    std::string sparse;
+    while (sparse.size() < (1 << 16))
+        sparse += "int some_variable = other_variable + 12345; // a comment\n";
+    sparse += "#include";
+    MatchEngine me = { &directive, nullptr };
+    std::vector<MatchResult> found = SearchAll(me, StringView(sparse.data(), sparse.length()));
+    EXPECT_TRUE(same(found, naive(directive, sparse)));
+    EXPECT_EQ(found.size(), 1u);
+    EXPECT_EQ(found.empty() ? 0 : found[0].offset, sparse.size() - 8);
+    EXPECT_EQ(found.empty() ? 0 : found[0].length, 8u);
+}
+
 TEST(RegexMatcher_Complete)
 {
     try
@@ -12,16 +12,50 @@ struct MatchResult
     size_t which;  // 0: no match, 1: match 1st pattern, ...
 };
 
+// Self-looping dfa state, its run is skipped by SkipRun().
+//
+// Stay on any ASCII char but exits[], or, when exitCount is 0, on chars
+// in one of [lo[i], hi[i]]. Non-ASCII chars always exit.
+struct DfaAccel
+{
+    int exitCount;
+    char exits[3];
+    int rangeCount;
+    char lo[4];
+    char hi[4];
+};
+
+// First char in [pos, end) that leaves the state, 16 chars at a time.
+const char * SkipRun(const DfaAccel & accel, const char * pos, const char * end);
+
+// Direct-coded scanner emitted by GenerateScannerSource().
+typedef MatchResult (*ScanFunction)(const char * begin, const char * end);
+
 struct MatchEngine
 {
     struct Dfa * dfa;
+    ScanFunction scan; // Generated scanner, preferred over dfa.
 };
 
 // Compile
 MatchEngine Compile(std::vector<std::string> & patterns);
+MatchEngine FromScanner(ScanFunction scan);
+
+// Generate
+UINT64 PatternsFingerprint(const std::vector<std::string> & patterns);
+std::string GenerateScannerSource(std::vector<std::string> & patterns,
+                                  const std::string & scanName,
+                                  const std::string & fingerprintName);
 
 // Match one
 MatchResult MatchPrefix(MatchEngine m, StringView text);
 // Match all
 std::vector<MatchResult> MatchAll(MatchEngine m, StringView text);
 std::vector<MatchResult> MatchAll(std::vector<std::string> patterns, StringView text);
+// Search: leftmost-longest matches, skipping chars no match starts at.
+// With a dfa, jumps between candidate chars (and the literal prefix all
+// patterns share) 16 chars at a time before trying the dfa.
+std::vector<MatchResult> SearchAll(MatchEngine m, StringView text);
+// Match all on up to threadCount threads (0: one per core), same result as
+// MatchAll(), but stops before an unmatched char instead of throwing.
+std::vector<MatchResult> MatchAllParallel(MatchEngine m, StringView text, size_t threadCount = 0);
@@ -64,9 +64,9 @@ ParameterPassingCallerProtocol::ParameterPassingCallerProtocol(FunctionType * fu
         rvaAsFirstParameter = false;
     }
 
-    for (Type ** pp = functionType->memberType; *pp; ++pp)
+    for (size_t i = 0; i < functionType->memberCount; ++i)
     {
-        Type * parameterType = *pp;
+        Type * parameterType = functionType->memberType[i];
 
         Location loc;
 
@@ -206,9 +206,9 @@ ParameterPassingCalleeProtocol::ParameterPassingCalleeProtocol(FunctionType * fu
         rvaAsFirstParameter = false;
     }
 
-    for (Type ** pp = functionType->memberType; *pp; ++pp)
+    for (size_t i = 0; i < functionType->memberCount; ++i)
     {
-        Type * parameterType = *pp;
+        Type * parameterType = functionType->memberType[i];
 
         Location loc;
 
@@ -1,6 +1,9 @@
 #include "DefinitionContext.h"
 
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
 
 namespace Language {
 
@@ -192,6 +195,185 @@ DefinitionContextNamespace DefinitionType2DefinitionContextNamespace(DefinitionT
     return ns;
 }
 
+namespace {
+
+class NameTable
+{
+public:
+    NameAtom Intern(StringRef name)
+    {
+        UINT32 hash = Hash(name);
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            NameAtom atom = Probe(name, hash);
+            if (atom != NO_NAME_ATOM)
+                return atom;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if ((names.size() + 1) * 4 > slots.size() * 3)
+            Grow();
+
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        for (; slots[i] != NO_NAME_ATOM; i = (i + 1) & mask)
+        {
+            NameAtom atom = slots[i];
+            if (hashes[atom] == hash && names[atom] == name)
+                return atom;
+        }
+
+        // Own the text, names may point into tokens of one compile.
+        texts.push_back(name.toString());
+        slots[i] = static_cast<NameAtom>(names.size());
+        names.push_back(StringRef(texts.back()));
+        hashes.push_back(hash);
+        return slots[i];
+    }
+
+    // NO_NAME_ATOM if not interned, the name isn't added.
+    NameAtom Find(StringRef name, UINT32 hash) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return Probe(name, hash);
+    }
+
+    StringRef Name(NameAtom atom) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        ASSERT(atom < names.size());
+        return names[atom];
+    }
+
+    static UINT32 Hash(StringRef name)
+    {
+        UINT32 hash = 2166136261u;
+        for (char c : name)
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        return hash;
+    }
+
+private:
+    NameAtom Probe(StringRef name, UINT32 hash) const
+    {
+        if (slots.empty())
+            return NO_NAME_ATOM;
+
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; slots[i] != NO_NAME_ATOM; i = (i + 1) & mask)
+        {
+            NameAtom atom = slots[i];
+            if (hashes[atom] == hash && names[atom] == name)
+                return atom;
+        }
+        return NO_NAME_ATOM;
+    }
+
+    void Grow()
+    {
+        slots.assign(Max<size_t>(64, slots.size() * 2), NO_NAME_ATOM);
+        size_t mask = slots.size() - 1;
+        for (NameAtom atom = 0; atom < names.size(); ++atom)
+        {
+            size_t i = hashes[atom] & mask;
+            while (slots[i] != NO_NAME_ATOM)
+                i = (i + 1) & mask;
+            slots[i] = atom;
+        }
+    }
+
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> texts;
+    std::vector<StringRef>  names;      // by atom
+    std::vector<UINT32>     hashes;     // by atom
+    std::vector<NameAtom>   slots;
+};
+
+NameTable & GlobalNameTable()
+{
+    static NameTable nameTable;
+    return nameTable;
+}
+
+size_t SlotOf(NameAtom atom, DefinitionContextNamespace ns, size_t mask)
+{
+    return ((atom * 3 + ns) * 2654435761u) & mask;
+}
+
+void IndexDefinition(DefinitionTable & table, NameAtom atom, DefinitionContextNamespace ns, size_t index)
+{
+    if ((table.count + 1) * 4 > table.slots.size() * 3)
+    {
+        std::vector<DefinitionTable::Slot> slots(Max<size_t>(8, table.slots.size() * 2), { NO_NAME_ATOM, 0, 0 });
+        size_t mask = slots.size() - 1;
+        for (const DefinitionTable::Slot & slot : table.slots)
+        {
+            if (slot.atom == NO_NAME_ATOM)
+                continue;
+            size_t i = SlotOf(slot.atom, static_cast<DefinitionContextNamespace>(slot.ns), mask);
+            while (slots[i].atom != NO_NAME_ATOM)
+                i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+        table.slots.swap(slots);
+    }
+
+    size_t mask = table.slots.size() - 1;
+    size_t i = SlotOf(atom, ns, mask);
+    while (table.slots[i].atom != NO_NAME_ATOM)
+        i = (i + 1) & mask;
+    table.slots[i] = { atom, static_cast<UINT32>(ns), static_cast<UINT32>(index) };
+    ++table.count;
+}
+
+// atom is of name, NO_NAME_ATOM until a definition of the name is
+// indexed: looking up names doesn't intern them.
+DefinitionLocation FindInScope(DefinitionContext * context,
+                               StringRef name,
+                               UINT32 hash,
+                               NameAtom & atom,
+                               DefinitionContextNamespace ns)
+{
+    std::vector<Definition *> & definitions = context->definitions[ns];
+    DefinitionTable & table = context->table;
+    for (; table.indexed[ns] < definitions.size(); ++table.indexed[ns])
+        IndexDefinition(table, InternName(definitions[table.indexed[ns]]->name), ns, table.indexed[ns]);
+
+    if (table.count == 0)
+        return nullptr;
+    if (atom == NO_NAME_ATOM)
+    {
+        atom = GlobalNameTable().Find(name, hash);
+        if (atom == NO_NAME_ATOM)
+            return nullptr;
+    }
+
+    size_t mask = table.slots.size() - 1;
+    for (size_t i = SlotOf(atom, ns, mask); table.slots[i].atom != NO_NAME_ATOM; i = (i + 1) & mask)
+    {
+        if (table.slots[i].atom == atom && table.slots[i].ns == static_cast<UINT32>(ns))
+            return &definitions[table.slots[i].index];
+    }
+    return nullptr;
+}
+
+}
+
+NameAtom InternName(StringRef name)
+{
+    return GlobalNameTable().Intern(name);
+}
+
+NameAtom FindName(StringRef name)
+{
+    return GlobalNameTable().Find(name, NameTable::Hash(name));
+}
+
+StringRef NameOfAtom(NameAtom atom)
+{
+    return GlobalNameTable().Name(atom);
+}
+
 DefinitionLocation FindDefinitionLocation(DefinitionContext * currentContext,
                                           StringRef name,
                                           DefinitionContextNamespace ns,
@@ -199,6 +381,9 @@ DefinitionLocation FindDefinitionLocation(DefinitionContext * currentContext,
 {
     ASSERT(currentContext);
 
+    UINT32 hash = NameTable::Hash(name);
+    NameAtom atom = NO_NAME_ATOM;
+
     if (ns == DefinitionContextNamespace::LABEL_NAMESPACE)
     {
         // Find label in function context.
@@ -210,16 +395,7 @@ DefinitionLocation FindDefinitionLocation(DefinitionContext * currentContext,
             ASSERT(context);
         }
 
-        DefinitionLocation location = nullptr;
-        for (Definition *& definition : context->definitions[ns])
-        {
-            if (definition->name == name)
-            {
-                location = &definition;
-                break;
-            }
-        }
-        return location;
+        return FindInScope(context, name, hash, atom, ns);
     }
     else
     {
@@ -229,14 +405,7 @@ DefinitionLocation FindDefinitionLocation(DefinitionContext * currentContext,
         DefinitionLocation location = nullptr;
         do
         {
-            for (Definition *& definition : context->definitions[ns])
-            {
-                if (definition->name == name)
-                {
-                    location = &definition;
-                    break;
-                }
-            }
+            location = FindInScope(context, name, hash, atom, ns);
             if (!location && searchParent)
                 context = context->parent;
             else
@@ -456,4 +625,70 @@ void PrintDefinitionContext(DefinitionContext * context)
     PrintDefinitionContextImpl(context, "");
 }
 
-}
\ No newline at end of file
+}
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+TEST(DefinitionContext_Lookup)
+{
+    using namespace Language;
+
+    TypeContext * types = CreateTypeContext();
+    Type * intType = &MakeInt(types, 4, true)->type;
+    Type * charType = &MakeChar(types)->type;
+
+    DefinitionContext * global = CreateDefinitionContext(nullptr, GLOBAL_SCOPE);
+    DefinitionContext * function = CreateDefinitionContext(global, FUNCTION_SCOPE);
+    DefinitionContext * block = CreateDefinitionContext(function, BLOCK_SCOPE);
+
+    // Inner scopes shadow outer ones, namespaces are apart.
+    Definition * x = NewObjectDefinition(global, "x", intType, GLOBAL_OBJECT);
+    Definition * blockX = NewObjectDefinition(block, "x", charType, LOCAL_OBJECT);
+    Definition * tagX = NewTypeTagDefinition(global, "x", nullptr);
+    EXPECT_EQ(LookupDefinition(block, "x", ID_NAMESPACE, true), blockX);
+    EXPECT_EQ(LookupDefinition(function, "x", ID_NAMESPACE, true), x);
+    EXPECT_EQ(LookupDefinition(function, "x", ID_NAMESPACE, false), nullptr);
+    EXPECT_EQ(LookupDefinition(block, "x", TAG_NAMESPACE, true), tagX);
+
+    // Redeclarations merge into the one definition in place.
+    NewFunctionDefinition(global, "f", intType, IMPORT_FUNCTION);
+    Definition * f = NewFunctionDefinition(global, "f", intType, PUBLIC_FUNCTION);
+    Definition * tag = NewTypeTagDefinition(global, "x", intType);
+    EXPECT_EQ(LookupDefinition(block, "f", ID_NAMESPACE, true), f);
+    EXPECT_EQ(AsFunctionDefinition(f)->funcStorageType, PUBLIC_FUNCTION);
+    EXPECT_EQ(LookupDefinition(block, "x", TAG_NAMESPACE, true), tag);
+    EXPECT_EQ(AsTypeTagDefinition(tag)->taggedType, intType);
+    EXPECT_EQ(global->definitions[ID_NAMESPACE].size(), 2u);
+    EXPECT_EQ(global->definitions[TAG_NAMESPACE].size(), 1u);
+
+    // Definitions appended after lookups, past several table growths, are
+    // indexed by the next lookup, in the scope and its parents.
+    std::vector<std::string> names;
+    for (int i = 0; i < 200; ++i)
+        names.push_back("v" + std::to_string(i));
+    for (int i = 0; i < 200; ++i)
+    {
+        ObjectDefinition * definition = new ObjectDefinition;
+        definition->def.name = StringRef(names[i].data(), names[i].size());
+        definition->def.type = OBJECT_DEFINITION;
+        definition->objType = intType;
+        definition->objStorageType = LOCAL_OBJECT;
+        definition->objValue = nullptr;
+        (i % 2 ? block : global)->definitions[ID_NAMESPACE].push_back(&definition->def);
+        if (i % 50 == 0)
+            EXPECT_EQ(LookupDefinition(block, "x", ID_NAMESPACE, true), blockX);
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        Definition * definition = LookupDefinition(block, StringRef(names[i].data(), names[i].size()), ID_NAMESPACE, true);
+        EXPECT_TRUE(definition && definition->name == StringRef(names[i].data(), names[i].size()));
+        EXPECT_EQ(LookupDefinition(function, StringRef(names[i].data(), names[i].size()), ID_NAMESPACE, true) != nullptr, i % 2 == 0);
+    }
+
+    // Missed lookups don't intern the name.
+    EXPECT_EQ(LookupDefinition(block, "DefinitionContext_Missing", ID_NAMESPACE, true), nullptr);
+    EXPECT_EQ(FindName("DefinitionContext_Missing"), NO_NAME_ATOM);
+    EXPECT_NE(FindName("v199"), NO_NAME_ATOM);
+}
+
+#endif
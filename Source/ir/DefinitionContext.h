@@ -108,6 +108,20 @@ Definition * NewTypeAliasDefinition(DefinitionContext * context,
                                     StringRef name,
                                     Type * aliasedType);
 
+// Names
+
+// Same atom for the same text, for the life of the process, safe to use
+// from concurrent compiles. Names of definitions are interned, looked up
+// names are not.
+typedef UINT32 NameAtom;
+
+const NameAtom NO_NAME_ATOM = 0xFFFFFFFF;
+
+NameAtom    InternName(StringRef name);
+// NO_NAME_ATOM if name isn't interned, without adding it.
+NameAtom    FindName(StringRef name);
+StringRef   NameOfAtom(NameAtom atom);
+
 // Manage
 
 enum DefinitionContextScope
@@ -122,6 +136,25 @@ enum DefinitionContextNamespace
     TAG_NAMESPACE,
     LABEL_NAMESPACE,
 };
+// Index of a scope's definitions: (atom, namespace) -> position in
+// definitions[namespace], open addressing with linear probing. Definitions
+// appended to the vectors are indexed on the next lookup.
+struct DefinitionTable
+{
+    struct Slot
+    {
+        NameAtom    atom;   // NO_NAME_ATOM: empty
+        UINT32      ns;
+        UINT32      index;
+    };
+
+    DefinitionTable() : count(0), indexed{ 0, 0, 0 } {}
+
+    std::vector<Slot>   slots;          // power of 2, at most 3/4 full
+    size_t              count;
+    size_t              indexed[3];     // by namespace
+};
+
 struct DefinitionContext
 {
     DefinitionContext *         parent;
@@ -130,6 +163,7 @@ struct DefinitionContext
     DefinitionContextScope      scope;
 
     std::map<DefinitionContextNamespace, std::vector<Definition *>> definitions;
+    DefinitionTable             table;
 };
 
 // To create root, set parent == nullptr.
@@ -139,6 +173,7 @@ DefinitionContext * CreateDefinitionContext(DefinitionContext * parent,
 // Query
 
 // searchParent only used for non-label definitions.
+// One hash probe per scope, the name is hashed once.
 Definition * LookupDefinition(DefinitionContext * currentContext,
                               StringRef name,
                               DefinitionContextNamespace ns,
@@ -268,7 +268,7 @@ Location GetArgumentLocation(FunctionType * functionType,
 
     while (true)
     {
-        ASSERT(functionType->memberType[argumentIndex]);
+        ASSERT(argumentIndex < functionType->memberCount);
         if (argumentName == functionType->memberName[argumentIndex])
             break;
         else
@@ -377,11 +377,23 @@ Node * ConstantExpression(FunctionContext * context, size_t value)
 
     return node;
 }
+Node * ConstantExpression(FunctionContext * context, IntType * type, u64 value)
+{
+    ASSERT(type->type.size == 8 || value <= 0xFFFFFFFFull);
+
+    Node * node = MakeNode(EXPR_DATA);
+    node->expr.type = &type->type;
+    node->expr.loc.type = INLINE;
+    node->expr.loc.inlineValue = value;
+
+    return node;
+}
 Node * ConstantExpression(FunctionContext * context, float value)
 {
     Node * node = MakeNode(EXPR_DATA);
     node->expr.type = &MakeFloat(context->typeContext)->type;;
     node->expr.loc = LocateFloat(context->constantContext, value);
+    context->floatConstants.push_back(value);
 
     return node;
 }
@@ -389,13 +401,12 @@ Node * ConstantExpression(FunctionContext * context, StringRef value)
 {
     Node * node = MakeNode(EXPR_DATA);
 
-    PointerType * pointer = MakePointer(context->typeContext);
-    pointer->target = &MakeChar(context->typeContext)->type;
-    node->expr.type = &pointer->type;
+    node->expr.type = &MakePointer(context->typeContext, &MakeChar(context->typeContext)->type)->type;
 
     Location stringLocation;
     Location stringPointerLocation;
     LocateString(context->constantContext, value, &stringLocation, &stringPointerLocation);
+    context->stringConstants.push_back(value);
 
     node->expr.loc = stringPointerLocation;
 
@@ -563,15 +574,15 @@ Node * CallExpression(FunctionContext * context,
     node->expr.loc = GetReturnValueLocation(functionType->target);
 
     AddChild(node, pointerToFunction);
-    Type ** paramTypeIter = functionType->memberType;
+    size_t paramIndex = 0;
     for (Node * argument : arguments)
     {
-        if (*paramTypeIter)
+        if (paramIndex < functionType->memberCount)
         {
             AddChild(node,
                      WrapCastNode(
                          WrapCastNode(argument, DecayType(context->typeContext, argument->expr.type)),
-                         *paramTypeIter));
+                         functionType->memberType[paramIndex]));
         }
         else
         {
@@ -584,7 +595,7 @@ Node * CallExpression(FunctionContext * context,
                          promoType));
         }
 
-        ++paramTypeIter;
+        ++paramIndex;
     }
 
     ASSERT(CheckCallExpression(node));
@@ -627,8 +638,8 @@ Node * IndirectExpression(FunctionContext * context, Node * expr)
     ASSERT(IsPointer(expr->expr.type));
 
     Type * type = CloneType(context->typeContext, AsPointer(expr->expr.type)->target);
-    TypeSetAssignable(type);
-    TypeSetAddressable(type);
+    type = TypeSetAssignable(context->typeContext, type);
+    type = TypeSetAddressable(context->typeContext, type);
 
     Node * node = MakeNode(EXPR_PIND);
     node->expr.type = type;
@@ -134,6 +134,10 @@ struct FunctionContext
     // Build stmt & expr tree
 
     Node * functionBody;
+    // Constants located for the body, in order, to locate again when a
+    // later compile reuses the body.
+    std::vector<float>      floatConstants;
+    std::vector<StringRef>  stringConstants;
 
     // Build definition tree
 
@@ -181,6 +185,7 @@ Node * EmptyExpression(FunctionContext * context);
 Node * IdExpression(FunctionContext * context, StringRef id);
 Node * ConstantExpression(FunctionContext * context, int value);
 Node * ConstantExpression(FunctionContext * context, size_t value);
+Node * ConstantExpression(FunctionContext * context, IntType * type, u64 value);
 Node * ConstantExpression(FunctionContext * context, float value);
 Node * ConstantExpression(FunctionContext * context, StringRef value);
 
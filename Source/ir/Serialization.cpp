@@ -0,0 +1,1031 @@
+#include "Serialization.h"
+
+#include "../Base/BinaryImage.h"
+
+namespace Language {
+
+namespace {
+
+const UINT32 IR_IMAGE_MAGIC = 0x20205249; // "IR  "
+const UINT32 IR_IMAGE_VERSION = 4;
+
+// Records start with a kind tag and 4 bytes padding, references point at
+// the tag and are checked to refer to the kind expected. Fields in order
+// after the tag, references 4 bytes:
+//
+// Unit:                function count, type context, constant context,
+//                      global definition context, function contexts...
+// TypeContext:         type count, pointer/array/function id counts,
+//                      nextTypeBaseId, id map entries, types...
+// Type:                name, prop, size, align, baseId, canonical, then by name
+//   INT                isSigned
+//   ARRAY              length, target
+//   POINTER            target
+//   FUNCTION           target, isVarList, count, (name, type)...
+//   ENUM               count, (name, value)...
+//   STRUCT             count, (offset, name, type)...
+//   UNION              count, (name, type)...
+// ConstantContext:     nextStringLabel, string/float counts,
+//                      (hash, label, stringLabel, value)..., (hash, label, value)...
+// Definition:          type, name, type/storage or value
+// DefinitionContext:   scope, parent, next, firstChild, ID/TAG/LABEL counts,
+//                      definitions...
+// Node:                type, down, right, up, then
+//   statement          context (compound), caseValue (case)
+//   expression         type, location
+// FunctionContext:     nextUniqueLabel, name, contexts, functionType, body,
+//                      label/target/switch/float/string counts,
+//                      (node, count, labels...)..., (node, target, index)...,
+//                      (node, count, children...)..., floats..., strings...
+
+enum RecordKind : UINT32
+{
+    RECORD_UNIT                 = 0x54494E55, // "UNIT"
+    RECORD_TYPE_CONTEXT         = 0x58435954, // "TYCX"
+    RECORD_CONSTANT_CONTEXT     = 0x58434E43, // "CNCX"
+    RECORD_DEFINITION_CONTEXT   = 0x58434644, // "DFCX"
+    RECORD_FUNCTION_CONTEXT     = 0x58434E46, // "FNCX"
+    RECORD_TYPE                 = 0x45505954, // "TYPE"
+    RECORD_DEFINITION           = 0x4E464544, // "DEFN"
+    RECORD_NODE                 = 0x45444F4E, // "NODE"
+};
+
+const size_t RECORD_TAG_SIZE = 8;
+const size_t TYPE_HEADER_SIZE = 40;
+const size_t DEFINITION_SIZE = 16;
+const size_t NODE_SIZE = 32;
+
+bool IsStatementNode(NodeType type)
+{
+    return BEGIN_STATEMENT < type && type < END_STATEMENT;
+}
+
+bool IsExpressionNode(NodeType type)
+{
+    return (BEGIN_EXPRESSION < type && type < END_EXPRESSION) || type == EMPTY_EXPRESSION;
+}
+
+size_t MemberCount(Type * type)
+{
+    switch (type->name)
+    {
+        case FUNCTION:  return AsFunction(type)->memberCount;
+        case ENUM:      return AsEnum(type)->memberCount;
+        case STRUCT:    return AsStruct(type)->memberCount;
+        case UNION:     return AsUnion(type)->memberCount;
+        default:        return 0;
+    }
+}
+
+// Sequential fields of a record being written.
+class RecordOut
+{
+public:
+    RecordOut(ImageWriter & image, UINT32 offset, size_t size)
+        : image(image), at(offset), end(offset + static_cast<UINT32>(size)) {}
+    ~RecordOut() { ASSERT(at == end); }
+
+    template <typename T>
+    void Put(T value)
+    {
+        image.Put<T>(at, value);
+        at += sizeof(T);
+    }
+    void Ref(UINT32 target)
+    {
+        image.PutRef(at, target);
+        at += 4;
+    }
+    void Skip(size_t size) { at += static_cast<UINT32>(size); }
+
+private:
+    ImageWriter &   image;
+    UINT32          at;
+    UINT32          end;
+};
+
+// Sequential fields of a record being loaded.
+class RecordIn
+{
+public:
+    RecordIn(const ImageReader & image, UINT32 offset) : image(image), at(offset) {}
+
+    template <typename T>
+    T Get()
+    {
+        at += sizeof(T);
+        return image.Get<T>(at - sizeof(T));
+    }
+    // Offset of the reference field.
+    UINT32 Ref()
+    {
+        at += 4;
+        return at - 4;
+    }
+    void Skip(size_t size) { at += static_cast<UINT32>(size); }
+    // Count of elementSize items that can fit in the image.
+    size_t Count(size_t elementSize)
+    {
+        UINT32 count = Get<UINT32>();
+        if (count * elementSize > image.Size())
+            throw std::invalid_argument("bad count in IR image");
+        return count;
+    }
+
+private:
+    const ImageReader & image;
+    UINT32              at;
+};
+
+void CheckImage(bool valid)
+{
+    if (!valid)
+        throw std::invalid_argument("bad record in IR image");
+}
+
+class IRImageWriter
+{
+public:
+    IRImageWriter() : image(IR_IMAGE_MAGIC, IR_IMAGE_VERSION) {}
+
+    UINT32 Ref(Type * type)                 { return type ? Record(type, RECORD_TYPE, TypeSize(type)) : 0; }
+    UINT32 Ref(Definition * definition)     { return definition ? Record(definition, RECORD_DEFINITION, DEFINITION_SIZE) : 0; }
+    UINT32 Ref(DefinitionContext * context) { return context ? Record(context, RECORD_DEFINITION_CONTEXT, DefinitionContextSize(context)) : 0; }
+    UINT32 Ref(Node * node)                 { return node ? Record(node, RECORD_NODE, NODE_SIZE) : 0; }
+    UINT32 Ref(TypeContext * context)       { return context ? Record(context, RECORD_TYPE_CONTEXT, TypeContextSize(context)) : 0; }
+    UINT32 Ref(ConstantContext * context)   { return context ? Record(context, RECORD_CONSTANT_CONTEXT, ConstantContextSize(context)) : 0; }
+    UINT32 Ref(FunctionContext * context)   { return context ? Record(context, RECORD_FUNCTION_CONTEXT, FunctionContextSize(context)) : 0; }
+    UINT32 Ref(StringRef s)                 { return image.PutString(s); }
+
+    // Tagged record of size bytes after the tag.
+    UINT32 Allocate(RecordKind kind, size_t size)
+    {
+        UINT32 offset = image.Allocate(RECORD_TAG_SIZE + size);
+        image.Put<UINT32>(offset, kind);
+        return offset;
+    }
+
+    ImageWriter image;
+
+private:
+    // Record of object, allocated and queued to be filled on first reference.
+    template <typename T>
+    UINT32 Record(T * object, RecordKind kind, size_t size)
+    {
+        UINT32 offset = image.Find(object);
+        if (offset == 0)
+        {
+            offset = Allocate(kind, size);
+            image.Bind(object, offset);
+            image.Defer([this, object, offset, size]() {
+                Fill(object, RecordOut(image, offset + RECORD_TAG_SIZE, size));
+            });
+        }
+        return offset;
+    }
+
+    static size_t TypeSize(Type * type);
+    static size_t DefinitionContextSize(DefinitionContext * context);
+    static size_t TypeContextSize(TypeContext * context);
+    static size_t ConstantContextSize(ConstantContext * context);
+    static size_t FunctionContextSize(FunctionContext * context);
+
+    void Fill(Type * type, RecordOut && out);
+    void Fill(Definition * definition, RecordOut && out);
+    void Fill(DefinitionContext * context, RecordOut && out);
+    void Fill(Node * node, RecordOut && out);
+    void Fill(TypeContext * context, RecordOut && out);
+    void Fill(ConstantContext * context, RecordOut && out);
+    void Fill(FunctionContext * context, RecordOut && out);
+};
+
+size_t IRImageWriter::TypeSize(Type * type)
+{
+    size_t count = MemberCount(type);
+    switch (type->name)
+    {
+        case INT:       return TYPE_HEADER_SIZE + 4;
+        case ARRAY:     return TYPE_HEADER_SIZE + 12;
+        case POINTER:   return TYPE_HEADER_SIZE + 4;
+        case FUNCTION:  return TYPE_HEADER_SIZE + 12 + 8 * count;
+        case ENUM:      return TYPE_HEADER_SIZE + 4 + 8 * count;
+        case STRUCT:    return TYPE_HEADER_SIZE + 8 + 16 * count;
+        case UNION:     return TYPE_HEADER_SIZE + 4 + 8 * count;
+        default:        return TYPE_HEADER_SIZE;
+    }
+}
+
+size_t IRImageWriter::DefinitionContextSize(DefinitionContext * context)
+{
+    size_t size = 28;
+    for (auto & definitions : context->definitions)
+        size += 4 * definitions.second.size();
+    return size;
+}
+
+size_t IRImageWriter::TypeContextSize(TypeContext * context)
+{
+    return 24 +
+        16 * context->existingPointTypeIdMap.size() +
+        24 * context->existingArrayTypeIdMap.size() +
+        16 * context->existingFunctionTypeIdMap.size() +
+        4 * context->types.size();
+}
+
+size_t IRImageWriter::ConstantContextSize(ConstantContext * context)
+{
+    return 12 +
+        16 * context->hashToStringConstant.size() +
+        12 * context->hashToFloatConstant.size();
+}
+
+size_t IRImageWriter::FunctionContextSize(FunctionContext * context)
+{
+    size_t size = 48 + 12 * context->nodeToTarget.size() +
+        4 * context->floatConstants.size() +
+        4 * context->stringConstants.size();
+    for (auto & labels : context->targetToLabels)
+        size += 8 + 4 * labels.second.size();
+    for (auto & children : context->switchToChildren)
+        size += 8 + 4 * children.second.size();
+    return size;
+}
+
+void IRImageWriter::Fill(Type * type, RecordOut && out)
+{
+    out.Put<UINT32>(type->name);
+    out.Put<int>(type->prop);
+    out.Put<UINT64>(type->size);
+    out.Put<UINT64>(type->align);
+    out.Put<UINT64>(type->baseId);
+    out.Ref(Ref(type->canonical));
+    out.Skip(4);
+
+    size_t count = MemberCount(type);
+    switch (type->name)
+    {
+        case INT:
+            out.Put<UINT32>(AsInt(type)->isSigned);
+            break;
+        case ARRAY:
+            out.Put<UINT64>(AsArray(type)->length);
+            out.Ref(Ref(AsArray(type)->target));
+            break;
+        case POINTER:
+            out.Ref(Ref(AsPointer(type)->target));
+            break;
+        case FUNCTION:
+            out.Ref(Ref(AsFunction(type)->target));
+            out.Put<UINT32>(AsFunction(type)->isVarList);
+            out.Put<UINT32>(static_cast<UINT32>(count));
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.Ref(Ref(AsFunction(type)->memberName[i]));
+                out.Ref(Ref(AsFunction(type)->memberType[i]));
+            }
+            break;
+        case ENUM:
+            out.Put<UINT32>(static_cast<UINT32>(count));
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.Ref(Ref(AsEnum(type)->memberName[i]));
+                out.Put<int>(AsEnum(type)->memberValue[i]);
+            }
+            break;
+        case STRUCT:
+            out.Put<UINT32>(static_cast<UINT32>(count));
+            out.Skip(4);
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.Put<UINT64>(AsStruct(type)->memberOffset[i]);
+                out.Ref(Ref(AsStruct(type)->memberName[i]));
+                out.Ref(Ref(AsStruct(type)->memberType[i]));
+            }
+            break;
+        case UNION:
+            out.Put<UINT32>(static_cast<UINT32>(count));
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.Ref(Ref(AsUnion(type)->memberName[i]));
+                out.Ref(Ref(AsUnion(type)->memberType[i]));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void IRImageWriter::Fill(Definition * definition, RecordOut && out)
+{
+    out.Put<UINT32>(definition->type);
+    out.Ref(Ref(definition->name));
+    switch (definition->type)
+    {
+        case OBJECT_DEFINITION:
+            ASSERT(AsObjectDefinition(definition)->objValue == nullptr);
+            out.Ref(Ref(AsObjectDefinition(definition)->objType));
+            out.Put<UINT32>(AsObjectDefinition(definition)->objStorageType);
+            break;
+        case FUNCTION_DEFINITION:
+            out.Ref(Ref(AsFunctionDefinition(definition)->funcType));
+            out.Put<UINT32>(AsFunctionDefinition(definition)->funcStorageType);
+            break;
+        case ENUM_CONST_DEFINITION:
+            out.Ref(Ref(AsEnumConstDefinition(definition)->enumConstType));
+            out.Put<int>(AsEnumConstDefinition(definition)->enumConstValue);
+            break;
+        case TYPE_TAG_DEFINITION:
+            out.Ref(Ref(AsTypeTagDefinition(definition)->taggedType));
+            out.Skip(4);
+            break;
+        case TYPE_ALIAS_DEFINITION:
+            out.Ref(Ref(AsTypeAliasDefinition(definition)->aliasedType));
+            out.Skip(4);
+            break;
+    }
+}
+
+void IRImageWriter::Fill(DefinitionContext * context, RecordOut && out)
+{
+    out.Put<UINT32>(context->scope);
+    out.Ref(Ref(context->parent));
+    out.Ref(Ref(context->next));
+    out.Ref(Ref(context->firstChild));
+
+    DefinitionContextNamespace namespaces[] = { ID_NAMESPACE, TAG_NAMESPACE, LABEL_NAMESPACE };
+    for (DefinitionContextNamespace ns : namespaces)
+    {
+        auto it = context->definitions.find(ns);
+        out.Put<UINT32>(it != context->definitions.end() ? static_cast<UINT32>(it->second.size()) : 0);
+    }
+    for (DefinitionContextNamespace ns : namespaces)
+    {
+        auto it = context->definitions.find(ns);
+        if (it != context->definitions.end())
+        {
+            for (Definition * definition : it->second)
+                out.Ref(Ref(definition));
+        }
+    }
+}
+
+void IRImageWriter::Fill(Node * node, RecordOut && out)
+{
+    out.Put<UINT32>(node->type);
+    out.Ref(Ref(node->down));
+    out.Ref(Ref(node->right));
+    out.Ref(Ref(node->up));
+
+    if (IsStatementNode(node->type))
+    {
+        out.Ref(node->type == STMT_COMPOUND ? Ref(node->stmt.context) : 0);
+        out.Skip(4);
+        out.Put<UINT64>(node->type == STMT_CASE ? node->stmt.caseValue : 0);
+    }
+    else if (IsExpressionNode(node->type))
+    {
+        const Location & loc = node->expr.loc;
+        out.Ref(Ref(node->expr.type));
+        out.Put<UINT32>(loc.type);
+        if (loc.type == LABEL)
+        {
+            out.Ref(Ref(*loc.labelValue));
+            out.Skip(4);
+        }
+        else if (loc.type == SEARCH_LOCAL_DEFINITION_TABLE)
+        {
+            out.Ref(Ref(loc.definitionValue));
+            out.Skip(4);
+        }
+        else if (loc.type == REGISTER || loc.type == REGISTER_INDIRECT)
+        {
+            out.Put<UINT64>(loc.registerType);
+        }
+        else
+        {
+            // Offset or inline value, same bits.
+            out.Put<UINT64>(loc.inlineValue);
+        }
+    }
+    else
+    {
+        out.Skip(NODE_SIZE - 16);
+    }
+}
+
+void IRImageWriter::Fill(TypeContext * context, RecordOut && out)
+{
+    out.Put<UINT32>(static_cast<UINT32>(context->types.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->existingPointTypeIdMap.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->existingArrayTypeIdMap.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->existingFunctionTypeIdMap.size()));
+    out.Put<UINT64>(context->nextTypeBaseId);
+    for (auto & id : context->existingPointTypeIdMap)
+    {
+        out.Put<UINT64>(id.first);
+        out.Put<UINT64>(id.second);
+    }
+    for (auto & id : context->existingArrayTypeIdMap)
+    {
+        out.Put<UINT64>(std::get<0>(id.first));
+        out.Put<UINT64>(std::get<1>(id.first));
+        out.Put<UINT64>(id.second);
+    }
+    for (auto & id : context->existingFunctionTypeIdMap)
+    {
+        out.Put<UINT64>(id.first);
+        out.Put<UINT64>(id.second);
+    }
+    for (Type * type : context->types)
+        out.Ref(Ref(type));
+}
+
+void IRImageWriter::Fill(ConstantContext * context, RecordOut && out)
+{
+    out.Put<int>(context->nextStringLabel);
+    out.Put<UINT32>(static_cast<UINT32>(context->hashToStringConstant.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->hashToFloatConstant.size()));
+    for (auto & constant : context->hashToStringConstant)
+    {
+        out.Put<int>(constant.first);
+        out.Ref(Ref(constant.second.label));
+        out.Ref(Ref(constant.second.stringLabel));
+        out.Ref(Ref(constant.second.stringValue));
+    }
+    for (auto & constant : context->hashToFloatConstant)
+    {
+        out.Put<int>(constant.first);
+        out.Ref(Ref(constant.second.label));
+        out.Put<float>(constant.second.value);
+    }
+}
+
+void IRImageWriter::Fill(FunctionContext * context, RecordOut && out)
+{
+    out.Put<int>(context->nextUniqueLabel);
+    out.Ref(Ref(context->functionName));
+    out.Ref(Ref(context->constantContext));
+    out.Ref(Ref(context->typeContext));
+    out.Ref(Ref(context->functionType ? &context->functionType->type : nullptr));
+    out.Ref(Ref(context->functionDefinitionContext));
+    out.Ref(Ref(context->functionBody));
+    out.Put<UINT32>(static_cast<UINT32>(context->targetToLabels.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->nodeToTarget.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->switchToChildren.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->floatConstants.size()));
+    out.Put<UINT32>(static_cast<UINT32>(context->stringConstants.size()));
+    for (auto & labels : context->targetToLabels)
+    {
+        out.Ref(Ref(labels.first));
+        out.Put<UINT32>(static_cast<UINT32>(labels.second.size()));
+        for (const std::string & label : labels.second)
+            out.Ref(Ref(label));
+    }
+    for (auto & target : context->nodeToTarget)
+    {
+        out.Ref(Ref(target.first));
+        out.Ref(Ref(target.second.first));
+        out.Put<int>(target.second.second);
+    }
+    for (auto & children : context->switchToChildren)
+    {
+        out.Ref(Ref(children.first));
+        out.Put<UINT32>(static_cast<UINT32>(children.second.size()));
+        for (Node * child : children.second)
+            out.Ref(Ref(child));
+    }
+    for (float value : context->floatConstants)
+        out.Put<float>(value);
+    for (StringRef value : context->stringConstants)
+        out.Ref(Ref(value));
+}
+
+class IRImageLoader
+{
+public:
+    IRImageLoader(const char * data, size_t size) : image(data, size, IR_IMAGE_MAGIC, IR_IMAGE_VERSION) {}
+    // Frees what was loaded unless released.
+    ~IRImageLoader()
+    {
+        for (auto & destroy : created)
+            destroy();
+    }
+
+    // Objects referred to by the reference field.
+    Type *              LoadType(UINT32 field)      { return Object<Type>(field, RECORD_TYPE, &IRImageLoader::NewType); }
+    Definition *        LoadDefinition(UINT32 field){ return Object<Definition>(field, RECORD_DEFINITION, &IRImageLoader::NewDefinition); }
+    DefinitionContext * LoadDefinitionContext(UINT32 field) { return Object<DefinitionContext>(field, RECORD_DEFINITION_CONTEXT, &IRImageLoader::New<DefinitionContext>); }
+    Node *              LoadNode(UINT32 field)      { return Object<Node>(field, RECORD_NODE, &IRImageLoader::New<Node>); }
+    TypeContext *       LoadTypeContext(UINT32 field) { return Object<TypeContext>(field, RECORD_TYPE_CONTEXT, &IRImageLoader::New<TypeContext>); }
+    ConstantContext *   LoadConstantContext(UINT32 field) { return Object<ConstantContext>(field, RECORD_CONSTANT_CONTEXT, &IRImageLoader::New<ConstantContext>); }
+    FunctionContext *   LoadFunctionContext(UINT32 field) { return Object<FunctionContext>(field, RECORD_FUNCTION_CONTEXT, &IRImageLoader::New<FunctionContext>); }
+    StringRef           LoadString(UINT32 field)    { return image.GetString(image.GetRef(field)); }
+
+    // Offset of the fields of the record, after checking its kind.
+    UINT32 Fields(UINT32 offset, RecordKind kind)
+    {
+        CheckImage(image.Get<UINT32>(offset) == kind);
+        return offset + RECORD_TAG_SIZE;
+    }
+    // Loaded objects are the caller's.
+    void Release() { created.clear(); }
+
+    ImageReader image;
+
+private:
+    // Object of the record, created and queued to be filled on first reference.
+    template <typename T>
+    T * Object(UINT32 field, RecordKind kind, T * (IRImageLoader::*create)(UINT32 fields))
+    {
+        UINT32 offset = image.GetRef(field);
+        if (offset == 0)
+            return nullptr;
+
+        UINT32 fields = Fields(offset, kind);
+        T * object = static_cast<T *>(image.Find(offset));
+        if (!object)
+        {
+            object = (this->*create)(fields);
+            image.Bind(offset, object);
+            image.Defer([this, object, fields]() { Fill(object, RecordIn(image, fields)); });
+        }
+        return object;
+    }
+
+    // Object deleted with the loader, unless released.
+    template <typename T>
+    T * Own(T * object)
+    {
+        created.push_back([object]() { delete object; });
+        return object;
+    }
+
+    template <typename T>
+    T *             New(UINT32 fields) { return Own(new T()); }
+    Type *          NewType(UINT32 offset);
+    Definition *    NewDefinition(UINT32 offset);
+
+    void Fill(Type * type, RecordIn && in);
+    void Fill(Definition * definition, RecordIn && in);
+    void Fill(DefinitionContext * context, RecordIn && in);
+    void Fill(Node * node, RecordIn && in);
+    void Fill(TypeContext * context, RecordIn && in);
+    void Fill(ConstantContext * context, RecordIn && in);
+    void Fill(FunctionContext * context, RecordIn && in);
+
+    std::vector<std::function<void()>> created;
+};
+
+Type * IRImageLoader::NewType(UINT32 fields)
+{
+    // Member arrays are arena allocated, freed with the arena.
+    switch (image.Get<UINT32>(fields))
+    {
+        case VOID:      return &Own(new VoidType())->type;
+        case BOOL:      return &Own(new BoolType())->type;
+        case CHAR:      return &Own(new CharType())->type;
+        case INT:       return &Own(new IntType())->type;
+        case FLOAT:     return &Own(new FloatType())->type;
+        case ARRAY:     return &Own(new ArrayType())->type;
+        case POINTER:   return &Own(new PointerType())->type;
+        case FUNCTION:  return &Own(new FunctionType())->type;
+        case ENUM:      return &Own(new EnumType())->type;
+        case STRUCT:    return &Own(new StructType())->type;
+        case UNION:     return &Own(new UnionType())->type;
+        default:        CheckImage(false); return nullptr;
+    }
+}
+
+Definition * IRImageLoader::NewDefinition(UINT32 fields)
+{
+    switch (image.Get<UINT32>(fields))
+    {
+        case OBJECT_DEFINITION:     return &Own(new ObjectDefinition())->def;
+        case FUNCTION_DEFINITION:   return &Own(new FunctionDefinition())->def;
+        case ENUM_CONST_DEFINITION: return &Own(new EnumConstDefinition())->def;
+        case TYPE_TAG_DEFINITION:   return &Own(new TypeTagDefinition())->def;
+        case TYPE_ALIAS_DEFINITION: return &Own(new TypeAliasDefinition())->def;
+        default:                    CheckImage(false); return nullptr;
+    }
+}
+
+void IRImageLoader::Fill(Type * type, RecordIn && in)
+{
+    type->name = static_cast<TypeName>(in.Get<UINT32>());
+    type->prop = in.Get<int>();
+    type->size = in.Get<UINT64>();
+    type->align = in.Get<UINT64>();
+    type->baseId = in.Get<UINT64>();
+    type->canonical = LoadType(in.Ref());
+    in.Skip(4);
+
+    switch (type->name)
+    {
+        case INT:
+            AsInt(type)->isSigned = in.Get<UINT32>() != 0;
+            break;
+        case ARRAY:
+            AsArray(type)->length = in.Get<UINT64>();
+            AsArray(type)->target = LoadType(in.Ref());
+            break;
+        case POINTER:
+            AsPointer(type)->target = LoadType(in.Ref());
+            break;
+        case FUNCTION:
+        {
+            FunctionType * function = AsFunction(type);
+            function->target = LoadType(in.Ref());
+            function->isVarList = in.Get<UINT32>() != 0;
+            size_t count = in.Count(8);
+            TypeSetMemberCount(type, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                function->memberName[i] = LoadString(in.Ref());
+                function->memberType[i] = LoadType(in.Ref());
+                CheckImage(function->memberType[i] != nullptr);
+            }
+            break;
+        }
+        case ENUM:
+        {
+            EnumType * enumType = AsEnum(type);
+            size_t count = in.Count(8);
+            TypeSetMemberCount(type, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                enumType->memberName[i] = LoadString(in.Ref());
+                enumType->memberValue[i] = in.Get<int>();
+            }
+            break;
+        }
+        case STRUCT:
+        {
+            StructType * structType = AsStruct(type);
+            size_t count = in.Count(16);
+            TypeSetMemberCount(type, count);
+            in.Skip(4);
+            for (size_t i = 0; i < count; ++i)
+            {
+                structType->memberOffset[i] = in.Get<UINT64>();
+                structType->memberName[i] = LoadString(in.Ref());
+                structType->memberType[i] = LoadType(in.Ref());
+            }
+            break;
+        }
+        case UNION:
+        {
+            UnionType * unionType = AsUnion(type);
+            size_t count = in.Count(8);
+            TypeSetMemberCount(type, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                unionType->memberName[i] = LoadString(in.Ref());
+                unionType->memberType[i] = LoadType(in.Ref());
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void IRImageLoader::Fill(Definition * definition, RecordIn && in)
+{
+    definition->type = static_cast<DefinitionType>(in.Get<UINT32>());
+    definition->name = LoadString(in.Ref());
+    switch (definition->type)
+    {
+        case OBJECT_DEFINITION:
+            AsObjectDefinition(definition)->objType = LoadType(in.Ref());
+            AsObjectDefinition(definition)->objStorageType = static_cast<ObjectStorageType>(in.Get<UINT32>());
+            AsObjectDefinition(definition)->objValue = nullptr;
+            break;
+        case FUNCTION_DEFINITION:
+            AsFunctionDefinition(definition)->funcType = LoadType(in.Ref());
+            AsFunctionDefinition(definition)->funcStorageType = static_cast<FunctionStorageType>(in.Get<UINT32>());
+            break;
+        case ENUM_CONST_DEFINITION:
+            AsEnumConstDefinition(definition)->enumConstType = LoadType(in.Ref());
+            AsEnumConstDefinition(definition)->enumConstValue = in.Get<int>();
+            break;
+        case TYPE_TAG_DEFINITION:
+            AsTypeTagDefinition(definition)->taggedType = LoadType(in.Ref());
+            break;
+        case TYPE_ALIAS_DEFINITION:
+            AsTypeAliasDefinition(definition)->aliasedType = LoadType(in.Ref());
+            break;
+    }
+}
+
+void IRImageLoader::Fill(DefinitionContext * context, RecordIn && in)
+{
+    context->scope = static_cast<DefinitionContextScope>(in.Get<UINT32>());
+    context->parent = LoadDefinitionContext(in.Ref());
+    context->next = LoadDefinitionContext(in.Ref());
+    context->firstChild = LoadDefinitionContext(in.Ref());
+
+    DefinitionContextNamespace namespaces[] = { ID_NAMESPACE, TAG_NAMESPACE, LABEL_NAMESPACE };
+    size_t counts[3];
+    for (size_t & count : counts)
+        count = in.Count(4);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < counts[i]; ++j)
+            context->definitions[namespaces[i]].push_back(LoadDefinition(in.Ref()));
+    }
+}
+
+void IRImageLoader::Fill(Node * node, RecordIn && in)
+{
+    node->type = static_cast<NodeType>(in.Get<UINT32>());
+    CheckImage(node->type <= EMPTY_EXPRESSION);
+    node->down = LoadNode(in.Ref());
+    node->right = LoadNode(in.Ref());
+    node->up = LoadNode(in.Ref());
+
+    if (IsStatementNode(node->type))
+    {
+        DefinitionContext * context = LoadDefinitionContext(in.Ref());
+        in.Skip(4);
+        UINT64 caseValue = in.Get<UINT64>();
+        if (node->type == STMT_CASE)
+            node->stmt.caseValue = caseValue;
+        else
+            node->stmt.context = context;
+    }
+    else if (IsExpressionNode(node->type))
+    {
+        Location & loc = node->expr.loc;
+        node->expr.type = LoadType(in.Ref());
+        loc.type = static_cast<LocationType>(in.Get<UINT32>());
+        CheckImage(loc.type <= NEED_ALLOC);
+        if (loc.type == LABEL)
+            loc.labelValue = Own(new StringRef(LoadString(in.Ref())));
+        else if (loc.type == SEARCH_LOCAL_DEFINITION_TABLE)
+            loc.definitionValue = LoadDefinition(in.Ref());
+        else if (loc.type == REGISTER || loc.type == REGISTER_INDIRECT)
+            loc.registerType = static_cast<RegisterType>(in.Get<UINT64>());
+        else
+            loc.inlineValue = in.Get<UINT64>();
+    }
+}
+
+void IRImageLoader::Fill(TypeContext * context, RecordIn && in)
+{
+    size_t typeCount = in.Count(4);
+    size_t pointerIdCount = in.Count(16);
+    size_t arrayIdCount = in.Count(24);
+    size_t functionIdCount = in.Count(16);
+    context->nextTypeBaseId = in.Get<UINT64>();
+    for (size_t i = 0; i < pointerIdCount; ++i)
+    {
+        UINT64 target = in.Get<UINT64>();
+        context->existingPointTypeIdMap[target] = in.Get<UINT64>();
+    }
+    for (size_t i = 0; i < arrayIdCount; ++i)
+    {
+        UINT64 target = in.Get<UINT64>();
+        UINT64 length = in.Get<UINT64>();
+        context->existingArrayTypeIdMap[std::make_tuple(target, length)] = in.Get<UINT64>();
+    }
+    for (size_t i = 0; i < functionIdCount; ++i)
+    {
+        UINT64 protocol = in.Get<UINT64>();
+        context->existingFunctionTypeIdMap[protocol] = in.Get<UINT64>();
+    }
+    context->types.reserve(typeCount);
+    for (size_t i = 0; i < typeCount; ++i)
+    {
+        context->types.push_back(LoadType(in.Ref()));
+        CheckImage(context->types.back() != nullptr);
+    }
+}
+
+void IRImageLoader::Fill(ConstantContext * context, RecordIn && in)
+{
+    context->nextStringLabel = in.Get<int>();
+    size_t stringCount = in.Count(16);
+    size_t floatCount = in.Count(12);
+    for (size_t i = 0; i < stringCount; ++i)
+    {
+        ConstantContext::StringConstant & constant = context->hashToStringConstant[in.Get<int>()];
+        constant.label = LoadString(in.Ref());
+        constant.stringLabel = LoadString(in.Ref());
+        constant.stringValue = LoadString(in.Ref());
+    }
+    for (size_t i = 0; i < floatCount; ++i)
+    {
+        ConstantContext::FloatConstant & constant = context->hashToFloatConstant[in.Get<int>()];
+        constant.label = LoadString(in.Ref());
+        constant.value = in.Get<float>();
+    }
+}
+
+void IRImageLoader::Fill(FunctionContext * context, RecordIn && in)
+{
+    context->nextUniqueLabel = in.Get<int>();
+    context->functionName = LoadString(in.Ref()).toString();
+    context->constantContext = LoadConstantContext(in.Ref());
+    context->typeContext = LoadTypeContext(in.Ref());
+    // Filled later, check the type name in the record.
+    UINT32 functionType = in.Ref();
+    context->functionType = reinterpret_cast<FunctionType *>(LoadType(functionType));
+    CheckImage(!context->functionType || image.Get<UINT32>(Fields(image.GetRef(functionType), RECORD_TYPE)) == FUNCTION);
+    context->functionDefinitionContext = LoadDefinitionContext(in.Ref());
+    context->functionBody = LoadNode(in.Ref());
+
+    size_t labelsCount = in.Count(8);
+    size_t targetCount = in.Count(12);
+    size_t switchCount = in.Count(8);
+    size_t floatCount = in.Count(4);
+    size_t stringCount = in.Count(4);
+    for (size_t i = 0; i < labelsCount; ++i)
+    {
+        std::vector<std::string> & labels = context->targetToLabels[LoadNode(in.Ref())];
+        labels.resize(in.Count(4));
+        for (std::string & label : labels)
+            label = LoadString(in.Ref()).toString();
+    }
+    for (size_t i = 0; i < targetCount; ++i)
+    {
+        Node * node = LoadNode(in.Ref());
+        Node * target = LoadNode(in.Ref());
+        context->nodeToTarget[node] = { target, in.Get<int>() };
+    }
+    for (size_t i = 0; i < switchCount; ++i)
+    {
+        std::vector<Node *> & children = context->switchToChildren[LoadNode(in.Ref())];
+        children.resize(in.Count(4));
+        for (Node * & child : children)
+            child = LoadNode(in.Ref());
+    }
+    context->floatConstants.resize(floatCount);
+    for (float & value : context->floatConstants)
+        value = in.Get<float>();
+    context->stringConstants.resize(stringCount);
+    for (StringRef & value : context->stringConstants)
+        value = LoadString(in.Ref());
+}
+
+}
+
+std::string SaveIR(const IRUnit & unit)
+{
+    IRImageWriter writer;
+    size_t size = 16 + 4 * unit.functionContexts.size();
+    UINT32 root = writer.Allocate(RECORD_UNIT, size);
+    RecordOut out(writer.image, root + RECORD_TAG_SIZE, size);
+    out.Put<UINT32>(static_cast<UINT32>(unit.functionContexts.size()));
+    out.Ref(writer.Ref(unit.typeContext));
+    out.Ref(writer.Ref(unit.constantContext));
+    out.Ref(writer.Ref(unit.globalDefinitionContext));
+    for (FunctionContext * functionContext : unit.functionContexts)
+        out.Ref(writer.Ref(functionContext));
+    return writer.image.Finish(root);
+}
+
+IRUnit LoadIR(const char * image, size_t size)
+{
+    // Objects loaded before a bad record are freed with the loader.
+    IRImageLoader loader(image, size);
+    RecordIn in(loader.image, loader.Fields(loader.image.Root(), RECORD_UNIT));
+
+    IRUnit unit;
+    unit.functionContexts.resize(in.Count(4));
+    unit.typeContext = loader.LoadTypeContext(in.Ref());
+    unit.constantContext = loader.LoadConstantContext(in.Ref());
+    unit.globalDefinitionContext = loader.LoadDefinitionContext(in.Ref());
+    for (FunctionContext * & functionContext : unit.functionContexts)
+        functionContext = loader.LoadFunctionContext(in.Ref());
+    loader.image.Flush();
+    if (unit.typeContext)
+    {
+        for (Type * type : unit.typeContext->types)
+        {
+            if (type->prop & TP_INTERNED)
+                unit.typeContext->internedTypes.insert(type);
+        }
+    }
+    loader.Release();
+    return unit;
+}
+
+}
+
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+#include "../Base/File.h"
+#include "../CodeGeneration/AstCompiler.h"
+#include "../CodeGeneration/Translation.h"
+
+static std::string TranslateIR(Language::IRUnit & unit)
+{
+    Language::x64Program program = Language::Translate(unit.globalDefinitionContext,
+                                                       unit.constantContext,
+                                                       unit.functionContexts);
+    return Language::GetProgram(program);
+}
+
+// IR of source, through a temporary file as the preprocessor reads files.
+// Names in the IR point into tokens.
+static Language::IRUnit CompileIR(const char * fileName, const std::string & source, std::vector<Token> & tokens)
+{
+    std::string path = GetTempFilePath(fileName);
+    SetFileContent(path.data(), source);
+    tokens = LexProcess(path.data());
+    RemoveFile(path.data());
+    TokenIterator ti(tokens);
+    AstTree ast = ParseTranslationUnit(ti);
+
+    AstCompileContext * context = CreateAstCompileContext();
+    CompileAst(context, ast.Root());
+    return { context->typeContext, context->constantContext, context->globalDefinitionContext, context->functionContexts };
+}
+
+static const char * kSerializationSource =
+    "int printf(const char * fmt, ...);\n"
+    "enum Color { RED, GREEN = 5, BLUE };\n"
+    "struct Point { int x; char tag; long int z; };\n"
+    "union Value { int i; float f; char c; };\n"
+    "int (*handler)(const char * fmt, ...);\n"
+    "struct Point origin;\n"
+    "float Scale(float f, int n)\n"
+    "{\n"
+    "    return f * 2.5 + n;\n"
+    "}\n"
+    "int Show(struct Point * p, union Value * v)\n"
+    "{\n"
+    "    printf(\"point %d %d\\n\", p->x, BLUE);\n"
+    "    v->f = Scale(1.5, p->x);\n"
+    "    return p->tag + GREEN;\n"
+    "}\n"
+    "int main()\n"
+    "{\n"
+    "    struct Point p;\n"
+    "    union Value v;\n"
+    "    p.x = 3;\n"
+    "    p.tag = 'a';\n"
+    "    p = origin;\n"
+    "    printf(\"done\\n\");\n"
+    "    return Show(&p, &v);\n"
+    "}\n";
+
+TEST(Serialization_RoundTrip)
+{
+    std::vector<Token> tokens;
+    Language::IRUnit unit = CompileIR("Serialization_RoundTrip.c", kSerializationSource, tokens);
+    std::string image = Language::SaveIR(unit);
+    std::string expected = TranslateIR(unit);
+
+    Language::IRUnit loaded = Language::LoadIR(image.data(), image.size());
+    EXPECT_EQ(loaded.functionContexts.size(), 3u);
+    EXPECT_EQ(loaded.typeContext->types.size(), unit.typeContext->types.size());
+    EXPECT_EQ(loaded.typeContext->internedTypes.size(), unit.typeContext->internedTypes.size());
+    EXPECT_EQ(Language::SaveIR(loaded), image);
+    EXPECT_EQ(TranslateIR(loaded), expected);
+}
+
+TEST(Serialization_BadImage)
+{
+    std::vector<Token> tokens;
+    Language::IRUnit unit = CompileIR("Serialization_BadImage.c", kSerializationSource, tokens);
+    const std::string image = Language::SaveIR(unit);
+
+    auto rejects = [](std::string bad) -> bool {
+        try { Language::LoadIR(bad.data(), bad.size()); } catch (const std::invalid_argument &) { return true; }
+        return false;
+    };
+    EXPECT_FALSE(rejects(image));
+
+    // Truncated, then also with the size in the header fixed up.
+    std::string truncated = image.substr(0, image.size() / 2);
+    EXPECT_TRUE(rejects(truncated));
+    UINT32 size = static_cast<UINT32>(truncated.size());
+    memcpy(&truncated[8], &size, 4);
+    EXPECT_TRUE(rejects(truncated));
+
+    // Name of the first type: root, type context, its type refs after
+    // the counts, base id and id maps. Fields follow the record tags.
+    ImageReader reader(image.data(), image.size(), Language::IR_IMAGE_MAGIC, Language::IR_IMAGE_VERSION);
+    const UINT32 tag = 8;
+    UINT32 typeContext = reader.GetRef(reader.Root() + tag + 4);
+    UINT32 firstType = typeContext + tag + 24 +
+                       16 * reader.Get<UINT32>(typeContext + tag + 4) +
+                       24 * reader.Get<UINT32>(typeContext + tag + 8) +
+                       16 * reader.Get<UINT32>(typeContext + tag + 12);
+    UINT32 typeName = reader.GetRef(firstType) + tag;
+    EXPECT_EQ(reader.Get<UINT32>(typeName), static_cast<UINT32>(Language::INT));
+
+    std::string corrupted = image;
+    UINT32 badName = 0xFFFF;
+    memcpy(&corrupted[typeName], &badName, 4);
+    EXPECT_TRUE(rejects(corrupted));
+
+    // A type reference to the type context record, of another kind.
+    corrupted = image;
+    UINT32 wrongKind = typeContext - firstType;
+    memcpy(&corrupted[firstType], &wrongKind, 4);
+    EXPECT_TRUE(rejects(corrupted));
+}
+
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "FunctionContext.h"
+
+namespace Language {
+
+// IR of a translation unit, as built by CompileAst().
+struct IRUnit
+{
+    TypeContext *                   typeContext;
+    ConstantContext *               constantContext;
+    DefinitionContext *             globalDefinitionContext;
+    std::vector<FunctionContext *>  functionContexts;
+};
+
+// Binary image of the contexts and all they point to, see BinaryImage.h.
+// Any context may be null. Build state of function contexts (the current*
+// stacks) isn't saved, it is empty once a function is built.
+std::string SaveIR(const IRUnit & unit);
+
+// Strings of the loaded IR point into image, which must outlive it.
+// Offsets, counts and record kinds are checked; on a bad image throws
+// std::invalid_argument and frees what was loaded.
+IRUnit      LoadIR(const char * image, size_t size);
+
+} // namespace Language
@@ -1,6 +1,7 @@
 #include "TypeContext.h"
 
 #include <iostream>
+#include <memory>
 
 #include "../Base/Common.h"
 #include "../Base/Bits.h"
@@ -165,68 +166,295 @@ u64 ChooseTypeBaseId(TypeContext * context, Type * type)
     return baseId;
 }
 
-VoidType * MakeVoid(TypeContext * context)
+// Owns the member arrays of all types, which like types are never freed.
+class MemberArena
 {
-    VoidType * type = new VoidType;
-    type->type.name = VOID;
-    type->type.prop = 0;
-    type->type.size = 0;
-    type->type.align = 0;
-    type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    context->types.push_back(&type->type);
+public:
+    MemberArena() : next(nullptr), end(nullptr) {}
+
+    void * Allocate(size_t size)
+    {
+        size = (size + 7) / 8 * 8;
+        if (size > BLOCK_SIZE / 4)
+        {
+            blocks.emplace_back(new char[size]);
+            return blocks.back().get();
+        }
+        if (size > static_cast<size_t>(end - next))
+        {
+            blocks.emplace_back(new char[BLOCK_SIZE]);
+            next = blocks.back().get();
+            end = next + BLOCK_SIZE;
+        }
+        void * memory = next;
+        next += size;
+        return memory;
+    }
+
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char * next;
+    char * end;
+};
+
+MemberArena & GlobalMemberArena()
+{
+    static MemberArena arena;
+    return arena;
+}
+
+template <typename T>
+T * NewMembers(size_t capacity)
+{
+    T * members = static_cast<T *>(GlobalMemberArena().Allocate(capacity * sizeof(T)));
+    for (size_t i = 0; i < capacity; ++i)
+        new (members + i) T();
+    return members;
+}
+
+template <typename T>
+void GrowMembers(T *& members, size_t count, size_t capacity)
+{
+    T * grown = NewMembers<T>(capacity);
+    std::copy(members, members + count, grown);
+    members = grown;
+}
+
+// Members of struct/union above this count are looked up by hash.
+const size_t MEMBER_INDEX_THRESHOLD = 16;
+const UINT32 NO_MEMBER = 0xFFFFFFFF;
+
+UINT32 HashMemberName(StringRef name)
+{
+    UINT32 hash = 2166136261u;
+    for (char c : name)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    return hash;
+}
+
+void IndexMembers(StringRef * memberName, size_t memberCount, UINT32 *& memberIndex, size_t & memberIndexMask)
+{
+    size_t slots = 1;
+    while (slots < memberCount * 2)
+        slots *= 2;
+
+    memberIndex = NewMembers<UINT32>(slots);
+    memberIndexMask = slots - 1;
+    std::fill(memberIndex, memberIndex + slots, NO_MEMBER);
+    for (size_t m = 0; m < memberCount; ++m)
+    {
+        size_t i = HashMemberName(memberName[m]) & memberIndexMask;
+        while (memberIndex[i] != NO_MEMBER)
+            i = (i + 1) & memberIndexMask;
+        memberIndex[i] = static_cast<UINT32>(m);
+    }
+}
+
+// Index of the member, memberCount if none. Builds the index when first
+// needed, so call on a complete type.
+template <typename T>
+size_t FindMember(T * type, StringRef name)
+{
+    if (type->memberCount <= MEMBER_INDEX_THRESHOLD)
+    {
+        size_t m = 0;
+        while (m < type->memberCount && type->memberName[m] != name)
+            ++m;
+        return m;
+    }
+
+    if (!type->memberIndex)
+        IndexMembers(type->memberName, type->memberCount, type->memberIndex, type->memberIndexMask);
+
+    for (size_t i = HashMemberName(name) & type->memberIndexMask;
+         type->memberIndex[i] != NO_MEMBER;
+         i = (i + 1) & type->memberIndexMask)
+    {
+        if (type->memberName[type->memberIndex[i]] == name)
+            return type->memberIndex[i];
+    }
+    return type->memberCount;
+}
+
+Type * NewTypeCopy(Type * type)
+{
+    Type * clone = nullptr;
+    switch (type->name)
+    {
+        case VOID:      clone = &(new VoidType(*AsVoid(type)))->type; break;
+        case BOOL:      clone = &(new BoolType(*AsBool(type)))->type; break;
+        case CHAR:      clone = &(new CharType(*AsChar(type)))->type; break;
+        case INT:       clone = &(new IntType(*AsInt(type)))->type; break;
+        case FLOAT:     clone = &(new FloatType(*AsFloat(type)))->type; break;
+        case ARRAY:     clone = &(new ArrayType(*AsArray(type)))->type; break;
+        case POINTER:   clone = &(new PointerType(*AsPointer(type)))->type; break;
+        case FUNCTION:  clone = &(new FunctionType(*AsFunction(type)))->type; break;
+        case ENUM:      clone = &(new EnumType(*AsEnum(type)))->type; break;
+        case STRUCT:    clone = &(new StructType(*AsStruct(type)))->type; break;
+        case UNION:     clone = &(new UnionType(*AsUnion(type)))->type; break;
+        default:        ASSERT(false); break;
+    }
+    return clone;
+}
+
+size_t HashMix(size_t hash, size_t value)
+{
+    return hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+}
+
+size_t InternedTypeHash::operator()(Type * type) const
+{
+    size_t hash = HashMix(type->name, type->prop);
+    hash = HashMix(hash, type->size);
+    switch (type->name)
+    {
+        case INT:
+            hash = HashMix(hash, AsInt(type)->isSigned);
+            break;
+        case ARRAY:
+            hash = HashMix(hash, AsArray(type)->length);
+            hash = HashMix(hash, reinterpret_cast<size_t>(AsArray(type)->target));
+            break;
+        case POINTER:
+            hash = HashMix(hash, reinterpret_cast<size_t>(AsPointer(type)->target));
+            break;
+        case FUNCTION:
+            hash = HashMix(hash, reinterpret_cast<size_t>(AsFunction(type)->target));
+            for (size_t i = 0; i < AsFunction(type)->memberCount; ++i)
+                hash = HashMix(hash, reinterpret_cast<size_t>(AsFunction(type)->memberType[i]));
+            break;
+        default:
+            break;
+    }
+    return hash;
+}
+
+bool InternedTypeEqual::operator()(Type * a, Type * b) const
+{
+    if (a->name != b->name ||
+        a->prop != b->prop ||
+        a->size != b->size ||
+        a->align != b->align ||
+        a->baseId != b->baseId)
+    {
+        return false;
+    }
+
+    switch (a->name)
+    {
+        case INT:
+            return AsInt(a)->isSigned == AsInt(b)->isSigned;
+        case ARRAY:
+            return AsArray(a)->length == AsArray(b)->length &&
+                   AsArray(a)->target == AsArray(b)->target;
+        case POINTER:
+            return AsPointer(a)->target == AsPointer(b)->target;
+        case FUNCTION:
+        {
+            FunctionType * aFunction = AsFunction(a);
+            FunctionType * bFunction = AsFunction(b);
+            if (aFunction->target != bFunction->target ||
+                aFunction->isVarList != bFunction->isVarList ||
+                aFunction->memberCount != bFunction->memberCount)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < aFunction->memberCount; ++i)
+            {
+                if (aFunction->memberType[i] != bFunction->memberType[i] ||
+                    aFunction->memberName[i] != bFunction->memberName[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            ASSERT(a->name != ENUM && a->name != STRUCT && a->name != UNION);
+            return true;
+    }
+}
+
+// The interned type equal to candidate, a copy of it if new.
+Type * InternType(TypeContext * context, Type * candidate)
+{
+    candidate->prop |= TP_INTERNED;
+
+    auto it = context->internedTypes.find(candidate);
+    if (it != context->internedTypes.end())
+        return *it;
+
+    Type * type = NewTypeCopy(candidate);
+    context->internedTypes.insert(type);
+    context->types.push_back(type);
+    (void)CanonicalType(context, type);
     return type;
 }
 
+VoidType * MakeVoid(TypeContext * context)
+{
+    VoidType type;
+    type.type.name = VOID;
+    type.type.prop = 0;
+    type.type.size = 0;
+    type.type.align = 0;
+    type.type.baseId = ChooseTypeBaseId(context, &type.type);
+    type.type.canonical = nullptr;
+    return AsVoid(InternType(context, &type.type));
+}
+
 BoolType * MakeBool(TypeContext * context)
 {
-    BoolType * type = new BoolType;
-    type->type.name = BOOL;
-    type->type.prop = TP_IS_INTEGRAL | TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
-    type->type.size = 1;
-    type->type.align = 1;
-    type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    context->types.push_back(&type->type);
-    return type;
+    BoolType type;
+    type.type.name = BOOL;
+    type.type.prop = TP_IS_INTEGRAL | TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
+    type.type.size = 1;
+    type.type.align = 1;
+    type.type.baseId = ChooseTypeBaseId(context, &type.type);
+    type.type.canonical = nullptr;
+    return AsBool(InternType(context, &type.type));
 }
 
 CharType * MakeChar(TypeContext * context)
 {
-    CharType * type = new CharType;
-    type->type.name = CHAR;
-    type->type.prop = TP_IS_INTEGRAL | TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
-    type->type.size = 1;
-    type->type.align = 1;
-    type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    context->types.push_back(&type->type);
-    return type;
+    CharType type;
+    type.type.name = CHAR;
+    type.type.prop = TP_IS_INTEGRAL | TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
+    type.type.size = 1;
+    type.type.align = 1;
+    type.type.baseId = ChooseTypeBaseId(context, &type.type);
+    type.type.canonical = nullptr;
+    return AsChar(InternType(context, &type.type));
 }
 
 IntType * MakeInt(TypeContext * context, size_t width, bool isSigned)
 {
     ASSERT(width <= 8 && CountBits(width) == 1);
-    IntType * type = new IntType;
-    type->type.name = INT;
-    type->type.prop = TP_IS_INTEGRAL | TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
-    type->type.size = width;
-    type->type.align = width;
-    type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    type->isSigned = isSigned;
-    context->types.push_back(&type->type);
-    return type;
+    IntType type;
+    type.type.name = INT;
+    type.type.prop = TP_IS_INTEGRAL | TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
+    type.type.size = width;
+    type.type.align = width;
+    type.type.baseId = ChooseTypeBaseId(context, &type.type);
+    type.type.canonical = nullptr;
+    type.isSigned = isSigned;
+    return AsInt(InternType(context, &type.type));
 }
 
 FloatType * MakeFloat(TypeContext * context, size_t width)
 {
     ASSERT(width == 4 || width == 8 || width == 10);
 
-    FloatType * type = new FloatType;
-    type->type.name = FLOAT;
-    type->type.prop = TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
-    type->type.size = width;
-    type->type.align = width == 10 ? 16 : width;
-    type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    context->types.push_back(&type->type);
-    return type;
+    FloatType type;
+    type.type.name = FLOAT;
+    type.type.prop = TP_IS_ARITHMETIC | TP_IS_SCALAR | TP_IS_OBJECT;
+    type.type.size = width;
+    type.type.align = width == 10 ? 16 : width;
+    type.type.baseId = ChooseTypeBaseId(context, &type.type);
+    type.type.canonical = nullptr;
+    return AsFloat(InternType(context, &type.type));
 }
 
 // OPTIMIZE: add type id support for array
@@ -238,6 +466,7 @@ ArrayType * MakeArray(TypeContext * context, size_t length)
     type->type.size = 0; // to fill
     type->type.align = 0; // to fill
     type->type.baseId = 0; // to fill
+    type->type.canonical = nullptr; // to fill
     type->length = length;
     type->target = nullptr; // to fill
     context->types.push_back(&type->type);
@@ -261,6 +490,7 @@ PointerType * MakePointer(TypeContext * context)
     type->type.size = 8;
     type->type.align = 8;
     type->type.baseId = 0; // to fill
+    type->type.canonical = nullptr; // to fill
     type->target = nullptr; // to fill
     context->types.push_back(&type->type);
     return type;
@@ -274,15 +504,15 @@ void PointerSetTarget(TypeContext * context, PointerType * type, Type * target)
 
 PointerType * MakePointer(TypeContext * context, Type * target)
 {
-    PointerType * type = new PointerType;
-    type->type.name = POINTER;
-    type->type.prop = TP_IS_SCALAR | TP_IS_OBJECT;
-    type->type.size = 8;
-    type->type.align = 8;
-    type->target = target;
-    type->type.baseId = 0; // ChooseTypeBaseId(context, &type->type);
-    context->types.push_back(&type->type);
-    return type;
+    PointerType type;
+    type.type.name = POINTER;
+    type.type.prop = TP_IS_SCALAR | TP_IS_OBJECT;
+    type.type.size = 8;
+    type.type.align = 8;
+    type.target = target;
+    type.type.baseId = 0; // ChooseTypeBaseId(context, &type.type);
+    type.type.canonical = nullptr;
+    return AsPointer(InternType(context, &type.type));
 }
 
 // OPTIMIZE: add type id support for function
@@ -294,8 +524,12 @@ FunctionType * MakeFunction(TypeContext * context)
     type->type.size = 0;
     type->type.align = 0;
     type->type.baseId = 0; // to fill
+    type->type.canonical = nullptr; // to fill
     type->target = nullptr; // to fill
-    for (int i = 0; i < 10; ++i) { type->memberType[i] = nullptr; } // 2 to fill
+    type->memberCount = 0; // to fill
+    type->memberCapacity = 0;
+    type->memberName = nullptr;
+    type->memberType = nullptr;
     type->isVarList = false; // to fill
     context->types.push_back(&type->type);
     return type;
@@ -308,8 +542,8 @@ void FunctionSetTarget(FunctionType * type, Type * target)
 
 void FunctionAddParameter(FunctionType * type, StringRef pname, Type * ptype)
 {
-    int i = 0;
-    while (type->memberType[i] != nullptr) { ++i; ASSERT(i < 10); }
+    size_t i = type->memberCount;
+    TypeSetMemberCount(&type->type, i + 1);
     type->memberName[i] = pname;
     ASSERT(ptype != nullptr);
     type->memberType[i] = ptype;
@@ -333,24 +567,27 @@ EnumType * MakeEnum(TypeContext * context)
     type->type.size = 4;
     type->type.align = 4;
     type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    // 2 to fill
+    type->type.canonical = &type->type;
+    type->memberCount = 0; // to fill
+    type->memberCapacity = 0;
+    type->memberName = nullptr;
+    type->memberValue = nullptr;
     context->types.push_back(&type->type);
     return type;
 }
 
 void EnumAddConst(EnumType * type, StringRef name, int value)
 {
-    int i = 0;
-    while (!type->memberName[i].empty()) { ++i; ASSERT(i < 10); }
+    size_t i = type->memberCount;
+    TypeSetMemberCount(&type->type, i + 1);
     type->memberName[i] = name;
     type->memberValue[i] = value;
 }
 
 void EnumChangeLastConstValue(EnumType * type, int value)
 {
-    int i = 0;
-    while (!type->memberName[i].empty()) { ++i; ASSERT(i < 10); }
-    type->memberValue[i] = value;
+    ASSERT(type->memberCount > 0);
+    type->memberValue[type->memberCount - 1] = value;
 }
 
 StructType * MakeStruct(TypeContext * context)
@@ -361,7 +598,14 @@ StructType * MakeStruct(TypeContext * context)
     type->type.size = 0; // to fill
     type->type.align = 0; // to fill
     type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    for (int i = 0; i < 10; ++i) { type->memberType[i] = nullptr; } // 3 to fill
+    type->type.canonical = &type->type;
+    type->memberCount = 0; // to fill
+    type->memberCapacity = 0;
+    type->memberName = nullptr;
+    type->memberType = nullptr;
+    type->memberOffset = nullptr;
+    type->memberIndex = nullptr;
+    type->memberIndexMask = 0;
     context->types.push_back(&type->type);
     return type;
 }
@@ -369,8 +613,8 @@ StructType * MakeStruct(TypeContext * context)
 void StructAddMember(StructType * type, StringRef mname, Type * mtype)
 {
     ASSERT(IsIncomplete(&type->type));
-    int i = 0;
-    while (type->memberType[i] != nullptr) { ++i; ASSERT(i < 10); }
+    size_t i = type->memberCount;
+    TypeSetMemberCount(&type->type, i + 1);
     type->memberName[i] = mname;
     type->memberType[i] = mtype;
     type->memberOffset[i] =
@@ -395,15 +639,21 @@ UnionType * MakeUnion(TypeContext * context)
     type->type.size = 0; // to fill
     type->type.align = 0; // to fill
     type->type.baseId = ChooseTypeBaseId(context, &type->type);
-    for (int i = 0; i < 10; ++i) { type->memberType[i] = nullptr; } // 2 to fill
+    type->type.canonical = &type->type;
+    type->memberCount = 0; // to fill
+    type->memberCapacity = 0;
+    type->memberName = nullptr;
+    type->memberType = nullptr;
+    type->memberIndex = nullptr;
+    type->memberIndexMask = 0;
     context->types.push_back(&type->type);
     return type;
 }
 
 void UnionAddMember(UnionType * type, StringRef mname, Type * mtype)
 {
-    int i = 0;
-    while (type->memberType[i] != nullptr) { ++i; ASSERT(i < 10); }
+    size_t i = type->memberCount;
+    TypeSetMemberCount(&type->type, i + 1);
     type->memberName[i] = mname;
     type->memberType[i] = mtype;
     type->type.align = Max(type->type.align, mtype->align);
@@ -416,25 +666,67 @@ void UnionDone(UnionType * type)
     type->type.prop &= ~TP_INCOMPLETE;
 }
 
-Type * CloneType(TypeContext * context, Type * type)
+void TypeSetMemberCount(Type * type, size_t count)
 {
-    Type * clone = nullptr;
+    size_t * capacity = nullptr;
     switch (type->name)
     {
-        case VOID:      clone = &(new VoidType(*AsVoid(type)))->type; break;
-        case BOOL:      clone = &(new BoolType(*AsBool(type)))->type; break;
-        case CHAR:      clone = &(new CharType(*AsChar(type)))->type; break;
-        case INT:       clone = &(new IntType(*AsInt(type)))->type; break;
-        case FLOAT:     clone = &(new FloatType(*AsFloat(type)))->type; break;
-        case ARRAY:     clone = &(new ArrayType(*AsArray(type)))->type; break;
-        case POINTER:   clone = &(new PointerType(*AsPointer(type)))->type; break;
-        case FUNCTION:  clone = &(new FunctionType(*AsFunction(type)))->type; break;
-        case ENUM:      clone = &(new EnumType(*AsEnum(type)))->type; break;
-        case STRUCT:    clone = &(new StructType(*AsStruct(type)))->type; break;
-        case UNION:     clone = &(new UnionType(*AsUnion(type)))->type; break;
-        default:        ASSERT(false); break;
+        case FUNCTION:  capacity = &AsFunction(type)->memberCapacity; break;
+        case ENUM:      capacity = &AsEnum(type)->memberCapacity; break;
+        case STRUCT:    capacity = &AsStruct(type)->memberCapacity; break;
+        case UNION:     capacity = &AsUnion(type)->memberCapacity; break;
+        default:        ASSERT(false); return;
     }
-    return clone;
+
+    if (count > *capacity)
+    {
+        size_t grown = Max<size_t>(4, *capacity * 2);
+        while (grown < count)
+            grown *= 2;
+
+        if (type->name == FUNCTION)
+        {
+            FunctionType * functionType = AsFunction(type);
+            GrowMembers(functionType->memberName, functionType->memberCount, grown);
+            GrowMembers(functionType->memberType, functionType->memberCount, grown);
+        }
+        else if (type->name == ENUM)
+        {
+            EnumType * enumType = AsEnum(type);
+            GrowMembers(enumType->memberName, enumType->memberCount, grown);
+            GrowMembers(enumType->memberValue, enumType->memberCount, grown);
+        }
+        else if (type->name == STRUCT)
+        {
+            StructType * structType = AsStruct(type);
+            GrowMembers(structType->memberName, structType->memberCount, grown);
+            GrowMembers(structType->memberType, structType->memberCount, grown);
+            GrowMembers(structType->memberOffset, structType->memberCount, grown);
+        }
+        else
+        {
+            UnionType * unionType = AsUnion(type);
+            GrowMembers(unionType->memberName, unionType->memberCount, grown);
+            GrowMembers(unionType->memberType, unionType->memberCount, grown);
+        }
+        *capacity = grown;
+    }
+
+    switch (type->name)
+    {
+        case FUNCTION:  AsFunction(type)->memberCount = count; break;
+        case ENUM:      AsEnum(type)->memberCount = count; break;
+        case STRUCT:    AsStruct(type)->memberCount = count; break;
+        default:        AsUnion(type)->memberCount = count; break;
+    }
+}
+
+Type * CloneType(TypeContext * context, Type * type)
+{
+    if (type->prop & TP_INTERNED)
+        return type;
+
+    return NewTypeCopy(type);
 }
 
 void SetTargetType(TypeContext * context, Type * type, Type * target)
@@ -458,19 +750,118 @@ void SetTargetType(TypeContext * context, Type * type, Type * target)
     }
 }
 
-void TypeSetProperties(Type * type, int prop)
+template <typename T>
+Type * InternVariant(TypeContext * context, T * type, int prop)
+{
+    T variant = *type;
+    variant.type.prop |= prop;
+    return InternType(context, &variant.type);
+}
+
+Type * TypeSetProperties(TypeContext * context, Type * type, int prop)
 {
     ASSERT((prop & ~0xf) == 0);
-    type->prop |= prop;
+    if ((type->prop & prop) == prop)
+        return type;
+
+    if (!(type->prop & TP_INTERNED))
+    {
+        type->prop |= prop;
+        return type;
+    }
+
+    switch (type->name)
+    {
+        case VOID:      return InternVariant(context, AsVoid(type), prop);
+        case BOOL:      return InternVariant(context, AsBool(type), prop);
+        case CHAR:      return InternVariant(context, AsChar(type), prop);
+        case INT:       return InternVariant(context, AsInt(type), prop);
+        case FLOAT:     return InternVariant(context, AsFloat(type), prop);
+        case ARRAY:     return InternVariant(context, AsArray(type), prop);
+        case POINTER:   return InternVariant(context, AsPointer(type), prop);
+        case FUNCTION:  return InternVariant(context, AsFunction(type), prop);
+        default:        ASSERT(false); return nullptr;
+    }
 }
 
-void TypeSetAssignable(Type * type)
+Type * TypeSetAssignable(TypeContext * context, Type * type)
 {
-    type->prop |= TP_ASSIGNABLE;
+    return TypeSetProperties(context, type, TP_ASSIGNABLE);
 }
-void TypeSetAddressable(Type * type)
+Type * TypeSetAddressable(TypeContext * context, Type * type)
 {
-    type->prop |= TP_ADDRESSABLE;
+    return TypeSetProperties(context, type, TP_ADDRESSABLE);
+}
+
+template <typename T>
+Type * InternUnqualified(TypeContext * context, T type)
+{
+    type.type.prop &= ~(TP_CONST | TP_ADDRESSABLE | TP_ASSIGNABLE);
+    return InternType(context, &type.type);
+}
+
+Type * CanonicalType(TypeContext * context, Type * type)
+{
+    // void/bool/char/int/float -> unqualified, ints of a width are one (as type ids)
+    // enum/struct/union        -> the declared type
+    // array                    -> unqualified, length + canonical target
+    // pointer                  -> unqualified, canonical target
+    // function                 -> unqualified, canonical protocol, no parameter names
+
+    if (type->canonical)
+        return type->canonical;
+
+    Type * canonical = nullptr;
+    switch (type->name)
+    {
+        case VOID:  canonical = InternUnqualified(context, *AsVoid(type)); break;
+        case BOOL:  canonical = InternUnqualified(context, *AsBool(type)); break;
+        case CHAR:  canonical = InternUnqualified(context, *AsChar(type)); break;
+        case FLOAT: canonical = InternUnqualified(context, *AsFloat(type)); break;
+        case INT:
+        {
+            IntType t = *AsInt(type);
+            t.isSigned = true;
+            canonical = InternUnqualified(context, t);
+            break;
+        }
+        case ARRAY:
+        {
+            ArrayType t = *AsArray(type);
+            ASSERT(t.target);
+            t.target = CanonicalType(context, t.target);
+            canonical = InternUnqualified(context, t);
+            break;
+        }
+        case POINTER:
+        {
+            PointerType t = *AsPointer(type);
+            ASSERT(t.target);
+            t.target = CanonicalType(context, t.target);
+            canonical = InternUnqualified(context, t);
+            break;
+        }
+        case FUNCTION:
+        {
+            FunctionType t = *AsFunction(type);
+            ASSERT(t.target);
+            t.target = CanonicalType(context, t.target);
+            // own arrays, no parameter names
+            t.memberCapacity = t.memberCount;
+            t.memberName = NewMembers<StringRef>(t.memberCount);
+            t.memberType = NewMembers<Type *>(t.memberCount);
+            for (size_t i = 0; i < t.memberCount; ++i)
+                t.memberType[i] = CanonicalType(context, AsFunction(type)->memberType[i]);
+            canonical = InternUnqualified(context, t);
+            break;
+        }
+        default:
+            ASSERT(false);
+            break;
+    }
+
+    type->canonical = canonical;
+    return canonical;
 }
 
 Type * IntegralPromotion(TypeContext * context, Type * type)
@@ -594,12 +985,9 @@ Type * DecayType(TypeContext * context, Type * type)
 
     if (type->name == ARRAY)
     {
-        PointerType * pointerType = MakePointer(context);
-
-        pointerType->target = AsArray(type)->target;
-        pointerType->type.prop |= (type->prop & TP_CONST);
-
-        return &pointerType->type;
+        return TypeSetProperties(context,
+                                 &MakePointer(context, AsArray(type)->target)->type,
+                                 type->prop & TP_CONST);
     }
     else if (type->name == FUNCTION)
     {
@@ -632,56 +1020,9 @@ TypeContext * CreateTypeContext()
 
 bool TypeEqual(Type * a, Type * b)
 {
-    // void/bool/char/int/float -> prop + type id
-    // enum/struct/union        -> prop + type id
-    // array                    -> prop + length + target
-    // pointer                  -> prop + target
-    // function                 -> prop + protocol
-
-    if (a->name != b->name)
-        return false;
-
-    int propSet = (a->name == FUNCTION ? 0 : TP_INCOMPLETE) /*| TP_CONST*/; // TODO: add TP_CONST
-    if ((a->prop & propSet) != (b->prop & propSet))
-        return false;
-
-    if (a->name == ARRAY)
-    {
-        ArrayType * aArray = AsArray(a);
-        ArrayType * bArray = AsArray(b);
-        return (aArray->length == bArray->length) &&
-               TypeEqual(aArray->target, bArray->target);
-    }
-    else if (a->name == POINTER)
-    {
-        PointerType * aPointer = AsPointer(a);
-        PointerType * bPointer = AsPointer(b);
-        return TypeEqual(aPointer->target, bPointer->target);
-    }
-    else if (a->name == FUNCTION)
-    {
-        FunctionType * aFunction = AsFunction(a);
-        FunctionType * bFunction = AsFunction(b);
-
-        if (aFunction->isVarList != bFunction->isVarList)
-            return false;
-        if (!TypeEqual(aFunction->target, bFunction->target))
-            return false;
-        for (Type ** aParam = aFunction->memberType, ** bParam = bFunction->memberType;
-             *aParam || *bParam;
-             ++aParam, ++bParam)
-        {
-            if (!(*aParam) || !(*bParam))
-                return false;
-            if (!TypeEqual(*aParam, *bParam))
-                return false;
-        }
-        return true;
-    }
-    else
-    {
-        return TypeId(a) == TypeId(b);
-    }
+    // canonical types are interned
+    ASSERT(a->canonical && b->canonical);
+    return a->canonical == b->canonical;
 }
 
 size_t TypeSize(Type * type)
@@ -800,33 +1141,22 @@ Type * GetMemberType(Type * type, StringRef memberName)
 {
     ASSERT(IsStructOrUnion(type) && !IsIncomplete(type));
 
+    // copies share members, index them once on the declared type
     Type * memberType = nullptr;
 
     if (type->name == STRUCT)
     {
-        StructType * structType = AsStruct(type);
-        for (int i = 0; i < 10; ++i)
-        {
-            if (structType->memberType[i] &&
-                structType->memberName[i] == memberName)
-            {
-                memberType = structType->memberType[i];
-                break;
-            }
-        }
+        StructType * structType = AsStruct(type->canonical);
+        size_t i = FindMember(structType, memberName);
+        if (i < structType->memberCount)
+            memberType = structType->memberType[i];
     }
     else
     {
-        UnionType * unionType = AsUnion(type);
-        for (int i = 0; i < 10; ++i)
-        {
-            if (unionType->memberType[i] &&
-                unionType->memberName[i] == memberName)
-            {
-                memberType = unionType->memberType[i];
-                break;
-            }
-        }
+        UnionType * unionType = AsUnion(type->canonical);
+        size_t i = FindMember(unionType, memberName);
+        if (i < unionType->memberCount)
+            memberType = unionType->memberType[i];
     }
 
     // TODO: handle 'const struct/union'
@@ -840,38 +1170,17 @@ size_t GetMemberOffset(Type * type, StringRef memberName)
 {
     ASSERT(IsStructOrUnion(type) && !IsIncomplete(type));
 
-    size_t offset = 10;
-
     if (type->name == STRUCT)
     {
-        StructType * structType = AsStruct(type);
-        for (int i = 0; i < 10; ++i)
-        {
-            if (structType->memberType[i] &&
-                structType->memberName[i] == memberName)
-            {
-                offset = i;
-                break;
-            }
-        }
-
-        ASSERT(offset != 10);
-        return structType->memberOffset[offset];
+        StructType * structType = AsStruct(type->canonical);
+        size_t i = FindMember(structType, memberName);
+        ASSERT(i < structType->memberCount);
+        return structType->memberOffset[i];
     }
     else
     {
-        UnionType * unionType = AsUnion(type);
-        for (int i = 0; i < 10; ++i)
-        {
-            if (unionType->memberType[i] &&
-                unionType->memberName[i] == memberName)
-            {
-                offset = i;
-                break;
-            }
-        }
-
-        ASSERT(offset != 10);
+        UnionType * unionType = AsUnion(type->canonical);
+        ASSERT(FindMember(unionType, memberName) < unionType->memberCount);
         return 0;
     }
 }
@@ -898,15 +1207,7 @@ Type * GetTargetType(Type * type)
 
 bool IsMatchedCall(FunctionType * func, std::vector<Type *> & arguments)
 {
-    size_t paramCount = 0;
-
-    for (size_t i = 0; i < 10; ++i)
-    {
-        if (func->memberType[i])
-            ++paramCount;
-        else
-            break;
-    }
+    size_t paramCount = func->memberCount;
 
     if (paramCount > arguments.size())
         return false;
@@ -992,4 +1293,167 @@ void PrintTypeContext(TypeContext * context)
     }
 }
 
-}
\ No newline at end of file
+}
+#ifdef UNIT_TEST
+#include "../UnitTest/UnitTest.h"
+
+#include <set>
+#include <string>
+
+TEST(TypeContext_Members)
+{
+    using namespace Language;
+
+    TypeContext * types = CreateTypeContext();
+    Type * intType = &MakeInt(types, 4, true)->type;
+    Type * charType = &MakeChar(types)->type;
+
+    std::vector<std::string> names;
+    for (int i = 0; i < 3000; ++i)
+        names.push_back("m" + std::to_string(i));
+    auto Name = [&names](size_t i) { return StringRef(names[i].data(), names[i].size()); };
+
+    // Members added earlier survive every capacity doubling.
+    StructType * big = MakeStruct(types);
+    std::set<size_t> capacities;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        StructAddMember(big, Name(i), intType);
+        capacities.insert(big->memberCapacity);
+        EXPECT_TRUE(big->memberCapacity >= big->memberCount);
+    }
+    StructDone(big);
+    EXPECT_TRUE(capacities == std::set<size_t>({ 4, 8, 16, 32, 64, 128, 256, 512 }));
+    EXPECT_EQ(big->memberCount, 300u);
+    EXPECT_EQ(big->type.size, 1200u);
+    for (size_t i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(big->memberName[i], Name(i));
+        EXPECT_EQ(big->memberType[i], intType);
+        EXPECT_EQ(big->memberOffset[i], i * 4);
+    }
+
+    EnumType * constants = MakeEnum(types);
+    for (int i = 0; i < 3000; ++i)
+        EnumAddConst(constants, Name(i), i * 3);
+    EXPECT_EQ(constants->memberCount, 3000u);
+    EXPECT_EQ(constants->memberCapacity, 4096u);
+    for (int i = 0; i < 3000; ++i)
+    {
+        EXPECT_EQ(constants->memberName[i], Name(i));
+        EXPECT_EQ(constants->memberValue[i], i * 3);
+    }
+
+    FunctionType * function = MakeFunction(types);
+    for (size_t i = 0; i < 14; ++i)
+        FunctionAddParameter(function, Name(i), i < 7 ? intType : charType);
+    SetTargetType(types, &function->type, intType);
+    EXPECT_EQ(function->memberCount, 14u);
+    EXPECT_EQ(function->memberCapacity, 16u);
+    for (size_t i = 0; i < 14; ++i)
+    {
+        EXPECT_EQ(function->memberName[i], Name(i));
+        EXPECT_EQ(function->memberType[i], i < 7 ? intType : charType);
+    }
+    EXPECT_EQ(AsFunction(CanonicalType(types, &function->type))->memberCount, 14u);
+
+    // Up to the threshold members are scanned, above it hashed.
+    for (size_t count : { MEMBER_INDEX_THRESHOLD, MEMBER_INDEX_THRESHOLD + 1 })
+    {
+        StructType * s = MakeStruct(types);
+        UnionType * u = MakeUnion(types);
+        for (size_t i = 0; i < count; ++i)
+        {
+            StructAddMember(s, Name(i), intType);
+            UnionAddMember(u, Name(i), i % 2 ? charType : intType);
+        }
+        StructDone(s);
+        UnionDone(u);
+        for (size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(FindMember(s, Name(i)), i);
+            EXPECT_EQ(FindMember(u, Name(i)), i);
+            EXPECT_EQ(GetMemberType(&u->type, Name(i)), i % 2 ? charType : intType);
+        }
+        EXPECT_EQ(FindMember(s, Name(count)), count);
+        EXPECT_EQ(FindMember(u, "m"), count);
+        EXPECT_EQ(s->memberIndex != nullptr, count > MEMBER_INDEX_THRESHOLD);
+        EXPECT_EQ(u->memberIndex != nullptr, count > MEMBER_INDEX_THRESHOLD);
+    }
+
+    // Index slots are a power of two, at least twice the members.
+    UINT32 * index = nullptr;
+    size_t mask = 0;
+    IndexMembers(big->memberName, big->memberCount, index, mask);
+    EXPECT_EQ(mask, 1023u);
+    EXPECT_EQ(std::count(index, index + mask + 1, NO_MEMBER), 1024 - 300);
+
+    // Copies share the members and look up through the declared type,
+    // which indexes them once.
+    Type * copy = CloneType(types, &big->type);
+    EXPECT_NE(copy, &big->type);
+    EXPECT_TRUE(TypeEqual(copy, &big->type));
+    EXPECT_EQ(big->memberIndex, nullptr);
+    for (size_t i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(GetMemberOffset(copy, Name(i)), i * 4);
+        EXPECT_EQ(GetMemberType(copy, Name(i)), intType);
+    }
+    EXPECT_NE(big->memberIndex, nullptr);
+    EXPECT_EQ(AsStruct(copy)->memberIndex, nullptr);
+    EXPECT_EQ(FindMember(big, Name(300)), 300u);
+}
+
+TEST(TypeContext_Interning)
+{
+    using namespace Language;
+
+    TypeContext * types = CreateTypeContext();
+
+    // Built-in types are made once.
+    Type * intType = &MakeInt(types, 4, true)->type;
+    Type * unsignedType = &MakeInt(types, 4, false)->type;
+    EXPECT_EQ(&MakeInt(types, 4, true)->type, intType);
+    EXPECT_NE(unsignedType, intType);
+    EXPECT_TRUE(TypeEqual(unsignedType, intType));
+    EXPECT_FALSE(TypeEqual(&MakeInt(types, 8, true)->type, intType));
+    EXPECT_EQ(CloneType(types, intType), intType);
+
+    // Properties of an interned type make another interned variant.
+    Type * assignable = TypeSetAssignable(types, intType);
+    EXPECT_NE(assignable, intType);
+    EXPECT_TRUE(IsAssignable(assignable));
+    EXPECT_FALSE(IsAssignable(intType));
+    EXPECT_EQ(TypeSetAssignable(types, intType), assignable);
+    EXPECT_EQ(TypeSetAssignable(types, assignable), assignable);
+    EXPECT_TRUE(TypeEqual(assignable, intType));
+
+    // Parameter names are not part of the function type.
+    auto FunctionPointer = [types, intType](StringRef parameter, Type * parameterType)
+    {
+        FunctionType * function = MakeFunction(types);
+        FunctionAddParameter(function, parameter, parameterType);
+        SetTargetType(types, &function->type, intType);
+        return &MakePointer(types, &function->type)->type;
+    };
+    Type * a = FunctionPointer("a", intType);
+    Type * b = FunctionPointer("b", intType);
+    EXPECT_NE(a, b);
+    EXPECT_TRUE(TypeEqual(a, b));
+    EXPECT_FALSE(TypeEqual(a, FunctionPointer("a", &MakeChar(types)->type)));
+
+    // Copies of a struct are the declared struct.
+    StructType * s = MakeStruct(types);
+    StructAddMember(s, "x", intType);
+    StructDone(s);
+    Type * copy = CloneType(types, &s->type);
+    EXPECT_NE(copy, &s->type);
+    EXPECT_TRUE(TypeEqual(copy, &s->type));
+    copy = TypeSetAssignable(types, copy);
+    EXPECT_TRUE(IsAssignable(copy));
+    EXPECT_FALSE(IsAssignable(&s->type));
+    EXPECT_TRUE(TypeEqual(copy, &s->type));
+    EXPECT_FALSE(TypeEqual(copy, &MakeStruct(types)->type));
+}
+
+#endif
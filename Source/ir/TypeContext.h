@@ -6,6 +6,7 @@
 #include <vector>
 #include <map>
 #include <tuple>
+#include <unordered_set>
 
 namespace Language {
 
@@ -53,6 +54,10 @@ enum TypeName
 // life of 'incomplete'
 //   only struct/union can be incomplete
 //   all type functions need aware of incompleteness, like size, equal, align, convert
+// life of 'interned'
+//   void/bool/char/int/float, pointer made with target, and their qualified
+//   variants are interned: one object per combination, shared, never changed
+//   tagged types and types built by declarator parts belong to one declaration
 enum TypeProperty
 {
     TP_INCOMPLETE       = 1,
@@ -65,6 +70,8 @@ enum TypeProperty
     TP_IS_SCALAR        = (1 << 6),
     
     TP_IS_OBJECT        = (1 << 7),
+
+    TP_INTERNED         = (1 << 8),
 };
 
 struct Type
@@ -74,6 +81,9 @@ struct Type
     size_t          size;
     size_t          align;
     u64             baseId;
+    // interned type shared by all types TypeEqual() to this one, see
+    // CanonicalType(), null while a declarator-built type is incomplete
+    Type *          canonical;
 };
 
 struct VoidType
@@ -117,13 +127,19 @@ struct PointerType
     Type * target;
 };
 
+// Member arrays are allocated from an arena and grow by copying, copies of
+// a type share them. Struct/union with many members get a hash index of
+// member names once looked up.
+
 struct FunctionType
 {
     Type type;
 
     Type *      target;
-    StringRef   memberName[10];
-    Type *      memberType[10];
+    size_t      memberCount;
+    size_t      memberCapacity;
+    StringRef * memberName;
+    Type **     memberType;
     bool        isVarList;
 };
 
@@ -131,25 +147,35 @@ struct EnumType
 {
     Type type;
 
-    StringRef   memberName[10];
-    int         memberValue[10];
+    size_t      memberCount;
+    size_t      memberCapacity;
+    StringRef * memberName;
+    int *       memberValue;
 };
 
 struct StructType
 {
     Type type;
 
-    StringRef   memberName[10];
-    Type *      memberType[10];
-    size_t      memberOffset[10];
+    size_t      memberCount;
+    size_t      memberCapacity;
+    StringRef * memberName;
+    Type **     memberType;
+    size_t *    memberOffset;
+    UINT32 *    memberIndex;        // null for few members
+    size_t      memberIndexMask;
 };
 
 struct UnionType
 {
     Type type;
 
-    StringRef   memberName[10];
-    Type *      memberType[10];
+    size_t      memberCount;
+    size_t      memberCapacity;
+    StringRef * memberName;
+    Type **     memberType;
+    UINT32 *    memberIndex;        // null for few members
+    size_t      memberIndexMask;
 };
 
 VoidType *      AsVoid(Type * type);
@@ -199,14 +225,22 @@ UnionType *     MakeUnion(TypeContext * context);    // member id/type
 void            UnionAddMember(UnionType * type, StringRef mname, Type * mtype);
 void            UnionDone(UnionType * type);
 
+// function, enum, struct, union: room for count members, kept ones stay
+void            TypeSetMemberCount(Type * type, size_t count);
+
+// interned type itself, or a copy
 Type *          CloneType(TypeContext * context, Type * type);
 
 // array, pointer, function
 void            SetTargetType(TypeContext * context, Type * type, Type * target);
 
-void            TypeSetProperties(Type * type, int prop);
-void            TypeSetAssignable(Type * type);
-void            TypeSetAddressable(Type * type);
+// Interned type: the interned variant with prop. Other types: changed in place.
+Type *          TypeSetProperties(TypeContext * context, Type * type, int prop);
+Type *          TypeSetAssignable(TypeContext * context, Type * type);
+Type *          TypeSetAddressable(TypeContext * context, Type * type);
+
+// Call once a declarator-built type is complete.
+Type *          CanonicalType(TypeContext * context, Type * type);
 
 Type *          IntegralPromotion(TypeContext * context, Type * type);
 Type *          UsualArithmeticConversion(TypeContext * context, Type * left, Type * right);
@@ -261,10 +295,21 @@ bool            IsMatchedCall(FunctionType * func, std::vector<Type *> & argumen
 
 // Manage runtime environment
 
+// Interned types by value, targets and members by identity.
+struct InternedTypeHash
+{
+    size_t operator()(Type * type) const;
+};
+struct InternedTypeEqual
+{
+    bool operator()(Type * a, Type * b) const;
+};
+
 struct TypeContext
 {
     // all types
     std::vector<Type *> types;
+    std::unordered_set<Type *, InternedTypeHash, InternedTypeEqual> internedTypes;
 
     // type id allocation
     u64 nextTypeBaseId;